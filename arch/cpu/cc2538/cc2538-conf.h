@@ -312,6 +312,10 @@
 #define AES_128_CONF            cc2538_aes_128_driver /**< AES-128 driver */
 #endif
 
+#ifndef AES_128_CONF_CONTEXT_ROUND_KEYS
+#define AES_128_CONF_CONTEXT_ROUND_KEYS 1 /**< Contexts only hold the key */
+#endif
+
 #ifndef CCM_STAR_CONF
 #define CCM_STAR_CONF           cc2538_ccm_star_driver /**< AES-CCM* driver */
 #endif
@@ -127,9 +127,34 @@ aead(const uint8_t *nonce, uint8_t *m, uint16_t m_len, const uint8_t *a,
   restore_crypto(crypto_enabled);
 }
 /*---------------------------------------------------------------------------*/
+static void
+init_context(struct aes_128_context *context, const uint8_t *key)
+{
+  cc2538_aes_128_driver.init_context(context, key);
+}
+/*---------------------------------------------------------------------------*/
+static void
+set_context(const struct aes_128_context *context)
+{
+  cc2538_aes_128_driver.set_context(context);
+}
+/*---------------------------------------------------------------------------*/
+/* The engine handles one frame at a time */
+static void
+aead_frames(const struct ccm_star_frame *frames, uint8_t count, int forward)
+{
+  for(; count > 0; count--, frames++) {
+    aead(frames->nonce, frames->m, frames->m_len, frames->a, frames->a_len,
+         frames->result, frames->mic_len, forward);
+  }
+}
+/*---------------------------------------------------------------------------*/
 const struct ccm_star_driver cc2538_ccm_star_driver = {
   set_key,
-  aead
+  aead,
+  init_context,
+  set_context,
+  aead_frames
 };
 
 /** @} */
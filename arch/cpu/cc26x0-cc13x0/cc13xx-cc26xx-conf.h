@@ -104,6 +104,11 @@
 #ifndef AES_128_CONF
 #define AES_128_CONF cc26xx_aes_128_driver
 #endif /* AES_128_CONF */
+
+/* The H/W AES only needs the key, not its expanded round keys */
+#ifndef AES_128_CONF_CONTEXT_ROUND_KEYS
+#define AES_128_CONF_CONTEXT_ROUND_KEYS 1
+#endif /* AES_128_CONF_CONTEXT_ROUND_KEYS */
 /** @} */
 /*---------------------------------------------------------------------------*/
 /**
@@ -119,9 +119,33 @@ cc26xx_aes_decrypt(uint8_t *cyphertext_and_result)
   encrypt_decrypt(cyphertext_and_result, false);
 }
 /*---------------------------------------------------------------------------*/
+static void
+init_context(struct aes_128_context *context, const uint8_t *key)
+{
+  memcpy(context->round_keys[0], key, AES_128_KEY_LENGTH);
+}
+/*---------------------------------------------------------------------------*/
+static void
+set_context(const struct aes_128_context *context)
+{
+  cc26xx_aes_set_key(context->round_keys[0]);
+}
+/*---------------------------------------------------------------------------*/
+static void
+encrypt_blocks(uint8_t *blocks, uint8_t count)
+{
+  for(; count > 0; count--) {
+    cc26xx_aes_encrypt(blocks);
+    blocks += AES_128_BLOCK_SIZE;
+  }
+}
+/*---------------------------------------------------------------------------*/
 const struct aes_128_driver cc26xx_aes_128_driver = {
   cc26xx_aes_set_key,
-  cc26xx_aes_encrypt
+  cc26xx_aes_encrypt,
+  init_context,
+  set_context,
+  encrypt_blocks
 };
 
 /** @} */
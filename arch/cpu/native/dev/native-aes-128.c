@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *         AES-128 for native builds, with AES-NI on x86 hosts that have
+ *         it. Its round keys are those of aes-128.c, stored as they are
+ *         loaded into the XMM registers.
+ */
+
+#include "dev/native-aes-128.h"
+#include <string.h>
+
+#if NATIVE_AES_128_AESNI
+#include <wmmintrin.h>
+
+#define AESNI __attribute__((target("aes,sse2")))
+#define LOAD(p)     _mm_loadu_si128((const __m128i *)(p))
+#define STORE(p, x) _mm_storeu_si128((__m128i *)(p), (x))
+
+static uint8_t round_keys[11][AES_128_KEY_LENGTH];
+/* The round keys in use: either round_keys or those of a context */
+static const uint8_t (*current_round_keys)[AES_128_KEY_LENGTH] = round_keys;
+#endif /* NATIVE_AES_128_AESNI */
+
+static const struct aes_128_driver *backend;
+
+#if NATIVE_AES_128_AESNI
+/*---------------------------------------------------------------------------*/
+static inline AESNI __m128i
+expand_step(__m128i key, __m128i assist)
+{
+  key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  return _mm_xor_si128(key, _mm_shuffle_epi32(assist, 0xff));
+}
+/*---------------------------------------------------------------------------*/
+/* The round constant of _mm_aeskeygenassist_si128() must be a constant */
+#define EXPAND(rk, i, rcon) do { \
+    k = expand_step(k, _mm_aeskeygenassist_si128(k, rcon)); \
+    _mm_storeu_si128((__m128i *)(rk)[i], k); \
+  } while(0)
+
+static AESNI void
+expand_key(uint8_t rk[][AES_128_KEY_LENGTH], const uint8_t *key)
+{
+  __m128i k;
+
+  k = _mm_loadu_si128((const __m128i *)key);
+  _mm_storeu_si128((__m128i *)rk[0], k);
+  EXPAND(rk, 1, 0x01);
+  EXPAND(rk, 2, 0x02);
+  EXPAND(rk, 3, 0x04);
+  EXPAND(rk, 4, 0x08);
+  EXPAND(rk, 5, 0x10);
+  EXPAND(rk, 6, 0x20);
+  EXPAND(rk, 7, 0x40);
+  EXPAND(rk, 8, 0x80);
+  EXPAND(rk, 9, 0x1b);
+  EXPAND(rk, 10, 0x36);
+}
+/*---------------------------------------------------------------------------*/
+static void
+aesni_set_key(const uint8_t *key)
+{
+  expand_key(round_keys, key);
+  current_round_keys = round_keys;
+}
+/*---------------------------------------------------------------------------*/
+static AESNI void
+aesni_encrypt(uint8_t *plaintext_and_result)
+{
+  const uint8_t (*rk)[AES_128_KEY_LENGTH] = current_round_keys;
+  __m128i state;
+  uint8_t round;
+
+  state = _mm_loadu_si128((const __m128i *)plaintext_and_result);
+  state = _mm_xor_si128(state, _mm_loadu_si128((const __m128i *)rk[0]));
+  for(round = 1; round < 10; round++) {
+    state = _mm_aesenc_si128(state,
+                             _mm_loadu_si128((const __m128i *)rk[round]));
+  }
+  state = _mm_aesenclast_si128(state,
+                               _mm_loadu_si128((const __m128i *)rk[10]));
+  _mm_storeu_si128((__m128i *)plaintext_and_result, state);
+}
+/*---------------------------------------------------------------------------*/
+static void
+aesni_init_context(struct aes_128_context *context, const uint8_t *key)
+{
+#if AES_128_CONTEXT_ROUND_KEYS >= 11
+  expand_key(context->round_keys, key);
+#else /* AES_128_CONTEXT_ROUND_KEYS >= 11 */
+  memcpy(context->round_keys[0], key, AES_128_KEY_LENGTH);
+#endif /* AES_128_CONTEXT_ROUND_KEYS >= 11 */
+}
+/*---------------------------------------------------------------------------*/
+static void
+aesni_set_context(const struct aes_128_context *context)
+{
+#if AES_128_CONTEXT_ROUND_KEYS >= 11
+  current_round_keys = context->round_keys;
+#else /* AES_128_CONTEXT_ROUND_KEYS >= 11 */
+  aesni_set_key(context->round_keys[0]);
+#endif /* AES_128_CONTEXT_ROUND_KEYS >= 11 */
+}
+/*---------------------------------------------------------------------------*/
+static AESNI void
+aesni_encrypt_blocks(uint8_t *blocks, uint8_t count)
+{
+  const uint8_t (*rk)[AES_128_KEY_LENGTH] = current_round_keys;
+  __m128i s0, s1, s2, s3;
+  __m128i k;
+  uint8_t round;
+
+  /* The rounds of independent blocks are interleaved, so that the AES
+   * unit starts a new one while the previous ones are in flight */
+  for(; count >= 4; count -= 4) {
+    k = LOAD(rk[0]);
+    s0 = _mm_xor_si128(LOAD(blocks), k);
+    s1 = _mm_xor_si128(LOAD(blocks + 16), k);
+    s2 = _mm_xor_si128(LOAD(blocks + 32), k);
+    s3 = _mm_xor_si128(LOAD(blocks + 48), k);
+    for(round = 1; round < 10; round++) {
+      k = LOAD(rk[round]);
+      s0 = _mm_aesenc_si128(s0, k);
+      s1 = _mm_aesenc_si128(s1, k);
+      s2 = _mm_aesenc_si128(s2, k);
+      s3 = _mm_aesenc_si128(s3, k);
+    }
+    k = LOAD(rk[10]);
+    STORE(blocks, _mm_aesenclast_si128(s0, k));
+    STORE(blocks + 16, _mm_aesenclast_si128(s1, k));
+    STORE(blocks + 32, _mm_aesenclast_si128(s2, k));
+    STORE(blocks + 48, _mm_aesenclast_si128(s3, k));
+    blocks += 4 * AES_128_BLOCK_SIZE;
+  }
+  if(count >= 2) {
+    k = LOAD(rk[0]);
+    s0 = _mm_xor_si128(LOAD(blocks), k);
+    s1 = _mm_xor_si128(LOAD(blocks + 16), k);
+    for(round = 1; round < 10; round++) {
+      k = LOAD(rk[round]);
+      s0 = _mm_aesenc_si128(s0, k);
+      s1 = _mm_aesenc_si128(s1, k);
+    }
+    k = LOAD(rk[10]);
+    STORE(blocks, _mm_aesenclast_si128(s0, k));
+    STORE(blocks + 16, _mm_aesenclast_si128(s1, k));
+    blocks += 2 * AES_128_BLOCK_SIZE;
+    count -= 2;
+  }
+  if(count) {
+    aesni_encrypt(blocks);
+  }
+}
+/*---------------------------------------------------------------------------*/
+const struct aes_128_driver native_aes_128_aesni_driver = {
+  aesni_set_key,
+  aesni_encrypt,
+  aesni_init_context,
+  aesni_set_context,
+  aesni_encrypt_blocks
+};
+#endif /* NATIVE_AES_128_AESNI */
+/*---------------------------------------------------------------------------*/
+int
+native_aes_128_has_aesni(void)
+{
+#if NATIVE_AES_128_AESNI
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("aes");
+#else /* NATIVE_AES_128_AESNI */
+  return 0;
+#endif /* NATIVE_AES_128_AESNI */
+}
+/*---------------------------------------------------------------------------*/
+const struct aes_128_driver *
+native_aes_128_backend(void)
+{
+  if(backend == NULL) {
+#if NATIVE_AES_128_AESNI
+    if(native_aes_128_has_aesni()) {
+      backend = &native_aes_128_aesni_driver;
+    } else {
+      backend = &aes_128_ttable_driver;
+    }
+#else /* NATIVE_AES_128_AESNI */
+    backend = &aes_128_ttable_driver;
+#endif /* NATIVE_AES_128_AESNI */
+  }
+  return backend;
+}
+/*---------------------------------------------------------------------------*/
+static void
+set_key(const uint8_t *key)
+{
+  native_aes_128_backend()->set_key(key);
+}
+/*---------------------------------------------------------------------------*/
+static void
+encrypt(uint8_t *plaintext_and_result)
+{
+  native_aes_128_backend()->encrypt(plaintext_and_result);
+}
+/*---------------------------------------------------------------------------*/
+static void
+init_context(struct aes_128_context *context, const uint8_t *key)
+{
+  native_aes_128_backend()->init_context(context, key);
+}
+/*---------------------------------------------------------------------------*/
+static void
+set_context(const struct aes_128_context *context)
+{
+  native_aes_128_backend()->set_context(context);
+}
+/*---------------------------------------------------------------------------*/
+static void
+encrypt_blocks(uint8_t *blocks, uint8_t count)
+{
+  native_aes_128_backend()->encrypt_blocks(blocks, count);
+}
+/*---------------------------------------------------------------------------*/
+const struct aes_128_driver native_aes_128_driver = {
+  set_key,
+  encrypt,
+  init_context,
+  set_context,
+  encrypt_blocks
+};
+/*---------------------------------------------------------------------------*/
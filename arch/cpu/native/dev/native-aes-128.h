@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *         AES-128 for native builds. native_aes_128_driver, the AES_128
+ *         of native platforms, checks the CPU once and then uses the
+ *         AES-NI instructions of x86 hosts that have them, and the
+ *         T-table driver of os/lib otherwise.
+ */
+
+#ifndef NATIVE_AES_128_H_
+#define NATIVE_AES_128_H_
+
+#include "contiki.h"
+#include "lib/aes-128.h"
+
+/* Whether to build the AES-NI driver, which only x86 hosts have */
+#if defined(__x86_64__) || defined(__i386__)
+#ifdef NATIVE_AES_128_CONF_AESNI
+#define NATIVE_AES_128_AESNI NATIVE_AES_128_CONF_AESNI
+#else
+#define NATIVE_AES_128_AESNI 1
+#endif
+#else
+#define NATIVE_AES_128_AESNI 0
+#endif
+
+/**
+ * Selects the fastest driver that the host supports.
+ */
+extern const struct aes_128_driver native_aes_128_driver;
+
+#if NATIVE_AES_128_AESNI
+/**
+ * The AES-NI driver. Only use it if native_aes_128_has_aesni().
+ */
+extern const struct aes_128_driver native_aes_128_aesni_driver;
+#endif /* NATIVE_AES_128_AESNI */
+
+/**
+ * \brief  Whether the driver with AES-NI is built and the CPU has AES-NI
+ */
+int native_aes_128_has_aesni(void);
+
+/**
+ * \brief  The driver that native_aes_128_driver uses
+ */
+const struct aes_128_driver *native_aes_128_backend(void);
+
+#endif /* NATIVE_AES_128_H_ */
@@ -35,5 +35,15 @@
 #define GPIO_HAL_CONF_ARCH_SW_TOGGLE     1
 #define GPIO_HAL_CONF_PORT_PIN_NUMBERING 0
 /*---------------------------------------------------------------------------*/
+/* AES-NI or a T-table, whichever the host supports */
+#ifndef AES_128_CONF
+#define AES_128_CONF native_aes_128_driver
+#endif /* AES_128_CONF */
+
+/* Border routers and simulated networks may unsecure bursts of frames */
+#ifndef CCM_STAR_CONF_BATCH_FRAMES
+#define CCM_STAR_CONF_BATCH_FRAMES 4
+#endif /* CCM_STAR_CONF_BATCH_FRAMES */
+/*---------------------------------------------------------------------------*/
 #endif /* NATIVE_DEF_H_ */
 /*---------------------------------------------------------------------------*/
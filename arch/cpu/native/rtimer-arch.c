@@ -42,19 +42,186 @@
 #include <sys/time.h>
 #endif /* !_WIN32 */
 #include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
 
 #include "sys/rtimer.h"
 #include "sys/clock.h"
 
+#if RTIMER_ARCH_TIMERFD && !NATIVE_VIRTUAL_TIME
+#include <sys/timerfd.h>
+#endif /* RTIMER_ARCH_TIMERFD && !NATIVE_VIRTUAL_TIME */
+
 #define DEBUG 0
 #if DEBUG
-#include <stdio.h>
 #define PRINTF(...) printf(__VA_ARGS__)
 #else
 #define PRINTF(...)
 #endif
 
+#define NSEC_PER_SEC  1000000000ULL
+#define NSEC_PER_TICK (NSEC_PER_SEC / RTIMER_ARCH_SECOND)
+
+#if NSEC_PER_TICK * RTIMER_ARCH_SECOND != NSEC_PER_SEC
+#error RTIMER_ARCH_SECOND must divide one billion
+#endif
+
+/*---------------------------------------------------------------------------*/
+/* Nanoseconds of the monotonic clock, which clock_time() also follows */
+static uint64_t
+now_ns(void)
+{
+#if NATIVE_VIRTUAL_TIME
+  return virtual_time_now();
+#elif defined(__linux__) || (defined(__MACH__) && __MAC_OS_X_VERSION_MIN_REQUIRED >= 101200)
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+#else
+  struct timeval tv;
+
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec * NSEC_PER_SEC + tv.tv_usec * 1000ULL;
+#endif
+}
+/*---------------------------------------------------------------------------*/
+rtimer_clock_t
+rtimer_arch_now(void)
+{
+  return (rtimer_clock_t)(now_ns() / NSEC_PER_TICK);
+}
+/*---------------------------------------------------------------------------*/
+/* The time until t, or zero if t has passed */
+static uint64_t
+ns_until(rtimer_clock_t t, uint64_t *now)
+{
+  uint64_t ticks;
+
+  *now = now_ns();
+  ticks = *now / NSEC_PER_TICK;
+  if(!RTIMER_CLOCK_LT((rtimer_clock_t)ticks, t)) {
+    return 0;
+  }
+  ticks += (rtimer_clock_t)(t - (rtimer_clock_t)ticks);
+  return ticks * NSEC_PER_TICK - *now;
+}
+/*---------------------------------------------------------------------------*/
+#if NATIVE_VIRTUAL_TIME
+static uint64_t next = VIRTUAL_TIME_NEVER;
+/*---------------------------------------------------------------------------*/
+void
+rtimer_arch_init(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+void
+rtimer_arch_schedule(rtimer_clock_t t)
+{
+  uint64_t now;
+
+  next = ns_until(t, &now);
+  next += now;
+  PRINTF("rtimer_arch_schedule time %"PRIu32" at %"PRIu64" ns\n",
+         (uint32_t)t, next);
+}
+/*---------------------------------------------------------------------------*/
+uint64_t
+rtimer_arch_next(void)
+{
+  return next;
+}
+/*---------------------------------------------------------------------------*/
+void
+rtimer_arch_check(void)
+{
+  if(next != VIRTUAL_TIME_NEVER && virtual_time_now() >= next) {
+    next = VIRTUAL_TIME_NEVER;
+    rtimer_run_next();
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
+rtimer_arch_tick(void)
+{
+  virtual_time_advance((virtual_time_now() / NSEC_PER_TICK + 1) *
+                       NSEC_PER_TICK);
+  rtimer_arch_check();
+}
+/*---------------------------------------------------------------------------*/
+#elif RTIMER_ARCH_TIMERFD
+/* Expires at the time of the next rtimer. The main loop wakes up when
+   the descriptor becomes readable and runs the rtimer from there. */
+static int timer_fd = -1;
+/*---------------------------------------------------------------------------*/
+static int
+set_fd(fd_set *rset, fd_set *wset)
+{
+  /* Always monitored, so that the main loop does not have to update
+     its registration every time the timer is armed */
+  FD_SET(timer_fd, rset);
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static void
+handle_fd(fd_set *rset, fd_set *wset)
+{
+  uint64_t expirations;
+
+  if(FD_ISSET(timer_fd, rset) &&
+     read(timer_fd, &expirations, sizeof(expirations)) > 0) {
+    rtimer_run_next();
+  }
+}
+/*---------------------------------------------------------------------------*/
+static const struct select_callback timer_fd_callback = { set_fd, handle_fd };
+/*---------------------------------------------------------------------------*/
+void
+rtimer_arch_init(void)
+{
+  timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  if(timer_fd < 0) {
+    perror("timerfd_create");
+    exit(EXIT_FAILURE);
+  }
+  if(!select_set_callback(timer_fd, &timer_fd_callback)) {
+    fprintf(stderr, "rtimer: descriptor %d exceeds SELECT_MAX\n", timer_fd);
+    exit(EXIT_FAILURE);
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
+rtimer_arch_schedule(rtimer_clock_t t)
+{
+  struct itimerspec its;
+  uint64_t now;
+  uint64_t delay;
+  int flags;
+
+  delay = ns_until(t, &now);
+  PRINTF("rtimer_arch_schedule time %"PRIu32" in %"PRIu64" ns\n",
+         (uint32_t)t, delay);
+
+  memset(&its, 0, sizeof(its));
+  if(delay == 0) {
+    /* Expire right away. A zero time would disarm the timer. */
+    its.it_value.tv_nsec = 1;
+    flags = 0;
+  } else {
+    its.it_value.tv_sec = (now + delay) / NSEC_PER_SEC;
+    its.it_value.tv_nsec = (now + delay) % NSEC_PER_SEC;
+    flags = TFD_TIMER_ABSTIME;
+  }
+  if(timerfd_settime(timer_fd, flags, &its, NULL) < 0) {
+    perror("timerfd_settime");
+  }
+}
 /*---------------------------------------------------------------------------*/
+#else /* RTIMER_ARCH_TIMERFD */
 static void
 interrupt(int sig)
 {
@@ -75,18 +242,24 @@ rtimer_arch_schedule(rtimer_clock_t t)
 {
 #ifndef _WIN32
   struct itimerval val;
-  rtimer_clock_t c;
+  uint64_t now;
+  uint64_t usec;
+
+  usec = (ns_until(t, &now) + 999) / 1000;
+  /* A zero expiration time would disarm the timer */
+  if(usec == 0) {
+    usec = 1;
+  }
 
-  c = t - clock_time();
-  
-  val.it_value.tv_sec = c / CLOCK_SECOND;
-  val.it_value.tv_usec = (c % CLOCK_SECOND) * CLOCK_SECOND;
+  val.it_value.tv_sec = usec / 1000000;
+  val.it_value.tv_usec = usec % 1000000;
 
-  PRINTF("rtimer_arch_schedule time %"PRIu32 " %"PRIu32 " in %ld.%ld seconds\n",
-         t, c, (long)val.it_value.tv_sec, (long)val.it_value.tv_usec);
+  PRINTF("rtimer_arch_schedule time %"PRIu32" in %ld.%06ld seconds\n",
+         (uint32_t)t, (long)val.it_value.tv_sec, (long)val.it_value.tv_usec);
 
   val.it_interval.tv_sec = val.it_interval.tv_usec = 0;
   setitimer(ITIMER_REAL, &val, NULL);
 #endif /* !_WIN32 */
 }
+#endif /* NATIVE_VIRTUAL_TIME */
 /*---------------------------------------------------------------------------*/
@@ -41,9 +41,63 @@
 #define RTIMER_ARCH_H_
 
 #include "contiki.h"
+#include "virtual-time.h"
 
-#define RTIMER_ARCH_SECOND CLOCK_CONF_SECOND
+/*
+ * Selects the rtimer backend that sleeps on a CLOCK_MONOTONIC timerfd
+ * serviced by the platform main loop. Otherwise, rtimers are run from
+ * a SIGALRM handler. The timerfd backend is only available on Linux.
+ */
+#ifdef RTIMER_ARCH_CONF_TIMERFD
+#define RTIMER_ARCH_TIMERFD RTIMER_ARCH_CONF_TIMERFD
+#elif defined(__linux__)
+#define RTIMER_ARCH_TIMERFD 1
+#else
+#define RTIMER_ARCH_TIMERFD 0
+#endif
+
+/*
+ * The rtimer clock counts ticks of the monotonic clock of the host.
+ * The rate must divide one billion, the number of nanoseconds per
+ * second.
+ */
+#ifdef RTIMER_ARCH_CONF_SECOND
+#define RTIMER_ARCH_SECOND RTIMER_ARCH_CONF_SECOND
+#else
+#define RTIMER_ARCH_SECOND 1000000
+#endif
+
+/* Done in 64 bits, which is cheap on the host */
+#define US_TO_RTIMERTICKS(US)   ((int32_t)(((int64_t)(US) *                 \
+                                            (int64_t)RTIMER_ARCH_SECOND) / \
+                                           1000000))
+#define RTIMERTICKS_TO_US(T)    ((int32_t)(((int64_t)(T) * 1000000) /       \
+                                           (int64_t)RTIMER_ARCH_SECOND))
+#define RTIMERTICKS_TO_US_64(T) ((uint32_t)(((uint64_t)(T) * 1000000) /     \
+                                            (uint64_t)RTIMER_ARCH_SECOND))
+
+rtimer_clock_t rtimer_arch_now(void);
+
+#if NATIVE_VIRTUAL_TIME
+/*
+ * In virtual time, the main loop runs the next rtimer once it has moved
+ * the time to its deadline: rtimer_arch_next() returns the deadline, in
+ * virtual nanoseconds, and rtimer_arch_check() runs the rtimer if it is
+ * due.
+ */
+uint64_t rtimer_arch_next(void);
+void rtimer_arch_check(void);
+void rtimer_arch_tick(void);
 
-#define rtimer_arch_now() clock_time()
+/* Nothing happens while busy-waiting, unless time moves forward */
+#define RTIMER_BUSYWAIT_UNTIL_ABS(cond, t0, max_time)                  \
+  ({                                                                    \
+    bool c;                                                             \
+    while(!(c = cond) && RTIMER_CLOCK_LT(RTIMER_NOW(), (t0) + (max_time))) { \
+      rtimer_arch_tick();                                               \
+    }                                                                   \
+    c;                                                                  \
+  })
+#endif /* NATIVE_VIRTUAL_TIME */
 
 #endif /* RTIMER_ARCH_H_ */
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *         Virtual time for native builds. When enabled, clock_time(),
+ *         clock_seconds() and RTIMER_NOW() follow a counter that only
+ *         moves when the platform main loop has nothing left to run:
+ *         it then jumps to the next etimer or rtimer deadline. Long
+ *         experiments run as fast as the CPU allows, and a run only
+ *         depends on its inputs and random seed.
+ */
+
+#ifndef VIRTUAL_TIME_H_
+#define VIRTUAL_TIME_H_
+
+#include "contiki.h"
+
+#include <stdint.h>
+
+#ifdef NATIVE_CONF_VIRTUAL_TIME
+#define NATIVE_VIRTUAL_TIME NATIVE_CONF_VIRTUAL_TIME
+#else
+#define NATIVE_VIRTUAL_TIME 0
+#endif
+
+/* A deadline that never comes */
+#define VIRTUAL_TIME_NEVER UINT64_MAX
+
+/**
+ * \brief  The virtual time, in nanoseconds since the start of the node
+ */
+uint64_t virtual_time_now(void);
+
+/**
+ * \brief  Move the virtual time forward
+ * \param  ns The new virtual time. Earlier times are ignored.
+ */
+void virtual_time_advance(uint64_t ns);
+
+#endif /* VIRTUAL_TIME_H_ */
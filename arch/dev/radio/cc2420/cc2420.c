@@ -588,9 +588,33 @@ encrypt(uint8_t *plaintext_and_result)
   RELEASE_LOCK();
 }
 /*---------------------------------------------------------------------------*/
+static void
+init_context(struct aes_128_context *context, const uint8_t *key)
+{
+  memcpy(context->round_keys[0], key, AES_128_KEY_LENGTH);
+}
+/*---------------------------------------------------------------------------*/
+static void
+set_context(const struct aes_128_context *context)
+{
+  set_key(context->round_keys[0]);
+}
+/*---------------------------------------------------------------------------*/
+static void
+encrypt_blocks(uint8_t *blocks, uint8_t count)
+{
+  for(; count > 0; count--) {
+    encrypt(blocks);
+    blocks += AES_128_BLOCK_SIZE;
+  }
+}
+/*---------------------------------------------------------------------------*/
 const struct aes_128_driver cc2420_aes_128_driver = {
   set_key,
-  encrypt
+  encrypt,
+  init_context,
+  set_context,
+  encrypt_blocks
 };
 /*---------------------------------------------------------------------------*/
 static void
@@ -75,6 +75,11 @@
 /* Radio setup */
 #define NETSTACK_CONF_RADIO cooja_radio_driver
 
+/* The motes run on the host, which has memory to spare for a T-table */
+#ifndef AES_128_CONF
+#define AES_128_CONF aes_128_ttable_driver
+#endif /* AES_128_CONF */
+
 /* Default network config */
 #if NETSTACK_CONF_WITH_IPV6
 
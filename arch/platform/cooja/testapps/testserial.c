@@ -42,6 +42,8 @@ PROCESS_THREAD(test_serial_process, ev, data)
 
   PROCESS_BEGIN();
 
+  process_subscribe(PROCESS_CURRENT(), serial_line_event_message);
+
   etimer_set(&et, CLOCK_SECOND);
 
   while(1) {
@@ -50,4 +50,9 @@
 #define CCM_STAR_CONF ccm_star_driver_jn516x
 #endif /* CCM_STAR_CONF */
 
+/* The H/W CCM* only needs the key, not its expanded round keys */
+#ifndef AES_128_CONF_CONTEXT_ROUND_KEYS
+#define AES_128_CONF_CONTEXT_ROUND_KEYS 1
+#endif /* AES_128_CONF_CONTEXT_ROUND_KEYS */
+
 #endif /* CONTIKI_CONF_H_ */
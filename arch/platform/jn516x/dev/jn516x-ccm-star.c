@@ -112,8 +112,33 @@ set_key(const uint8_t *key)
   }
 }
 /*---------------------------------------------------------------------------*/
+static void
+init_context(struct aes_128_context *context, const uint8_t *key)
+{
+  memcpy(context->round_keys[0], key, AES_128_KEY_LENGTH);
+}
+/*---------------------------------------------------------------------------*/
+static void
+set_context(const struct aes_128_context *context)
+{
+  set_key(context->round_keys[0]);
+}
+/*---------------------------------------------------------------------------*/
+/* The engine handles one frame at a time */
+static void
+aead_frames(const struct ccm_star_frame *frames, uint8_t count, int forward)
+{
+  for(; count > 0; count--, frames++) {
+    aead(frames->nonce, frames->m, frames->m_len, frames->a, frames->a_len,
+         frames->result, frames->mic_len, forward);
+  }
+}
+/*---------------------------------------------------------------------------*/
 const struct ccm_star_driver ccm_star_driver_jn516x = {
   set_key,
-  aead
+  aead,
+  init_context,
+  set_context,
+  aead_frames
 };
 /*---------------------------------------------------------------------------*/
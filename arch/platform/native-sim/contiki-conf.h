@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CONTIKI_CONF_H_
+#define CONTIKI_CONF_H_
+
+/* include the project config */
+#ifdef PROJECT_CONF_PATH
+#include PROJECT_CONF_PATH
+#endif /* PROJECT_CONF_PATH */
+/*---------------------------------------------------------------------------*/
+#include "native-def.h"
+/*---------------------------------------------------------------------------*/
+#include <inttypes.h>
+
+#define NATIVE_SIM 1
+
+#define CC_CONF_REGISTER_ARGS          1
+#define CC_CONF_FUNCTION_POINTER_ARGS  1
+#define CC_CONF_VA_ARGS                1
+#define CC_CONF_INLINE inline
+
+#ifndef EEPROM_CONF_SIZE
+#define EEPROM_CONF_SIZE				1024
+#endif
+
+typedef unsigned int uip_stats_t;
+
+#ifndef UIP_CONF_BYTE_ORDER
+#define UIP_CONF_BYTE_ORDER      UIP_LITTLE_ENDIAN
+#endif
+
+/* Radio setup */
+#ifndef NETSTACK_CONF_RADIO
+#define NETSTACK_CONF_RADIO      native_sim_radio_driver
+#endif /* NETSTACK_CONF_RADIO */
+
+/* The simulated radio does not acknowledge frames */
+#define CSMA_CONF_SEND_SOFT_ACK 1
+#define CSMA_CONF_ACK_WAIT_TIME                RTIMER_SECOND / 500
+#define CSMA_CONF_AFTER_ACK_DETECTED_WAIT_TIME 0
+
+/* 1 len byte, 2 bytes CRC */
+#define RADIO_PHY_OVERHEAD         3
+/* 250kbps data rate. One byte = 32us */
+#define RADIO_BYTE_AIR_TIME       32
+#define RADIO_DELAY_BEFORE_TX 0
+#define RADIO_DELAY_BEFORE_RX 0
+#define RADIO_DELAY_BEFORE_DETECT 0
+
+#if NETSTACK_CONF_WITH_IPV6
+/* Sized for networks of a few hundred motes. Every mote of a simulation
+   has its own copy of these tables. */
+#ifndef NETSTACK_MAX_ROUTE_ENTRIES
+#define NETSTACK_MAX_ROUTE_ENTRIES   300
+#endif /* NETSTACK_MAX_ROUTE_ENTRIES */
+#ifndef NBR_TABLE_CONF_MAX_NEIGHBORS
+#define NBR_TABLE_CONF_MAX_NEIGHBORS 64
+#endif /* NBR_TABLE_CONF_MAX_NEIGHBORS */
+/* Index the routing table of such networks */
+#ifndef UIP_DS6_ROUTE_CONF_HASH
+#define UIP_DS6_ROUTE_CONF_HASH 1
+#endif /* UIP_DS6_ROUTE_CONF_HASH */
+
+/* configure queues */
+#ifndef QUEUEBUF_CONF_NUM
+#define QUEUEBUF_CONF_NUM 16
+#endif /* QUEUEBUF_CONF_NUM */
+
+#define UIP_CONF_IPV6_QUEUE_PKT  1
+#define UIP_ARCH_IPCHKSUM        1
+#endif /* NETSTACK_CONF_WITH_IPV6 */
+
+#include <ctype.h>
+
+typedef unsigned long clock_time_t;
+
+#define CLOCK_CONF_SECOND 1000
+
+/* Use 64-bit rtimer, which counts simulated microseconds */
+#define RTIMER_CONF_CLOCK_SIZE 8
+
+#ifndef ETIMER_CONF_WHEEL
+#define ETIMER_CONF_WHEEL 1
+#endif /* ETIMER_CONF_WHEEL */
+#ifndef ETIMER_CONF_WHEEL_LEVELS
+#define ETIMER_CONF_WHEEL_LEVELS 6
+#endif /* ETIMER_CONF_WHEEL_LEVELS */
+#ifndef PROCESS_CONF_POLL_QUEUE
+#define PROCESS_CONF_POLL_QUEUE 1
+#endif /* PROCESS_CONF_POLL_QUEUE */
+
+#define LOG_CONF_ENABLED 1
+
+/* Not part of C99 but actually present */
+int strcasecmp(const char*, const char*);
+
+#define PLATFORM_CONF_PROVIDES_MAIN_LOOP 1
+#define PLATFORM_CONF_SUPPORTS_STACK_CHECK 0
+
+#endif /* CONTIKI_CONF_H_ */
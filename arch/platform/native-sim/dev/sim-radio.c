@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \addtogroup native_sim_platform
+ * @{
+ *
+ * \file
+ *         Radio driver of a native-sim mote, after the one of Cooja
+ *         motes. The simulator decides which motes receive a frame and
+ *         with what signal strength.
+ */
+
+#include "contiki.h"
+#include "native-sim.h"
+
+#include "net/packetbuf.h"
+#include "net/netstack.h"
+#include "sys/energest.h"
+
+#include "dev/radio.h"
+#include "dev/sim-radio.h"
+
+#include <string.h>
+
+#define CCA_SS_THRESHOLD -95
+
+static const void *pending_data;
+static rtimer_clock_t last_packet_timestamp;
+static int last_rssi = -110;
+static int radio_is_on = 1;
+static int channel = IEEE802154_DEFAULT_CHANNEL;
+
+/* If we are in the polling mode, poll_mode is 1; otherwise 0 */
+static int poll_mode = 0;
+static int send_on_cca = 1;
+
+PROCESS(sim_radio_process, "sim radio process");
+/*---------------------------------------------------------------------------*/
+static int
+radio_on(void)
+{
+  if(!radio_is_on) {
+    ENERGEST_ON(ENERGEST_TYPE_LISTEN);
+    radio_is_on = 1;
+    native_sim_host->radio_set(radio_is_on, channel);
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+radio_off(void)
+{
+  if(radio_is_on) {
+    ENERGEST_OFF(ENERGEST_TYPE_LISTEN);
+    radio_is_on = 0;
+    native_sim_host->radio_set(radio_is_on, channel);
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+radio_read(void *buf, unsigned short bufsize)
+{
+  int len;
+
+  len = native_sim_host->radio_read(buf, bufsize, &last_rssi);
+  if(len > 0) {
+    last_packet_timestamp = RTIMER_NOW();
+    if(!poll_mode) {
+      packetbuf_set_attr(PACKETBUF_ATTR_RSSI, last_rssi);
+    }
+  }
+  return len;
+}
+/*---------------------------------------------------------------------------*/
+static int
+channel_clear(void)
+{
+  return native_sim_host->radio_rssi() <= CCA_SS_THRESHOLD;
+}
+/*---------------------------------------------------------------------------*/
+static int
+radio_send(const void *payload, unsigned short payload_len)
+{
+  if(payload_len > SIM_RADIO_BUFSIZE || payload_len == 0) {
+    return RADIO_TX_ERR;
+  }
+
+  if(send_on_cca && !channel_clear()) {
+    return RADIO_TX_COLLISION;
+  }
+
+  if(radio_is_on) {
+    ENERGEST_SWITCH(ENERGEST_TYPE_LISTEN, ENERGEST_TYPE_TRANSMIT);
+  } else {
+    ENERGEST_ON(ENERGEST_TYPE_TRANSMIT);
+  }
+
+  native_sim_host->radio_transmit(payload, payload_len);
+
+  if(radio_is_on) {
+    ENERGEST_SWITCH(ENERGEST_TYPE_TRANSMIT, ENERGEST_TYPE_LISTEN);
+  } else {
+    ENERGEST_OFF(ENERGEST_TYPE_TRANSMIT);
+  }
+
+  return RADIO_TX_OK;
+}
+/*---------------------------------------------------------------------------*/
+static int
+prepare_packet(const void *data, unsigned short len)
+{
+  if(len > SIM_RADIO_BUFSIZE) {
+    return RADIO_TX_ERR;
+  }
+  pending_data = data;
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+static int
+transmit_packet(unsigned short len)
+{
+  if(pending_data == NULL) {
+    return RADIO_TX_ERR;
+  }
+  return radio_send(pending_data, len);
+}
+/*---------------------------------------------------------------------------*/
+static int
+receiving_packet(void)
+{
+  return native_sim_host->radio_receiving();
+}
+/*---------------------------------------------------------------------------*/
+static int
+pending_packet(void)
+{
+  return native_sim_host->radio_pending();
+}
+/*---------------------------------------------------------------------------*/
+void
+sim_radio_check(void)
+{
+  if(!poll_mode && native_sim_host->radio_pending()) {
+    process_poll(&sim_radio_process);
+  }
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(sim_radio_process, ev, data)
+{
+  int len;
+
+  PROCESS_BEGIN();
+
+  while(1) {
+    PROCESS_YIELD_UNTIL(ev == PROCESS_EVENT_POLL);
+    if(poll_mode) {
+      continue;
+    }
+
+    packetbuf_clear();
+    len = radio_read(packetbuf_dataptr(), PACKETBUF_SIZE);
+    if(len > 0) {
+      packetbuf_set_datalen(len);
+      NETSTACK_MAC.input();
+    }
+  }
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
+static int
+init(void)
+{
+  ENERGEST_ON(ENERGEST_TYPE_LISTEN);
+  native_sim_host->radio_set(radio_is_on, channel);
+  process_start(&sim_radio_process, NULL);
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static radio_result_t
+get_value(radio_param_t param, radio_value_t *value)
+{
+  switch(param) {
+  case RADIO_PARAM_POWER_MODE:
+    *value = radio_is_on ? RADIO_POWER_MODE_ON : RADIO_POWER_MODE_OFF;
+    return RADIO_RESULT_OK;
+  case RADIO_PARAM_CHANNEL:
+    *value = channel;
+    return RADIO_RESULT_OK;
+  case RADIO_PARAM_RX_MODE:
+    *value = poll_mode ? RADIO_RX_MODE_POLL_MODE : 0;
+    return RADIO_RESULT_OK;
+  case RADIO_PARAM_TX_MODE:
+    *value = send_on_cca ? RADIO_TX_MODE_SEND_ON_CCA : 0;
+    return RADIO_RESULT_OK;
+  case RADIO_PARAM_LAST_RSSI:
+    *value = last_rssi;
+    return RADIO_RESULT_OK;
+  case RADIO_PARAM_RSSI:
+    *value = native_sim_host->radio_rssi();
+    return RADIO_RESULT_OK;
+  case RADIO_CONST_CHANNEL_MIN:
+    *value = 11;
+    return RADIO_RESULT_OK;
+  case RADIO_CONST_CHANNEL_MAX:
+    *value = 26;
+    return RADIO_RESULT_OK;
+  case RADIO_CONST_MAX_PAYLOAD_LEN:
+    *value = (radio_value_t)SIM_RADIO_BUFSIZE;
+    return RADIO_RESULT_OK;
+  default:
+    return RADIO_RESULT_NOT_SUPPORTED;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static radio_result_t
+set_value(radio_param_t param, radio_value_t value)
+{
+  switch(param) {
+  case RADIO_PARAM_POWER_MODE:
+    if(value == RADIO_POWER_MODE_ON) {
+      radio_on();
+      return RADIO_RESULT_OK;
+    }
+    if(value == RADIO_POWER_MODE_OFF) {
+      radio_off();
+      return RADIO_RESULT_OK;
+    }
+    return RADIO_RESULT_INVALID_VALUE;
+  case RADIO_PARAM_CHANNEL:
+    if(value < 11 || value > 26) {
+      return RADIO_RESULT_INVALID_VALUE;
+    }
+    channel = value;
+    native_sim_host->radio_set(radio_is_on, channel);
+    return RADIO_RESULT_OK;
+  case RADIO_PARAM_RX_MODE:
+    if(value & ~(RADIO_RX_MODE_ADDRESS_FILTER |
+                 RADIO_RX_MODE_AUTOACK | RADIO_RX_MODE_POLL_MODE)) {
+      return RADIO_RESULT_INVALID_VALUE;
+    }
+    /* Neither frame filtering nor automatic acknowledgements */
+    if(value & (RADIO_RX_MODE_ADDRESS_FILTER | RADIO_RX_MODE_AUTOACK)) {
+      return RADIO_RESULT_NOT_SUPPORTED;
+    }
+    poll_mode = (value & RADIO_RX_MODE_POLL_MODE) != 0;
+    return RADIO_RESULT_OK;
+  case RADIO_PARAM_TX_MODE:
+    if(value & ~(RADIO_TX_MODE_SEND_ON_CCA)) {
+      return RADIO_RESULT_INVALID_VALUE;
+    }
+    send_on_cca = (value & RADIO_TX_MODE_SEND_ON_CCA) != 0;
+    return RADIO_RESULT_OK;
+  default:
+    return RADIO_RESULT_NOT_SUPPORTED;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static radio_result_t
+get_object(radio_param_t param, void *dest, size_t size)
+{
+  if(param == RADIO_PARAM_LAST_PACKET_TIMESTAMP) {
+    if(size != sizeof(rtimer_clock_t) || !dest) {
+      return RADIO_RESULT_INVALID_VALUE;
+    }
+    *(rtimer_clock_t *)dest = last_packet_timestamp;
+    return RADIO_RESULT_OK;
+  }
+  return RADIO_RESULT_NOT_SUPPORTED;
+}
+/*---------------------------------------------------------------------------*/
+static radio_result_t
+set_object(radio_param_t param, const void *src, size_t size)
+{
+  return RADIO_RESULT_NOT_SUPPORTED;
+}
+/*---------------------------------------------------------------------------*/
+const struct radio_driver native_sim_radio_driver =
+{
+  init,
+  prepare_packet,
+  transmit_packet,
+  radio_send,
+  radio_read,
+  channel_clear,
+  receiving_packet,
+  pending_packet,
+  radio_on,
+  radio_off,
+  get_value,
+  set_value,
+  get_object,
+  set_object
+};
+/*---------------------------------------------------------------------------*/
+/** @} */
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \addtogroup native_sim_platform
+ * @{
+ *
+ * \file
+ *         Interface between a native-sim mote and the simulator that
+ *         runs it. The simulator loads each mote firmware as a shared
+ *         object and calls native_sim_main() in a coroutine of its own.
+ *         The mote reaches the simulator, which owns time and the radio
+ *         medium, only through the functions of struct native_sim_host.
+ */
+
+#ifndef NATIVE_SIM_H_
+#define NATIVE_SIM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Incremented on every incompatible change of struct native_sim_host */
+#define NATIVE_SIM_API_VERSION 1
+
+/* The name of the entry point of a mote firmware */
+#define NATIVE_SIM_MAIN "native_sim_main"
+
+/* A time that never comes */
+#define NATIVE_SIM_NEVER UINT64_MAX
+
+struct native_sim_host {
+  unsigned api_version;
+
+  /** The ID of the mote, which sets its link-layer address and node ID */
+  uint16_t (* mote_id)(void);
+  /** A seed for the random number generator of the mote */
+  uint32_t (* seed)(void);
+
+  /** The simulated time, in microseconds */
+  uint64_t (* now)(void);
+  /**
+   * Return to the simulator until the simulated time reaches the given
+   * time, or until the radio of the mote receives a frame.
+   */
+  void (* wait)(uint64_t until);
+
+  /** Write output of the mote, such as log messages */
+  void (* output)(const char *data, size_t len);
+
+  /**
+   * Transmit a frame. Returns when the transmission has ended, with
+   * the simulated time advanced by the air time of the frame.
+   */
+  void (* radio_transmit)(const void *frame, unsigned short len);
+  /**
+   * Move the frame received by the radio, if any, to the buffer.
+   * Returns its length, or 0.
+   */
+  int (* radio_read)(void *buf, unsigned short size, int *rssi);
+  /** Whether a received frame waits to be read */
+  int (* radio_pending)(void);
+  /** Whether the radio is receiving a frame */
+  int (* radio_receiving)(void);
+  /** The strongest signal on the channel of the radio, in dBm */
+  int (* radio_rssi)(void);
+  /** Turn the radio on or off, and set its channel */
+  void (* radio_set)(int on, int channel);
+};
+
+/**
+ * The entry point of a mote firmware. Does not return.
+ */
+void native_sim_main(const struct native_sim_host *host);
+
+/* The simulator of the mote, set by native_sim_main() */
+extern const struct native_sim_host *native_sim_host;
+
+#endif /* NATIVE_SIM_H_ */
+/** @} */
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \ingroup platform
+ *
+ * \defgroup native_sim_platform Native-sim platform
+ *
+ * Mote firmware for the native network simulator in tools/native-sim.
+ * Many motes run in one process, in simulated time, and exchange frames
+ * through a simulated radio medium.
+ * @{
+ *
+ * \file
+ *         Main loop of a native-sim mote.
+ */
+
+#include "contiki.h"
+#include "native-sim.h"
+#include "dev/sim-radio.h"
+#include "lib/random.h"
+#include "net/linkaddr.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+const struct native_sim_host *native_sim_host;
+
+/* The main function, implemented in contiki-main.c */
+int main(void);
+/*---------------------------------------------------------------------------*/
+static void
+set_lladdr(void)
+{
+  linkaddr_t addr;
+  uint16_t id;
+  int i;
+
+  /* As Cooja motes do, repeat the ID over the address */
+  id = native_sim_host->mote_id();
+  memset(&addr, 0, sizeof(linkaddr_t));
+  for(i = 0; i + 1 < LINKADDR_SIZE; i += 2) {
+    addr.u8[i] = id >> 8;
+    addr.u8[i + 1] = id & 0xff;
+  }
+  linkaddr_set_node_addr(&addr);
+}
+/*---------------------------------------------------------------------------*/
+void
+platform_init_stage_one(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+void
+platform_init_stage_two(void)
+{
+  set_lladdr();
+  random_seed(native_sim_host->seed());
+}
+/*---------------------------------------------------------------------------*/
+void
+platform_init_stage_three(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+void
+platform_main_loop(void)
+{
+  uint64_t next;
+  uint64_t t;
+
+  while(1) {
+    while(process_run() > 0);
+
+    /* Sleep in the simulator until the next timer */
+    next = rtimer_arch_next();
+    if(etimer_pending()) {
+      t = (uint64_t)etimer_next_expiration_time() * (1000000 / CLOCK_SECOND);
+      if(t < next) {
+        next = t;
+      }
+    }
+    if(next > native_sim_host->now()) {
+      native_sim_host->wait(next);
+    }
+
+    rtimer_arch_check();
+    if(etimer_pending() && etimer_next_expiration_time() <= clock_time()) {
+      etimer_request_poll();
+    }
+    sim_radio_check();
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
+native_sim_main(const struct native_sim_host *host)
+{
+  if(host->api_version != NATIVE_SIM_API_VERSION) {
+    fprintf(stderr, "native-sim: API version %u, expected %u\n",
+            host->api_version, NATIVE_SIM_API_VERSION);
+    abort();
+  }
+  native_sim_host = host;
+  main();
+}
+/*---------------------------------------------------------------------------*/
+/** @} */
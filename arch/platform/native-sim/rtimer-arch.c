@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \addtogroup native_sim_platform
+ * @{
+ *
+ * \file
+ *         Real-time timer of a native-sim mote. The platform main loop
+ *         asks the simulator to resume the mote at the time of the next
+ *         rtimer, and runs it from there.
+ */
+
+#include "contiki.h"
+#include "sys/rtimer.h"
+
+static uint64_t next = NATIVE_SIM_NEVER;
+/*---------------------------------------------------------------------------*/
+void
+rtimer_arch_init(void)
+{
+  next = NATIVE_SIM_NEVER;
+}
+/*---------------------------------------------------------------------------*/
+void
+rtimer_arch_schedule(rtimer_clock_t t)
+{
+  next = t;
+}
+/*---------------------------------------------------------------------------*/
+uint64_t
+rtimer_arch_next(void)
+{
+  return next;
+}
+/*---------------------------------------------------------------------------*/
+void
+rtimer_arch_check(void)
+{
+  if(next != NATIVE_SIM_NEVER && native_sim_host->now() >= next) {
+    next = NATIVE_SIM_NEVER;
+    rtimer_run_next();
+  }
+}
+/*---------------------------------------------------------------------------*/
+/** @} */
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \addtogroup native_sim_platform
+ * @{
+ *
+ * \file
+ *         Real-time timer of a native-sim mote, which counts simulated
+ *         microseconds.
+ */
+
+#ifndef RTIMER_ARCH_H_
+#define RTIMER_ARCH_H_
+
+#include "contiki.h"
+#include "native-sim.h"
+
+#include <stdbool.h>
+
+#define RTIMER_ARCH_SECOND UINT64_C(1000000)
+
+#define US_TO_RTIMERTICKS(US)   (US)
+#define RTIMERTICKS_TO_US(T)    (T)
+#define RTIMERTICKS_TO_US_64(T) (T)
+
+#define rtimer_arch_now() ((rtimer_clock_t)native_sim_host->now())
+
+/** The time of the next rtimer, or NATIVE_SIM_NEVER */
+uint64_t rtimer_arch_next(void);
+/** Run the next rtimer if its time has come */
+void rtimer_arch_check(void);
+
+/**
+ * Simulated time only passes while the mote waits in the simulator,
+ * so a busy-wait has to return there until the condition holds. The
+ * simulator resumes the mote earlier when its radio receives a frame.
+ */
+#define RTIMER_BUSYWAIT_UNTIL_ABS(cond, t0, max_time)                   \
+  ({                                                                    \
+    bool c;                                                             \
+    while(!(c = cond) && RTIMER_CLOCK_LT(RTIMER_NOW(), (t0) + (max_time))) { \
+      native_sim_host->wait((t0) + (max_time));                         \
+    }                                                                   \
+    c;                                                                  \
+  })
+
+#endif /* RTIMER_ARCH_H_ */
+/** @} */
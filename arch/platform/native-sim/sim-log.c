@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \addtogroup native_sim_platform
+ * @{
+ *
+ * \file
+ *         Output of a native-sim mote. printf() and friends are
+ *         replaced, so that the simulator can tell the output of the
+ *         motes apart.
+ */
+
+#include "contiki.h"
+#include "native-sim.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifndef MAX_LOG_LENGTH
+#define MAX_LOG_LENGTH 1024
+#endif /* MAX_LOG_LENGTH */
+
+/*---------------------------------------------------------------------------*/
+int
+putchar(int c)
+{
+  char ch = c;
+
+  native_sim_host->output(&ch, 1);
+  return c;
+}
+/*---------------------------------------------------------------------------*/
+int
+puts(const char *s)
+{
+  native_sim_host->output(s, strlen(s));
+  native_sim_host->output("\n", 1);
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+int
+printf(const char *fmt, ...)
+{
+  char buf[MAX_LOG_LENGTH];
+  va_list ap;
+  int res;
+
+  va_start(ap, fmt);
+  res = vsnprintf(buf, sizeof(buf), fmt, ap);
+  va_end(ap);
+
+  if(res > 0) {
+    native_sim_host->output(buf, res < (int)sizeof(buf) ? res : sizeof(buf) - 1);
+  }
+  return res;
+}
+/*---------------------------------------------------------------------------*/
+/** @} */
@@ -38,6 +38,7 @@
  */
 
 #include "sys/clock.h"
+#include "virtual-time.h"
 #include <time.h>
 #include <sys/time.h>
 
@@ -50,7 +51,12 @@ typedef struct clock_timespec_s {
 static void
 get_time(clock_timespec_t *spec)
 {
-#if defined(__linux__) || (defined(__MACH__) && __MAC_OS_X_VERSION_MIN_REQUIRED >= 101200)
+#if NATIVE_VIRTUAL_TIME
+  uint64_t ns = virtual_time_now();
+
+  spec->tv_sec = ns / 1000000000;
+  spec->tv_nsec = ns % 1000000000;
+#elif defined(__linux__) || (defined(__MACH__) && __MAC_OS_X_VERSION_MIN_REQUIRED >= 101200)
   struct timespec ts;
 
   clock_gettime(CLOCK_MONOTONIC, &ts);
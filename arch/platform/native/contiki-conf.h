@@ -85,6 +85,10 @@ typedef unsigned int uip_stats_t;
 #ifndef NBR_TABLE_CONF_MAX_NEIGHBORS
 #define NBR_TABLE_CONF_MAX_NEIGHBORS 300
 #endif /* NBR_TABLE_CONF_MAX_NEIGHBORS */
+/* Index the routing table of such networks */
+#ifndef UIP_DS6_ROUTE_CONF_HASH
+#define UIP_DS6_ROUTE_CONF_HASH 1
+#endif /* UIP_DS6_ROUTE_CONF_HASH */
 
 /* configure queues */
 #ifndef QUEUEBUF_CONF_NUM
@@ -102,6 +106,18 @@ typedef unsigned long clock_time_t;
 
 #define CLOCK_CONF_SECOND 1000
 
+/* Native nodes often run hundreds of timers: use the etimer wheel */
+#ifndef ETIMER_CONF_WHEEL
+#define ETIMER_CONF_WHEEL 1
+#endif /* ETIMER_CONF_WHEEL */
+#ifndef ETIMER_CONF_WHEEL_LEVELS
+#define ETIMER_CONF_WHEEL_LEVELS 6
+#endif /* ETIMER_CONF_WHEEL_LEVELS */
+/* Only visit the processes that have been polled */
+#ifndef PROCESS_CONF_POLL_QUEUE
+#define PROCESS_CONF_POLL_QUEUE 1
+#endif /* PROCESS_CONF_POLL_QUEUE */
+
 #define LOG_CONF_ENABLED 1
 
 #define PLATFORM_SUPPORTS_BUTTON_HAL 1
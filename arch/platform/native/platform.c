@@ -42,8 +42,12 @@
  * @{
  */
 
+#include <stdbool.h>
 #include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
 #include <sys/select.h>
 #include <errno.h>
@@ -52,6 +56,11 @@
 #include "net/wpcap-drv.h"
 #endif /* __CYGWIN__ */
 
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#endif /* __linux__ */
+
 #include "contiki.h"
 #include "net/netstack.h"
 
@@ -63,6 +72,8 @@
 #include "net/ipv6/uip.h"
 #include "net/ipv6/uip-debug.h"
 #include "net/queuebuf.h"
+#include "lib/random.h"
+#include "virtual-time.h"
 
 #if NETSTACK_CONF_WITH_IPV6
 #include "net/ipv6/uip-ds6.h"
@@ -80,19 +91,40 @@
  * @{
  */
 
+/*
+ * Selects a main loop based on epoll(7), which sleeps until a
+ * monitored file descriptor becomes ready or the next etimer expires,
+ * instead of polling with select(). Only available on Linux. In
+ * virtual time, the main loop never sleeps while a timer is pending,
+ * and polls its descriptors with select().
+ */
+#if NATIVE_VIRTUAL_TIME
+#define SELECT_EPOLL 0
+#elif defined(SELECT_CONF_EPOLL)
+#define SELECT_EPOLL SELECT_CONF_EPOLL
+#elif defined(__linux__)
+#define SELECT_EPOLL 1
+#else
+#define SELECT_EPOLL 0
+#endif
+
 /*
  * Defines the maximum number of file descriptors monitored by the platform
- * main loop.
+ * main loop. With epoll, any descriptor that fits in an fd_set can be
+ * monitored by default.
  */
 #ifdef SELECT_CONF_MAX
 #define SELECT_MAX SELECT_CONF_MAX
+#elif SELECT_EPOLL
+#define SELECT_MAX FD_SETSIZE
 #else
 #define SELECT_MAX 8
 #endif
 
 /*
  * Defines the timeout (in msec) of the select operation if no monitored file
- * descriptors becomes ready.
+ * descriptors becomes ready. With epoll, this is the longest time the
+ * main loop sleeps when no etimer is pending.
  */
 #ifdef SELECT_CONF_TIMEOUT
 #define SELECT_TIMEOUT SELECT_CONF_TIMEOUT
@@ -108,12 +140,37 @@
 #else
 #define SELECT_STDIN 1
 #endif
+
+/*
+ * The seed of the random number generator, in virtual time. The
+ * CONTIKI_NG_SEED environment variable overrides it, so that the runs
+ * of an experiment can use different seeds without rebuilding.
+ */
+#ifdef NATIVE_CONF_SEED
+#define NATIVE_SEED NATIVE_CONF_SEED
+#else
+#define NATIVE_SEED 1
+#endif
 /** @} */
 /*---------------------------------------------------------------------------*/
 
 static const struct select_callback *select_callback[SELECT_MAX];
 static int select_max = 0;
 
+#if SELECT_EPOLL
+static int epoll_fd = -1;
+/* Expires at the time of the next etimer */
+static int timer_fd = -1;
+static clock_time_t timer_deadline;
+static bool timer_armed;
+/* The events that each descriptor is registered for in the epoll set */
+static uint32_t fd_events[SELECT_MAX];
+/* Descriptors that epoll cannot monitor, such as regular files */
+static bool fd_unpollable[SELECT_MAX];
+
+static void epoll_remove(int fd);
+#endif /* SELECT_EPOLL */
+
 #ifdef PLATFORM_CONF_MAC_ADDR
 static uint8_t mac_addr[] = PLATFORM_CONF_MAC_ADDR;
 #else /* PLATFORM_CONF_MAC_ADDR */
@@ -132,6 +189,12 @@ select_set_callback(int fd, const struct select_callback *callback)
       callback = NULL;
     }
 
+#if SELECT_EPOLL
+    if(callback != select_callback[fd]) {
+      epoll_remove(fd);
+    }
+#endif /* SELECT_EPOLL */
+
     select_callback[fd] = callback;
 
     /* Update fd max */
@@ -171,9 +234,15 @@ static void
 stdin_handle_fd(fd_set *rset, fd_set *wset)
 {
   char c;
+  ssize_t len;
+
   if(FD_ISSET(STDIN_FILENO, rset)) {
-    if(read(STDIN_FILENO, &c, 1) > 0) {
+    len = read(STDIN_FILENO, &c, 1);
+    if(len > 0) {
       input_handler(c);
+    } else if(len == 0) {
+      /* End of file: stop waiting for input */
+      select_set_callback(STDIN_FILENO, NULL);
     }
   }
 }
@@ -263,6 +332,14 @@ platform_init_stage_two()
   set_lladdr();
   serial_line_init();
 
+#if NATIVE_VIRTUAL_TIME
+  if(getenv("CONTIKI_NG_SEED") != NULL) {
+    random_seed(strtoul(getenv("CONTIKI_NG_SEED"), NULL, 0));
+  } else {
+    random_seed(NATIVE_SEED);
+  }
+#endif /* NATIVE_VIRTUAL_TIME */
+
 #if SELECT_STDIN
   if(NULL == input_handler) {
     native_uart_set_input(serial_line_input_byte);
@@ -286,6 +363,317 @@ platform_init_stage_three()
   setvbuf(stdout, (char *)NULL, _IONBF, 0);
 }
 /*---------------------------------------------------------------------------*/
+#if SELECT_EPOLL
+/* Make the epoll registration of a descriptor match the events that
+   its callback asks for. Unchanged registrations cost no system call. */
+static void
+epoll_update(int fd, uint32_t events)
+{
+  struct epoll_event ev;
+  int op;
+
+  if(events == fd_events[fd] || fd_unpollable[fd]) {
+    return;
+  }
+
+  /* A descriptor without events is removed, because epoll would
+     report errors and hang-ups on it anyway. */
+  if(events == 0) {
+    op = EPOLL_CTL_DEL;
+  } else if(fd_events[fd] == 0) {
+    op = EPOLL_CTL_ADD;
+  } else {
+    op = EPOLL_CTL_MOD;
+  }
+
+  memset(&ev, 0, sizeof(ev));
+  ev.events = events;
+  ev.data.fd = fd;
+  if(epoll_ctl(epoll_fd, op, fd, &ev) < 0) {
+    if(errno == EPERM) {
+      /* Always ready, as select() would report it */
+      fd_unpollable[fd] = true;
+    } else {
+      perror("epoll_ctl");
+    }
+    events = 0;
+  }
+  fd_events[fd] = events;
+}
+/*---------------------------------------------------------------------------*/
+static void
+epoll_remove(int fd)
+{
+  if(epoll_fd >= 0 && fd_events[fd] != 0) {
+    /* The descriptor may already be closed, which removes it */
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+  }
+  fd_events[fd] = 0;
+  fd_unpollable[fd] = false;
+}
+/*---------------------------------------------------------------------------*/
+/* Arm the timer descriptor to expire at the time of the next etimer,
+   and return whether an etimer has already expired. */
+static bool
+update_timer(void)
+{
+  struct itimerspec its;
+  struct timespec now;
+  clock_time_t deadline, remaining;
+
+  if(!etimer_pending()) {
+    return false;
+  }
+
+  deadline = etimer_next_expiration_time();
+  remaining = deadline - clock_time();
+  if(remaining == 0 || remaining > ((clock_time_t)-1) / 2) {
+    return true;
+  }
+
+  if(timer_armed && deadline == timer_deadline) {
+    return false;
+  }
+
+  /* clock_time() counts whole ticks of the monotonic clock, so the
+     etimer expires at the start of the tick of its deadline. */
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  now.tv_nsec -= now.tv_nsec % (1000000000 / CLOCK_SECOND);
+  memset(&its, 0, sizeof(its));
+  its.it_value.tv_sec = now.tv_sec + remaining / CLOCK_SECOND;
+  its.it_value.tv_nsec = now.tv_nsec +
+    (remaining % CLOCK_SECOND) * (1000000000 / CLOCK_SECOND);
+  if(its.it_value.tv_nsec >= 1000000000) {
+    its.it_value.tv_sec++;
+    its.it_value.tv_nsec -= 1000000000;
+  }
+  if(timerfd_settime(timer_fd, TFD_TIMER_ABSTIME, &its, NULL) < 0) {
+    perror("timerfd_settime");
+    return true;
+  }
+  timer_deadline = deadline;
+  timer_armed = true;
+  return false;
+}
+/*---------------------------------------------------------------------------*/
+static void
+epoll_init(void)
+{
+  struct epoll_event ev;
+
+  epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  if(epoll_fd < 0 || timer_fd < 0) {
+    perror("epoll");
+    exit(EXIT_FAILURE);
+  }
+
+  memset(&ev, 0, sizeof(ev));
+  ev.events = EPOLLIN;
+  ev.data.fd = timer_fd;
+  epoll_ctl(epoll_fd, EPOLL_CTL_ADD, timer_fd, &ev);
+}
+/*---------------------------------------------------------------------------*/
+void
+platform_main_loop()
+{
+  struct epoll_event events[SELECT_MAX < 16 ? SELECT_MAX + 1 : 16];
+  fd_set fdr;
+  fd_set fdw;
+  uint64_t expirations;
+  int i;
+  int n;
+  int fd;
+  int timeout;
+  bool unpollable;
+
+#if SELECT_STDIN
+  select_set_callback(STDIN_FILENO, &stdin_fd);
+#endif /* SELECT_STDIN */
+
+  epoll_init();
+
+  while(1) {
+    timeout = process_run() ? 0 : SELECT_TIMEOUT;
+
+    /* Ask the callbacks which events they wait for */
+    FD_ZERO(&fdr);
+    FD_ZERO(&fdw);
+    unpollable = false;
+    for(i = 0; i <= select_max; i++) {
+      if(select_callback[i] != NULL && select_callback[i]->set_fd(&fdr, &fdw)) {
+        epoll_update(i, (FD_ISSET(i, &fdr) ? EPOLLIN : 0) |
+                     (FD_ISSET(i, &fdw) ? EPOLLOUT : 0));
+        unpollable |= fd_unpollable[i];
+      } else if(select_callback[i] != NULL) {
+        epoll_update(i, 0);
+      }
+    }
+
+    if(update_timer()) {
+      etimer_request_poll();
+      timeout = 0;
+    } else if(etimer_pending() && timeout != 0) {
+      /* The timer descriptor wakes us up */
+      timeout = -1;
+    }
+    if(unpollable) {
+      timeout = 0;
+    }
+
+    n = epoll_wait(epoll_fd, events, sizeof(events) / sizeof(events[0]),
+                   timeout);
+    if(n < 0) {
+      if(errno != EINTR) {
+        perror("epoll_wait");
+      }
+      continue;
+    }
+
+    for(i = 0; i < n; i++) {
+      fd = events[i].data.fd;
+      if(fd == timer_fd) {
+        if(read(timer_fd, &expirations, sizeof(expirations)) > 0) {
+          timer_armed = false;
+          etimer_request_poll();
+        }
+        continue;
+      }
+      if(select_callback[fd] == NULL) {
+        continue;
+      }
+      /* Hand the ready descriptor to its callback as select() would */
+      FD_ZERO(&fdr);
+      FD_ZERO(&fdw);
+      if(events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) {
+        if(fd_events[fd] & EPOLLIN) {
+          FD_SET(fd, &fdr);
+        }
+      }
+      if(events[i].events & (EPOLLOUT | EPOLLERR | EPOLLHUP)) {
+        if(fd_events[fd] & EPOLLOUT) {
+          FD_SET(fd, &fdw);
+        }
+      }
+      select_callback[fd]->handle_fd(&fdr, &fdw);
+    }
+
+    /* Descriptors that epoll cannot monitor are always ready */
+    if(unpollable) {
+      for(fd = 0; fd <= select_max; fd++) {
+        if(select_callback[fd] != NULL && fd_unpollable[fd]) {
+          FD_ZERO(&fdr);
+          FD_ZERO(&fdw);
+          if(select_callback[fd]->set_fd(&fdr, &fdw)) {
+            select_callback[fd]->handle_fd(&fdr, &fdw);
+          }
+        }
+      }
+    }
+  }
+}
+#elif NATIVE_VIRTUAL_TIME
+/* Ticks until the next etimer expires, or zero if it has expired */
+static clock_time_t
+etimer_remaining(void)
+{
+  clock_time_t remaining = etimer_next_expiration_time() - clock_time();
+
+  return remaining > ((clock_time_t)-1) / 2 ? 0 : remaining;
+}
+/*---------------------------------------------------------------------------*/
+/* Move the virtual time to the next etimer or rtimer deadline, and
+   return whether there is one. */
+static bool
+advance_time(void)
+{
+  const uint64_t tick = 1000000000 / CLOCK_SECOND;
+  uint64_t next;
+  uint64_t now;
+
+  next = rtimer_arch_next();
+  if(etimer_pending()) {
+    /* The etimer expires at the start of the tick of its deadline */
+    now = virtual_time_now();
+    now += etimer_remaining() * tick - now % tick;
+    if(now < next) {
+      next = now;
+    }
+  }
+  if(next == VIRTUAL_TIME_NEVER) {
+    return false;
+  }
+
+  virtual_time_advance(next);
+  rtimer_arch_check();
+  if(etimer_pending() && etimer_remaining() == 0) {
+    etimer_request_poll();
+  }
+  return true;
+}
+/*---------------------------------------------------------------------------*/
+void
+platform_main_loop()
+{
+#if SELECT_STDIN
+  select_set_callback(STDIN_FILENO, &stdin_fd);
+#endif /* SELECT_STDIN */
+  while(1) {
+    fd_set fdr;
+    fd_set fdw;
+    int maxfd;
+    int i;
+    int retval;
+    struct timeval tv;
+
+    while(process_run() > 0);
+
+    FD_ZERO(&fdr);
+    FD_ZERO(&fdw);
+    maxfd = 0;
+    for(i = 0; i <= select_max; i++) {
+      if(select_callback[i] != NULL && select_callback[i]->set_fd(&fdr, &fdw)) {
+        maxfd = i;
+      }
+    }
+
+    /* Input from descriptors is handled before time moves on */
+    memset(&tv, 0, sizeof(tv));
+    retval = select(maxfd + 1, &fdr, &fdw, NULL, &tv);
+    if(retval < 0) {
+      if(errno != EINTR) {
+        perror("select");
+      }
+      continue;
+    }
+    for(i = 0; retval > 0 && i <= maxfd; i++) {
+      if(select_callback[i] != NULL) {
+        select_callback[i]->handle_fd(&fdr, &fdw);
+      }
+    }
+    if(process_nevents() > 0 || advance_time()) {
+      continue;
+    }
+
+    /* Nothing happens until input arrives */
+    FD_ZERO(&fdr);
+    FD_ZERO(&fdw);
+    maxfd = 0;
+    for(i = 0; i <= select_max; i++) {
+      if(select_callback[i] != NULL && select_callback[i]->set_fd(&fdr, &fdw)) {
+        maxfd = i;
+      }
+    }
+    if(select(maxfd + 1, &fdr, &fdw, NULL, NULL) > 0) {
+      for(i = 0; i <= maxfd; i++) {
+        if(select_callback[i] != NULL) {
+          select_callback[i]->handle_fd(&fdr, &fdw);
+        }
+      }
+    }
+  }
+}
+#else /* SELECT_EPOLL */
 void
 platform_main_loop()
 {
@@ -333,6 +721,7 @@ platform_main_loop()
 
   return;
 }
+#endif /* SELECT_EPOLL */
 /*---------------------------------------------------------------------------*/
 void
 log_message(char *m1, char *m2)
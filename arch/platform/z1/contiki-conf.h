@@ -71,6 +71,11 @@
 #define AES_128_CONF cc2420_aes_128_driver
 #endif /* AES_128_CONF */
 
+/* The H/W AES only needs the key, not its expanded round keys */
+#ifndef AES_128_CONF_CONTEXT_ROUND_KEYS
+#define AES_128_CONF_CONTEXT_ROUND_KEYS 1
+#endif /* AES_128_CONF_CONTEXT_ROUND_KEYS */
+
 /*---------------------------------------------------------------------------*/
 #include "msp430-conf.h"
 /*---------------------------------------------------------------------------*/
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *         Benchmark: every node sends large UDP datagrams, which are
+ *         fragmented by 6LoWPAN, to the root at the end of a multi-hop
+ *         line. The root logs the end-to-end latency of each datagram,
+ *         and every node logs how many fragment buffers it used.
+ */
+
+#include "contiki.h"
+#include "contiki-net.h"
+#include "net/ipv6/sicslowpan.h"
+#include "sys/node-id.h"
+#include "lib/random.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+/* Log configuration */
+#include "sys/log.h"
+#define LOG_MODULE "App"
+#define LOG_LEVEL LOG_LEVEL_INFO
+
+#define ROOT_ID       1
+#define UDP_PORT      8214
+#define SEND_INTERVAL (10 * CLOCK_SECOND)
+#define DATAGRAM_LEN  400
+
+struct datagram {
+  uint32_t seqno;
+  uint32_t sent;
+  uint8_t data[DATAGRAM_LEN - 2 * sizeof(uint32_t)];
+};
+
+static struct simple_udp_connection udp_conn;
+static struct datagram datagram;
+
+/*---------------------------------------------------------------------------*/
+PROCESS(app_process, "App process");
+AUTOSTART_PROCESSES(&app_process);
+
+/*---------------------------------------------------------------------------*/
+static void
+udp_rx_callback(struct simple_udp_connection *c,
+         const uip_ipaddr_t *sender_addr,
+         uint16_t sender_port,
+         const uip_ipaddr_t *receiver_addr,
+         uint16_t receiver_port,
+         const uint8_t *data,
+         uint16_t datalen)
+{
+  struct datagram d;
+
+  if(datalen != sizeof(d)) {
+    LOG_WARN("Received %u bytes instead of %u\n",
+             datalen, (unsigned)sizeof(d));
+    return;
+  }
+  memcpy(&d, data, sizeof(d));
+  LOG_INFO("Received %"PRIu32" from %u latency %"PRIu32" ms\n",
+           d.seqno, sender_addr->u8[15],
+           (uint32_t)clock_time() - d.sent);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(app_process, ev, data)
+{
+  static struct etimer timer;
+  static uip_ipaddr_t dest_ipaddr;
+
+  PROCESS_BEGIN();
+
+  simple_udp_register(&udp_conn, UDP_PORT, NULL,
+                      UDP_PORT, udp_rx_callback);
+
+  if(node_id == ROOT_ID) {
+    NETSTACK_ROUTING.root_start();
+  }
+
+  memset(datagram.data, node_id, sizeof(datagram.data));
+  etimer_set(&timer, SEND_INTERVAL + random_rand() % SEND_INTERVAL);
+  while(1) {
+    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&timer));
+    etimer_set(&timer, SEND_INTERVAL / 2 + random_rand() % SEND_INTERVAL);
+
+    if(node_id != ROOT_ID && NETSTACK_ROUTING.node_is_reachable() &&
+       NETSTACK_ROUTING.get_root_ipaddr(&dest_ipaddr)) {
+      datagram.sent = clock_time();
+      simple_udp_sendto(&udp_conn, &datagram, sizeof(datagram), &dest_ipaddr);
+      datagram.seqno++;
+    }
+
+    LOG_INFO("Fragments: reassembled %"PRIu32" forwarded %"PRIu32
+             " max buffers %"PRIu32"\n",
+             sicslowpan_reass_stats.reassembled,
+             sicslowpan_reass_stats.forwarded,
+             sicslowpan_reass_stats.max_buffers);
+  }
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
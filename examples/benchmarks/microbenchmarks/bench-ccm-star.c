@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *         Measures the number of frames per second secured and
+ *         unsecured with CCM*, when the key is set before each frame as
+ *         the MAC layers used to do, and when it is selected from
+ *         prepared contexts.
+ */
+
+#include "contiki.h"
+#include "lib/ccm-star.h"
+#include "lib/random.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Frames per measurement */
+#define FRAMES 100000
+
+/* The K1 and K2 of TSCH: one key for EBs, another for the other frames */
+#define KEYS 2
+
+/* Frames of a burst unsecured at once */
+#define BURST 8
+
+PROCESS(bench_process, "CCM* benchmark");
+AUTOSTART_PROCESSES(&bench_process);
+
+RANDOM_STREAM(bench_random, RANDOM_STREAM_APP);
+
+static uint8_t keys[KEYS][AES_128_KEY_LENGTH];
+static struct aes_128_context contexts[KEYS];
+static uint8_t nonce[CCM_STAR_NONCE_LENGTH];
+static uint8_t frames[BURST][127];
+static uint8_t mics[BURST][16];
+static struct ccm_star_frame burst[BURST];
+/*---------------------------------------------------------------------------*/
+static double
+cpu_usec(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+/*---------------------------------------------------------------------------*/
+static void
+report(const char *what, unsigned a_len, unsigned m_len, double start)
+{
+  double elapsed = cpu_usec() - start;
+
+  printf("%-26s a=%-3u m=%-3u n=%-7u %9.0f us %7.1f ns/frame %9.0f frames/s\n",
+         what, a_len, m_len, FRAMES, elapsed, elapsed * 1e3 / FRAMES,
+         FRAMES / elapsed * 1e6);
+}
+/*---------------------------------------------------------------------------*/
+static void
+run(unsigned a_len, unsigned m_len, unsigned mic_len)
+{
+  unsigned i;
+  unsigned forward;
+  double start;
+
+  for(forward = 0; forward <= 1; forward++) {
+    /* Every other frame uses the other key, as EBs and data frames do */
+    start = cpu_usec();
+    for(i = 0; i < FRAMES; i++) {
+      CCM_STAR.set_key(keys[i % KEYS]);
+      CCM_STAR.aead(nonce, frames[0] + a_len, m_len, frames[0], a_len,
+                    mics[0], mic_len, forward);
+    }
+    report(forward ? "secure, set_key" : "unsecure, set_key",
+           a_len, m_len, start);
+
+    start = cpu_usec();
+    for(i = 0; i < FRAMES; i++) {
+      CCM_STAR.set_context(&contexts[i % KEYS]);
+      CCM_STAR.aead(nonce, frames[0] + a_len, m_len, frames[0], a_len,
+                    mics[0], mic_len, forward);
+    }
+    report(forward ? "secure, set_context" : "unsecure, set_context",
+           a_len, m_len, start);
+  }
+
+  /* A burst of frames received with the same key, as on a border router */
+  for(i = 0; i < BURST; i++) {
+    burst[i].nonce = nonce;
+    burst[i].a = frames[i];
+    burst[i].a_len = a_len;
+    burst[i].m = frames[i] + a_len;
+    burst[i].m_len = m_len;
+    burst[i].result = mics[i];
+    burst[i].mic_len = mic_len;
+  }
+  CCM_STAR.set_context(&contexts[1]);
+  start = cpu_usec();
+  for(i = 0; i < FRAMES; i += BURST) {
+    CCM_STAR.aead_frames(burst, BURST, 0);
+  }
+  report("unsecure, aead_frames", a_len, m_len, start);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(bench_process, ev, data)
+{
+  unsigned i;
+  unsigned k;
+  double start;
+
+  PROCESS_BEGIN();
+
+  printf("CCM* benchmark, %u keys, bursts of %u frames, %u at once\n",
+         KEYS, BURST, CCM_STAR_BATCH_FRAMES);
+
+  for(k = 0; k < KEYS; k++) {
+    for(i = 0; i < AES_128_KEY_LENGTH; i++) {
+      keys[k][i] = random_stream_rand(&bench_random);
+    }
+    CCM_STAR.init_context(&contexts[k], keys[k]);
+  }
+  for(i = 0; i < sizeof(nonce); i++) {
+    nonce[i] = random_stream_rand(&bench_random);
+  }
+  for(k = 0; k < BURST; k++) {
+    for(i = 0; i < sizeof(frames[k]); i++) {
+      frames[k][i] = random_stream_rand(&bench_random);
+    }
+  }
+
+  /* The cost of selecting the key alone */
+  start = cpu_usec();
+  for(i = 0; i < FRAMES; i++) {
+    CCM_STAR.set_key(keys[i % KEYS]);
+  }
+  report("set_key only", 0, 0, start);
+
+  start = cpu_usec();
+  for(i = 0; i < FRAMES; i++) {
+    CCM_STAR.set_context(&contexts[i % KEYS]);
+  }
+  report("set_context only", 0, 0, start);
+
+  /* An Enhanced ACK with a MIC-32 */
+  run(19, 0, 4);
+  /* A full data frame with ENC-MIC-64 */
+  run(23, 127 - 23 - 2 - 8, 8);
+
+  exit(0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
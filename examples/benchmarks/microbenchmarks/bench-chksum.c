@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *         Measures the throughput of the Internet checksum over buffers
+ *         of typical packet sizes, and of the UDP checksum of a packet
+ *         in uip_buf.
+ */
+
+#include "contiki.h"
+#include "net/ipv6/uip.h"
+#include "net/ipv6/uipbuf.h"
+#include "lib/random.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Bytes summed per measurement */
+#define TOTAL_BYTES (64 * 1024 * 1024)
+
+PROCESS(bench_process, "Checksum benchmark");
+AUTOSTART_PROCESSES(&bench_process);
+
+RANDOM_STREAM(bench_random, RANDOM_STREAM_APP);
+
+static uint8_t buf[UIP_BUFSIZE + 1];
+/*---------------------------------------------------------------------------*/
+static double
+cpu_usec(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+/*---------------------------------------------------------------------------*/
+static void
+report(const char *what, unsigned len, unsigned n, double start)
+{
+  double elapsed = cpu_usec() - start;
+
+  printf("%-24s len=%-5u n=%-8u %10.0f us %8.1f ns/op %8.0f MB/s\n",
+         what, len, n, elapsed, elapsed * 1e3 / n,
+         (double)len * n / elapsed);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(bench_process, ev, data)
+{
+  static const unsigned sizes[] = { 8, 40, 64, 127, 256, 512, 1024, 1280 };
+  volatile uint16_t sink = 0;
+  unsigned s;
+  unsigned len;
+  unsigned n;
+  unsigned i;
+  double start;
+
+  PROCESS_BEGIN();
+
+  printf("Checksum benchmark, %s-bit words\n", UIP_CHKSUM_WIDE ? "32" : "16");
+
+  for(i = 0; i < sizeof(buf); i++) {
+    buf[i] = random_stream_rand(&bench_random);
+  }
+  for(i = 0; i < UIP_BUFSIZE; i++) {
+    uip_buf[i] = random_stream_rand(&bench_random);
+  }
+
+  for(s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    len = sizes[s];
+    n = TOTAL_BYTES / len;
+
+    start = cpu_usec();
+    for(i = 0; i < n; i++) {
+      sink += uip_chksum((uint16_t *)buf, len);
+    }
+    report("uip_chksum", len, n, start);
+
+    /* Headers start at odd offsets in some frame buffers */
+    start = cpu_usec();
+    for(i = 0; i < n; i++) {
+      sink += uip_chksum((uint16_t *)(buf + 1), len);
+    }
+    report("uip_chksum (unaligned)", len, n, start);
+
+    if(len >= UIP_UDPH_LEN && UIP_IPH_LEN + len <= UIP_BUFSIZE) {
+      uip_ext_len = 0;
+      uipbuf_set_len_field(UIP_IP_BUF, len);
+      start = cpu_usec();
+      for(i = 0; i < n; i++) {
+        sink += uip_udpchksum();
+      }
+      report("uip_udpchksum", len, n, start);
+    }
+  }
+
+  exit(0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
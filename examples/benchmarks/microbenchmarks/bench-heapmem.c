@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/**
+ * \file
+ *         Replays allocation traces modelled on the MQTT client and
+ *         the LwM2M engine, and measures the latency of heapmem
+ *         operations and the fragmentation of the heap.
+ */
+
+#include "contiki.h"
+#include "lib/heapmem.h"
+#include "lib/random.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define STEPS         200000
+/* Latencies are collected in a histogram of this resolution */
+#define BUCKET_NS     10
+#define NUM_BUCKETS   1000
+
+PROCESS(bench_process, "Heapmem benchmark");
+AUTOSTART_PROCESSES(&bench_process);
+
+static unsigned histogram[NUM_BUCKETS];
+static unsigned ops;
+static unsigned failures;
+static double total_ns;
+/* The cost of reading the clock, which is subtracted from latencies */
+static double clock_ns;
+static double fragmentation;
+static unsigned samples;
+
+/* Objects of the traces */
+#define MAX_INFLIGHT  8
+#define MAX_SUBS      16
+#define MAX_OBJECTS   24
+static void *topics[MAX_INFLIGHT];
+static void *payloads[MAX_INFLIGHT];
+static void *subs[MAX_SUBS];
+static void *objects[MAX_OBJECTS];
+static void *location;
+/*---------------------------------------------------------------------------*/
+static double
+now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+/*---------------------------------------------------------------------------*/
+static void
+record(double start)
+{
+  double elapsed = now_ns() - start - clock_ns;
+  unsigned bucket;
+
+  if(elapsed < 0) {
+    elapsed = 0;
+  }
+  bucket = elapsed / BUCKET_NS;
+  histogram[bucket < NUM_BUCKETS ? bucket : NUM_BUCKETS - 1]++;
+  total_ns += elapsed;
+  ops++;
+}
+/*---------------------------------------------------------------------------*/
+static void
+calibrate(void)
+{
+  double start, elapsed;
+  unsigned i;
+
+  clock_ns = 1e9;
+  for(i = 0; i < 10000; i++) {
+    start = now_ns();
+    elapsed = now_ns() - start;
+    if(elapsed < clock_ns) {
+      clock_ns = elapsed;
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void *
+timed_alloc(size_t size)
+{
+  double start = now_ns();
+  void *ptr = heapmem_alloc(size);
+
+  record(start);
+  if(ptr == NULL) {
+    failures++;
+  }
+  return ptr;
+}
+/*---------------------------------------------------------------------------*/
+static void *
+timed_realloc(void *ptr, size_t size)
+{
+  double start = now_ns();
+  void *new_ptr = heapmem_realloc(ptr, size);
+
+  record(start);
+  if(new_ptr == NULL) {
+    failures++;
+    return ptr;
+  }
+  return new_ptr;
+}
+/*---------------------------------------------------------------------------*/
+static void
+timed_free(void **ptr)
+{
+  double start = now_ns();
+
+  heapmem_free(*ptr);
+  record(start);
+  *ptr = NULL;
+}
+/*---------------------------------------------------------------------------*/
+static size_t
+skewed_size(size_t min, size_t max)
+{
+  /* Mostly small sizes, occasionally up to the maximum */
+  size_t range = max - min + 1;
+
+  return min + (random_rand() % range) * (random_rand() % range) / range;
+}
+/*---------------------------------------------------------------------------*/
+/* A client that publishes messages with QoS 1 and keeps them until
+   they are acknowledged, receives messages into a buffer that grows
+   to the payload size, and sometimes changes its subscriptions. */
+static void
+mqtt_step(unsigned step)
+{
+  static unsigned next;
+  unsigned i;
+  void *rx;
+
+  i = next++ % MAX_INFLIGHT;
+  if(topics[i] != NULL) {
+    /* The oldest message has been acknowledged */
+    timed_free(&topics[i]);
+    timed_free(&payloads[i]);
+  }
+  topics[i] = timed_alloc(16 + random_rand() % 48);
+  payloads[i] = timed_alloc(skewed_size(32, 512));
+
+  rx = timed_alloc(64);
+  if(rx != NULL) {
+    rx = timed_realloc(rx, skewed_size(64, 384));
+    timed_free(&rx);
+  }
+
+  if(step % 64 == 0) {
+    i = random_rand() % MAX_SUBS;
+    if(subs[i] != NULL) {
+      timed_free(&subs[i]);
+    }
+    subs[i] = timed_alloc(24 + random_rand() % 40);
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* An LwM2M client that replaces object instances, encodes responses
+   into a buffer that grows in steps, and updates its registration. */
+static void
+lwm2m_step(unsigned step)
+{
+  unsigned i, len, target;
+  void *response;
+
+  i = random_rand() % MAX_OBJECTS;
+  if(objects[i] == NULL || random_rand() % 8 == 0) {
+    if(objects[i] != NULL) {
+      timed_free(&objects[i]);
+    }
+    objects[i] = timed_alloc(48 + random_rand() % 112);
+  }
+
+  target = 128 + random_rand() % 640;
+  response = timed_alloc(64);
+  for(len = 128; response != NULL && len <= target; len += 64) {
+    response = timed_realloc(response, len);
+  }
+  if(response != NULL) {
+    timed_free(&response);
+  }
+
+  if(step % 128 == 0) {
+    if(location != NULL) {
+      timed_free(&location);
+    }
+    location = timed_alloc(16 + random_rand() % 24);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+free_all(void)
+{
+  unsigned i;
+
+  for(i = 0; i < MAX_INFLIGHT; i++) {
+    heapmem_free(topics[i]);
+    heapmem_free(payloads[i]);
+    topics[i] = payloads[i] = NULL;
+  }
+  for(i = 0; i < MAX_SUBS; i++) {
+    heapmem_free(subs[i]);
+    subs[i] = NULL;
+  }
+  for(i = 0; i < MAX_OBJECTS; i++) {
+    heapmem_free(objects[i]);
+    objects[i] = NULL;
+  }
+  heapmem_free(location);
+  location = NULL;
+}
+/*---------------------------------------------------------------------------*/
+static void
+sample_fragmentation(void)
+{
+  heapmem_stats_t stats;
+
+  heapmem_stats(&stats);
+  if(stats.available > 0) {
+    fragmentation += 1.0 - (double)stats.max_available / stats.available;
+    samples++;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static double
+percentile(double fraction)
+{
+  unsigned i, count;
+
+  count = 0;
+  for(i = 0; i < NUM_BUCKETS; i++) {
+    count += histogram[i];
+    if(count >= fraction * ops) {
+      break;
+    }
+  }
+  return (i + 1) * BUCKET_NS;
+}
+/*---------------------------------------------------------------------------*/
+static void
+replay(const char *name, void (*step)(unsigned))
+{
+  unsigned i;
+
+  memset(histogram, 0, sizeof(histogram));
+  ops = failures = samples = 0;
+  total_ns = fragmentation = 0;
+
+  random_init(1);
+  for(i = 0; i < STEPS; i++) {
+    step(i);
+    if(i % 256 == 0) {
+      sample_fragmentation();
+    }
+  }
+  free_all();
+
+  printf("%-6s ops=%-8u %6.1f ns/op  p99 %4.0f ns  p99.99 %4.0f ns  "
+         "failures %-5u fragmentation %4.1f%%\n",
+         name, ops, total_ns / ops, percentile(0.99), percentile(0.9999),
+         failures, 100 * fragmentation / samples);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(bench_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Heapmem benchmark, %u byte arena, size classes %s\n",
+         HEAPMEM_CONF_ARENA_SIZE,
+         HEAPMEM_CONF_SIZE_CLASSES ? "enabled" : "disabled");
+
+  calibrate();
+  replay("MQTT", mqtt_step);
+  replay("LwM2M", lwm2m_step);
+
+  exit(0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *         Measures the cost of sending small UDP packets through
+ *         6LoWPAN, which is dominated by IPHC header compression, for
+ *         periodic flows to one or a few destinations.
+ */
+
+#include "contiki.h"
+#include "net/ipv6/uip.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/ipv6/uipbuf.h"
+#include "net/ipv6/sicslowpan.h"
+#include "net/packetbuf.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define ROUNDS    2000000
+#define DATA_LEN  32
+#define MAX_FLOWS 8
+
+PROCESS(bench_process, "IPHC benchmark");
+AUTOSTART_PROCESSES(&bench_process);
+
+static uint8_t packets[MAX_FLOWS][UIP_IPUDPH_LEN + DATA_LEN];
+static linkaddr_t link_dests[MAX_FLOWS];
+/*---------------------------------------------------------------------------*/
+static double
+cpu_usec(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+/*---------------------------------------------------------------------------*/
+/* A UDP packet from <prefix>::<our IID> to <prefix>::<IID of flow>,
+   which is also the link-layer destination */
+static void
+make_packet(unsigned flow, uint16_t prefix)
+{
+  struct uip_ip_hdr *ip = (struct uip_ip_hdr *)packets[flow];
+  struct uip_udp_hdr *udp = (struct uip_udp_hdr *)(packets[flow] + UIP_IPH_LEN);
+  uip_lladdr_t lladdr;
+
+  memset(&link_dests[flow], 0, sizeof(link_dests[flow]));
+  link_dests[flow].u8[0] = 0x02;
+  link_dests[flow].u8[LINKADDR_SIZE - 1] = flow + 1;
+  memcpy(&lladdr, &link_dests[flow], sizeof(lladdr));
+
+  memset(packets[flow], 0, sizeof(packets[flow]));
+  ip->vtc = 0x60;
+  uipbuf_set_len_field(ip, UIP_UDPH_LEN + DATA_LEN);
+  ip->proto = UIP_PROTO_UDP;
+  ip->ttl = 64;
+  uip_ip6addr(&ip->srcipaddr, prefix, 0, 0, 0, 0, 0, 0, 0);
+  uip_ds6_set_addr_iid(&ip->srcipaddr, &uip_lladdr);
+  uip_ip6addr(&ip->destipaddr, prefix, 0, 0, 0, 0, 0, 0, 0);
+  uip_ds6_set_addr_iid(&ip->destipaddr, &lladdr);
+  udp->srcport = UIP_HTONS(8765);
+  udp->destport = UIP_HTONS(5678);
+  udp->udplen = UIP_HTONS(UIP_UDPH_LEN + DATA_LEN);
+  udp->udpchksum = UIP_HTONS(0x1234);
+}
+/*---------------------------------------------------------------------------*/
+static void
+run(const char *what, uint16_t prefix, unsigned flows)
+{
+  unsigned i;
+  unsigned f;
+  double start;
+  double elapsed;
+
+  for(f = 0; f < flows; f++) {
+    make_packet(f, prefix);
+  }
+
+  start = cpu_usec();
+  for(i = 0; i < ROUNDS; i++) {
+    f = i % flows;
+    memcpy(uip_buf, packets[f], sizeof(packets[f]));
+    uip_len = sizeof(packets[f]);
+    sicslowpan_driver.output(&link_dests[f]);
+  }
+  elapsed = cpu_usec() - start;
+
+  printf("%-16s flows=%-2u %8.1f ns/packet frame=%u bytes\n",
+         what, flows, elapsed * 1e3 / ROUNDS, packetbuf_datalen());
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(bench_process, ev, data)
+{
+  static const unsigned flows[] = { 1, 2, 8 };
+  unsigned s;
+
+  PROCESS_BEGIN();
+
+  printf("IPHC benchmark\n");
+
+  /* The network layer of the platform is not 6LoWPAN */
+  sicslowpan_driver.init();
+
+  for(s = 0; s < sizeof(flows) / sizeof(flows[0]); s++) {
+    /* The prefix of address context 0 */
+    run("with context", UIP_DS6_DEFAULT_PREFIX, flows[s]);
+    run("link-local", 0xfe80, flows[s]);
+    run("inline prefix", 0x2001, flows[s]);
+  }
+
+  exit(0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
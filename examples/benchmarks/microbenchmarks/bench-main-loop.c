@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/**
+ * \file
+ *         Measures the CPU time that the native main loop uses while the
+ *         system is idle, and how late it delivers expired etimers.
+ */
+
+#include "contiki.h"
+#include "lib/random.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/resource.h>
+
+/* Wall time of each idle measurement */
+#define IDLE_TIME  (3 * CLOCK_SECOND)
+#define SAMPLES    200
+/* Random etimer intervals are spread over this many clock ticks */
+#define SPREAD     (CLOCK_SECOND / 20)
+
+/* The main loop of the native platform, see platform.c */
+#ifdef SELECT_CONF_EPOLL
+#define MAIN_LOOP (SELECT_CONF_EPOLL ? "epoll" : "select")
+#elif defined(__linux__)
+#define MAIN_LOOP "epoll"
+#else
+#define MAIN_LOOP "select"
+#endif
+
+PROCESS(bench_process, "Main loop benchmark");
+AUTOSTART_PROCESSES(&bench_process);
+
+static struct etimer et;
+static unsigned long latency[SAMPLES];
+static struct rusage usage_start;
+/*---------------------------------------------------------------------------*/
+static double
+tv_usec(const struct timeval *tv)
+{
+  return tv->tv_sec * 1e6 + tv->tv_usec;
+}
+/*---------------------------------------------------------------------------*/
+static void
+usage_begin(void)
+{
+  getrusage(RUSAGE_SELF, &usage_start);
+}
+/*---------------------------------------------------------------------------*/
+static void
+usage_report(const char *what, clock_time_t wall)
+{
+  struct rusage usage;
+  double cpu;
+
+  getrusage(RUSAGE_SELF, &usage);
+  cpu = tv_usec(&usage.ru_utime) + tv_usec(&usage.ru_stime) -
+    tv_usec(&usage_start.ru_utime) - tv_usec(&usage_start.ru_stime);
+
+  printf("%-24s %10.0f us CPU per s %6.2f%% %8ld wakeups\n",
+         what, cpu * CLOCK_SECOND / wall, cpu * CLOCK_SECOND / wall / 1e4,
+         usage.ru_nvcsw - usage_start.ru_nvcsw);
+}
+/*---------------------------------------------------------------------------*/
+/* Time in microseconds between the expiration time of the etimer and
+   now. The native clock counts whole milliseconds of CLOCK_MONOTONIC. */
+static unsigned long
+lateness(struct etimer *t)
+{
+  struct timespec now;
+  clock_time_t ticks;
+
+  ticks = clock_time() - etimer_expiration_time(t);
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return ticks * (1000000UL / CLOCK_SECOND) +
+    (now.tv_nsec % (1000000000L / CLOCK_SECOND)) / 1000;
+}
+/*---------------------------------------------------------------------------*/
+static int
+compare(const void *a, const void *b)
+{
+  unsigned long x = *(const unsigned long *)a;
+  unsigned long y = *(const unsigned long *)b;
+
+  return x < y ? -1 : x > y;
+}
+/*---------------------------------------------------------------------------*/
+static void
+latency_report(const char *what)
+{
+  qsort(latency, SAMPLES, sizeof(latency[0]), compare);
+  printf("%-24s n=%-4u p50 %7lu us p90 %7lu us p99 %7lu us max %7lu us\n",
+         what, SAMPLES, latency[SAMPLES / 2], latency[SAMPLES * 9 / 10],
+         latency[SAMPLES * 99 / 100], latency[SAMPLES - 1]);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(bench_process, ev, data)
+{
+  static unsigned i;
+
+  PROCESS_BEGIN();
+
+  printf("Main loop benchmark, %s\n", MAIN_LOOP);
+
+  /* Nothing to do but wait for a single timer */
+  usage_begin();
+  etimer_set(&et, IDLE_TIME);
+  PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+  usage_report("idle", IDLE_TIME);
+
+  /* A periodic timer, as used by most protocols */
+  usage_begin();
+  etimer_set(&et, CLOCK_SECOND / 100);
+  for(i = 0; i < SAMPLES; i++) {
+    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+    latency[i] = lateness(&et);
+    etimer_reset(&et);
+  }
+  usage_report("periodic 10 ms", SAMPLES * CLOCK_SECOND / 100);
+  latency_report("periodic 10 ms latency");
+
+  /* Timers with random intervals, set at random points within a tick */
+  for(i = 0; i < SAMPLES; i++) {
+    etimer_set(&et, 1 + random_rand() % SPREAD);
+    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+    latency[i] = lateness(&et);
+  }
+  latency_report("random latency");
+
+  exit(0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *         Measures the cost of adding neighbors and of finding them by
+ *         link-layer address as the neighbor table grows from 10 to
+ *         1000 entries.
+ */
+
+#include "contiki.h"
+#include "net/nbr-table.h"
+#include "lib/random.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LOOKUPS 100000
+
+PROCESS(bench_process, "Neighbor table benchmark");
+AUTOSTART_PROCESSES(&bench_process);
+
+RANDOM_STREAM(bench_random, RANDOM_STREAM_APP);
+
+struct bench_nbr {
+  uint16_t id;
+};
+NBR_TABLE(struct bench_nbr, bench_table);
+
+static linkaddr_t addrs[NBR_TABLE_MAX_NEIGHBORS];
+/*---------------------------------------------------------------------------*/
+static double
+cpu_usec(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+/*---------------------------------------------------------------------------*/
+static void
+report(const char *what, unsigned nbrs, unsigned n, double start)
+{
+  double elapsed = cpu_usec() - start;
+
+  printf("%-24s nbrs=%-6u n=%-6u %10.0f us %8.3f us/op\n",
+         what, nbrs, n, elapsed, elapsed / n);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(bench_process, ev, data)
+{
+  static const unsigned sizes[] = { 10, 100, 300, 1000 };
+  linkaddr_t addr;
+  unsigned s;
+  unsigned n;
+  unsigned i;
+  unsigned found;
+  double start;
+
+  PROCESS_BEGIN();
+
+  printf("Neighbor table benchmark, address index %s\n",
+         NBR_TABLE_HASH_SIZE ? "enabled" : "disabled");
+
+  nbr_table_register(bench_table, NULL);
+  /* IEEE 802.15.4 extended addresses of one vendor */
+  for(i = 0; i < NBR_TABLE_MAX_NEIGHBORS; i++) {
+    memset(&addrs[i], 0, sizeof(addrs[i]));
+    addrs[i].u8[0] = 0x00;
+    addrs[i].u8[1] = 0x12;
+    addrs[i].u8[2] = 0x4b;
+    addrs[i].u8[LINKADDR_SIZE - 2] = i >> 8;
+    addrs[i].u8[LINKADDR_SIZE - 1] = i;
+  }
+
+  for(s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    n = sizes[s];
+    if(n > NBR_TABLE_MAX_NEIGHBORS) {
+      break;
+    }
+
+    start = cpu_usec();
+    for(i = 0; i < n; i++) {
+      nbr_table_add_lladdr(bench_table, &addrs[i],
+                           NBR_TABLE_REASON_UNDEFINED, NULL);
+    }
+    report("nbr_table_add_lladdr", n, n, start);
+
+    found = 0;
+    start = cpu_usec();
+    for(i = 0; i < LOOKUPS; i++) {
+      found += nbr_table_get_from_lladdr(bench_table,
+        &addrs[random_stream_u32(&bench_random) % n]) != NULL;
+    }
+    report("lookup (neighbor)", n, LOOKUPS, start);
+
+    /* Frames from nodes that are not neighbors */
+    linkaddr_copy(&addr, &addrs[0]);
+    addr.u8[LINKADDR_SIZE - 3] = 0xff;
+    start = cpu_usec();
+    for(i = 0; i < LOOKUPS; i++) {
+      addr.u8[LINKADDR_SIZE - 1] = random_stream_u32(&bench_random);
+      found += nbr_table_get_from_lladdr(bench_table, &addr) != NULL;
+    }
+    report("lookup (unknown)", n, LOOKUPS, start);
+
+    if(found != LOOKUPS) {
+      printf("Error: %u lookups of %u neighbors succeeded\n", found,
+             LOOKUPS);
+    }
+
+    start = cpu_usec();
+    nbr_table_clear();
+    report("nbr_table_clear", n, n, start);
+  }
+
+  exit(0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
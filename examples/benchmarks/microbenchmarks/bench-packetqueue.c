@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *         Measures the cost of parking a packet during address
+ *         resolution and sending it afterwards, by detaching its
+ *         buffer from uip_buf, against copying it out and back in.
+ */
+
+#include "contiki.h"
+#include "net/ipv6/uip.h"
+#include "net/ipv6/uip-packetqueue.h"
+#include "sys/ctimer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define ROUNDS 1000000
+
+PROCESS(bench_process, "Packet queue benchmark");
+AUTOSTART_PROCESSES(&bench_process);
+
+static uip_buf_t copy_buf;
+static struct ctimer copy_lifetimer;
+static struct uip_packetqueue_handle handle;
+/*---------------------------------------------------------------------------*/
+static double
+cpu_usec(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+/*---------------------------------------------------------------------------*/
+static void
+report(const char *what, unsigned len, unsigned n, unsigned copied,
+       double start)
+{
+  double elapsed = cpu_usec() - start;
+
+  printf("%-24s len=%-5u n=%-8u %10.0f us %8.1f ns/packet %6u bytes copied\n",
+         what, len, n, elapsed, elapsed * 1e3 / n, copied);
+}
+/*---------------------------------------------------------------------------*/
+static void
+copy_timedout(void *ptr)
+{
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(bench_process, ev, data)
+{
+  static const unsigned sizes[] = { 80, 400, 1280 };
+  unsigned s;
+  unsigned len;
+  unsigned i;
+  unsigned lost;
+  double start;
+
+  PROCESS_BEGIN();
+
+  printf("Packet queue benchmark, %u packet buffers\n", UIPBUF_POOL_SIZE);
+
+  uip_packetqueue_new(&handle);
+  for(s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    len = sizes[s];
+    memset(uip_buf, 0x5a, len);
+
+    /* What the queue did before: copy the packet out with a lifetime,
+       and back in once the address is resolved */
+    start = cpu_usec();
+    for(i = 0; i < ROUNDS; i++) {
+      uip_len = len;
+      ctimer_set(&copy_lifetimer, CLOCK_SECOND, copy_timedout, NULL);
+      memcpy(copy_buf.u8, uip_buf, uip_len);
+      uip_len = 0;
+      ctimer_stop(&copy_lifetimer);
+      uip_len = len;
+      memcpy(uip_buf, copy_buf.u8, uip_len);
+    }
+    report("copy out and in", len, ROUNDS, 2 * len, start);
+
+    lost = 0;
+    start = cpu_usec();
+    for(i = 0; i < ROUNDS; i++) {
+      uip_len = len;
+      if(!uip_packetqueue_enqueue(&handle, CLOCK_SECOND)) {
+        lost++;
+      }
+      uip_len = 0;
+      if(!uip_packetqueue_dequeue(&handle)) {
+        lost++;
+      }
+    }
+    report("uip_packetqueue", len, ROUNDS, 0, start);
+    if(lost > 0) {
+      printf("Error: %u packets lost\n", lost);
+    }
+  }
+
+  exit(0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *         Counts the bytes copied between packetbuf and queuebufs for
+ *         each frame a MAC layer delivers, when every transmission
+ *         attempt restores the frame to packetbuf and creates it again,
+ *         as CSMA did before, and when the frame is created once and
+ *         every attempt is sent from its queuebuf.
+ */
+
+#include "contiki.h"
+#include "net/packetbuf.h"
+#include "net/queuebuf.h"
+#include "net/netstack.h"
+#include "net/mac/framer/frame802154.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define ROUNDS 200000
+
+PROCESS(bench_process, "Queuebuf benchmark");
+AUTOSTART_PROCESSES(&bench_process);
+
+/* Stands for the transmit buffer of the radio driver */
+static uint8_t radio_buf[PACKETBUF_SIZE];
+static uint8_t payload[PACKETBUF_SIZE];
+static const linkaddr_t receiver = { { 1, 2, 3, 4, 5, 6, 7, 8 } };
+/*---------------------------------------------------------------------------*/
+static double
+cpu_usec(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+/*---------------------------------------------------------------------------*/
+static void
+report(const char *what, unsigned len, unsigned attempts, unsigned n,
+       uint32_t copied, double start)
+{
+  double elapsed = cpu_usec() - start;
+
+  printf("%-22s len=%-4u tx=%u %8.1f ns/frame %6lu bytes copied/frame\n",
+         what, len, attempts, elapsed * 1e3 / n,
+         (unsigned long)(copied / n));
+}
+/*---------------------------------------------------------------------------*/
+static void
+radio_prepare(const void *frame, unsigned short len)
+{
+  memcpy(radio_buf, frame, len);
+}
+/*---------------------------------------------------------------------------*/
+static void
+new_packet(unsigned len)
+{
+  packetbuf_clear();
+  packetbuf_copyfrom(payload, len);
+  packetbuf_set_addr(PACKETBUF_ADDR_RECEIVER, &receiver);
+  packetbuf_set_addr(PACKETBUF_ADDR_SENDER, &linkaddr_node_addr);
+  packetbuf_set_attr(PACKETBUF_ATTR_FRAME_TYPE, FRAME802154_DATAFRAME);
+  packetbuf_set_attr(PACKETBUF_ATTR_MAC_SEQNO, 42);
+  packetbuf_set_attr(PACKETBUF_ATTR_MAC_ACK, 1);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(bench_process, ev, data)
+{
+  static const unsigned sizes[] = { 40, 100 };
+  static const unsigned attempts[] = { 1, 4 };
+  unsigned s, a, t;
+  unsigned len;
+  unsigned i;
+  unsigned lost;
+  uint32_t copied;
+  struct queuebuf *qb;
+  double start;
+
+  PROCESS_BEGIN();
+
+  printf("Queuebuf benchmark\n");
+
+  memset(payload, 0x5a, sizeof(payload));
+  for(s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    len = sizes[s];
+    for(a = 0; a < sizeof(attempts) / sizeof(attempts[0]); a++) {
+      lost = 0;
+      copied = queuebuf_bytes_copied;
+      start = cpu_usec();
+      for(i = 0; i < ROUNDS; i++) {
+        new_packet(len);
+        qb = queuebuf_new_from_packetbuf();
+        if(qb == NULL) {
+          lost++;
+          continue;
+        }
+        for(t = 0; t < attempts[a]; t++) {
+          queuebuf_to_packetbuf(qb);
+          if(NETSTACK_FRAMER.create() < 0) {
+            lost++;
+          }
+          radio_prepare(packetbuf_hdrptr(), packetbuf_totlen());
+          if(t + 1 < attempts[a]) {
+            queuebuf_update_attr_from_packetbuf(qb);
+          }
+        }
+        queuebuf_free(qb);
+      }
+      report("copy per attempt", len, attempts[a], ROUNDS,
+             queuebuf_bytes_copied - copied, start);
+
+      copied = queuebuf_bytes_copied;
+      start = cpu_usec();
+      for(i = 0; i < ROUNDS; i++) {
+        new_packet(len);
+        if(NETSTACK_FRAMER.create() < 0) {
+          lost++;
+        }
+        qb = queuebuf_new_from_packetbuf();
+        if(qb == NULL) {
+          lost++;
+          continue;
+        }
+        for(t = 0; t < attempts[a]; t++) {
+          /* The radio driver and the sent callback need the attributes
+             of the frame, which are saved again before a retransmission */
+          queuebuf_attr_to_packetbuf(qb);
+          radio_prepare(queuebuf_dataptr(qb), queuebuf_datalen(qb));
+          if(t + 1 < attempts[a]) {
+            queuebuf_update_attr_from_packetbuf(qb);
+          }
+        }
+        queuebuf_free(qb);
+      }
+      report("send from queuebuf", len, attempts[a], ROUNDS,
+             queuebuf_bytes_copied - copied, start);
+      if(lost > 0) {
+        printf("Error: %u frames lost\n", lost);
+      }
+    }
+  }
+
+  exit(0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *         Measures the cost of drawing random numbers: libc rand(),
+ *         random_rand() and the random streams.
+ */
+
+#include "contiki.h"
+#include "lib/random.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define DRAWS 10000000
+
+PROCESS(bench_process, "Random benchmark");
+AUTOSTART_PROCESSES(&bench_process);
+
+RANDOM_STREAM(bench_random, RANDOM_STREAM_APP);
+
+/* Keeps the compiler from dropping the draws */
+static volatile uint32_t sink;
+/*---------------------------------------------------------------------------*/
+static double
+cpu_usec(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+/*---------------------------------------------------------------------------*/
+static void
+report(const char *what, double start)
+{
+  double elapsed = cpu_usec() - start;
+
+  printf("%-28s n=%-9u %8.0f us %8.2f ns/draw\n",
+         what, DRAWS, elapsed, elapsed * 1000 / DRAWS);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(bench_process, ev, data)
+{
+  double start;
+  uint32_t acc;
+  float facc;
+  unsigned i;
+
+  PROCESS_BEGIN();
+
+  printf("Random benchmark\n");
+
+  acc = 0;
+  start = cpu_usec();
+  for(i = 0; i < DRAWS; i++) {
+    acc += rand();
+  }
+  report("libc rand", start);
+  sink = acc;
+
+  acc = 0;
+  start = cpu_usec();
+  for(i = 0; i < DRAWS; i++) {
+    acc += random_rand();
+  }
+  report("random_rand", start);
+  sink = acc;
+
+  acc = 0;
+  start = cpu_usec();
+  for(i = 0; i < DRAWS; i++) {
+    acc += random_stream_u32(&bench_random);
+  }
+  report("random_stream_u32", start);
+  sink = acc;
+
+  acc = 0;
+  start = cpu_usec();
+  for(i = 0; i < DRAWS; i++) {
+    acc += (uint32_t)random_stream_u64(&bench_random);
+  }
+  report("random_stream_u64", start);
+  sink = acc;
+
+  facc = 0;
+  start = cpu_usec();
+  for(i = 0; i < DRAWS; i++) {
+    facc += random_stream_float(&bench_random);
+  }
+  report("random_stream_float", start);
+  sink = (uint32_t)facc;
+
+  exit(0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *         Measures the cost of adding, looking up and removing routes
+ *         as the routing table grows from 10 to 10000 entries.
+ */
+
+#include "contiki.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/ipv6/uip-ds6-route.h"
+#include "lib/random.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define NUM_NEXTHOPS 8
+#define LOOKUPS      100000
+
+PROCESS(bench_process, "Route benchmark");
+AUTOSTART_PROCESSES(&bench_process);
+
+RANDOM_STREAM(bench_random, RANDOM_STREAM_APP);
+
+static uip_ipaddr_t nexthops[NUM_NEXTHOPS];
+static uip_ipaddr_t hosts[UIP_DS6_ROUTE_NB];
+static uip_ds6_route_t *routes[UIP_DS6_ROUTE_NB];
+/*---------------------------------------------------------------------------*/
+static double
+cpu_usec(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+/*---------------------------------------------------------------------------*/
+static void
+report(const char *what, unsigned routes, unsigned n, double start)
+{
+  double elapsed = cpu_usec() - start;
+
+  printf("%-24s routes=%-6u n=%-6u %10.0f us %8.3f us/op\n",
+         what, routes, n, elapsed, elapsed / n);
+}
+/*---------------------------------------------------------------------------*/
+static void
+add_nexthops(void)
+{
+  uip_lladdr_t lladdr;
+  int i;
+
+  for(i = 0; i < NUM_NEXTHOPS; i++) {
+    memset(&lladdr, 0, sizeof(lladdr));
+    lladdr.addr[sizeof(lladdr.addr) - 1] = i + 1;
+    uip_ip6addr(&nexthops[i], 0xfe80, 0, 0, 0, 0, 0, 0, i + 1);
+    uip_ds6_nbr_add(&nexthops[i], &lladdr, 1, NBR_REACHABLE,
+                    NBR_TABLE_REASON_UNDEFINED, NULL);
+  }
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(bench_process, ev, data)
+{
+  static const unsigned sizes[] = { 10, 100, 1000, 10000 };
+  uip_ipaddr_t prefix;
+  uip_ipaddr_t addr;
+  unsigned s;
+  unsigned n;
+  unsigned i;
+  unsigned found;
+  double start;
+
+  PROCESS_BEGIN();
+
+  printf("Route benchmark, route index %s\n",
+         UIP_DS6_ROUTE_HASH ? "enabled" : "disabled");
+
+  add_nexthops();
+  /* Downward routes of a storing-mode root: host routes to the
+     nodes of a few /64 prefixes */
+  for(i = 0; i < UIP_DS6_ROUTE_NB; i++) {
+    uip_ip6addr(&hosts[i], 0xfd00, 0, 0, i % 4, 0x0212, 0x4b00,
+                i >> 16, i & 0xffff);
+  }
+
+  for(s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    n = sizes[s];
+    if(n > UIP_DS6_ROUTE_NB) {
+      break;
+    }
+
+    start = cpu_usec();
+    for(i = 0; i < n; i++) {
+      routes[i] = uip_ds6_route_add(&hosts[i], 128,
+                                    &nexthops[i % NUM_NEXTHOPS]);
+    }
+    report("uip_ds6_route_add", n, n, start);
+
+    /* A covering prefix, for the lookups that miss the host routes */
+    uip_ip6addr(&prefix, 0xfd00, 0, 0, 0, 0, 0, 0, 0);
+    uip_ds6_route_add(&prefix, 16, &nexthops[0]);
+
+    found = 0;
+    start = cpu_usec();
+    for(i = 0; i < LOOKUPS; i++) {
+      found += uip_ds6_route_lookup(
+        &hosts[random_stream_u32(&bench_random) % n]) != NULL;
+    }
+    report("lookup (host route)", n, LOOKUPS, start);
+
+    uip_ip6addr(&addr, 0xfd00, 0, 0, 9, 0, 0, 0, 1);
+    start = cpu_usec();
+    for(i = 0; i < LOOKUPS; i++) {
+      addr.u16[7] = random_stream_u32(&bench_random);
+      found += uip_ds6_route_lookup(&addr) != NULL;
+    }
+    report("lookup (prefix route)", n, LOOKUPS, start);
+
+    if(found != 2 * LOOKUPS) {
+      printf("Error: %u of %u lookups failed\n", 2 * LOOKUPS - found,
+             2 * LOOKUPS);
+    }
+
+    uip_ds6_route_rm(uip_ds6_route_lookup(&prefix));
+    start = cpu_usec();
+    for(i = 0; i < n; i++) {
+      uip_ds6_route_rm(routes[i]);
+    }
+    report("uip_ds6_route_rm", n, n, start);
+  }
+
+  exit(0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
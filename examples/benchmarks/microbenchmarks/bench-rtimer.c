@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/**
+ * \file
+ *         Runs a periodic rtimer and prints a histogram of how late its
+ *         callbacks run, with and without other processes keeping the
+ *         main loop busy. Callbacks that run after the next deadline of
+ *         the period, or later than a threshold, are counted as misses.
+ */
+
+#include "contiki.h"
+#include "sys/rtimer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PERIOD_US   1000
+#define SAMPLES     2000
+/* Callbacks later than this are counted as deadline misses */
+#define MISS_US     100
+/* Time that the load process spends in each invocation */
+#define LOAD_US     200
+/* Bucket i counts lateness in [2^(i-1), 2^i) us, bucket 0 less than 1 us */
+#define BUCKETS     16
+
+PROCESS(bench_process, "Rtimer jitter benchmark");
+PROCESS(load_process, "Load");
+AUTOSTART_PROCESSES(&bench_process);
+
+static struct rtimer rt;
+static rtimer_clock_t period;
+static rtimer_clock_t deadline;
+static volatile unsigned samples;
+static unsigned histogram[BUCKETS];
+static unsigned misses;
+static unsigned overruns;
+static uint32_t max_late;
+/*---------------------------------------------------------------------------*/
+static unsigned
+bucket_of(uint32_t late)
+{
+  unsigned bucket;
+
+  for(bucket = 0; late > 0 && bucket < BUCKETS - 1; bucket++) {
+    late >>= 1;
+  }
+  return bucket;
+}
+/*---------------------------------------------------------------------------*/
+static void
+callback(struct rtimer *t, void *ptr)
+{
+  int32_t diff;
+  uint32_t late;
+
+  diff = RTIMER_CLOCK_DIFF(RTIMER_NOW(), deadline);
+  late = diff > 0 ? RTIMERTICKS_TO_US_64(diff) : 0;
+  histogram[bucket_of(late)]++;
+  if(late > max_late) {
+    max_late = late;
+  }
+  if(late > MISS_US) {
+    misses++;
+  }
+
+  /* Keep the period of the deadlines. Deadlines that have already
+     passed are skipped. */
+  deadline += period;
+  while(!RTIMER_CLOCK_LT(RTIMER_NOW(), deadline)) {
+    deadline += period;
+    overruns++;
+  }
+
+  if(++samples < SAMPLES) {
+    rtimer_set(&rt, deadline, 0, callback, NULL);
+  } else {
+    process_poll(&bench_process);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+report(const char *what)
+{
+  unsigned i;
+
+  printf("%s: %u callbacks every %u us, %u late by more than %u us, "
+         "%u deadlines skipped, max %lu us\n",
+         what, SAMPLES, PERIOD_US, misses, MISS_US, overruns,
+         (unsigned long)max_late);
+  for(i = 0; i < BUCKETS; i++) {
+    if(histogram[i] == 0) {
+      continue;
+    }
+    if(i == 0) {
+      printf("  %7s < %6u us %6u\n", "", 1, histogram[i]);
+    } else if(i == BUCKETS - 1) {
+      printf("  %7lu+         us %6u\n", 1UL << (i - 1), histogram[i]);
+    } else {
+      printf("  %7lu - %6lu us %6u\n", 1UL << (i - 1), 1UL << i,
+             histogram[i]);
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+start(void)
+{
+  samples = 0;
+  misses = 0;
+  overruns = 0;
+  max_late = 0;
+  memset(histogram, 0, sizeof(histogram));
+  deadline = RTIMER_NOW() + period;
+  rtimer_set(&rt, deadline, 0, callback, NULL);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(load_process, ev, data)
+{
+  rtimer_clock_t end;
+
+  PROCESS_BEGIN();
+
+  while(1) {
+    end = RTIMER_NOW() + US_TO_RTIMERTICKS(LOAD_US);
+    while(RTIMER_CLOCK_LT(RTIMER_NOW(), end));
+    process_poll(&load_process);
+    PROCESS_YIELD();
+  }
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(bench_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Rtimer jitter benchmark, %s, %lu ticks per second\n",
+         RTIMER_ARCH_TIMERFD ? "timerfd" : "SIGALRM",
+         (unsigned long)RTIMER_SECOND);
+  period = US_TO_RTIMERTICKS(PERIOD_US);
+
+  start();
+  PROCESS_WAIT_EVENT_UNTIL(ev == PROCESS_EVENT_POLL);
+  report("idle");
+
+  /* Another process runs for LOAD_US at a time, all the time */
+  process_start(&load_process, NULL);
+  start();
+  PROCESS_WAIT_EVENT_UNTIL(ev == PROCESS_EVENT_POLL);
+  report("loaded");
+
+  exit(0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
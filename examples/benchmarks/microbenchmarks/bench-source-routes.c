@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *         Measures the per-packet cost of finding the source route from
+ *         a non-storing root to a destination, in graphs of 10 to 10000
+ *         nodes.
+ */
+
+#include "contiki.h"
+#include "net/ipv6/uip-sr.h"
+#include "net/routing/routing.h"
+#include "lib/random.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define PACKETS 100000
+
+PROCESS(bench_process, "Source route benchmark");
+AUTOSTART_PROCESSES(&bench_process);
+
+RANDOM_STREAM(bench_random, RANDOM_STREAM_APP);
+
+static uip_ipaddr_t addrs[UIP_SR_LINK_NUM];
+/*---------------------------------------------------------------------------*/
+static double
+cpu_usec(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+/*---------------------------------------------------------------------------*/
+static void
+report(const char *what, unsigned nodes, unsigned n, double start)
+{
+  double elapsed = cpu_usec() - start;
+
+  printf("%-24s nodes=%-6u n=%-6u %10.0f us %8.3f us/op\n",
+         what, nodes, n, elapsed, elapsed / n);
+}
+/*---------------------------------------------------------------------------*/
+static void
+make_addr(uip_ipaddr_t *addr, unsigned i)
+{
+  uip_sr_node_t tmp;
+
+  /* Take the prefix that the routing protocol gives to the nodes */
+  memset(&tmp, 0, sizeof(tmp));
+  tmp.link_identifier[0] = 0x02;
+  tmp.link_identifier[1] = 0x12;
+  tmp.link_identifier[2] = 0x4b;
+  tmp.link_identifier[6] = i >> 8;
+  tmp.link_identifier[7] = i;
+  NETSTACK_ROUTING.get_sr_node_ipaddr(addr, &tmp);
+}
+/*---------------------------------------------------------------------------*/
+/* What the root does to build the source routing header of a packet */
+static unsigned
+source_route(const uip_ipaddr_t *dest)
+{
+  uip_sr_node_t *dest_node;
+  uip_sr_node_t *root_node;
+  uip_sr_node_t *node;
+  uip_ipaddr_t hop_addr;
+  uint8_t hops;
+  uint8_t cmpr;
+
+  dest_node = uip_sr_get_node(NULL, dest);
+  root_node = uip_sr_get_node(NULL, &addrs[0]);
+  if(!uip_sr_get_path(dest_node, root_node, &hops, &cmpr)) {
+    return 0;
+  }
+  for(node = dest_node; node->parent != root_node; node = node->parent) {
+    NETSTACK_ROUTING.get_sr_node_ipaddr(&hop_addr, node);
+  }
+  return hops + 1;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(bench_process, ev, data)
+{
+  static const unsigned sizes[] = { 10, 100, 1000, 10000 };
+  unsigned s;
+  unsigned n;
+  unsigned i;
+  unsigned hops;
+  double start;
+
+  PROCESS_BEGIN();
+
+  printf("Source route benchmark, node index %s\n",
+         UIP_SR_HASH ? "enabled" : "disabled");
+
+  for(i = 0; i < UIP_SR_LINK_NUM; i++) {
+    make_addr(&addrs[i], i);
+  }
+
+  for(s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    n = sizes[s];
+    if(n > UIP_SR_LINK_NUM) {
+      break;
+    }
+
+    /* A random tree: each node joins an earlier one, as DAOs would
+       arrive while the network forms */
+    start = cpu_usec();
+    uip_sr_update_node(NULL, &addrs[0], NULL, UIP_SR_INFINITE_LIFETIME);
+    for(i = 1; i < n; i++) {
+      uip_sr_update_node(NULL, &addrs[i],
+                         &addrs[random_stream_u32(&bench_random) % i], 600);
+    }
+    report("uip_sr_update_node", n, n, start);
+
+    hops = 0;
+    start = cpu_usec();
+    for(i = 0; i < PACKETS; i++) {
+      hops += source_route(&addrs[1 + random_stream_u32(&bench_random) %
+                                  (n - 1)]);
+    }
+    report("source route", n, PACKETS, start);
+    printf("%-24s nodes=%-6u %.2f hops on average\n", "", n,
+           (double)hops / PACKETS);
+
+    uip_sr_free_all();
+  }
+
+  exit(0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *         Measures the cost of arming, re-arming, stopping and expiring
+ *         large numbers of event and callback timers. With the etimer
+ *         wheel, fails if re-arming or stopping a timer gets slower
+ *         with the number of pending timers.
+ */
+
+#include "contiki.h"
+#include "sys/ctimer.h"
+#include "lib/random.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define MAX_TIMERS 10000
+/* Expiring timers are spread over this many clock ticks */
+#define SPREAD     (CLOCK_SECOND / 4)
+/* Highest ratio of the cost per timer with 10k and with 1k pending
+   timers for the operations that must take constant time */
+#define MAX_GROWTH 4
+
+PROCESS(bench_process, "Timer benchmark");
+AUTOSTART_PROCESSES(&bench_process);
+
+static struct etimer etimers[MAX_TIMERS];
+static struct ctimer ctimers[MAX_TIMERS];
+static unsigned expired;
+/* Cost per timer of the constant-time operations, per size */
+enum { OP_RESTART, OP_STOP, OP_CTIMER_STOP, NUM_OPS };
+static const char *const op_names[NUM_OPS] = {
+  "etimer_restart", "etimer_stop", "ctimer_stop"
+};
+static double op_cost[2][NUM_OPS];
+/*---------------------------------------------------------------------------*/
+static double
+cpu_usec(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+/*---------------------------------------------------------------------------*/
+static double
+report(const char *what, unsigned n, double start)
+{
+  double elapsed = cpu_usec() - start;
+
+  printf("%-28s n=%-6u %10.0f us %8.3f us/timer\n",
+         what, n, elapsed, elapsed / n);
+  return elapsed / n;
+}
+/*---------------------------------------------------------------------------*/
+/* Returns zero if a constant-time operation got slower with more
+   pending timers */
+static int
+check_scaling(void)
+{
+  int ok = 1;
+  unsigned op;
+
+  for(op = 0; op < NUM_OPS; op++) {
+    if(op_cost[1][op] > MAX_GROWTH * op_cost[0][op]) {
+      printf("FAIL: %s takes %.3f us/timer with %u pending timers, "
+             "%.3f us/timer with 1000\n", op_names[op],
+             op_cost[1][op], MAX_TIMERS, op_cost[0][op]);
+      ok = 0;
+    }
+  }
+  return ok;
+}
+/*---------------------------------------------------------------------------*/
+static void
+wait_past(clock_time_t ticks)
+{
+  clock_time_t end = clock_time() + ticks + 1;
+
+  while(clock_time() < end);
+}
+/*---------------------------------------------------------------------------*/
+static void
+callback(void *ptr)
+{
+  expired++;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(bench_process, ev, data)
+{
+  static const unsigned sizes[] = { 1000, MAX_TIMERS };
+  static unsigned s;
+  static unsigned n;
+  static double start;
+  unsigned i;
+
+  PROCESS_BEGIN();
+
+  printf("Timer benchmark, etimer wheel %s\n",
+         ETIMER_WHEEL ? "enabled" : "disabled");
+
+  for(s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    n = sizes[s];
+
+    /* Long-running timers, which stay pending during the test */
+    start = cpu_usec();
+    for(i = 0; i < n; i++) {
+      etimer_set(&etimers[i], CLOCK_SECOND * 60 + random_rand() % 1000);
+    }
+    report("etimer_set", n, start);
+
+    start = cpu_usec();
+    for(i = 0; i < n; i++) {
+      etimer_restart(&etimers[i]);
+    }
+    op_cost[s][OP_RESTART] = report("etimer_restart (pending)", n, start);
+
+    start = cpu_usec();
+    for(i = 0; i < n; i++) {
+      etimer_next_expiration_time();
+    }
+    report("etimer_next_expiration_time", n, start);
+
+    start = cpu_usec();
+    for(i = 0; i < n; i++) {
+      etimer_stop(&etimers[i]);
+    }
+    op_cost[s][OP_STOP] = report("etimer_stop", n, start);
+
+    start = cpu_usec();
+    for(i = 0; i < n; i++) {
+      ctimer_set(&ctimers[i], CLOCK_SECOND * 60 + random_rand() % 1000,
+                 callback, NULL);
+    }
+    report("ctimer_set", n, start);
+
+    start = cpu_usec();
+    for(i = 0; i < n; i++) {
+      ctimer_stop(&ctimers[i]);
+    }
+    op_cost[s][OP_CTIMER_STOP] = report("ctimer_stop", n, start);
+
+    /* Timers that expire within a short window. The clock is allowed
+       to pass the window before measuring, so that the CPU time only
+       covers processing the expired timers and delivering them. */
+    expired = 0;
+    for(i = 0; i < n; i++) {
+      etimer_set(&etimers[i], 1 + random_rand() % SPREAD);
+    }
+    wait_past(SPREAD);
+    start = cpu_usec();
+    while(expired < n) {
+      PROCESS_WAIT_EVENT_UNTIL(ev == PROCESS_EVENT_TIMER);
+      expired++;
+    }
+    report("etimer expire", n, start);
+
+    expired = 0;
+    for(i = 0; i < n; i++) {
+      ctimer_set(&ctimers[i], 1 + random_rand() % SPREAD, callback, NULL);
+    }
+    wait_past(SPREAD);
+    start = cpu_usec();
+    while(expired < n) {
+      PROCESS_PAUSE();
+    }
+    report("ctimer expire", n, start);
+  }
+
+  if(ETIMER_WHEEL && !check_scaling()) {
+    exit(1);
+  }
+  exit(0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
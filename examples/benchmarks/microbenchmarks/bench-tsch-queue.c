@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *         Measures the cost of picking a unicast packet for a shared
+ *         broadcast TSCH link and of updating the backoff windows
+ *         afterwards, as done by the slot operation, with 10 to 900
+ *         neighbors, against walking all neighbors as the queues did
+ *         before they kept the ready neighbors apart.
+ */
+
+#include "contiki.h"
+#include "net/packetbuf.h"
+#include "net/mac/tsch/tsch.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define ROUNDS        200000
+#define MAX_NEIGHBORS 900
+
+PROCESS(bench_process, "TSCH queue benchmark");
+AUTOSTART_PROCESSES(&bench_process);
+
+static linkaddr_t addrs[MAX_NEIGHBORS];
+static struct tsch_neighbor *nbrs[MAX_NEIGHBORS];
+static unsigned num_nbrs;
+static struct tsch_link shared_link;
+/*---------------------------------------------------------------------------*/
+static double
+cpu_usec(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+/*---------------------------------------------------------------------------*/
+/* The first neighbor we have no Tx link to that may send, walking all
+   neighbors */
+static struct tsch_packet *
+walk_unicast_packet_for_any(struct tsch_neighbor **n, struct tsch_link *link)
+{
+  unsigned i;
+
+  for(i = 0; i < num_nbrs; i++) {
+    if(!nbrs[i]->is_broadcast && nbrs[i]->tx_links_count == 0) {
+      struct tsch_packet *p = tsch_queue_get_packet_for_nbr(nbrs[i], link);
+      if(p != NULL) {
+        *n = nbrs[i];
+        return p;
+      }
+    }
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+/* Decrements the backoff windows after a shared broadcast link, walking
+   all neighbors */
+static void
+walk_update_all_backoff_windows(void)
+{
+  unsigned i;
+
+  for(i = 0; i < num_nbrs; i++) {
+    if(nbrs[i]->backoff_window != 0 && nbrs[i]->tx_links_count == 0) {
+      nbrs[i]->backoff_window--;
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+add_packet(const linkaddr_t *addr)
+{
+  packetbuf_clear();
+  packetbuf_set_datalen(50);
+  tsch_queue_add_packet(addr, 3, NULL, NULL);
+}
+/*---------------------------------------------------------------------------*/
+/* A shared broadcast link with no broadcast packet to send. One
+   transmission in four fails. A neighbor gets a new packet when its
+   packet leaves the queue, so that the same number of neighbors always
+   have packets. */
+static void
+slot(unsigned round, int walk)
+{
+  struct tsch_neighbor *n = NULL;
+  struct tsch_packet *p;
+
+  if(walk) {
+    p = walk_unicast_packet_for_any(&n, &shared_link);
+  } else {
+    p = tsch_queue_get_unicast_packet_for_any(&n, &shared_link);
+  }
+  if(p != NULL) {
+    p->transmissions++;
+    if(!tsch_queue_packet_sent(n, p, &shared_link,
+                               round % 4 == 0 ? MAC_TX_NOACK : MAC_TX_OK)) {
+      tsch_queue_free_packet(p);
+      add_packet(tsch_queue_get_nbr_address(n));
+    }
+  }
+  if(walk) {
+    walk_update_all_backoff_windows();
+  } else {
+    tsch_queue_update_all_backoff_windows(&tsch_broadcast_address);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static double
+run(unsigned busy, int walk)
+{
+  unsigned i;
+  double start;
+
+  /* Start from empty queues */
+  tsch_queue_reset();
+  for(i = 0; i < num_nbrs; i++) {
+    nbrs[i]->backoff_window = 0;
+  }
+  for(i = 0; i < busy; i++) {
+    add_packet(&addrs[i * num_nbrs / busy]);
+  }
+
+  start = cpu_usec();
+  for(i = 0; i < ROUNDS; i++) {
+    slot(i, walk);
+  }
+  return (cpu_usec() - start) * 1e3 / ROUNDS;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(bench_process, ev, data)
+{
+  static const unsigned neighbors[] = { 10, 100, 900 };
+  static const unsigned busy[] = { 1, 4 };
+  unsigned s, b, i;
+  double indexed;
+  double walked;
+
+  PROCESS_BEGIN();
+
+  printf("TSCH queue benchmark\n");
+
+  tsch_queue_init();
+  shared_link.link_options = LINK_OPTION_TX | LINK_OPTION_SHARED;
+  linkaddr_copy(&shared_link.addr, &tsch_broadcast_address);
+
+  for(s = 0; s < sizeof(neighbors) / sizeof(neighbors[0]); s++) {
+    /* Neighbors we have no Tx link to, as with the minimal schedule */
+    for(num_nbrs = 0; num_nbrs < neighbors[s]; num_nbrs++) {
+      memset(&addrs[num_nbrs], 0, sizeof(linkaddr_t));
+      addrs[num_nbrs].u8[0] = 0x02;
+      addrs[num_nbrs].u8[LINKADDR_SIZE - 2] = (num_nbrs + 1) >> 8;
+      addrs[num_nbrs].u8[LINKADDR_SIZE - 1] = num_nbrs + 1;
+      nbrs[num_nbrs] = tsch_queue_add_nbr(&addrs[num_nbrs]);
+      if(nbrs[num_nbrs] == NULL) {
+        printf("neighbor table full\n");
+        exit(1);
+      }
+    }
+    for(b = 0; b < sizeof(busy) / sizeof(busy[0]); b++) {
+      indexed = run(busy[b], 0);
+      walked = run(busy[b], 1);
+      printf("neighbors=%-4u busy=%u %8.1f ns/slot ready list %8.1f ns/slot walked\n",
+             num_nbrs, busy[b], indexed, walked);
+    }
+    /* Drop the neighbors */
+    tsch_queue_reset();
+    for(i = 0; i < num_nbrs; i++) {
+      nbrs[i]->backoff_window = 0;
+    }
+    tsch_queue_free_unused_neighbors();
+  }
+
+  exit(0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *         Measures the cost of finding the next active TSCH link, as
+ *         done at every wakeup of the slot operation, with 1, 4 and 16
+ *         slotframes of up to 500 links, against walking all links as
+ *         the schedule did before it kept them sorted.
+ */
+
+#include "contiki.h"
+#include "lib/random.h"
+#include "net/mac/tsch/tsch.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define ROUNDS 200000
+
+PROCESS(bench_process, "TSCH schedule benchmark");
+AUTOSTART_PROCESSES(&bench_process);
+
+static struct tsch_link *links[TSCH_SCHEDULE_MAX_LINKS];
+/*---------------------------------------------------------------------------*/
+static double
+cpu_usec(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+/*---------------------------------------------------------------------------*/
+/* The next active link, walking all links of all slotframes */
+static struct tsch_link *
+walk_next_active_link(struct tsch_asn_t *asn, uint16_t *time_offset,
+                      struct tsch_link **backup_link)
+{
+  uint16_t time_to_curr_best = 0;
+  struct tsch_link *curr_best = NULL;
+  struct tsch_link *curr_backup = NULL;
+  struct tsch_slotframe *sf;
+
+  for(sf = tsch_schedule_slotframe_head(); sf != NULL;
+      sf = tsch_schedule_slotframe_next(sf)) {
+    uint16_t timeslot = TSCH_ASN_MOD(*asn, sf->size);
+    struct tsch_link *l;
+    for(l = list_head(sf->links_list); l != NULL; l = list_item_next(l)) {
+      uint16_t time_to_timeslot =
+        l->timeslot > timeslot ?
+        l->timeslot - timeslot :
+        sf->size.val + l->timeslot - timeslot;
+      if(curr_best == NULL || time_to_timeslot < time_to_curr_best) {
+        time_to_curr_best = time_to_timeslot;
+        curr_best = l;
+        curr_backup = NULL;
+      } else if(time_to_timeslot == time_to_curr_best) {
+        struct tsch_link *new_best = NULL;
+        if((curr_best->link_options & LINK_OPTION_TX) == (l->link_options & LINK_OPTION_TX)) {
+          if(l->slotframe_handle != curr_best->slotframe_handle) {
+            if(l->slotframe_handle < curr_best->slotframe_handle) {
+              new_best = l;
+            }
+          } else {
+            /* No neighbor has packets queued */
+            new_best = curr_best;
+          }
+        } else if(l->link_options & LINK_OPTION_TX) {
+          new_best = l;
+        }
+        if(new_best != l && (l->link_options & LINK_OPTION_RX)) {
+          if(curr_backup == NULL || l->slotframe_handle < curr_backup->slotframe_handle) {
+            curr_backup = l;
+          }
+        }
+        if(new_best != curr_best && (curr_best->link_options & LINK_OPTION_RX)) {
+          if(curr_backup == NULL || curr_best->slotframe_handle < curr_backup->slotframe_handle) {
+            curr_backup = curr_best;
+          }
+        }
+        if(new_best != NULL) {
+          curr_best = new_best;
+        }
+      }
+    }
+  }
+  *time_offset = time_to_curr_best;
+  *backup_link = curr_backup;
+  return curr_best;
+}
+/*---------------------------------------------------------------------------*/
+/* Slotframes of distinct prime lengths, with links at random timeslots
+   and channel offsets: Rx links, and Tx links to one of 50 neighbors as
+   installed by Orchestra */
+static void
+make_schedule(unsigned num_slotframes, unsigned num_links)
+{
+  static const uint16_t sizes[] = {
+    397, 101, 61, 47, 43, 41, 37, 31, 29, 23, 19, 17, 13, 11, 7, 5
+  };
+  struct tsch_slotframe *sf;
+  linkaddr_t addr;
+  unsigned i;
+
+  tsch_schedule_remove_all_slotframes();
+  for(i = 0; i < num_slotframes; i++) {
+    tsch_schedule_add_slotframe(i, sizes[i]);
+  }
+  memset(&addr, 0, sizeof(addr));
+  for(i = 0; i < num_links; i++) {
+    sf = tsch_schedule_get_slotframe_by_handle(i % num_slotframes);
+    addr.u8[LINKADDR_SIZE - 1] = random_rand() % 50;
+    links[i] = tsch_schedule_add_link(sf,
+                                      (i & 1) ? LINK_OPTION_RX : LINK_OPTION_TX,
+                                      LINK_TYPE_NORMAL, &addr,
+                                      random_rand() % sf->size.val,
+                                      random_rand() % 16, 0);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+run(unsigned num_slotframes, unsigned num_links)
+{
+  struct tsch_asn_t asn;
+  struct tsch_link *link, *backup;
+  uint16_t offset;
+  unsigned i;
+  unsigned checksum = 0;
+  double start;
+  double indexed;
+  double walked;
+  double updated;
+
+  make_schedule(num_slotframes, num_links);
+
+  /* From one active link to the next, as the slot operation does */
+  TSCH_ASN_INIT(asn, 0, 0);
+  start = cpu_usec();
+  for(i = 0; i < ROUNDS; i++) {
+    link = tsch_schedule_get_next_active_link(&asn, &offset, &backup);
+    TSCH_ASN_INC(asn, offset);
+    checksum += link->handle;
+  }
+  indexed = (cpu_usec() - start) * 1e3 / ROUNDS;
+
+  TSCH_ASN_INIT(asn, 0, 0);
+  start = cpu_usec();
+  for(i = 0; i < ROUNDS; i++) {
+    link = walk_next_active_link(&asn, &offset, &backup);
+    TSCH_ASN_INC(asn, offset);
+    checksum -= link->handle;
+  }
+  walked = (cpu_usec() - start) * 1e3 / ROUNDS;
+
+  /* Re-install random links, as Orchestra does when neighbors change */
+  start = cpu_usec();
+  for(i = 0; i < ROUNDS / 10; i++) {
+    unsigned n = random_rand() % num_links;
+    struct tsch_slotframe *sf =
+      tsch_schedule_get_slotframe_by_handle(links[n]->slotframe_handle);
+    uint8_t options = links[n]->link_options;
+    linkaddr_t addr;
+    linkaddr_copy(&addr, &links[n]->addr);
+    tsch_schedule_remove_link(sf, links[n]);
+    links[n] = tsch_schedule_add_link(sf, options, LINK_TYPE_NORMAL, &addr,
+                                      random_rand() % sf->size.val,
+                                      random_rand() % 16, 0);
+  }
+  updated = (cpu_usec() - start) * 1e3 / (ROUNDS / 10);
+
+  printf("slotframes=%-2u links=%-3u %8.1f ns/lookup indexed %8.1f ns/lookup walked %8.1f ns/update%s\n",
+         num_slotframes, num_links, indexed, walked, updated,
+         checksum == 0 ? "" : " MISMATCH");
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(bench_process, ev, data)
+{
+  static const unsigned num_slotframes[] = { 1, 4, 16 };
+  static const unsigned num_links[] = { 16, 100, 500 };
+  unsigned s, l;
+
+  PROCESS_BEGIN();
+
+  printf("TSCH schedule benchmark\n");
+
+  tsch_queue_init();
+  tsch_schedule_init();
+
+  for(s = 0; s < sizeof(num_slotframes) / sizeof(num_slotframes[0]); s++) {
+    for(l = 0; l < sizeof(num_links) / sizeof(num_links[0]); l++) {
+      run(num_slotframes[s], num_links[l]);
+    }
+  }
+
+  exit(0);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PROJECT_CONF_H_
+#define PROJECT_CONF_H_
+
+/* The arena of bench-heapmem, roughly that of a constrained node */
+#define HEAPMEM_CONF_ARENA_SIZE 6144
+#ifndef HEAPMEM_CONF_SIZE_CLASSES
+#define HEAPMEM_CONF_SIZE_CLASSES 0
+#endif /* HEAPMEM_CONF_SIZE_CLASSES */
+
+/* The routing table of bench-routes: the host routes of a large
+   storing-mode root, and a prefix route */
+#define UIP_CONF_MAX_ROUTES (10000 + 1)
+
+/* The source routing graph of bench-source-routes */
+#define UIP_SR_CONF_LINK_NUM 10000
+
+/* The neighbor table of bench-nbr-table */
+#define NBR_TABLE_CONF_MAX_NEIGHBORS 1000
+
+/* bench-queuebuf counts the bytes copied by queuebufs */
+#define QUEUEBUF_CONF_STATS 1
+
+/* bench-iphc sends frames to a MAC that drops them */
+#define NETSTACK_CONF_MAC bench_mac_driver
+
+/* The schedule of bench-tsch-schedule */
+#define TSCH_SCHEDULE_CONF_MAX_SLOTFRAMES 16
+#define TSCH_SCHEDULE_CONF_MAX_LINKS 500
+
+#endif /* PROJECT_CONF_H_ */
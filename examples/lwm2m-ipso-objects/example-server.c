@@ -294,6 +294,8 @@ PROCESS_THREAD(router_process, ev, data)
 
   PROCESS_BEGIN();
 
+  process_subscribe(PROCESS_CURRENT(), serial_line_event_message);
+
   /* Initialize DAG root */
   NETSTACK_ROUTING.root_start();
 
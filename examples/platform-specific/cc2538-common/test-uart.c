@@ -82,6 +82,8 @@ PROCESS_THREAD(cc2538_uart_demo_process, ev, data)
   char string[20];
   
   PROCESS_BEGIN();
+
+  process_subscribe(PROCESS_CURRENT(), serial_line_event_message);
   uart_set_input(1, serial_line_input_byte);
   etimer_set(&et, CLOCK_SECOND * 4);
   leds_toggle(LEDS_GREEN);
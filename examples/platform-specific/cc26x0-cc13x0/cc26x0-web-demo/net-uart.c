@@ -254,6 +254,8 @@ PROCESS_THREAD(net_uart_process, ev, data)
 {
   PROCESS_BEGIN();
 
+  process_subscribe(PROCESS_CURRENT(), serial_line_event_message);
+
   printf("CC26XX Net UART Process\n");
 
   set_config_defaults();
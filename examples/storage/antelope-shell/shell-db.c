@@ -53,6 +53,8 @@ PROCESS_THREAD(db_shell, ev, data)
 
   PROCESS_BEGIN();
 
+  process_subscribe(PROCESS_CURRENT(), serial_line_event_message);
+
   db_init();
 
   for(;;) {
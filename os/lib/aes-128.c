@@ -65,6 +65,8 @@ static const uint8_t sbox[256] =   {
 0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16 };
 
 static uint8_t round_keys[11][AES_128_KEY_LENGTH];
+/* The round keys in use: either round_keys or those of a context */
+static const uint8_t (*current_round_keys)[AES_128_KEY_LENGTH] = round_keys;
 
 /*---------------------------------------------------------------------------*/
 /* multiplies by 2 in GF(2) */
@@ -75,28 +77,55 @@ galois_mul2(uint8_t value)
   return ((value << 1) ^ xor_val);
 }
 /*---------------------------------------------------------------------------*/
-static void
-set_key(const uint8_t *key)
+void
+aes_128_expand_key(uint8_t rk[][AES_128_KEY_LENGTH], const uint8_t *key)
 {
   uint8_t i;
   uint8_t j;
   uint8_t rcon;
   
   rcon = 0x01;
-  memcpy(round_keys[0], key, AES_128_KEY_LENGTH);
+  memcpy(rk[0], key, AES_128_KEY_LENGTH);
   for(i = 1; i <= 10; i++) {
-    round_keys[i][0] = sbox[round_keys[i - 1][13]] ^ round_keys[i - 1][0] ^ rcon;
-    round_keys[i][1] = sbox[round_keys[i - 1][14]] ^ round_keys[i - 1][1];
-    round_keys[i][2] = sbox[round_keys[i - 1][15]] ^ round_keys[i - 1][2];
-    round_keys[i][3] = sbox[round_keys[i - 1][12]] ^ round_keys[i - 1][3];
+    rk[i][0] = sbox[rk[i - 1][13]] ^ rk[i - 1][0] ^ rcon;
+    rk[i][1] = sbox[rk[i - 1][14]] ^ rk[i - 1][1];
+    rk[i][2] = sbox[rk[i - 1][15]] ^ rk[i - 1][2];
+    rk[i][3] = sbox[rk[i - 1][12]] ^ rk[i - 1][3];
     for(j = 4; j < AES_128_BLOCK_SIZE; j++) {
-      round_keys[i][j] = round_keys[i - 1][j] ^ round_keys[i][j - 4];
+      rk[i][j] = rk[i - 1][j] ^ rk[i][j - 4];
     }
     rcon = galois_mul2(rcon);
   }
 }
 /*---------------------------------------------------------------------------*/
 static void
+set_key(const uint8_t *key)
+{
+  aes_128_expand_key(round_keys, key);
+  current_round_keys = round_keys;
+}
+/*---------------------------------------------------------------------------*/
+static void
+init_context(struct aes_128_context *context, const uint8_t *key)
+{
+#if AES_128_CONTEXT_ROUND_KEYS >= 11
+  aes_128_expand_key(context->round_keys, key);
+#else /* AES_128_CONTEXT_ROUND_KEYS >= 11 */
+  memcpy(context->round_keys[0], key, AES_128_KEY_LENGTH);
+#endif /* AES_128_CONTEXT_ROUND_KEYS >= 11 */
+}
+/*---------------------------------------------------------------------------*/
+static void
+set_context(const struct aes_128_context *context)
+{
+#if AES_128_CONTEXT_ROUND_KEYS >= 11
+  current_round_keys = context->round_keys;
+#else /* AES_128_CONTEXT_ROUND_KEYS >= 11 */
+  set_key(context->round_keys[0]);
+#endif /* AES_128_CONTEXT_ROUND_KEYS >= 11 */
+}
+/*---------------------------------------------------------------------------*/
+static void
 encrypt(uint8_t *state)
 {
   uint8_t buf1, buf2, buf3, buf4, round, i;
@@ -104,7 +133,7 @@ encrypt(uint8_t *state)
   /* round 0 */
   /* AddRoundKey */
   for(i = 0; i < AES_128_BLOCK_SIZE; i++) {
-    state[i] = state[i] ^ round_keys[0][i];
+    state[i] = state[i] ^ current_round_keys[0][i];
   }
   
   for(round = 1; round <= 10; round++) {
@@ -161,13 +190,25 @@ encrypt(uint8_t *state)
     
     /* AddRoundKey */
     for(i = 0; i < AES_128_BLOCK_SIZE; i++) {
-      state[i] = state[i] ^ round_keys[round][i];
+      state[i] = state[i] ^ current_round_keys[round][i];
     }
   }
 }
 /*---------------------------------------------------------------------------*/
+static void
+encrypt_blocks(uint8_t *blocks, uint8_t count)
+{
+  for(; count > 0; count--) {
+    encrypt(blocks);
+    blocks += AES_128_BLOCK_SIZE;
+  }
+}
+/*---------------------------------------------------------------------------*/
 const struct aes_128_driver aes_128_driver = {
   set_key,
-  encrypt
+  encrypt,
+  init_context,
+  set_context,
+  encrypt_blocks
 };
 /*---------------------------------------------------------------------------*/
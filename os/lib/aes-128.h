@@ -51,6 +51,24 @@
 #define AES_128            aes_128_driver
 #endif /* AES_128_CONF */
 
+/* The number of round keys kept in a context. Drivers that need nothing
+ * but the key itself only use the first, and platforms whose AES_128 is
+ * such a driver may set this to 1 to save RAM. */
+#ifdef AES_128_CONF_CONTEXT_ROUND_KEYS
+#define AES_128_CONTEXT_ROUND_KEYS AES_128_CONF_CONTEXT_ROUND_KEYS
+#else /* AES_128_CONF_CONTEXT_ROUND_KEYS */
+#define AES_128_CONTEXT_ROUND_KEYS 11
+#endif /* AES_128_CONF_CONTEXT_ROUND_KEYS */
+
+/**
+ * A key prepared by init_context(). Callers that switch between a few
+ * static keys keep one context per key and select it with set_context(),
+ * instead of passing the key to set_key() before each use.
+ */
+struct aes_128_context {
+  uint8_t round_keys[AES_128_CONTEXT_ROUND_KEYS][AES_128_KEY_LENGTH];
+};
+
 /**
  * Structure of AES drivers.
  */
@@ -65,8 +83,45 @@ struct aes_128_driver {
    * \brief Encrypts.
    */
   void (* encrypt)(uint8_t *plaintext_and_result);
+
+  /**
+   * \brief Prepares a context for a key, e.g., expands the key schedule.
+   */
+  void (* init_context)(struct aes_128_context *context, const uint8_t *key);
+
+  /**
+   * \brief Sets the current key to the key of a context. The context must
+   *        remain unchanged as long as it is in use.
+   */
+  void (* set_context)(const struct aes_128_context *context);
+
+  /**
+   * \brief Encrypts independent blocks, which pipelined or SIMD
+   *        implementations work on at once.
+   * \param blocks The blocks, one after the other, encrypted in place.
+   * \param count  The number of blocks.
+   */
+  void (* encrypt_blocks)(uint8_t *blocks, uint8_t count);
 };
 
 extern const struct aes_128_driver AES_128;
 
+/**
+ * The byte-wise software driver, which is AES_128 by default.
+ */
+extern const struct aes_128_driver aes_128_driver;
+
+/**
+ * A software driver with a 32-bit T-table, for hosts with fast 32-bit
+ * loads and memory to spare.
+ */
+extern const struct aes_128_driver aes_128_ttable_driver;
+
+/**
+ * \brief Expands a key into the 11 round keys of AES-128, for software
+ *        drivers.
+ */
+void aes_128_expand_key(uint8_t round_keys[][AES_128_KEY_LENGTH],
+                        const uint8_t *key);
+
 #endif /* AES_128_H_ */
@@ -51,6 +51,17 @@
 /* Valid values are 4, 6, 8, 10, 12, 14, and 16 octets */
 #define MIC_LEN_VALID(x) ((x) >= 4 && (x) <= 16 && (x) % 2 == 0)
 
+/* A frame being processed. It takes a step per block of its CBC-MAC: B_0,
+ * then the blocks of a and of m. */
+struct frame_state {
+  const struct ccm_star_frame *frame;
+  uint8_t x[AES_128_BLOCK_SIZE]; /* The CBC-MAC */
+  uint8_t s0[AES_128_BLOCK_SIZE]; /* A_0 encrypted */
+  uint16_t step;
+  uint16_t steps;
+  uint16_t a_blocks;
+};
+
 /*---------------------------------------------------------------------------*/
 static void
 set_iv(uint8_t *iv,
@@ -64,85 +75,144 @@ set_iv(uint8_t *iv,
   iv[15] = counter;
 }
 /*---------------------------------------------------------------------------*/
-/* XORs the block m[pos] ... m[pos + 15] with K_{counter} */
+/* XORs the len bytes of data that fall in a block, at most 16, into block */
 static void
-ctr_step(const uint8_t *nonce,
-    uint16_t pos,
-    uint8_t *m_and_result,
-    uint16_t m_len,
-    uint16_t counter)
+xor_block(uint8_t *block, const uint8_t *data, uint32_t len)
 {
-  uint8_t a[AES_128_BLOCK_SIZE];
   uint8_t i;
 
-  set_iv(a, CCM_STAR_ENCRYPTION_FLAGS, nonce, counter);
-  AES_128.encrypt(a);
-
-  for(i = 0; (pos + i < m_len) && (i < AES_128_BLOCK_SIZE); i++) {
-    m_and_result[pos + i] ^= a[i];
+  if(len >= AES_128_BLOCK_SIZE) {
+    for(i = 0; i < AES_128_BLOCK_SIZE; i++) {
+      block[i] ^= data[i];
+    }
+  } else {
+    for(i = 0; i < len; i++) {
+      block[i] ^= data[i];
+    }
   }
 }
 /*---------------------------------------------------------------------------*/
 static void
-mic(const uint8_t *nonce,
-    const uint8_t *m, uint16_t m_len,
-    const uint8_t *a, uint16_t a_len,
-    uint8_t *result,
-    uint8_t mic_len)
+init_state(struct frame_state *st, const struct ccm_star_frame *frame)
 {
-  uint8_t x[AES_128_BLOCK_SIZE];
-  uint32_t pos; /* 32-bits as can need to exceed m_len to reach end of loop */
-  uint8_t i;
-
-  set_iv(x, CCM_STAR_AUTH_FLAGS(a_len > 0, mic_len), nonce, m_len);
-  AES_128.encrypt(x);
+  st->frame = frame;
+  st->step = 0;
+  /* The first block of a also holds its two-byte length */
+  st->a_blocks = frame->a_len
+      ? (frame->a_len + 2 + AES_128_BLOCK_SIZE - 1) / AES_128_BLOCK_SIZE
+      : 0;
+  st->steps = 1 + st->a_blocks
+      + (frame->m_len + AES_128_BLOCK_SIZE - 1) / AES_128_BLOCK_SIZE;
+}
+/*---------------------------------------------------------------------------*/
+/* The counter of the block of m that is encrypted or decrypted along with
+ * the current step, or 0. In forward direction, block i of m is encrypted
+ * with A_{i + 1} at the step where the MIC takes it in. Otherwise, it is
+ * decrypted one step before. */
+static uint16_t
+step_counter(const struct frame_state *st, int forward)
+{
+  uint16_t counter;
 
-  if(a_len) {
-    x[0] = x[0] ^ (a_len >> 8);
-    x[1] = x[1] ^ a_len;
-    for(i = 2; (i - 2 < a_len) && (i < AES_128_BLOCK_SIZE); i++) {
-      x[i] ^= a[i - 2];
+  if(forward) {
+    if(st->step <= st->a_blocks) {
+      return 0;
     }
-
-    AES_128.encrypt(x);
-
-    pos = 14;
-    while(pos < a_len) {
-      for(i = 0; (pos + i < a_len) && (i < AES_128_BLOCK_SIZE); i++) {
-        x[i] ^= a[pos + i];
-      }
-      pos += AES_128_BLOCK_SIZE;
-      AES_128.encrypt(x);
+    counter = st->step - st->a_blocks;
+  } else {
+    if(st->step < st->a_blocks) {
+      return 0;
     }
+    counter = st->step - st->a_blocks + 1;
   }
+  return counter < st->steps - st->a_blocks ? counter : 0;
+}
+/*---------------------------------------------------------------------------*/
+/* Adds the next block of B_0, a and m to the CBC-MAC */
+static void
+absorb(struct frame_state *st)
+{
+  const struct ccm_star_frame *f = st->frame;
+  uint32_t pos;
 
-  if(m_len) {
-    pos = 0;
-    while(pos < m_len) {
-      for(i = 0; (pos + i < m_len) && (i < AES_128_BLOCK_SIZE); i++) {
-        x[i] ^= m[pos + i];
-      }
-      pos += AES_128_BLOCK_SIZE;
-      AES_128.encrypt(x);
-    }
+  if(st->step == 0) {
+    set_iv(st->x, CCM_STAR_AUTH_FLAGS(f->a_len > 0, f->mic_len),
+        f->nonce, f->m_len);
+  } else if(st->step == 1 && st->a_blocks) {
+    st->x[0] ^= f->a_len >> 8;
+    st->x[1] ^= f->a_len;
+    xor_block(st->x + 2, f->a,
+        f->a_len < AES_128_BLOCK_SIZE - 2 ? f->a_len : AES_128_BLOCK_SIZE - 2);
+  } else if(st->step <= st->a_blocks) {
+    pos = 14 + (uint32_t)(st->step - 2) * AES_128_BLOCK_SIZE;
+    xor_block(st->x, f->a + pos, f->a_len - pos);
+  } else {
+    pos = (uint32_t)(st->step - 1 - st->a_blocks) * AES_128_BLOCK_SIZE;
+    xor_block(st->x, f->m + pos, f->m_len - pos);
   }
-
-  ctr_step(nonce, 0, x, AES_128_BLOCK_SIZE, 0);
-
-  memcpy(result, x, mic_len);
 }
 /*---------------------------------------------------------------------------*/
+/* Runs frames in lockstep. At each step, the block of the CBC-MAC of
+ * every frame is encrypted along with the counter blocks that do not
+ * depend on it, so that pipelined AES implementations have independent
+ * blocks to work on. */
 static void
-ctr(const uint8_t *nonce, uint8_t *m, uint16_t m_len)
+run(struct frame_state *states, uint8_t count, int forward)
 {
-  uint32_t pos; /* 32-bits as can need to exceed m_len to reach end of loop */
+  uint8_t blocks[CCM_STAR_BATCH_FRAMES * 3][AES_128_BLOCK_SIZE];
+  struct frame_state *st;
+  uint32_t pos;
   uint16_t counter;
+  uint8_t n;
+  uint8_t j;
+  uint8_t i;
 
-  pos = 0;
-  counter = 1;
-  while(pos < m_len) {
-    ctr_step(nonce, pos, m, m_len, counter++);
-    pos += AES_128_BLOCK_SIZE;
+  for(;;) {
+    n = 0;
+    for(j = 0; j < count; j++) {
+      st = &states[j];
+      if(st->step == st->steps) {
+        continue;
+      }
+      absorb(st);
+      memcpy(blocks[n++], st->x, AES_128_BLOCK_SIZE);
+      if(st->step == 0) {
+        /* A_0, which encrypts the MIC */
+        set_iv(blocks[n++], CCM_STAR_ENCRYPTION_FLAGS, st->frame->nonce, 0);
+      }
+      counter = step_counter(st, forward);
+      if(counter) {
+        set_iv(blocks[n++], CCM_STAR_ENCRYPTION_FLAGS, st->frame->nonce,
+            counter);
+      }
+    }
+    if(n == 0) {
+      return;
+    }
+
+    AES_128.encrypt_blocks(blocks[0], n);
+
+    n = 0;
+    for(j = 0; j < count; j++) {
+      st = &states[j];
+      if(st->step == st->steps) {
+        continue;
+      }
+      memcpy(st->x, blocks[n++], AES_128_BLOCK_SIZE);
+      if(st->step == 0) {
+        memcpy(st->s0, blocks[n++], AES_128_BLOCK_SIZE);
+      }
+      counter = step_counter(st, forward);
+      if(counter) {
+        pos = (uint32_t)(counter - 1) * AES_128_BLOCK_SIZE;
+        xor_block(st->frame->m + pos, blocks[n++], st->frame->m_len - pos);
+      }
+      if(++st->step == st->steps) {
+        for(i = 0; i < st->frame->mic_len; i++) {
+          st->frame->result[i] = st->x[i] ^ st->s0[i];
+        }
+      }
+    }
   }
 }
 /*---------------------------------------------------------------------------*/
@@ -153,35 +223,65 @@ set_key(const uint8_t *key)
 }
 /*---------------------------------------------------------------------------*/
 static void
+init_context(struct aes_128_context *context, const uint8_t *key)
+{
+  AES_128.init_context(context, key);
+}
+/*---------------------------------------------------------------------------*/
+static void
+set_context(const struct aes_128_context *context)
+{
+  AES_128.set_context(context);
+}
+/*---------------------------------------------------------------------------*/
+static void
 aead(const uint8_t* nonce,
     uint8_t* m, uint16_t m_len,
     const uint8_t* a, uint16_t a_len,
     uint8_t *result, uint8_t mic_len,
     int forward)
 {
+  struct ccm_star_frame frame;
+  struct frame_state st;
+
   if(a_len > MAX_A_LEN || !MIC_LEN_VALID(mic_len)) {
     return;
   }
 
-  if(!forward) {
-    /* decrypt */
-    ctr(nonce, m, m_len);
-  }
-
-  mic(nonce,
-    m, m_len,
-    a, a_len,
-    result,
-    mic_len);
+  frame.nonce = nonce;
+  frame.m = m;
+  frame.m_len = m_len;
+  frame.a = a;
+  frame.a_len = a_len;
+  frame.result = result;
+  frame.mic_len = mic_len;
+  init_state(&st, &frame);
+  run(&st, 1, forward);
+}
+/*---------------------------------------------------------------------------*/
+static void
+aead_frames(const struct ccm_star_frame *frames, uint8_t count, int forward)
+{
+  struct frame_state states[CCM_STAR_BATCH_FRAMES];
+  uint8_t n;
 
-  if(forward) {
-    /* encrypt */
-    ctr(nonce, m, m_len);
+  n = 0;
+  for(; count > 0; count--, frames++) {
+    if(frames->a_len <= MAX_A_LEN && MIC_LEN_VALID(frames->mic_len)) {
+      init_state(&states[n++], frames);
+    }
+    if(n == CCM_STAR_BATCH_FRAMES || (count == 1 && n > 0)) {
+      run(states, n, forward);
+      n = 0;
+    }
   }
 }
 /*---------------------------------------------------------------------------*/
 const struct ccm_star_driver ccm_star_driver = {
   set_key,
-  aead
+  aead,
+  init_context,
+  set_context,
+  aead_frames
 };
 /*---------------------------------------------------------------------------*/
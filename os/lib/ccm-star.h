@@ -41,6 +41,7 @@
 #define CCM_STAR_H_
 
 #include "contiki.h"
+#include "lib/aes-128.h"
 
 #ifdef CCM_STAR_CONF
 #define CCM_STAR CCM_STAR_CONF
@@ -50,6 +51,27 @@
 
 #define CCM_STAR_NONCE_LENGTH 13
 
+/* The number of frames of aead_frames() that the default implementation
+ * interleaves. Each takes about 100 bytes of stack. */
+#ifdef CCM_STAR_CONF_BATCH_FRAMES
+#define CCM_STAR_BATCH_FRAMES CCM_STAR_CONF_BATCH_FRAMES
+#else /* CCM_STAR_CONF_BATCH_FRAMES */
+#define CCM_STAR_BATCH_FRAMES 1
+#endif /* CCM_STAR_CONF_BATCH_FRAMES */
+
+/**
+ * A frame of aead_frames(), with the parameters of aead().
+ */
+struct ccm_star_frame {
+  const uint8_t *nonce;
+  uint8_t *m;
+  uint16_t m_len;
+  const uint8_t *a;
+  uint16_t a_len;
+  uint8_t *result;
+  uint8_t mic_len;
+};
+
 /**
  * Structure of CCM* drivers.
  */
@@ -75,6 +97,28 @@ struct ccm_star_driver {
       const uint8_t* a, uint16_t a_len,
       uint8_t *result, uint8_t mic_len,
       int forward);
+
+  /**
+   * \brief         Prepares a context for a key. Default implementation calls AES_128.init_context().
+   * \param context The context to prepare.
+   * \param key     The key of the context.
+   */
+  void (* init_context)(struct aes_128_context *context, const uint8_t *key);
+
+  /**
+   * \brief         Sets the key in use to the key of a context, without preparing it again. Default implementation calls AES_128.set_context().
+   * \param context A context prepared with init_context(). It must remain unchanged as long as it is in use.
+   */
+  void (* set_context)(const struct aes_128_context *context);
+
+  /**
+   * \brief         Combines authentication and encryption of several frames with the key in use, as aead() does for each of them. Default implementation interleaves up to CCM_STAR_BATCH_FRAMES frames.
+   * \param frames  The frames.
+   * \param count   The number of frames.
+   * \param forward != 0 if used in forward direction.
+   */
+  void (* aead_frames)(const struct ccm_star_frame *frames, uint8_t count,
+      int forward);
 };
 
 extern const struct ccm_star_driver CCM_STAR;
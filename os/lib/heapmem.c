@@ -75,7 +75,8 @@
  * The HEAPMEM_CONF_SEARCH_MAX parameter limits the time spent on
  * chunk allocation and defragmentation. The lower this number is, the
  * faster the operations become. The cost of this speedup, however, is
- * that the space overhead might increase.
+ * that the space overhead might increase. With size classes, it only
+ * limits the search for a chunk when the heap is nearly full.
  */
 #ifdef HEAPMEM_CONF_SEARCH_MAX
 #define CHUNK_SEARCH_MAX HEAPMEM_CONF_SEARCH_MAX
@@ -103,6 +104,36 @@
 #define HEAPMEM_ALIGNMENT sizeof(int)
 #endif /* HEAPMEM_CONF_ALIGNMENT */
 
+/*
+ * The HEAPMEM_CONF_SIZE_CLASSES parameter selects an allocator that
+ * keeps free chunks in segregated lists, one per size class, in the
+ * manner of the Two-Level Segregated Fit (TLSF) allocator. Finding a
+ * free chunk, and coalescing a freed chunk with its neighbors, then
+ * take constant time, regardless of how fragmented the heap is.
+ * Allocated chunks have the same header as with the default allocator.
+ * Free chunks use the links of their header for their free list, and
+ * end with a pointer to themselves as a boundary tag, so no chunk is
+ * smaller than a pointer. The other cost is a table of list heads,
+ * whose size grows with the logarithm of the arena size.
+ */
+#ifdef HEAPMEM_CONF_SIZE_CLASSES
+#define HEAPMEM_SIZE_CLASSES HEAPMEM_CONF_SIZE_CLASSES
+#else
+#define HEAPMEM_SIZE_CLASSES 0
+#endif /* HEAPMEM_CONF_SIZE_CLASSES */
+
+/*
+ * The HEAPMEM_CONF_SIZE_CLASS_BITS parameter sets into how many size
+ * classes (1 << bits) each power-of-two range of chunk sizes is
+ * divided. More classes waste less memory when rounding requests up
+ * to a class, but use a larger table of list heads. At most 5.
+ */
+#ifdef HEAPMEM_CONF_SIZE_CLASS_BITS
+#define SIZE_CLASS_BITS HEAPMEM_CONF_SIZE_CLASS_BITS
+#else
+#define SIZE_CLASS_BITS 3
+#endif /* HEAPMEM_CONF_SIZE_CLASS_BITS */
+
 #define ALIGN(size)						\
   (((size) + (HEAPMEM_ALIGNMENT - 1)) & ~(HEAPMEM_ALIGNMENT - 1))
 
@@ -149,7 +180,9 @@ static char heap_base[HEAPMEM_ARENA_SIZE] CC_ALIGN(HEAPMEM_ALIGNMENT);
 static size_t heap_usage;
 
 static chunk_t *first_chunk = (chunk_t *)heap_base;
-static chunk_t *free_list;
+
+/* The number of allocation requests that could not be satisfied. */
+static size_t alloc_failures;
 
 /* extend_space: Increases the current footprint used in the heap, and
    returns a pointer to the old end. */
@@ -168,6 +201,297 @@ extend_space(size_t size)
   return old_usage;
 }
 
+#if HEAPMEM_SIZE_CLASSES
+/*
+ * Free chunks are kept in lists indexed by a first-level class, which
+ * is the power of two below the chunk size, and a second-level class,
+ * which divides that range linearly into SL_COUNT classes. Chunks
+ * smaller than SMALL_SIZE all belong to the first first-level class,
+ * which is divided in steps of the alignment. A bitmap of non-empty
+ * lists at each level makes the search for a chunk constant-time.
+ */
+
+/* Floor of the binary logarithm of a constant, for array sizes. */
+#define LOG2_2(x)  ((x) >= 2 ? 1 : 0)
+#define LOG2_4(x)  ((x) >= 4 ? 2 + LOG2_2((x) >> 2) : LOG2_2(x))
+#define LOG2_8(x)  ((x) >= 16 ? 4 + LOG2_4((x) >> 4) : LOG2_4(x))
+#define LOG2_16(x) ((x) >= 256 ? 8 + LOG2_8((x) >> 8) : LOG2_8(x))
+#define LOG2_32(x) ((x) >= 65536UL ? 16 + LOG2_16((x) >> 16) : LOG2_16(x))
+
+#define SL_COUNT   (1 << SIZE_CLASS_BITS)
+#define ALIGN_LOG2 LOG2_32(HEAPMEM_ALIGNMENT)
+#define FL_SHIFT   (SIZE_CLASS_BITS + ALIGN_LOG2)
+#define SMALL_SIZE ((size_t)1 << FL_SHIFT)
+#define FL_COUNT							\
+  (LOG2_32(HEAPMEM_ARENA_SIZE) >= FL_SHIFT ?				\
+   LOG2_32(HEAPMEM_ARENA_SIZE) - FL_SHIFT + 2 : 1)
+
+static chunk_t *free_lists[FL_COUNT][SL_COUNT];
+static uint32_t fl_bitmap;
+static uint32_t sl_bitmap[FL_COUNT];
+
+/*
+ * A free chunk ends with a pointer to itself, and the chunk following
+ * it has the CHUNK_FLAG_LEFT_FREE flag set. This lets a chunk that is
+ * being freed find a free chunk to its left in constant time. Hence,
+ * a chunk must be large enough to hold that pointer.
+ */
+#define CHUNK_FLAG_LEFT_FREE 0x2
+#define MIN_CHUNK_SIZE ALIGN(sizeof(chunk_t *))
+
+/* log2_floor: Return the index of the most significant bit set. */
+static unsigned
+log2_floor(size_t x)
+{
+#ifdef __GNUC__
+  return sizeof(unsigned long) * 8 - 1 - __builtin_clzl(x);
+#else
+  unsigned n;
+
+  for(n = 0; x > 1; x >>= 1) {
+    n++;
+  }
+  return n;
+#endif
+}
+
+/* lowest_bit: Return the index of the least significant bit set. */
+static unsigned
+lowest_bit(uint32_t x)
+{
+#ifdef __GNUC__
+  return __builtin_ctzl(x);
+#else
+  unsigned n;
+
+  for(n = 0; (x & 1) == 0; x >>= 1) {
+    n++;
+  }
+  return n;
+#endif
+}
+
+/* mapping: Find the size class that a chunk of a given size belongs to. */
+static void
+mapping(size_t size, unsigned *fl, unsigned *sl)
+{
+  unsigned msb;
+
+  if(size < SMALL_SIZE) {
+    *fl = 0;
+    *sl = size >> ALIGN_LOG2;
+  } else {
+    msb = log2_floor(size);
+    *fl = msb - FL_SHIFT + 1;
+    *sl = (size >> (msb - SIZE_CLASS_BITS)) & (SL_COUNT - 1);
+  }
+}
+
+/* insert_free: Put a chunk on the free list of its size class. */
+static void
+insert_free(chunk_t * const chunk)
+{
+  unsigned fl, sl;
+
+  mapping(chunk->size, &fl, &sl);
+  chunk->prev = NULL;
+  chunk->next = free_lists[fl][sl];
+  if(chunk->next != NULL) {
+    chunk->next->prev = chunk;
+  }
+  free_lists[fl][sl] = chunk;
+  fl_bitmap |= (uint32_t)1 << fl;
+  sl_bitmap[fl] |= (uint32_t)1 << sl;
+}
+
+/* remove_free: Take a chunk off the free list of its size class. */
+static void
+remove_free(chunk_t * const chunk)
+{
+  unsigned fl, sl;
+
+  mapping(chunk->size, &fl, &sl);
+  if(chunk->prev != NULL) {
+    chunk->prev->next = chunk->next;
+  } else {
+    free_lists[fl][sl] = chunk->next;
+    if(chunk->next == NULL) {
+      sl_bitmap[fl] &= ~((uint32_t)1 << sl);
+      if(sl_bitmap[fl] == 0) {
+        fl_bitmap &= ~((uint32_t)1 << fl);
+      }
+    }
+  }
+  if(chunk->next != NULL) {
+    chunk->next->prev = chunk->prev;
+  }
+}
+
+/*
+ * free_chunk: Mark a chunk as being free, merge it with the free
+ * chunks on either side of it, and put the result on a free list. A
+ * free chunk at the end of the heap is released into the wilderness.
+ * Hence, two free chunks are never adjacent, and the last chunk is
+ * always allocated.
+ */
+static void
+free_chunk(chunk_t *chunk)
+{
+  chunk_t *neighbor;
+
+  chunk->flags &= ~CHUNK_FLAG_ALLOCATED;
+
+  if(!IS_LAST_CHUNK(chunk)) {
+    neighbor = NEXT_CHUNK(chunk);
+    if(CHUNK_FREE(neighbor)) {
+      remove_free(neighbor);
+      chunk->size += sizeof(chunk_t) + neighbor->size;
+    }
+  }
+
+  if(chunk->flags & CHUNK_FLAG_LEFT_FREE) {
+    memcpy(&neighbor, (char *)chunk - sizeof(chunk_t *), sizeof(neighbor));
+    remove_free(neighbor);
+    neighbor->size += sizeof(chunk_t) + chunk->size;
+    chunk = neighbor;
+  }
+
+  if(IS_LAST_CHUNK(chunk)) {
+    heap_usage -= sizeof(chunk_t) + chunk->size;
+  } else {
+    memcpy(GET_PTR(chunk) + chunk->size - sizeof(chunk_t *), &chunk,
+           sizeof(chunk));
+    NEXT_CHUNK(chunk)->flags |= CHUNK_FLAG_LEFT_FREE;
+    insert_free(chunk);
+  }
+}
+
+/* allocate_chunk: Take a chunk off its free list and mark it as
+   being allocated. */
+static void
+allocate_chunk(chunk_t * const chunk)
+{
+  remove_free(chunk);
+  chunk->flags = CHUNK_FLAG_ALLOCATED;
+  /* Free chunks are never last. */
+  NEXT_CHUNK(chunk)->flags &= ~CHUNK_FLAG_LEFT_FREE;
+}
+
+/*
+ * split_chunk: Keep the part of an allocated chunk beyond the offset
+ * free, if it is large enough to hold a chunk of its own.
+ */
+static void
+split_chunk(chunk_t * const chunk, size_t offset)
+{
+  chunk_t *new_chunk;
+
+  offset = ALIGN(offset);
+  if(offset < MIN_CHUNK_SIZE) {
+    offset = MIN_CHUNK_SIZE;
+  }
+
+  if(offset + sizeof(chunk_t) + MIN_CHUNK_SIZE <= chunk->size) {
+    new_chunk = (chunk_t *)(GET_PTR(chunk) + offset);
+    new_chunk->size = chunk->size - sizeof(chunk_t) - offset;
+    new_chunk->flags = CHUNK_FLAG_ALLOCATED;
+    chunk->size = offset;
+    free_chunk(new_chunk);
+  }
+}
+
+/* coalesce_chunks: Extend an allocated chunk with the free chunk that
+   follows it, if any. */
+static void
+coalesce_chunks(chunk_t *chunk)
+{
+  chunk_t *next;
+
+  if(CHUNK_FREE(chunk) || IS_LAST_CHUNK(chunk)) {
+    /* Free chunks are already coalesced. */
+    return;
+  }
+
+  next = NEXT_CHUNK(chunk);
+  if(CHUNK_FREE(next)) {
+    allocate_chunk(next);
+    chunk->size += sizeof(chunk_t) + next->size;
+  }
+}
+
+/*
+ * find_free_chunk: Find a chunk in the smallest non-empty size class
+ * that is at least as large as the given one, if any.
+ */
+static chunk_t *
+find_free_chunk(unsigned fl, unsigned sl)
+{
+  uint32_t map;
+
+  map = sl_bitmap[fl] & (~(uint32_t)0 << sl);
+  if(map == 0) {
+    /* Look at the larger first-level classes. */
+    map = fl + 1 < FL_COUNT ? fl_bitmap & (~(uint32_t)0 << (fl + 1)) : 0;
+    if(map == 0) {
+      return NULL;
+    }
+    fl = lowest_bit(map);
+    map = sl_bitmap[fl];
+  }
+  return free_lists[fl][lowest_bit(map)];
+}
+
+/*
+ * get_free_chunk: Find a free chunk to satisfy an allocation request.
+ *
+ * The first chunk in the size class of the request is used if it is
+ * large enough. Otherwise, the size is rounded up to the next size
+ * class, so that any chunk in the class found is large enough. When
+ * no such chunk exists, the caller will try to extend the heap. Only
+ * if this fails too do we search, with a bounded effort, the rest of
+ * the free list of the size class of the request.
+ */
+static chunk_t *
+get_free_chunk(const size_t size, int last_resort)
+{
+  unsigned fl, sl;
+  chunk_t *chunk;
+  int i;
+
+  mapping(size, &fl, &sl);
+  if(fl >= FL_COUNT) {
+    /* Larger than any chunk can be. */
+    return NULL;
+  }
+
+  chunk = free_lists[fl][sl];
+  if(last_resort) {
+    i = CHUNK_SEARCH_MAX;
+    while(chunk != NULL && chunk->size < size) {
+      if(--i == 0) {
+        return NULL;
+      }
+      chunk = chunk->next;
+    }
+  } else if(chunk == NULL || chunk->size < size) {
+    if(size >= SMALL_SIZE) {
+      mapping(size + ((size_t)1 << (log2_floor(size) - SIZE_CLASS_BITS)) - 1,
+              &fl, &sl);
+    }
+    chunk = fl < FL_COUNT ? find_free_chunk(fl, sl) : NULL;
+  }
+
+  if(chunk != NULL) {
+    allocate_chunk(chunk);
+    split_chunk(chunk, size);
+  }
+
+  return chunk;
+}
+#else /* HEAPMEM_SIZE_CLASSES */
+
+static chunk_t *free_list;
+
 /* free_chunk: Mark a chunk as being free, and put it on the free list. */
 static void
 free_chunk(chunk_t * const chunk)
@@ -268,11 +592,16 @@ defrag_chunks(void)
 /* get_free_chunk: Search the free list for the most suitable chunk, as
    determined by its size, to satisfy an allocation request. */
 static chunk_t *
-get_free_chunk(const size_t size)
+get_free_chunk(const size_t size, int last_resort)
 {
   int i;
   chunk_t *chunk, *best;
 
+  if(last_resort) {
+    /* The whole search is done at the first attempt. */
+    return NULL;
+  }
+
   /* Defragment chunks only right before they are needed for allocation. */
   defrag_chunks();
 
@@ -307,6 +636,7 @@ get_free_chunk(const size_t size)
 
   return best;
 }
+#endif /* HEAPMEM_SIZE_CLASSES */
 
 /*
  * heapmem_alloc: Allocate an object of the specified size, returning
@@ -321,6 +651,9 @@ get_free_chunk(const size_t size)
  *
  * As a last resort, heapmem_alloc() will try to extend the heap
  * space, and thereby create a new chunk available for use.
+ *
+ * With size classes, the chunk is instead taken from the smallest
+ * non-empty size class that fits the request, in constant time.
  */
 void *
 #if HEAPMEM_DEBUG
@@ -333,18 +666,29 @@ heapmem_alloc(size_t size)
 
   /* Fail early on too large allocation requests to prevent wrapping values. */
   if(size > HEAPMEM_ARENA_SIZE) {
+    alloc_failures++;
     return NULL;
   }
 
   size = ALIGN(size);
+#if HEAPMEM_SIZE_CLASSES
+  if(size < MIN_CHUNK_SIZE) {
+    size = MIN_CHUNK_SIZE;
+  }
+#endif
 
-  chunk = get_free_chunk(size);
+  chunk = get_free_chunk(size, 0);
   if(chunk == NULL) {
     chunk = extend_space(sizeof(chunk_t) + size);
-    if(chunk == NULL) {
-      return NULL;
+    if(chunk != NULL) {
+      chunk->size = size;
+    } else {
+      chunk = get_free_chunk(size, 1);
+      if(chunk == NULL) {
+        alloc_failures++;
+        return NULL;
+      }
     }
-    chunk->size = size;
   }
 
   chunk->flags = CHUNK_FLAG_ALLOCATED;
@@ -495,6 +839,20 @@ heapmem_realloc(void *ptr, size_t size)
 }
 #endif /* HEAPMEM_REALLOC */
 
+/* stats_class: Determine the statistics size class of a chunk. */
+static unsigned
+stats_class(size_t size)
+{
+  unsigned class;
+
+  for(class = 0; class < HEAPMEM_STATS_CLASSES - 1; class++) {
+    if(size < (16UL << class)) {
+      break;
+    }
+  }
+  return class;
+}
+
 /* heapmem_stats: Calculate statistics regarding memory usage. */
 void
 heapmem_stats(heapmem_stats_t *stats)
@@ -508,13 +866,24 @@ heapmem_stats(heapmem_stats_t *stats)
       chunk = NEXT_CHUNK(chunk)) {
     if(CHUNK_ALLOCATED(chunk)) {
       stats->allocated += chunk->size;
+      stats->class_allocated[stats_class(chunk->size)]++;
     } else {
       coalesce_chunks(chunk);
       stats->available += chunk->size;
+      stats->free_chunks++;
+      stats->class_free[stats_class(chunk->size)]++;
+      if(chunk->size > stats->max_available) {
+        stats->max_available = chunk->size;
+      }
     }
     stats->overhead += sizeof(chunk_t);
   }
   stats->available += HEAPMEM_ARENA_SIZE - heap_usage;
+  if(HEAPMEM_ARENA_SIZE - heap_usage >= sizeof(chunk_t) &&
+     HEAPMEM_ARENA_SIZE - heap_usage - sizeof(chunk_t) > stats->max_available) {
+    stats->max_available = HEAPMEM_ARENA_SIZE - heap_usage - sizeof(chunk_t);
+  }
   stats->footprint = heap_usage;
   stats->chunks = stats->overhead / sizeof(chunk_t);
+  stats->failures = alloc_failures;
 }
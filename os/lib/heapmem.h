@@ -47,6 +47,10 @@
  * adds some memory overhead compared to a single-linked list, it
  * improves the performance of list management.
  *
+ * When HEAPMEM_CONF_SIZE_CLASSES is set, free chunks are instead kept
+ * in one list per size class, which bounds the time of allocations
+ * and deallocations regardless of fragmentation.
+ *
  * Internally, allocated chunks can be retrieved using the pointer to
  * the allocated memory returned by heapmem_alloc() and
  * heapmem_realloc(), because the chunk structure immediately precedes
@@ -76,12 +80,28 @@
 
 #include <stdlib.h>
 
+/*
+ * The number of size classes in the statistics. Class 0 holds chunks
+ * smaller than 16 bytes, class n > 0 holds chunks of 8 << n to
+ * (16 << n) - 1 bytes, and the last class holds all larger chunks.
+ */
+#define HEAPMEM_STATS_CLASSES 10
+
 typedef struct heapmem_stats {
   size_t allocated;
   size_t overhead;
   size_t available;
   size_t footprint;
   size_t chunks;
+  /* The number of free chunks. */
+  size_t free_chunks;
+  /* The largest allocation that can currently succeed. */
+  size_t max_available;
+  /* The number of failed allocations since boot. */
+  size_t failures;
+  /* The number of allocated and free chunks per size class. */
+  size_t class_allocated[HEAPMEM_STATS_CLASSES];
+  size_t class_free[HEAPMEM_STATS_CLASSES];
 } heapmem_stats_t;
 
 #if HEAPMEM_DEBUG
@@ -156,6 +176,8 @@ void heapmem_free(void *ptr);
  * the amount of memory allocated, overhead used for memory management,
  * and the number of chunks allocated. By using this information, developers
  * can tune their software to use the heapmem allocator more efficiently.
+ * The per-class chunk counts, and the largest possible allocation,
+ * show how fragmented the heap is.
  *
  */
 
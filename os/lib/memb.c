@@ -47,54 +47,99 @@
 #include "contiki.h"
 #include "lib/memb.h"
 
+#define NUM_WORDS(m) (((m)->num + MEMB_WORD_BITS - 1) / MEMB_WORD_BITS)
+#define BIT(i) (1U << ((i) % MEMB_WORD_BITS))
+/*---------------------------------------------------------------------------*/
+/* Return the index of the lowest bit that is set in a word. */
+static unsigned
+lowest_bit(unsigned word)
+{
+#ifdef __GNUC__
+  return __builtin_ctz(word);
+#else
+  unsigned i;
+
+  for(i = 0; (word & 1) == 0; word >>= 1) {
+    i++;
+  }
+  return i;
+#endif
+}
 /*---------------------------------------------------------------------------*/
 void
 memb_init(struct memb *m)
 {
-  memset(m->used, 0, m->num);
+  memset(m->used, 0, NUM_WORDS(m) * sizeof(unsigned));
   memset(m->mem, 0, m->size * m->num);
+  m->hint = 0;
+  m->count = 0;
+#if MEMB_STATS
+  m->peak = 0;
+#endif
 }
 /*---------------------------------------------------------------------------*/
 void *
 memb_alloc(struct memb *m)
 {
+  unsigned w;
   int i;
 
-  for(i = 0; i < m->num; ++i) {
-    if(m->used[i] == false) {
-      /* If this block was unused, we set the used flag on
-	 and return a pointer to the memory block. */
-      m->used[i] = true;
+  /* Find the first word of the bitmap with a free block. Blocks are
+     allocated lowest first, as before the bitmap was introduced. */
+  for(w = m->hint; w < NUM_WORDS(m); w++) {
+    if(~m->used[w] != 0) {
+      i = w * MEMB_WORD_BITS + lowest_bit(~m->used[w]);
+      if(i >= m->num) {
+        /* Only the unused bits of the last word are clear. */
+        break;
+      }
+      /* Set the used flag of the block and return a pointer to it. */
+      m->used[w] |= BIT(i);
+      m->hint = w;
+      m->count++;
+#if MEMB_STATS
+      if(m->count > m->peak) {
+        m->peak = m->count;
+      }
+#endif
       return (void *)((char *)m->mem + (i * m->size));
     }
   }
 
   /* No free block was found, so we return NULL to indicate failure to
      allocate block. */
+  m->hint = w;
   return NULL;
 }
 /*---------------------------------------------------------------------------*/
 int
 memb_free(struct memb *m, void *ptr)
 {
+  size_t offset;
   int i;
-  char *ptr2;
 
-  /* Walk through the list of blocks and try to find the block to
-     which the pointer "ptr" points to. */
-  ptr2 = (char *)m->mem;
-  for(i = 0; i < m->num; ++i) {
-    if(ptr2 == (char *)ptr) {
-      /* We've found the block to which "ptr" points, so we check the allocation
-         status to detect the double-free error and free the block. */
-      if (m->used[i] == false)
-        return -1;
-      m->used[i] = false;
-      return 0;
-    }
-    ptr2 += m->size;
+  if(!memb_inmemb(m, ptr)) {
+    return -1;
+  }
+
+  /* Find the block to which "ptr" points. */
+  offset = (char *)ptr - (char *)m->mem;
+  if(offset % m->size != 0) {
+    return -1;
+  }
+  i = offset / m->size;
+
+  /* Check the allocation status to detect the double-free error, and
+     free the block. */
+  if((m->used[i / MEMB_WORD_BITS] & BIT(i)) == 0) {
+    return -1;
   }
-  return -1;
+  m->used[i / MEMB_WORD_BITS] &= ~BIT(i);
+  m->count--;
+  if(i / MEMB_WORD_BITS < m->hint) {
+    m->hint = i / MEMB_WORD_BITS;
+  }
+  return 0;
 }
 /*---------------------------------------------------------------------------*/
 int
@@ -107,15 +152,14 @@ memb_inmemb(struct memb *m, void *ptr)
 int
 memb_numfree(struct memb *m)
 {
-  int i;
-  int num_free = 0;
-
-  for(i = 0; i < m->num; ++i) {
-    if(m->used[i] == false) {
-      ++num_free;
-    }
-  }
-
-  return num_free;
+  return m->num - m->count;
+}
+/*---------------------------------------------------------------------------*/
+#if MEMB_STATS
+int
+memb_peak(struct memb *m)
+{
+  return m->peak;
 }
+#endif /* MEMB_STATS */
 /** @} */
@@ -48,6 +48,10 @@
  * memory by the memb_alloc() function, and are deallocated with the
  * memb_free() function.
  *
+ * The allocation status of the blocks is kept in a bitmap, so that a
+ * free block is found a machine word at a time, and a block is freed
+ * in constant time.
+ *
  * @{
  */
 
@@ -66,6 +70,22 @@
 #include <stdbool.h>
 #include "sys/cc.h"
 
+/**
+ * \brief Track the peak number of blocks in use in each memory block
+ *
+ * When enabled, memb_peak() returns the largest number of blocks of a
+ * pool that have been allocated at the same time since memb_init(),
+ * which is useful to size the pools of an application.
+ */
+#ifdef MEMB_CONF_STATS
+#define MEMB_STATS MEMB_CONF_STATS
+#else
+#define MEMB_STATS 0
+#endif /* MEMB_CONF_STATS */
+
+/** The number of blocks whose status is kept in a bitmap word */
+#define MEMB_WORD_BITS (sizeof(unsigned) * 8)
+
 /**
  * Declare a memory block.
  *
@@ -88,7 +108,8 @@ MEMB(connections, struct connection, 16);
  *
  */
 #define MEMB(name, structure, num) \
-        static bool CC_CONCAT(name,_memb_used)[num]; \
+        static unsigned CC_CONCAT(name,_memb_used)[((num) + MEMB_WORD_BITS - 1) / \
+                                                   MEMB_WORD_BITS]; \
         static structure CC_CONCAT(name,_memb_mem)[num]; \
         static struct memb name = {sizeof(structure), num, \
                                           CC_CONCAT(name,_memb_used), \
@@ -97,8 +118,14 @@ MEMB(connections, struct connection, 16);
 struct memb {
   unsigned short size;
   unsigned short num;
-  bool *used;
+  unsigned *used;
   void *mem;
+  /* The rest is zero-initialized by MEMB(), which is a valid state. */
+  unsigned short hint;  /* No free block in the bitmap words before this */
+  unsigned short count; /* Blocks in use */
+#if MEMB_STATS
+  unsigned short peak;
+#endif
 };
 
 /**
@@ -149,6 +176,18 @@ int memb_inmemb(struct memb *m, void *ptr);
  */
 int  memb_numfree(struct memb *m);
 
+#if MEMB_STATS
+/**
+ * Get the peak usage of memory blocks
+ *
+ * \param m m A set of memory blocks previously declared with MEMB().
+ *
+ * \return the largest number of blocks that have been allocated at
+ * the same time since memb_init()
+ */
+int  memb_peak(struct memb *m);
+#endif /* MEMB_STATS */
+
 /** @} */
 /** @} */
 
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *         Random streams: independent xoshiro128** generators, seeded
+ *         from a shared seed and the ID of each stream.
+ */
+
+#include "contiki.h"
+#include "lib/random.h"
+
+/*
+ * The seed of the streams until random_seed() is called, if
+ * random_rand() draws from the streams itself.
+ */
+#ifdef RANDOM_CONF_SEED
+#define RANDOM_SEED RANDOM_CONF_SEED
+#else
+#define RANDOM_SEED 1
+#endif
+
+static uint32_t seed = RANDOM_SEED;
+/* Changes with the seed, so that streams start over. Zero until the
+   seed is set. */
+static uint8_t epoch;
+
+RANDOM_STREAM(default_stream, RANDOM_STREAM_DEFAULT);
+/*---------------------------------------------------------------------------*/
+static uint32_t
+rotl(uint32_t x, int k)
+{
+  return (x << k) | (x >> (32 - k));
+}
+/*---------------------------------------------------------------------------*/
+static uint64_t
+splitmix64(uint64_t *x)
+{
+  uint64_t z = (*x += 0x9e3779b97f4a7c15ULL);
+
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+/*---------------------------------------------------------------------------*/
+static void
+seed_stream(struct random_stream *stream)
+{
+  uint64_t x;
+  uint64_t z;
+
+  if(epoch == 0) {
+    /* When random_rand() draws from the default stream, that stream is
+       seeded with RANDOM_SEED first. */
+    epoch = 1;
+    random_seed(((uint32_t)random_rand() << 16) | random_rand());
+  }
+
+  x = ((uint64_t)stream->id << 32) | seed;
+  z = splitmix64(&x);
+  stream->s[0] = (uint32_t)z;
+  stream->s[1] = (uint32_t)(z >> 32);
+  z = splitmix64(&x);
+  stream->s[2] = (uint32_t)z;
+  stream->s[3] = (uint32_t)(z >> 32);
+  stream->epoch = epoch;
+}
+/*---------------------------------------------------------------------------*/
+void
+random_seed(uint32_t s)
+{
+  seed = s;
+  if(++epoch == 0) {
+    epoch = 1;
+  }
+}
+/*---------------------------------------------------------------------------*/
+uint32_t
+random_stream_u32(struct random_stream *stream)
+{
+  uint32_t *s = stream->s;
+  uint32_t result;
+  uint32_t t;
+
+  if(stream->epoch != epoch || epoch == 0) {
+    seed_stream(stream);
+  }
+
+  result = rotl(s[1] * 5, 7) * 9;
+  t = s[1] << 9;
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = rotl(s[3], 11);
+
+  return result;
+}
+/*---------------------------------------------------------------------------*/
+uint64_t
+random_stream_u64(struct random_stream *stream)
+{
+  uint64_t high = random_stream_u32(stream);
+
+  return (high << 32) | random_stream_u32(stream);
+}
+/*---------------------------------------------------------------------------*/
+unsigned short
+random_stream_rand(struct random_stream *stream)
+{
+  /* The high bits are the best ones */
+  return random_stream_u32(stream) >> 16;
+}
+/*---------------------------------------------------------------------------*/
+float
+random_stream_float(struct random_stream *stream)
+{
+  /* As many bits as the mantissa holds */
+  return (random_stream_u32(stream) >> 8) * (1.0f / 16777216.0f);
+}
+/*---------------------------------------------------------------------------*/
+uint32_t
+random_u32(void)
+{
+  return random_stream_u32(&default_stream);
+}
+/*---------------------------------------------------------------------------*/
+uint64_t
+random_u64(void)
+{
+  return random_stream_u64(&default_stream);
+}
+/*---------------------------------------------------------------------------*/
+float
+random_float(void)
+{
+  return random_stream_float(&default_stream);
+}
+/*---------------------------------------------------------------------------*/
@@ -32,21 +32,17 @@
 
 
 #include "lib/random.h"
-#include <stdlib.h>
 
 /*---------------------------------------------------------------------------*/
 void
 random_init(unsigned short seed)
 {
-  srand(seed);
+  random_seed(seed);
 }
 /*---------------------------------------------------------------------------*/
 unsigned short
 random_rand(void)
 {
-/* In gcc int rand() uses RAND_MAX and long random() uses RANDOM_MAX=0x7FFFFFFF */
-/* RAND_MAX varies depending on the architecture */
-
-  return (unsigned short)rand();
+  return random_u32() >> 16;
 }
 /*---------------------------------------------------------------------------*/
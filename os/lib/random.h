@@ -32,9 +32,13 @@
 #ifndef RANDOM_H_
 #define RANDOM_H_
 
+#include <stdint.h>
+
 /*
  * Initialize the pseudo-random generator.
  *
+ * The seed also seeds the random streams, so that a run can be
+ * reproduced from it.
  */
 void random_init(unsigned short seed);
 
@@ -45,8 +49,56 @@ void random_init(unsigned short seed);
  */
 unsigned short random_rand(void);
 
-/* In gcc int rand() uses RAND_MAX and long random() uses RANDOM_MAX */
-/* Since random_rand casts to unsigned short, we'll use this maxmimum */
+/* The largest number that random_rand() returns */
 #define RANDOM_RAND_MAX 65535U
 
+/*
+ * Random streams
+ *
+ * A random stream is an independent xoshiro128** generator. Modules that
+ * draw random numbers at their own pace, such as the MAC layer, Trickle
+ * timers, the routing protocol and applications, each use a stream of
+ * their own, so that the numbers that one of them draws do not change
+ * the numbers of the others.
+ *
+ * The state of a stream is derived from its ID and from a seed shared
+ * by all streams. The seed is set by random_seed(), which random_init()
+ * calls on platforms that use the default generator. On other platforms,
+ * the seed is drawn from random_rand() when a stream is first used.
+ */
+struct random_stream {
+  uint32_t s[4];
+  uint16_t id;
+  uint8_t epoch;
+};
+
+/* Stream IDs. Applications use IDs from RANDOM_STREAM_APP. */
+#define RANDOM_STREAM_DEFAULT  0
+#define RANDOM_STREAM_MAC      1
+#define RANDOM_STREAM_TRICKLE  2
+#define RANDOM_STREAM_ROUTING  3
+#define RANDOM_STREAM_APP      16
+
+/* Define a stream, which is seeded when first used */
+#define RANDOM_STREAM(name, stream_id) \
+  static struct random_stream name = { { 0 }, (stream_id), 0 }
+
+/*
+ * Set the seed of all streams, which start over from it.
+ */
+void random_seed(uint32_t seed);
+
+/* A random number, uniformly distributed over the range of its type */
+uint32_t random_stream_u32(struct random_stream *stream);
+uint64_t random_stream_u64(struct random_stream *stream);
+/* A random number between 0 and RANDOM_RAND_MAX */
+unsigned short random_stream_rand(struct random_stream *stream);
+/* A random number in [0, 1) */
+float random_stream_float(struct random_stream *stream);
+
+/* The same, from the default stream */
+uint32_t random_u32(void);
+uint64_t random_u64(void);
+float random_float(void);
+
 #endif /* RANDOM_H_ */
@@ -61,10 +61,12 @@
  * (see ::TRICKLE_TIMER_WIDE_RAND)
  */
 #if TRICKLE_TIMER_WIDE_RAND
-#define tt_rand() wide_rand()
+#define tt_rand() random_stream_u32(&trickle_random)
 #else
-#define tt_rand() random_rand()
+#define tt_rand() random_stream_rand(&trickle_random)
 #endif
+
+RANDOM_STREAM(trickle_random, RANDOM_STREAM_TRICKLE);
 /*---------------------------------------------------------------------------*/
 /* Declarations of variables of local interest */
 /*---------------------------------------------------------------------------*/
@@ -76,15 +78,6 @@ static void double_interval(void *ptr);
 /*---------------------------------------------------------------------------*/
 /* Local utilities and functions to be used as ctimer callbacks */
 /*---------------------------------------------------------------------------*/
-#if TRICKLE_TIMER_WIDE_RAND
-/* Returns a 4-byte wide, unsigned random number */
-static uint32_t
-wide_rand(void)
-{
-  return (uint32_t)random_rand() << 16 | random_rand();
-}
-#endif
-/*---------------------------------------------------------------------------*/
 /*
  * Returns the maximum sane Imax value for a given Imin
  *
@@ -59,10 +59,12 @@
  * -Add stateless multicast option
  */
 
+#include <stddef.h>
 #include <string.h>
 
 #include "contiki.h"
 #include "dev/watchdog.h"
+#include "lib/list.h"
 #include "net/link-stats.h"
 #include "net/ipv6/uipopt.h"
 #include "net/ipv6/tcpip.h"
@@ -195,6 +197,47 @@ static int last_tx_status;
 
 static int last_rssi;
 
+static void send_packet(linkaddr_t *dest);
+
+/*---------------------------------------------------------------------------*/
+/* Copy the transmission attributes of the packet in uip_buf to packetbuf */
+static void
+set_mac_attrs(void)
+{
+  /* copy over the retransmission count from uipbuf attributes */
+  packetbuf_set_attr(PACKETBUF_ATTR_MAX_MAC_TRANSMISSIONS,
+                     uipbuf_get_attr(UIPBUF_ATTR_MAX_MAC_TRANSMISSIONS));
+#if LLSEC802154_USES_AUX_HEADER
+  /* copy LLSEC level */
+  packetbuf_set_attr(PACKETBUF_ATTR_SECURITY_LEVEL,
+    uipbuf_get_attr(UIPBUF_ATTR_LLSEC_LEVEL));
+#if LLSEC802154_USES_EXPLICIT_KEYS
+  packetbuf_set_attr(PACKETBUF_ATTR_KEY_INDEX,
+    uipbuf_get_attr(UIPBUF_ATTR_LLSEC_KEY_ID));
+#endif /* LLSEC802154_USES_EXPLICIT_KEYS */
+#endif /*  LLSEC802154_USES_AUX_HEADER */
+}
+/*---------------------------------------------------------------------------*/
+/* Copy the reception attributes of the packet in packetbuf to uipbuf */
+static void
+set_uipbuf_attrs(void)
+{
+  uipbuf_set_attr(UIPBUF_ATTR_RSSI, packetbuf_attr(PACKETBUF_ATTR_RSSI));
+  uipbuf_set_attr(UIPBUF_ATTR_LINK_QUALITY, packetbuf_attr(PACKETBUF_ATTR_LINK_QUALITY));
+#if LLSEC802154_USES_AUX_HEADER
+  /*
+   * Assuming that the last packet in packetbuf is containing
+   *  the LLSEC state so that it can be copied to uipbuf.
+   */
+  uipbuf_set_attr(UIPBUF_ATTR_LLSEC_LEVEL,
+    packetbuf_attr(PACKETBUF_ATTR_SECURITY_LEVEL));
+#if LLSEC802154_USES_EXPLICIT_KEYS
+  uipbuf_set_attr(UIPBUF_ATTR_LLSEC_KEY_ID,
+    packetbuf_attr(PACKETBUF_ATTR_KEY_INDEX));
+#endif /* LLSEC802154_USES_EXPLICIT_KEYS */
+#endif /*  LLSEC802154_USES_AUX_HEADER */
+}
+
 /* ----------------------------------------------------------------- */
 /* Support for reassembling multiple packets                         */
 /* ----------------------------------------------------------------- */
@@ -213,14 +256,41 @@ static uint16_t my_tag;
 #endif
 
 /* REASS_CONTEXTS corresponds to the number of simultaneous
- * reassemblies that can be made. NOTE: the first buffer for each
- * reassembly is stored in the context since it can be larger than the
- * rest of the fragments due to header compression.
+ * reassemblies that can be made. NOTE: the fragments of all the
+ * reassemblies, including the first ones, are stored in the fragment
+ * buffers, which are shared between them.
  **/
 #ifdef SICSLOWPAN_CONF_REASS_CONTEXTS
 #define SICSLOWPAN_REASS_CONTEXTS SICSLOWPAN_CONF_REASS_CONTEXTS
 #else
-#define SICSLOWPAN_REASS_CONTEXTS 2
+#define SICSLOWPAN_REASS_CONTEXTS 4
+#endif
+
+/* The number of buckets of the index of the reassembly contexts by
+   sender and tag */
+#ifdef SICSLOWPAN_CONF_REASS_HASH_SIZE
+#define SICSLOWPAN_REASS_HASH_SIZE SICSLOWPAN_CONF_REASS_HASH_SIZE
+#else
+#define SICSLOWPAN_REASS_HASH_SIZE SICSLOWPAN_REASS_CONTEXTS
+#endif
+
+/* Forward the fragments of packets routed through this node as they
+   arrive, without reassembling the packets first (RFC 8930). Only
+   the first fragment is passed to the IP layer, to find the next
+   hop. */
+#ifdef SICSLOWPAN_CONF_FRAG_FORWARDING
+#define SICSLOWPAN_FRAG_FORWARDING SICSLOWPAN_CONF_FRAG_FORWARDING
+#else
+#define SICSLOWPAN_FRAG_FORWARDING 0
+#endif
+
+#if SICSLOWPAN_FRAG_FORWARDING && !UIP_CONF_ROUTER
+#error SICSLOWPAN_CONF_FRAG_FORWARDING requires UIP_CONF_ROUTER
+#endif
+
+/* Contexts and buffers are referred to with 8-bit indices */
+#if SICSLOWPAN_FRAGMENT_BUFFERS > 255 || SICSLOWPAN_REASS_CONTEXTS > 255
+#error Too many SICSLOWPAN_FRAGMENT_BUFFERS or SICSLOWPAN_REASS_CONTEXTS set.
 #endif
 
 /* The size of each fragment (IP payload) for the 6lowpan fragmentation */
@@ -239,215 +309,514 @@ static uint16_t my_tag;
 /* Assuming that the worst growth for uncompression is 38 bytes */
 #define SICSLOWPAN_FIRST_FRAGMENT_SIZE (SICSLOWPAN_FRAGMENT_SIZE + 38)
 
+/* The uncompressed first fragment is stored in pieces of this size,
+   which keeps them aligned on the 8-byte units of fragment offsets */
+#define SICSLOWPAN_FIRST_FRAGMENT_CHUNK (SICSLOWPAN_FRAGMENT_SIZE & ~7)
+
+/* One bit for each 8-byte unit of a packet */
+#define REASS_BITMAP_SIZE ((UIP_BUFSIZE + 63) / 64)
+
 /* all information needed for reassembly */
 struct sicslowpan_frag_info {
+  /** The next context in use, in the order they were created */
+  struct sicslowpan_frag_info *next;
   /** When reassembling, the source address of the fragments being merged */
   linkaddr_t sender;
-  /** The destination address of the fragments being merged */
-  linkaddr_t receiver;
   /** When reassembling, the tag in the fragments being merged. */
   uint16_t tag;
-  /** Total length of the fragmented packet */
+  /** Total length of the fragmented packet, 0 if the context is free */
   uint16_t len;
   /** Current length of reassembled fragments */
   uint16_t reassembled_len;
   /** Reassembly %process %timer. */
   struct timer reass_timer;
-
-  /** Fragment size of first fragment */
-  uint16_t first_frag_len;
-  /** First fragment - needs a larger buffer since the size is uncompressed size
-   and we need to know total size to know when we have received last fragment. */
-  uint8_t first_frag[SICSLOWPAN_FIRST_FRAGMENT_SIZE];
+  /** Index + 1 of the next context in the same hash bucket */
+  uint8_t hash_next;
+  /** Index + 1 of the first fragment buffer of the context */
+  uint8_t frags;
+  /** The packet was dropped. The context is kept until it times out,
+      so that the rest of its fragments are dropped on arrival. */
+  uint8_t dropped;
+  /** The 8-byte units of the packet received so far */
+  uint8_t received[REASS_BITMAP_SIZE];
+#if SICSLOWPAN_FRAG_FORWARDING
+  /** The packet is forwarded, its fragments are sent to this neighbor
+      with this tag */
+  uint8_t forwarding;
+  uint16_t fwd_tag;
+  linkaddr_t fwd_to;
+#endif /* SICSLOWPAN_FRAG_FORWARDING */
 };
 
 static struct sicslowpan_frag_info frag_info[SICSLOWPAN_REASS_CONTEXTS];
+/* The contexts in use, oldest first. They all have the same lifetime,
+   so this is also the order in which they time out. */
+LIST(frag_info_list);
+static uint8_t frag_info_hash[SICSLOWPAN_REASS_HASH_SIZE];
 
 struct sicslowpan_frag_buf {
-  /* the index of the frag_info */
-  uint8_t index;
+  /* Index + 1 of the next buffer of the context, or of the free list */
+  uint8_t next;
   /* Fragment offset */
   uint8_t offset;
-  /* Length of this fragment (if zero this buffer is not allocated) */
+  /* Length of this fragment */
   uint8_t len;
   uint8_t data[SICSLOWPAN_FRAGMENT_SIZE];
 };
 
 static struct sicslowpan_frag_buf frag_buf[SICSLOWPAN_FRAGMENT_BUFFERS];
+static uint8_t free_frag_bufs;
+static uint8_t used_frag_bufs;
+
+/* A first fragment is uncompressed here before it is stored */
+static uint8_t first_frag[SICSLOWPAN_FIRST_FRAGMENT_SIZE];
+
+#if SICSLOWPAN_FRAG_FORWARDING
+/* The context of the packet whose first fragment is in uip_buf */
+static struct sicslowpan_frag_info *fwd_info;
+#endif /* SICSLOWPAN_FRAG_FORWARDING */
+
+struct sicslowpan_reass_stats sicslowpan_reass_stats;
 
 /*---------------------------------------------------------------------------*/
-static int
-clear_fragments(uint8_t frag_info_index)
+static void
+reass_init(void)
 {
-  int i, clear_count;
-  clear_count = 0;
-  frag_info[frag_info_index].len = 0;
-  for(i = 0; i < SICSLOWPAN_FRAGMENT_BUFFERS; i++) {
-    if(frag_buf[i].len > 0 && frag_buf[i].index == frag_info_index) {
-      /* deallocate the buffer */
-      frag_buf[i].len = 0;
-      clear_count++;
-    }
+  int i;
+
+  list_init(frag_info_list);
+  memset(frag_info_hash, 0, sizeof(frag_info_hash));
+  for(i = 0; i < SICSLOWPAN_REASS_CONTEXTS; i++) {
+    frag_info[i].len = 0;
+  }
+  free_frag_bufs = 0;
+  used_frag_bufs = 0;
+  for(i = SICSLOWPAN_FRAGMENT_BUFFERS - 1; i >= 0; i--) {
+    frag_buf[i].next = free_frag_bufs;
+    free_frag_bufs = i + 1;
   }
-  return clear_count;
 }
 /*---------------------------------------------------------------------------*/
-static int
-timeout_fragments(int not_context)
+static uint8_t *
+frag_info_bucket(const linkaddr_t *sender, uint16_t tag)
 {
+  uint16_t h = tag;
   int i;
-  int count = 0;
-  for(i = 0; i < SICSLOWPAN_REASS_CONTEXTS; i++) {
-    if(frag_info[i].len > 0 && i != not_context &&
-       timer_expired(&frag_info[i].reass_timer)) {
-      /* This context can be freed */
-      count += clear_fragments(i);
+
+  for(i = 0; i < LINKADDR_SIZE; i++) {
+    h = h * 31 + sender->u8[i];
+  }
+  return &frag_info_hash[h % SICSLOWPAN_REASS_HASH_SIZE];
+}
+/*---------------------------------------------------------------------------*/
+static struct sicslowpan_frag_info *
+find_frag_info(const linkaddr_t *sender, uint16_t tag)
+{
+  struct sicslowpan_frag_info *info;
+  uint8_t i;
+
+  for(i = *frag_info_bucket(sender, tag); i != 0; i = info->hash_next) {
+    info = &frag_info[i - 1];
+    if(info->tag == tag && linkaddr_cmp(&info->sender, sender)) {
+      return info;
     }
   }
-  return count;
+  return NULL;
 }
 /*---------------------------------------------------------------------------*/
-static int
-store_fragment(uint8_t index, uint8_t offset)
+/* Return the buffers of a context to the pool */
+static void
+clear_fragments(struct sicslowpan_frag_info *info)
+{
+  uint8_t i;
+  uint8_t next;
+
+  for(i = info->frags; i != 0; i = next) {
+    next = frag_buf[i - 1].next;
+    frag_buf[i - 1].next = free_frag_bufs;
+    free_frag_bufs = i;
+    used_frag_bufs--;
+  }
+  info->frags = 0;
+}
+/*---------------------------------------------------------------------------*/
+/* Drop the packet, but keep the context until it times out */
+static void
+drop_fragments(struct sicslowpan_frag_info *info)
+{
+  clear_fragments(info);
+  info->dropped = 1;
+}
+/*---------------------------------------------------------------------------*/
+static void
+free_frag_info(struct sicslowpan_frag_info *info)
 {
+  uint8_t *p;
+
+  clear_fragments(info);
+  for(p = frag_info_bucket(&info->sender, info->tag); *p != 0;
+      p = &frag_info[*p - 1].hash_next) {
+    if(&frag_info[*p - 1] == info) {
+      *p = info->hash_next;
+      break;
+    }
+  }
+  list_remove(frag_info_list, info);
+  info->len = 0;
+}
+/*---------------------------------------------------------------------------*/
+static void
+timeout_fragments(void)
+{
+  struct sicslowpan_frag_info *info;
+
+  while((info = list_head(frag_info_list)) != NULL &&
+        timer_expired(&info->reass_timer)) {
+    if(!info->dropped) {
+      LOG_WARN("reassembly: timeout - tag: %d\n", info->tag);
+      sicslowpan_reass_stats.timeouts++;
+    }
+    free_frag_info(info);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static struct sicslowpan_frag_info *
+new_frag_info(const linkaddr_t *sender, uint16_t tag, uint16_t len)
+{
+  struct sicslowpan_frag_info *info = NULL;
+  uint8_t *bucket;
   int i;
-  int len;
 
-  len = packetbuf_datalen() - packetbuf_hdr_len;
+  for(i = 0; i < SICSLOWPAN_REASS_CONTEXTS; i++) {
+    if(frag_info[i].len == 0) {
+      info = &frag_info[i];
+      break;
+    }
+  }
+  if(info == NULL) {
+    /* Reuse the context of a dropped packet, but never one that is
+       still being reassembled */
+    for(info = list_head(frag_info_list);
+        info != NULL && !info->dropped;
+        info = list_item_next(info));
+    if(info == NULL) {
+      return NULL;
+    }
+    free_frag_info(info);
+  }
 
-  if(len <= 0 || len > SICSLOWPAN_FRAGMENT_SIZE) {
-    /* Unacceptable fragment size. */
+  linkaddr_copy(&info->sender, sender);
+  info->tag = tag;
+  info->len = len;
+  info->reassembled_len = 0;
+  info->frags = 0;
+  info->dropped = 0;
+  memset(info->received, 0, sizeof(info->received));
+#if SICSLOWPAN_FRAG_FORWARDING
+  info->forwarding = 0;
+#endif /* SICSLOWPAN_FRAG_FORWARDING */
+  timer_set(&info->reass_timer, SICSLOWPAN_REASS_MAXAGE * CLOCK_SECOND / 16);
+  bucket = frag_info_bucket(sender, tag);
+  info->hash_next = *bucket;
+  *bucket = info - frag_info + 1;
+  list_add(frag_info_list, info);
+  return info;
+}
+/*---------------------------------------------------------------------------*/
+/* Record that the bytes [offset, offset + len) of the packet were
+   received. Returns 1 if none of them was received before, 0 if all of
+   them were, and -1 if the fragment overlaps with others. */
+static int
+mark_received(struct sicslowpan_frag_info *info, uint16_t offset, uint16_t len)
+{
+  uint16_t first = offset >> 3;
+  uint16_t last = (offset + len - 1) >> 3;
+  uint16_t unit;
+  uint16_t seen = 0;
+
+  for(unit = first; unit <= last; unit++) {
+    if(info->received[unit >> 3] & (1 << (unit & 7))) {
+      seen++;
+    }
+  }
+  if(seen == last - first + 1) {
+    return 0;
+  }
+  if(seen > 0) {
     return -1;
   }
-
-  for(i = 0; i < SICSLOWPAN_FRAGMENT_BUFFERS; i++) {
-    if(frag_buf[i].len == 0) {
-      /* copy over the data from packetbuf into the fragment buffer,
-         and store offset and len */
-      frag_buf[i].offset = offset; /* frag offset */
-      frag_buf[i].len = len;
-      frag_buf[i].index = index;
-      memcpy(frag_buf[i].data, packetbuf_ptr + packetbuf_hdr_len, len);
-      /* return the length of the stored fragment */
-      return len;
+  for(unit = first; unit <= last; unit++) {
+    info->received[unit >> 3] |= 1 << (unit & 7);
+  }
+  info->reassembled_len += len;
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+/* Store len bytes of the packet, from offset. If the pool is empty,
+   the oldest other packet being reassembled is dropped: as the
+   fragments of a packet are sent back to back, it is the one most
+   likely to have lost a fragment. */
+static bool
+store_fragment(struct sicslowpan_frag_info *info, uint16_t offset,
+               const uint8_t *data, uint8_t len)
+{
+  struct sicslowpan_frag_info *other;
+  struct sicslowpan_frag_buf *buf;
+
+  if(free_frag_bufs == 0) {
+    for(other = list_head(frag_info_list); other != NULL;
+        other = list_item_next(other)) {
+      if(other != info && other->frags != 0) {
+        LOG_WARN("reassembly: evicting packet - tag: %d\n", other->tag);
+        drop_fragments(other);
+        sicslowpan_reass_stats.evictions++;
+        break;
+      }
     }
+    if(free_frag_bufs == 0) {
+      LOG_WARN("reassembly: failed to store fragment - packet reassembly will fail tag:%d\n",
+               info->tag);
+      drop_fragments(info);
+      sicslowpan_reass_stats.evictions++;
+      return false;
+    }
+  }
+
+  buf = &frag_buf[free_frag_bufs - 1];
+  free_frag_bufs = buf->next;
+  if(++used_frag_bufs > sicslowpan_reass_stats.max_buffers) {
+    sicslowpan_reass_stats.max_buffers = used_frag_bufs;
   }
-  /* failed */
-  return -1;
+  buf->offset = offset >> 3;
+  buf->len = len;
+  memcpy(buf->data, data, len);
+  buf->next = info->frags;
+  info->frags = buf - frag_buf + 1;
+  return true;
+}
+#if SICSLOWPAN_FRAG_FORWARDING
+/*---------------------------------------------------------------------------*/
+/* Send a subsequent fragment of a forwarded packet to the next hop. The
+   data may be in packetbuf. */
+static void
+forward_fragment(struct sicslowpan_frag_info *info, uint16_t offset,
+                 const uint8_t *data, uint8_t len)
+{
+  packetbuf_clear();
+  packetbuf_ptr = packetbuf_dataptr();
+  memmove(packetbuf_ptr + SICSLOWPAN_FRAGN_HDR_LEN, data, len);
+  SET16(PACKETBUF_FRAG_PTR, PACKETBUF_FRAG_DISPATCH_SIZE,
+        ((SICSLOWPAN_DISPATCH_FRAGN << 8) | info->len));
+  SET16(PACKETBUF_FRAG_PTR, PACKETBUF_FRAG_TAG, info->fwd_tag);
+  PACKETBUF_FRAG_PTR[PACKETBUF_FRAG_OFFSET] = offset >> 3;
+  packetbuf_set_datalen(SICSLOWPAN_FRAGN_HDR_LEN + len);
+  set_mac_attrs();
+
+  LOG_INFO("forwarding: fragment (tag %d -> %d, offset %d)\n",
+           info->tag, info->fwd_tag, offset);
+  send_packet(&info->fwd_to);
 }
 /*---------------------------------------------------------------------------*/
-/* add a new fragment to the buffer */
-static int8_t
+/* Returns true if the packet of the context is forwarded. Once all of
+   its fragments were forwarded, the context is kept until it times
+   out, so that duplicates of the fragments are dropped. */
+static bool
+fragment_forwarded(struct sicslowpan_frag_info *info)
+{
+  if(!info->forwarding) {
+    return false;
+  }
+  if(info->reassembled_len >= info->len) {
+    drop_fragments(info);
+    sicslowpan_reass_stats.forwarded++;
+  }
+  return true;
+}
+#endif /* SICSLOWPAN_FRAG_FORWARDING */
+/*---------------------------------------------------------------------------*/
+/* Find or create the reassembly context of a fragment, and store the
+   payload if this is not the first fragment. The first fragment is
+   stored by store_first_fragment() once it is uncompressed. Returns
+   NULL if the fragment is dropped. */
+static struct sicslowpan_frag_info *
 add_fragment(uint16_t tag, uint16_t frag_size, uint8_t offset)
 {
-  int i;
+  struct sicslowpan_frag_info *info;
+  const linkaddr_t *sender = packetbuf_addr(PACKETBUF_ADDR_SENDER);
   int len;
-  int8_t found = -1;
 
-  if(offset == 0) {
-    /* This is a first fragment - check if we can add this */
-    for(i = 0; i < SICSLOWPAN_REASS_CONTEXTS; i++) {
-      /* clear all fragment info with expired timer to free all fragment buffers */
-      if(frag_info[i].len > 0 && timer_expired(&frag_info[i].reass_timer)) {
-        clear_fragments(i);
-      }
+  timeout_fragments();
 
-      /* We use len as indication on used or not used */
-      if(found < 0 && frag_info[i].len == 0) {
-        /* We remember the first free fragment info but must continue
-           the loop to free any other expired fragment buffers. */
-        found = i;
-      }
+  info = find_frag_info(sender, tag);
+  if(info == NULL) {
+    if(frag_size == 0 || frag_size > UIP_BUFSIZE) {
+      LOG_WARN("reassembly: invalid total size of fragments - tag: %d\n", tag);
+      return NULL;
     }
-
-    if(found < 0) {
+    info = new_frag_info(sender, tag, frag_size);
+    if(info == NULL) {
       LOG_WARN("reassembly: failed to store new fragment session - tag: %d\n", tag);
-      return -1;
+      sicslowpan_reass_stats.no_context++;
+      return NULL;
     }
+  }
 
-    /* Found a free fragment info to store data in */
-    frag_info[found].len = frag_size;
-    frag_info[found].tag = tag;
-    linkaddr_copy(&frag_info[found].sender,
-                  packetbuf_addr(PACKETBUF_ADDR_SENDER));
-    timer_set(&frag_info[found].reass_timer, SICSLOWPAN_REASS_MAXAGE * CLOCK_SECOND / 16);
-    /* first fragment can not be stored immediately but is moved into
-       the buffer while uncompressing */
-    return found;
+  if(info->dropped) {
+    return NULL;
+  }
+  if(info->len != frag_size) {
+    LOG_WARN("reassembly: fragments disagree on the size - tag: %d\n", tag);
+    drop_fragments(info);
+    sicslowpan_reass_stats.overlaps++;
+    return NULL;
   }
 
-  /* This is a N-fragment - should find the info */
-  for(i = 0; i < SICSLOWPAN_REASS_CONTEXTS; i++) {
-    if(frag_info[i].tag == tag && frag_info[i].len > 0 &&
-       linkaddr_cmp(&frag_info[i].sender, packetbuf_addr(PACKETBUF_ADDR_SENDER))) {
-      /* Tag and Sender match - this must be the correct info to store in */
-      found = i;
-      break;
+  if(offset == 0) {
+    /* Only a first fragment covers the first 8 bytes */
+    if(info->received[0] & 1) {
+      sicslowpan_reass_stats.duplicates++;
+      return NULL;
     }
+    return info;
   }
 
-  if(found < 0) {
-    /* no entry found for storing the new fragment */
-    LOG_WARN("reassembly: failed to store N-fragment - could not find session - tag: %d offset: %d\n", tag, offset);
-    return -1;
+  len = packetbuf_datalen() - packetbuf_hdr_len;
+  if(len <= 0 || len > SICSLOWPAN_FRAGMENT_SIZE ||
+     (offset << 3) + len > info->len) {
+    LOG_WARN("reassembly: invalid fragment - tag: %d offset: %d\n", tag, offset);
+    return NULL;
   }
 
-  /* i is the index of the reassembly context */
-  len = store_fragment(i, offset);
-  if(len < 0 && timeout_fragments(i) > 0) {
-    len = store_fragment(i, offset);
+  switch(mark_received(info, offset << 3, len)) {
+  case 0:
+    sicslowpan_reass_stats.duplicates++;
+    return NULL;
+  case -1:
+    LOG_WARN("reassembly: overlapping fragment - tag: %d offset: %d\n", tag, offset);
+    drop_fragments(info);
+    sicslowpan_reass_stats.overlaps++;
+    return NULL;
   }
-  if(len > 0) {
-    frag_info[i].reassembled_len += len;
-    return i;
-  } else {
-    /* should we also clear all fragments since we failed to store
-       this fragment? */
-    LOG_WARN("reassembly: failed to store fragment - packet reassembly will fail tag:%d l\n", frag_info[i].tag);
-    return -1;
+
+#if SICSLOWPAN_FRAG_FORWARDING
+  if(info->forwarding) {
+    forward_fragment(info, offset << 3, packetbuf_ptr + packetbuf_hdr_len, len);
+    return info;
+  }
+#endif /* SICSLOWPAN_FRAG_FORWARDING */
+  if(!store_fragment(info, offset << 3, packetbuf_ptr + packetbuf_hdr_len, len)) {
+    return NULL;
   }
+  return info;
 }
 /*---------------------------------------------------------------------------*/
-/* Copy all the fragments that are associated with a specific context
-   into uip */
+/* Record the reception of the uncompressed first fragment */
 static bool
-copy_frags2uip(int context)
+mark_first_fragment(struct sicslowpan_frag_info *info, uint16_t len)
 {
-  int i;
-
-  /* Check length fields before proceeding. */
-  if(frag_info[context].len < frag_info[context].first_frag_len ||
-     frag_info[context].len > sizeof(uip_buf)) {
+  if(len == 0 || len > info->len) {
     LOG_WARN("input: invalid total size of fragments\n");
-    clear_fragments(context);
+    drop_fragments(info);
     return false;
   }
+  if(mark_received(info, 0, len) < 0) {
+    LOG_WARN("reassembly: overlapping first fragment - tag: %d\n", info->tag);
+    drop_fragments(info);
+    sicslowpan_reass_stats.overlaps++;
+    return false;
+  }
+  return true;
+}
+/*---------------------------------------------------------------------------*/
+/* Store the uncompressed first fragment, which is in first_frag */
+static bool
+store_first_fragment(struct sicslowpan_frag_info *info, uint16_t len)
+{
+  uint16_t offset;
+  uint8_t chunk;
 
-  /* Copy from the fragment context info buffer first */
-  memcpy((uint8_t *)UIP_IP_BUF, (uint8_t *)frag_info[context].first_frag,
-         frag_info[context].first_frag_len);
-
-  /* Ensure that no previous data is used for reassembly in case of missing fragments. */
-  memset((uint8_t *)UIP_IP_BUF + frag_info[context].first_frag_len, 0,
-         frag_info[context].len - frag_info[context].first_frag_len);
-
-  for(i = 0; i < SICSLOWPAN_FRAGMENT_BUFFERS; i++) {
-    /* And also copy all matching fragments */
-    if(frag_buf[i].len > 0 && frag_buf[i].index == context) {
-      if((frag_buf[i].offset << 3) + frag_buf[i].len > sizeof(uip_buf)) {
-        LOG_WARN("input: invalid fragment offset\n");
-        clear_fragments(context);
-        return false;
-      }
-      memcpy((uint8_t *)UIP_IP_BUF + (uint16_t)(frag_buf[i].offset << 3),
-             (uint8_t *)frag_buf[i].data, frag_buf[i].len);
+  for(offset = 0; offset < len; offset += chunk) {
+    chunk = MIN(len - offset, SICSLOWPAN_FIRST_FRAGMENT_CHUNK);
+    if(!store_fragment(info, offset, first_frag + offset, chunk)) {
+      return false;
     }
   }
-  /* deallocate all the fragments for this context */
-  clear_fragments(context);
+  return true;
+}
+/*---------------------------------------------------------------------------*/
+/* Copy all the fragments of a complete packet into uip, and free its
+   context */
+static void
+copy_frags2uip(struct sicslowpan_frag_info *info)
+{
+  struct sicslowpan_frag_buf *buf;
+  uint8_t i;
+
+  /* The bounds of every fragment were checked against the size of the
+     packet, which fits in uip_buf */
+  for(i = info->frags; i != 0; i = buf->next) {
+    buf = &frag_buf[i - 1];
+    memcpy((uint8_t *)UIP_IP_BUF + (uint16_t)(buf->offset << 3),
+           buf->data, buf->len);
+  }
+  free_frag_info(info);
+  sicslowpan_reass_stats.reassembled++;
+}
+#if SICSLOWPAN_FRAG_FORWARDING
+/*---------------------------------------------------------------------------*/
+/* Pass the uncompressed first fragment, in first_frag, to the IP layer
+   to forward it. If it is forwarded, output() sets up the context to
+   forward the other fragments. Returns false if the packet is to be
+   reassembled instead. */
+static bool
+forward_first_fragment(struct sicslowpan_frag_info *info, uint16_t len)
+{
+  struct uip_ip_hdr *hdr = (struct uip_ip_hdr *)first_frag;
+  struct sicslowpan_frag_buf *buf;
+  uint8_t result;
+  uint8_t i;
+
+  /* Only unicast packets routed through this node are forwarded. The
+     IP layer has the final say, e.g. on packets with a routing header
+     where this node is the last hop. */
+  if(len >= info->len || len < UIP_IPH_LEN ||
+     uip_is_addr_mcast(&hdr->destipaddr) ||
+     uip_is_addr_linklocal(&hdr->destipaddr) ||
+     (uip_ds6_is_my_addr(&hdr->destipaddr) &&
+      uipbuf_search_header(first_frag, len, UIP_PROTO_ROUTING) == NULL)) {
+    return false;
+  }
 
+  memcpy(UIP_IP_BUF, first_frag, len);
+  uip_len = len;
+  fwd_info = info;
+  uip_fragment_fwd = UIP_FRAGMENT_FWD_TRY;
+  tcpip_input();
+  result = uip_fragment_fwd;
+  uip_fragment_fwd = UIP_FRAGMENT_FWD_NONE;
+  fwd_info = NULL;
+
+  if(info->forwarding) {
+    /* Send the fragments that arrived before the first one */
+    for(i = info->frags; i != 0; i = buf->next) {
+      buf = &frag_buf[i - 1];
+      forward_fragment(info, buf->offset << 3, buf->data, buf->len);
+    }
+    clear_fragments(info);
+    fragment_forwarded(info);
+    return true;
+  }
+  if(result == UIP_FRAGMENT_FWD_REASSEMBLE) {
+    /* The IP layer dropped the fragment and cleared the attributes */
+    uipbuf_clear();
+    set_uipbuf_attrs();
+    return false;
+  }
+  /* The IP layer dropped the packet */
+  drop_fragments(info);
   return true;
 }
+#endif /* SICSLOWPAN_FRAG_FORWARDING */
 #endif /* SICSLOWPAN_CONF_FRAG */
 
 /* -------------------------------------------------------------------------- */
@@ -515,6 +884,37 @@ addr_contexts[SICSLOWPAN_CONF_MAX_ADDR_CONTEXTS];
 /** pointer to an address context. */
 static struct sicslowpan_addr_context *context;
 
+/** Number of IPv6 headers whose compression is cached, for the flows
+    that send to the same destination over and over */
+#ifdef SICSLOWPAN_CONF_IPHC_CACHE_SIZE
+#define SICSLOWPAN_IPHC_CACHE_SIZE SICSLOWPAN_CONF_IPHC_CACHE_SIZE
+#else /* SICSLOWPAN_CONF_IPHC_CACHE_SIZE */
+#define SICSLOWPAN_IPHC_CACHE_SIZE 2
+#endif /* SICSLOWPAN_CONF_IPHC_CACHE_SIZE */
+
+#if SICSLOWPAN_IPHC_CACHE_SIZE > 0
+/* The longest compressed IPv6 header: dispatch bytes, context
+   identifiers, traffic class and flow label, next header, hop limit
+   and both addresses inline */
+#define IPHC_CACHE_HDR_LEN (2 + 1 + 4 + 1 + 1 + 16 + 16)
+/* The fields of the IPv6 header that determine its compression are
+   the ones before and after the payload length */
+#define IPHC_CACHE_TCFLOW_LEN (offsetof(struct uip_ip_hdr, len))
+#define IPHC_CACHE_ADDR_LEN (UIP_IPH_LEN - offsetof(struct uip_ip_hdr, proto))
+
+struct iphc_cache_entry {
+  struct uip_ip_hdr ip_hdr;
+  linkaddr_t link_destaddr;
+  uint8_t hdr_len; /* 0 if the entry is unused */
+  uint8_t hdr[IPHC_CACHE_HDR_LEN];
+};
+
+static struct iphc_cache_entry iphc_cache[SICSLOWPAN_IPHC_CACHE_SIZE];
+static uint8_t iphc_cache_next;
+/* The link-layer address the cached headers were compressed with */
+static uip_lladdr_t iphc_cache_lladdr;
+#endif /* SICSLOWPAN_IPHC_CACHE_SIZE > 0 */
+
 /** pointer to the byte where to write next inline field. */
 static uint8_t *iphc_ptr;
 
@@ -647,73 +1047,17 @@ uncompress_addr(uip_ipaddr_t *ipaddr, uint8_t const prefix[],
 
 /*--------------------------------------------------------------------*/
 /**
- * \brief Compress IP/UDP header
- *
- * This function is called by the 6lowpan code to create a compressed
- * 6lowpan packet in the packetbuf buffer from a full IPv6 packet in the
- * uip_buf buffer.
- *
- *
- * IPHC (RFC 6282)\n
- * http://tools.ietf.org/html/
- *
- * \note We do not support ISA100_UDP header compression
- *
- * For LOWPAN_UDP compression, we either compress both ports or none.
- * General format with LOWPAN_UDP compression is
- * \verbatim
- *                      1                   2                   3
- *  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
- * +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
- * |0|1|1|TF |N|HLI|C|S|SAM|M|D|DAM| SCI   | DCI   | comp. IPv6 hdr|
- * +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
- * | compressed IPv6 fields .....                                  |
- * +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
- * | LOWPAN_UDP    | non compressed UDP fields ...                 |
- * +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
- * | L4 data ...                                                   |
- * +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
- * \endverbatim
- * \note The context number 00 is reserved for the link local prefix.
- * For unicast addresses, if we cannot compress the prefix, we neither
- * compress the IID.
+ * \brief Compress the IPv6 header in uip_buf, without its extension
+ * headers, into the IPHC dispatch bytes and inline fields at
+ * PACKETBUF_IPHC_BUF. iphc_ptr is moved from the byte after the
+ * dispatch bytes to the end of the inline fields.
  * \param link_destaddr L2 destination address, needed to compress IP
  * dest
- * \return 1 if success, else 0
  */
-static int
-compress_hdr_iphc(linkaddr_t *link_destaddr)
+static void
+compress_ipv6_hdr(linkaddr_t *link_destaddr)
 {
-  uint8_t tmp, iphc0, iphc1, *next_hdr, *next_nhc;
-  int ext_hdr_len;
-  struct uip_udp_hdr *udp_buf;
-
-  if(LOG_DBG_ENABLED) {
-    uint16_t ndx;
-    LOG_DBG("compression: before (%d): ", UIP_IP_BUF->len[1]);
-    for(ndx = 0; ndx < UIP_IP_BUF->len[1] + 40; ndx++) {
-      uint8_t data = ((uint8_t *) (UIP_IP_BUF))[ndx];
-      LOG_DBG_("%02x", data);
-    }
-    LOG_DBG_("\n");
-  }
-
-/* Macro used only internally, during header compression. Checks if there
- * is sufficient space in packetbuf before writing any further. */
-#define CHECK_BUFFER_SPACE(writelen) do { \
-  if(iphc_ptr + (writelen) >= PACKETBUF_PAYLOAD_END) { \
-    LOG_WARN("Not enough packetbuf space to compress header (%u bytes, %u left). Aborting.\n", \
-                (unsigned)(writelen), (unsigned)(PACKETBUF_PAYLOAD_END - iphc_ptr)); \
-    return 0; \
-  } \
-} while(0);
-
-  iphc_ptr = PACKETBUF_IPHC_BUF + 2;
-
-  /* Check if there is enough space for the compressed IPv6 header, in the
-   * worst case (least compressed case). Extension headers and transport
-   * layer will be checked when they are compressed. */
-  CHECK_BUFFER_SPACE(38);
+  uint8_t tmp, iphc0, iphc1;
 
   /*
    * As we copy some bit-length fields, in the IPHC encoding bytes,
@@ -907,6 +1251,145 @@ compress_hdr_iphc(linkaddr_t *link_destaddr)
     }
   }
 
+  PACKETBUF_IPHC_BUF[0] = iphc0;
+  PACKETBUF_IPHC_BUF[1] = iphc1;
+}
+#if SICSLOWPAN_IPHC_CACHE_SIZE > 0
+/*--------------------------------------------------------------------*/
+/* Empty the cache, as the compression of every header may change */
+static void
+iphc_cache_flush(void)
+{
+  uint8_t i;
+
+  for(i = 0; i < SICSLOWPAN_IPHC_CACHE_SIZE; i++) {
+    iphc_cache[i].hdr_len = 0;
+  }
+  memcpy(&iphc_cache_lladdr, &uip_lladdr, sizeof(iphc_cache_lladdr));
+}
+/*--------------------------------------------------------------------*/
+/* Copy the cached compression of the IPv6 header in uip_buf, if any,
+   to PACKETBUF_IPHC_BUF. Returns false if it is not cached. */
+static bool
+iphc_cache_lookup(const linkaddr_t *link_destaddr)
+{
+  struct iphc_cache_entry *e;
+  uint8_t i;
+
+  /* The source address may be derived from the link-layer address */
+  if(memcmp(&iphc_cache_lladdr, &uip_lladdr, sizeof(iphc_cache_lladdr)) != 0) {
+    iphc_cache_flush();
+    return false;
+  }
+
+  for(i = 0; i < SICSLOWPAN_IPHC_CACHE_SIZE; i++) {
+    e = &iphc_cache[i];
+    if(e->hdr_len != 0 &&
+       memcmp(&e->ip_hdr, UIP_IP_BUF, IPHC_CACHE_TCFLOW_LEN) == 0 &&
+       memcmp(&e->ip_hdr.proto, &UIP_IP_BUF->proto,
+              IPHC_CACHE_ADDR_LEN) == 0 &&
+       linkaddr_cmp(&e->link_destaddr, link_destaddr)) {
+      memcpy(PACKETBUF_IPHC_BUF, e->hdr, e->hdr_len);
+      iphc_ptr = PACKETBUF_IPHC_BUF + e->hdr_len;
+      return true;
+    }
+  }
+  return false;
+}
+/*--------------------------------------------------------------------*/
+/* Cache the compression of the IPv6 header in uip_buf, which was just
+   written to PACKETBUF_IPHC_BUF, in place of the oldest entry */
+static void
+iphc_cache_add(const linkaddr_t *link_destaddr)
+{
+  struct iphc_cache_entry *e = &iphc_cache[iphc_cache_next];
+
+  iphc_cache_next = (iphc_cache_next + 1) % SICSLOWPAN_IPHC_CACHE_SIZE;
+  memcpy(&e->ip_hdr, UIP_IP_BUF, UIP_IPH_LEN);
+  linkaddr_copy(&e->link_destaddr, link_destaddr);
+  e->hdr_len = iphc_ptr - PACKETBUF_IPHC_BUF;
+  memcpy(e->hdr, PACKETBUF_IPHC_BUF, e->hdr_len);
+}
+#endif /* SICSLOWPAN_IPHC_CACHE_SIZE > 0 */
+/*--------------------------------------------------------------------*/
+/**
+ * \brief Compress IP/UDP header
+ *
+ * This function is called by the 6lowpan code to create a compressed
+ * 6lowpan packet in the packetbuf buffer from a full IPv6 packet in the
+ * uip_buf buffer.
+ *
+ *
+ * IPHC (RFC 6282)\n
+ * http://tools.ietf.org/html/
+ *
+ * \note We do not support ISA100_UDP header compression
+ *
+ * For LOWPAN_UDP compression, we either compress both ports or none.
+ * General format with LOWPAN_UDP compression is
+ * \verbatim
+ *                      1                   2                   3
+ *  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+ * +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ * |0|1|1|TF |N|HLI|C|S|SAM|M|D|DAM| SCI   | DCI   | comp. IPv6 hdr|
+ * +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ * | compressed IPv6 fields .....                                  |
+ * +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ * | LOWPAN_UDP    | non compressed UDP fields ...                 |
+ * +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ * | L4 data ...                                                   |
+ * +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ * \endverbatim
+ * \note The context number 00 is reserved for the link local prefix.
+ * For unicast addresses, if we cannot compress the prefix, we neither
+ * compress the IID.
+ * \param link_destaddr L2 destination address, needed to compress IP
+ * dest
+ * \return 1 if success, else 0
+ */
+static int
+compress_hdr_iphc(linkaddr_t *link_destaddr)
+{
+  uint8_t *next_hdr, *next_nhc;
+  int ext_hdr_len;
+  struct uip_udp_hdr *udp_buf;
+
+  if(LOG_DBG_ENABLED) {
+    uint16_t ndx;
+    LOG_DBG("compression: before (%d): ", UIP_IP_BUF->len[1]);
+    for(ndx = 0; ndx < UIP_IP_BUF->len[1] + 40; ndx++) {
+      uint8_t data = ((uint8_t *) (UIP_IP_BUF))[ndx];
+      LOG_DBG_("%02x", data);
+    }
+    LOG_DBG_("\n");
+  }
+
+/* Macro used only internally, during header compression. Checks if there
+ * is sufficient space in packetbuf before writing any further. */
+#define CHECK_BUFFER_SPACE(writelen) do { \
+  if(iphc_ptr + (writelen) >= PACKETBUF_PAYLOAD_END) { \
+    LOG_WARN("Not enough packetbuf space to compress header (%u bytes, %u left). Aborting.\n", \
+                (unsigned)(writelen), (unsigned)(PACKETBUF_PAYLOAD_END - iphc_ptr)); \
+    return 0; \
+  } \
+} while(0);
+
+  iphc_ptr = PACKETBUF_IPHC_BUF + 2;
+
+  /* Check if there is enough space for the compressed IPv6 header, in the
+   * worst case (least compressed case). Extension headers and transport
+   * layer will be checked when they are compressed. */
+  CHECK_BUFFER_SPACE(38);
+
+#if SICSLOWPAN_IPHC_CACHE_SIZE > 0
+  if(!iphc_cache_lookup(link_destaddr)) {
+    compress_ipv6_hdr(link_destaddr);
+    iphc_cache_add(link_destaddr);
+  }
+#else /* SICSLOWPAN_IPHC_CACHE_SIZE > 0 */
+  compress_ipv6_hdr(link_destaddr);
+#endif /* SICSLOWPAN_IPHC_CACHE_SIZE > 0 */
+
   uncomp_hdr_len = UIP_IPH_LEN;
 
   /* Start of ext hdr compression or UDP compression */
@@ -1031,9 +1514,6 @@ compress_hdr_iphc(linkaddr_t *link_destaddr)
     /* as the last EXT_HDR should be "uncompressed" and have the next there */
     LOG_DBG("compression: last header could is not compressed: %d\n", *next_hdr);
   }
-  /* before the packetbuf_hdr_len operation */
-  PACKETBUF_IPHC_BUF[0] = iphc0;
-  PACKETBUF_IPHC_BUF[1] = iphc1;
 
   if(LOG_DBG_ENABLED) {
     uint16_t ndx;
@@ -1618,10 +2098,30 @@ static uint8_t
 output(const linkaddr_t *localdest)
 {
   int frag_needed;
+  /* The length of the packet, of which uip_buf may only hold the first
+     fragment */
+  uint16_t datagram_len = uip_len;
 
   /* The MAC address of the destination of the packet */
   linkaddr_t dest;
 
+#if SICSLOWPAN_FRAG_FORWARDING
+  if(uip_len < uipbuf_get_len_field(UIP_IP_BUF) + UIP_IPH_LEN) {
+    datagram_len = uipbuf_get_len_field(UIP_IP_BUF) + UIP_IPH_LEN;
+    if(fwd_info == NULL) {
+      LOG_WARN("output: first fragment out of its forwarding context - dropping packet\n");
+      return 0;
+    }
+    if(datagram_len != fwd_info->len) {
+      /* The headers were changed on the way, e.g. by inserting a
+         routing header, so the fragments no longer line up */
+      LOG_INFO("output: packet size changed, reassembling it for forwarding\n");
+      uip_fragment_fwd = UIP_FRAGMENT_FWD_REASSEMBLE;
+      return 0;
+    }
+  }
+#endif /* SICSLOWPAN_FRAG_FORWARDING */
+
   /* init */
   uncomp_hdr_len = 0;
   packetbuf_hdr_len = 0;
@@ -1649,21 +2149,10 @@ output(const linkaddr_t *localdest)
 
   LOG_INFO("output: sending IPv6 packet with len %d\n", uip_len);
 
-  /* copy over the retransmission count from uipbuf attributes */
-  packetbuf_set_attr(PACKETBUF_ATTR_MAX_MAC_TRANSMISSIONS,
-                     uipbuf_get_attr(UIPBUF_ATTR_MAX_MAC_TRANSMISSIONS));
+  set_mac_attrs();
 
 /* Calculate NETSTACK_FRAMER's header length, that will be added in the NETSTACK_MAC */
   packetbuf_set_addr(PACKETBUF_ADDR_RECEIVER, &dest);
-#if LLSEC802154_USES_AUX_HEADER
-  /* copy LLSEC level */
-  packetbuf_set_attr(PACKETBUF_ATTR_SECURITY_LEVEL,
-    uipbuf_get_attr(UIPBUF_ATTR_LLSEC_LEVEL));
-#if LLSEC802154_USES_EXPLICIT_KEYS
-  packetbuf_set_attr(PACKETBUF_ATTR_KEY_INDEX,
-    uipbuf_get_attr(UIPBUF_ATTR_LLSEC_KEY_ID));
-#endif /* LLSEC802154_USES_EXPLICIT_KEYS */
-#endif /*  LLSEC802154_USES_AUX_HEADER */
 
   mac_max_payload = NETSTACK_MAC.max_payload();
 
@@ -1698,7 +2187,8 @@ output(const linkaddr_t *localdest)
 
   packetbuf_set_addr(PACKETBUF_ADDR_RECEIVER, &dest);
 
-  frag_needed = (int)uip_len - (int)uncomp_hdr_len + (int)packetbuf_hdr_len > mac_max_payload;
+  frag_needed = (int)uip_len - (int)uncomp_hdr_len + (int)packetbuf_hdr_len > mac_max_payload ||
+    datagram_len != uip_len;
   LOG_INFO("output: header len %d -> %d, total len %d -> %d, MAC max payload %d, frag_needed %d\n",
             uncomp_hdr_len, packetbuf_hdr_len,
             uip_len, uip_len - uncomp_hdr_len + packetbuf_hdr_len,
@@ -1764,11 +2254,18 @@ output(const linkaddr_t *localdest)
 
     /* Set FRAG1 header */
     SET16(PACKETBUF_FRAG_PTR, PACKETBUF_FRAG_DISPATCH_SIZE,
-          ((SICSLOWPAN_DISPATCH_FRAG1 << 8) | uip_len));
+          ((SICSLOWPAN_DISPATCH_FRAG1 << 8) | datagram_len));
     SET16(PACKETBUF_FRAG_PTR, PACKETBUF_FRAG_TAG, frag_tag);
 
     /* Set frag1 payload len. Was already caulcated earlier as frag1_payload */
     packetbuf_payload_len = frag1_payload;
+#if SICSLOWPAN_FRAG_FORWARDING
+    if(packetbuf_payload_len > total_payload) {
+      /* A forwarded first fragment may be shorter than what fits here,
+         and always ends on an 8-byte boundary */
+      packetbuf_payload_len = total_payload;
+    }
+#endif /* SICSLOWPAN_FRAG_FORWARDING */
 
     /* Copy payload from uIP and send fragment */
     /* Send fragment */
@@ -1779,12 +2276,21 @@ output(const linkaddr_t *localdest)
       return 0;
     }
 
+#if SICSLOWPAN_FRAG_FORWARDING
+    if(datagram_len != uip_len) {
+      /* The other fragments of the packet follow the first one */
+      fwd_info->forwarding = 1;
+      fwd_info->fwd_tag = frag_tag;
+      linkaddr_copy(&fwd_info->fwd_to, &dest);
+    }
+#endif /* SICSLOWPAN_FRAG_FORWARDING */
+
     /* Now prepare for subsequent fragments. */
 
     /* FRAGN header: tag was already set at FRAG1. Now set dispatch for all FRAGN */
     packetbuf_hdr_len = SICSLOWPAN_FRAGN_HDR_LEN;
     SET16(PACKETBUF_FRAG_PTR, PACKETBUF_FRAG_DISPATCH_SIZE,
-          ((SICSLOWPAN_DISPATCH_FRAGN << 8) | uip_len));
+          ((SICSLOWPAN_DISPATCH_FRAGN << 8) | datagram_len));
 
     /* Keep track of the total length of data sent */
     processed_ip_out_len = uncomp_hdr_len + packetbuf_payload_len;
@@ -1848,8 +2354,8 @@ output(const linkaddr_t *localdest)
  *  copied in siclowpan_buf. If the IP packet is complete it is copied
  *  to uip_buf and the IP layer is called.
  *
- * \note We do not check for overlapping sicslowpan fragments
- * (it is a SHALL in the RFC 4944 and should never happen)
+ * \note Fragments may arrive in any order. Duplicate fragments are
+ * ignored, and a packet with overlapping fragments is dropped.
  */
 static void
 input(void)
@@ -1863,7 +2369,7 @@ input(void)
 
 #if SICSLOWPAN_CONF_FRAG
   uint8_t is_fragment = 0;
-  int8_t frag_context = 0;
+  struct sicslowpan_frag_info *frag_context = NULL;
 
   /* tag of the fragment */
   uint16_t frag_tag = 0;
@@ -1895,8 +2401,7 @@ input(void)
   /* Save the RSSI and LQI of the incoming packet in case the upper layer will
      want to query us for it later. */
   last_rssi = (signed short)packetbuf_attr(PACKETBUF_ATTR_RSSI);
-  uipbuf_set_attr(UIPBUF_ATTR_RSSI, packetbuf_attr(PACKETBUF_ATTR_RSSI));
-  uipbuf_set_attr(UIPBUF_ATTR_LINK_QUALITY, packetbuf_attr(PACKETBUF_ATTR_LINK_QUALITY));
+  set_uipbuf_attrs();
 
 
 #if SICSLOWPAN_CONF_FRAG
@@ -1920,12 +2425,12 @@ input(void)
       /* Add the fragment to the fragmentation context */
       frag_context = add_fragment(frag_tag, frag_size, frag_offset);
 
-      if(frag_context == -1) {
+      if(frag_context == NULL) {
         LOG_ERR("input: failed to allocate new reassembly context\n");
         return;
       }
 
-      buffer = frag_info[frag_context].first_frag;
+      buffer = first_frag;
       buffer_size = SICSLOWPAN_FIRST_FRAGMENT_SIZE;
       break;
     case SICSLOWPAN_DISPATCH_FRAGN:
@@ -1938,22 +2443,28 @@ input(void)
       frag_size = GET16(PACKETBUF_FRAG_PTR, PACKETBUF_FRAG_DISPATCH_SIZE) & 0x07ff;
       packetbuf_hdr_len += SICSLOWPAN_FRAGN_HDR_LEN;
 
+      if(frag_offset == 0) {
+        LOG_ERR("input: subsequent fragment with offset 0 (tag %d)\n", frag_tag);
+        return;
+      }
+
       /* Add the fragment to the fragmentation context (this will also
          copy the payload) */
       frag_context = add_fragment(frag_tag, frag_size, frag_offset);
 
-      if(frag_context == -1) {
-        LOG_ERR("input: reassembly context not found (tag %d)\n", frag_tag);
+      if(frag_context == NULL) {
+        LOG_ERR("input: fragment dropped (tag %d)\n", frag_tag);
         return;
       }
+#if SICSLOWPAN_FRAG_FORWARDING
+      if(fragment_forwarded(frag_context)) {
+        return;
+      }
+#endif /* SICSLOWPAN_FRAG_FORWARDING */
 
       /* Ok - add_fragment will store the fragment automatically - so
          we should not store more */
       buffer = NULL;
-
-      if(frag_info[frag_context].reassembled_len >= frag_size) {
-        last_fragment = 1;
-      }
       is_fragment = 1;
       break;
     default:
@@ -2031,13 +2542,15 @@ input(void)
     if(req_size > sizeof(uip_buf)) {
 #if SICSLOWPAN_CONF_FRAG
       LOG_ERR(
-          "input: packet and fragment context %u dropped, minimum required IP_BUF size: %d+%d+%d=%d (current size: %u)\n",
-          frag_context,
+          "input: packet and fragment context (tag %u) dropped, minimum required IP_BUF size: %d+%d+%d=%d (current size: %u)\n",
+          frag_tag,
           uncomp_hdr_len, (uint16_t)(frag_offset << 3),
           packetbuf_payload_len, req_size, (unsigned)sizeof(uip_buf));
       /* Discard all fragments for this contex, as reassembling this particular fragment would
        * cause an overflow in uipbuf */
-      clear_fragments(frag_context);
+      if(frag_context != NULL) {
+        drop_fragments(frag_context);
+      }
 #endif /* SICSLOWPAN_CONF_FRAG */
       return;
     }
@@ -2056,21 +2569,29 @@ input(void)
   /* update processed_ip_in_len if fragment, sicslowpan_len otherwise */
 
 #if SICSLOWPAN_CONF_FRAG
-  if(frag_size > 0) {
-    /* Add the size of the header only for the first fragment. */
-    if(first_fragment != 0) {
-      frag_info[frag_context].reassembled_len = uncomp_hdr_len + packetbuf_payload_len;
-      frag_info[frag_context].first_frag_len = uncomp_hdr_len + packetbuf_payload_len;
-    }
-    /* For the last fragment, we are OK if there is extrenous bytes at
-       the end of the packet. */
-    if(last_fragment != 0) {
-      frag_info[frag_context].reassembled_len = frag_size;
-      /* copy to uip */
-      if(!copy_frags2uip(frag_context)) {
+  if(is_fragment) {
+    /* Store the uncompressed first fragment with the others */
+    if(first_fragment) {
+      uint16_t len = uncomp_hdr_len + packetbuf_payload_len;
+
+      if(!mark_first_fragment(frag_context, len)) {
+        return;
+      }
+#if SICSLOWPAN_FRAG_FORWARDING
+      if(forward_first_fragment(frag_context, len)) {
+        return;
+      }
+#endif /* SICSLOWPAN_FRAG_FORWARDING */
+      if(!store_first_fragment(frag_context, len)) {
         return;
       }
     }
+    /* Fragments may arrive in any order, the packet is complete once
+       all of its bytes were received */
+    if(frag_context->reassembled_len >= frag_context->len) {
+      last_fragment = 1;
+      copy_frags2uip(frag_context);
+    }
   }
 
   /*
@@ -2106,19 +2627,6 @@ input(void)
       callback->input_callback();
     }
 
-#if LLSEC802154_USES_AUX_HEADER
-    /*
-     * Assuming that the last packet in packetbuf is containing
-     *  the LLSEC state so that it can be copied to uipbuf.
-     */
-    uipbuf_set_attr(UIPBUF_ATTR_LLSEC_LEVEL,
-      packetbuf_attr(PACKETBUF_ATTR_SECURITY_LEVEL));
-#if LLSEC802154_USES_EXPLICIT_KEYS
-    uipbuf_set_attr(UIPBUF_ATTR_LLSEC_KEY_ID,
-      packetbuf_attr(PACKETBUF_ATTR_KEY_INDEX));
-#endif /* LLSEC802154_USES_EXPLICIT_KEYS */
-#endif /*  LLSEC802154_USES_AUX_HEADER */
-
     tcpip_input();
 #if SICSLOWPAN_CONF_FRAG
   }
@@ -2176,6 +2684,16 @@ sicslowpan_init(void)
 #endif /* SICSLOWPAN_CONF_MAX_ADDR_CONTEXTS > 1 */
 
 #endif /* SICSLOWPAN_COMPRESSION == SICSLOWPAN_COMPRESSION_IPHC */
+
+#if SICSLOWPAN_COMPRESSION >= SICSLOWPAN_COMPRESSION_IPHC && \
+    SICSLOWPAN_IPHC_CACHE_SIZE > 0
+  /* The contexts may have changed */
+  iphc_cache_flush();
+#endif /* SICSLOWPAN_IPHC_CACHE_SIZE > 0 */
+
+#if SICSLOWPAN_CONF_FRAG
+  reass_init();
+#endif /* SICSLOWPAN_CONF_FRAG */
 }
 /*--------------------------------------------------------------------*/
 int
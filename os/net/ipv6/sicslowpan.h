@@ -336,6 +336,30 @@ struct sicslowpan_nh_compressor {
 
 };
 
+#if SICSLOWPAN_CONF_FRAG
+/**
+ * Statistics of the reassembly of fragmented packets
+ */
+struct sicslowpan_reass_stats {
+  uint32_t reassembled; /**< Packets reassembled */
+  uint32_t timeouts;    /**< Packets dropped because they were not
+                             complete before SICSLOWPAN_REASS_MAXAGE */
+  uint32_t evictions;   /**< Packets dropped to free fragment buffers */
+  uint32_t no_context;  /**< Fragments dropped because all reassembly
+                             contexts were in use */
+  uint32_t duplicates;  /**< Fragments dropped because they were
+                             received before */
+  uint32_t overlaps;    /**< Packets dropped because their fragments
+                             overlapped or disagreed on the size */
+  uint32_t forwarded;   /**< Packets forwarded fragment by fragment,
+                             without reassembly */
+  uint32_t max_buffers; /**< Highest number of fragment buffers in
+                             use at once */
+};
+
+extern struct sicslowpan_reass_stats sicslowpan_reass_stats;
+#endif /* SICSLOWPAN_CONF_FRAG */
+
 extern CC_DEPRECATED("Use UIPBUF_ATTR_RSSI instead") int sicslowpan_get_last_rssi(void);
 
 extern const struct network_driver sicslowpan_driver;
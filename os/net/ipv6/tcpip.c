@@ -130,7 +130,7 @@ tcpip_output(const uip_lladdr_t *a)
   }
 }
 
-PROCESS(tcpip_process, "TCP/IP stack");
+PROCESS_WITH_PRIORITY(tcpip_process, "TCP/IP stack", PROCESS_PRIORITY_HIGH);
 
 /*---------------------------------------------------------------------------*/
 #if UIP_TCP
@@ -559,11 +559,17 @@ get_nexthop(uip_ipaddr_t *addr)
 static int
 queue_packet(uip_ds6_nbr_t *nbr)
 {
-  /* Copy outgoing pkt in the queuing buffer for later transmit. */
+  if(uip_fragment_fwd == UIP_FRAGMENT_FWD_TRY) {
+    /* A first fragment can only be sent while the link layer forwards
+       its datagram. Have the datagram reassembled instead, it is queued
+       once complete. */
+    uip_fragment_fwd = UIP_FRAGMENT_FWD_REASSEMBLE;
+    return 1;
+  }
+
+  /* Keep the outgoing pkt in its buffer for later transmit. */
 #if UIP_CONF_IPV6_QUEUE_PKT
-  if(uip_packetqueue_alloc(&nbr->packethandle, UIP_DS6_NBR_PACKET_LIFETIME) != NULL) {
-    memcpy(uip_packetqueue_buf(&nbr->packethandle), UIP_IP_BUF, uip_len);
-    uip_packetqueue_set_buflen(&nbr->packethandle, uip_len);
+  if(uip_packetqueue_enqueue(&nbr->packethandle, UIP_DS6_NBR_PACKET_LIFETIME)) {
     return 0;
   }
 #endif
@@ -582,10 +588,7 @@ send_queued(uip_ds6_nbr_t *nbr)
    * NA after sendiong a NS, you receive a NS with SLLAO: the entry moves
    * to STALE, and you must both send a NA and the queued packet.
    */
-  if(uip_packetqueue_buflen(&nbr->packethandle) != 0) {
-    uip_len = uip_packetqueue_buflen(&nbr->packethandle);
-    memcpy(UIP_IP_BUF, uip_packetqueue_buf(&nbr->packethandle), uip_len);
-    uip_packetqueue_free(&nbr->packethandle);
+  while(uip_packetqueue_dequeue(&nbr->packethandle)) {
     tcpip_output(uip_ds6_nbr_get_ll(nbr));
   }
 #endif /*UIP_CONF_IPV6_QUEUE_PKT*/
@@ -599,17 +602,24 @@ send_nd6_ns(const uip_ipaddr_t *nexthop)
 #if UIP_ND6_SEND_NS
    uip_ds6_nbr_t *nbr = NULL;
   if((nbr = uip_ds6_nbr_add(nexthop, NULL, 0, NBR_INCOMPLETE, NBR_TABLE_REASON_IPV6_ND, NULL)) != NULL) {
+    uip_ipaddr_t src;
+    bool src_is_mine;
+
     err = 0;
 
-    queue_packet(nbr);
   /* RFC4861, 7.2.2:
    * "If the source address of the packet prompting the solicitation is the
    * same as one of the addresses assigned to the outgoing interface, that
    * address SHOULD be placed in the IP Source Address of the outgoing
    * solicitation.  Otherwise, any one of the addresses assigned to the
-   * interface should be used."*/
-   if(uip_ds6_is_my_addr(&UIP_IP_BUF->srcipaddr)){
-      uip_nd6_ns_output(&UIP_IP_BUF->srcipaddr, NULL, &nbr->ipaddr);
+   * interface should be used."
+   * The packet leaves uip_buf when it is queued, so look at it first. */
+    src_is_mine = uip_ds6_is_my_addr(&UIP_IP_BUF->srcipaddr);
+    uip_ipaddr_copy(&src, &UIP_IP_BUF->srcipaddr);
+
+    queue_packet(nbr);
+    if(src_is_mine) {
+      uip_nd6_ns_output(&src, NULL, &nbr->ipaddr);
     } else {
       uip_nd6_ns_output(NULL, NULL, &nbr->ipaddr);
     }
@@ -816,6 +826,8 @@ PROCESS_THREAD(tcpip_process, ev, data)
 #endif
 
   tcpip_event = process_alloc_event();
+  /* Deliver packets to applications ahead of bulk events */
+  process_set_event_urgent(tcpip_event);
 #if UIP_CONF_ICMP6
   tcpip_icmp6_event = process_alloc_event();
 #endif /* UIP_CONF_ICMP6 */
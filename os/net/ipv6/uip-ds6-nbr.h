@@ -91,6 +91,14 @@
   (NBR_TABLE_MAX_NEIGHBORS * UIP_DS6_NBR_MAX_6ADDRS_PER_NBR)
 #endif /* UIP_DS6_NBR_CONF_MAX_NEIGHBOR_CACHES */
 
+/** \brief How long a packet waits for address resolution of its
+ * neighbor before it is dropped */
+#ifdef UIP_DS6_NBR_CONF_PACKET_LIFETIME
+#define UIP_DS6_NBR_PACKET_LIFETIME UIP_DS6_NBR_CONF_PACKET_LIFETIME
+#else
+#define UIP_DS6_NBR_PACKET_LIFETIME (CLOCK_SECOND * 4)
+#endif /* UIP_DS6_NBR_CONF_PACKET_LIFETIME */
+
 #if UIP_DS6_NBR_MULTI_IPV6_ADDRS
 /** \brief nbr_table entry when UIP_DS6_NBR_MULTI_IPV6_ADDRS is
  * enabled. uip_ds6_nbrs is a list of uip_ds6_nbr_t objects */
@@ -117,7 +125,6 @@ typedef struct uip_ds6_nbr {
 #endif /* UIP_ND6_SEND_NS || UIP_ND6_SEND_RA */
 #if UIP_CONF_IPV6_QUEUE_PKT
   struct uip_packetqueue_handle packethandle;
-#define UIP_DS6_NBR_PACKET_LIFETIME CLOCK_SECOND * 4
 #endif                          /*UIP_CONF_QUEUE_PKT */
 } uip_ds6_nbr_t;
 
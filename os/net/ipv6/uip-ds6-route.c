@@ -91,6 +91,16 @@ MEMB(routememb, uip_ds6_route_t, UIP_DS6_ROUTE_NB);
 static int num_routes = 0;
 static void rm_routelist_callback(nbr_table_item_t *ptr);
 
+#if UIP_DS6_ROUTE_HASH
+/* The routes are also indexed for lookups through their index_next
+   field. Host routes are chained on the hash bucket of their
+   address, and the other routes on the prefixlist, longest prefix
+   first, so that the first prefix that matches is the longest
+   match. */
+static uip_ds6_route_t *routehash[UIP_DS6_ROUTE_HASH_SIZE];
+static uip_ds6_route_t *prefixlist;
+#endif /* UIP_DS6_ROUTE_HASH */
+
 #endif /* (UIP_MAX_ROUTES != 0) */
 
 /* Default routes are held on the defaultrouterlist and their
@@ -168,12 +178,66 @@ uip_ds6_notification_rm(struct uip_ds6_notification *n)
 }
 #endif
 /*---------------------------------------------------------------------------*/
+#if (UIP_MAX_ROUTES != 0) && UIP_DS6_ROUTE_HASH
+static uip_ds6_route_t **
+index_head(const uip_ipaddr_t *addr, uint8_t length)
+{
+  uint32_t h;
+  int i;
+
+  if(length != 128) {
+    return &prefixlist;
+  }
+
+  h = 0;
+  for(i = 0; i < 8; i++) {
+    h = (h ^ addr->u16[i]) * 0x01000193;
+  }
+  return &routehash[(h ^ (h >> 16)) % UIP_DS6_ROUTE_HASH_SIZE];
+}
+/*---------------------------------------------------------------------------*/
+static void
+index_add(uip_ds6_route_t *r)
+{
+  uip_ds6_route_t **p;
+
+  p = index_head(&r->ipaddr, r->length);
+  if(r->length != 128) {
+    /* Keep the prefix list sorted by decreasing prefix length */
+    while(*p != NULL && (*p)->length > r->length) {
+      p = &(*p)->index_next;
+    }
+  }
+  r->index_next = *p;
+  *p = r;
+}
+/*---------------------------------------------------------------------------*/
+static void
+index_remove(uip_ds6_route_t *r)
+{
+  uip_ds6_route_t **p;
+
+  for(p = index_head(&r->ipaddr, r->length);
+      *p != NULL;
+      p = &(*p)->index_next) {
+    if(*p == r) {
+      *p = r->index_next;
+      return;
+    }
+  }
+}
+#endif /* (UIP_MAX_ROUTES != 0) && UIP_DS6_ROUTE_HASH */
+/*---------------------------------------------------------------------------*/
 void
 uip_ds6_route_init(void)
 {
 #if (UIP_MAX_ROUTES != 0)
   memb_init(&routememb);
   list_init(routelist);
+#if UIP_DS6_ROUTE_HASH
+  memset(routehash, 0, sizeof(routehash));
+  prefixlist = NULL;
+#endif /* UIP_DS6_ROUTE_HASH */
   nbr_table_register(nbr_routes,
                      (nbr_table_callback *)rm_routelist_callback);
 #endif /* (UIP_MAX_ROUTES != 0) */
@@ -283,17 +347,36 @@ uip_ds6_route_lookup(const uip_ipaddr_t *addr)
 #if (UIP_MAX_ROUTES != 0)
   uip_ds6_route_t *r;
   uip_ds6_route_t *found_route;
+#if !UIP_DS6_ROUTE_HASH
   uint8_t longestmatch;
-
-  LOG_INFO("Looking up route for ");
-  LOG_INFO_6ADDR(addr);
-  LOG_INFO_("\n");
+#endif /* !UIP_DS6_ROUTE_HASH */
 
   if(addr == NULL) {
     return NULL;
   }
 
+  LOG_DBG("Looking up route for ");
+  LOG_DBG_6ADDR(addr);
+  LOG_DBG_("\n");
+
   found_route = NULL;
+#if UIP_DS6_ROUTE_HASH
+  /* A host route is always the longest match */
+  for(r = *index_head(addr, 128); r != NULL; r = r->index_next) {
+    if(uip_ipaddr_cmp(addr, &r->ipaddr)) {
+      found_route = r;
+      break;
+    }
+  }
+  if(found_route == NULL) {
+    for(r = prefixlist; r != NULL; r = r->index_next) {
+      if(uip_ipaddr_prefixcmp(addr, &r->ipaddr, r->length)) {
+        found_route = r;
+        break;
+      }
+    }
+  }
+#else /* UIP_DS6_ROUTE_HASH */
   longestmatch = 0;
   for(r = uip_ds6_route_head();
       r != NULL;
@@ -308,26 +391,29 @@ uip_ds6_route_lookup(const uip_ipaddr_t *addr)
       }
     }
   }
+#endif /* UIP_DS6_ROUTE_HASH */
 
   if(found_route != NULL) {
-    LOG_INFO("Found route: ");
-    LOG_INFO_6ADDR(addr);
-    LOG_INFO_(" via ");
-    LOG_INFO_6ADDR(uip_ds6_route_nexthop(found_route));
-    LOG_INFO_("\n");
+    LOG_DBG("Found route: ");
+    LOG_DBG_6ADDR(addr);
+    LOG_DBG_(" via ");
+    LOG_DBG_6ADDR(uip_ds6_route_nexthop(found_route));
+    LOG_DBG_("\n");
   } else {
-    LOG_WARN("No route found\n");
+    LOG_DBG("No route found\n");
   }
 
+#if UIP_DS6_ROUTE_REMOVE_LEAST_RECENTLY_USED
   if(found_route != NULL && found_route != list_head(routelist)) {
     /* If we found a route, we put it at the start of the routeslist
        list. The list is ordered by how recently we looked them up:
        the least recently used route will be at the end of the
-       list - for fast lookups (assuming multiple packets to the same node). */
+       list, which is the one dropped when the table is full. */
 
     list_remove(routelist, found_route);
     list_push(routelist, found_route);
   }
+#endif /* UIP_DS6_ROUTE_REMOVE_LEAST_RECENTLY_USED */
 
   return found_route;
 #else /* (UIP_MAX_ROUTES != 0) */
@@ -335,6 +421,27 @@ uip_ds6_route_lookup(const uip_ipaddr_t *addr)
 #endif /* (UIP_MAX_ROUTES != 0) */
 }
 /*---------------------------------------------------------------------------*/
+#if (UIP_MAX_ROUTES != 0)
+/* Find the route with exactly this prefix, not the longest match */
+static uip_ds6_route_t *
+find_route(const uip_ipaddr_t *ipaddr, uint8_t length)
+{
+  uip_ds6_route_t *r;
+
+#if UIP_DS6_ROUTE_HASH
+  for(r = *index_head(ipaddr, length); r != NULL; r = r->index_next) {
+#else /* UIP_DS6_ROUTE_HASH */
+  for(r = uip_ds6_route_head(); r != NULL; r = uip_ds6_route_next(r)) {
+#endif /* UIP_DS6_ROUTE_HASH */
+    if(r->length == length &&
+       uip_ipaddr_prefixcmp(ipaddr, &r->ipaddr, length)) {
+      return r;
+    }
+  }
+  return NULL;
+}
+#endif /* (UIP_MAX_ROUTES != 0) */
+/*---------------------------------------------------------------------------*/
 uip_ds6_route_t *
 uip_ds6_route_add(const uip_ipaddr_t *ipaddr, uint8_t length,
                   const uip_ipaddr_t *nexthop)
@@ -363,7 +470,7 @@ uip_ds6_route_add(const uip_ipaddr_t *ipaddr, uint8_t length,
   /* First make sure that we don't add a route twice. If we find an
      existing route for our destination, we'll delete the old
      one first. */
-  r = uip_ds6_route_lookup(ipaddr);
+  r = find_route(ipaddr, length);
   if(r != NULL) {
     const uip_ipaddr_t *current_nexthop;
     current_nexthop = uip_ds6_route_nexthop(r);
@@ -470,6 +577,9 @@ uip_ds6_route_add(const uip_ipaddr_t *ipaddr, uint8_t length,
 
   uip_ipaddr_copy(&(r->ipaddr), ipaddr);
   r->length = length;
+#if UIP_DS6_ROUTE_HASH
+  index_add(r);
+#endif /* UIP_DS6_ROUTE_HASH */
 
 #ifdef UIP_DS6_ROUTE_STATE_TYPE
   memset(&r->state, 0, sizeof(UIP_DS6_ROUTE_STATE_TYPE));
@@ -515,6 +625,9 @@ uip_ds6_route_rm(uip_ds6_route_t *route)
 
     /* Remove the route from the route list */
     list_remove(routelist, route);
+#if UIP_DS6_ROUTE_HASH
+    index_remove(route);
+#endif /* UIP_DS6_ROUTE_HASH */
 
     /* Find the corresponding neighbor_route and remove it. */
     for(neighbor_route = list_head(route->neighbor_routes->route_list);
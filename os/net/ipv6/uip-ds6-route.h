@@ -111,6 +111,24 @@ void uip_ds6_notification_rm(struct uip_ds6_notification *n);
 #define UIP_DS6_ROUTE_NB 4
 #endif /* UIP_MAX_ROUTES */
 
+/** \brief Index the routing table for uip_ds6_route_lookup(). Host
+ *  routes (/128) are kept in a hash table, and the remaining prefixes
+ *  on a list sorted by length, so that a lookup no longer walks the
+ *  whole table. It costs a pointer per route and per bucket, so it is
+ *  enabled by default on native platforms only. */
+#ifdef UIP_DS6_ROUTE_CONF_HASH
+#define UIP_DS6_ROUTE_HASH UIP_DS6_ROUTE_CONF_HASH
+#else /* UIP_DS6_ROUTE_CONF_HASH */
+#define UIP_DS6_ROUTE_HASH 0
+#endif /* UIP_DS6_ROUTE_CONF_HASH */
+
+/** \brief Number of buckets of the host route hash table */
+#ifdef UIP_DS6_ROUTE_CONF_HASH_SIZE
+#define UIP_DS6_ROUTE_HASH_SIZE UIP_DS6_ROUTE_CONF_HASH_SIZE
+#else /* UIP_DS6_ROUTE_CONF_HASH_SIZE */
+#define UIP_DS6_ROUTE_HASH_SIZE (UIP_DS6_ROUTE_NB > 0 ? UIP_DS6_ROUTE_NB : 1)
+#endif /* UIP_DS6_ROUTE_CONF_HASH_SIZE */
+
 /** \brief define some additional RPL related route state and
  *  neighbor callback for RPL - if not a DS6_ROUTE_STATE is already set */
 #ifndef UIP_DS6_ROUTE_STATE_TYPE
@@ -176,6 +194,10 @@ typedef struct uip_ds6_route {
      belong to the neighbor table entry that this routing table entry
      uses. */
   struct uip_ds6_route_neighbor_routes *neighbor_routes;
+#if UIP_DS6_ROUTE_HASH
+  /* Next route in the same hash bucket, or next prefix route */
+  struct uip_ds6_route *index_next;
+#endif /* UIP_DS6_ROUTE_HASH */
   uip_ipaddr_t ipaddr;
 #ifdef UIP_DS6_ROUTE_STATE_TYPE
   UIP_DS6_ROUTE_STATE_TYPE state;
@@ -6,8 +6,8 @@
 
 #include "net/ipv6/uip-packetqueue.h"
 
-#define MAX_NUM_QUEUED_PACKETS 2
-MEMB(packets_memb, struct uip_packetqueue_packet, MAX_NUM_QUEUED_PACKETS);
+/* Each queued packet holds one buffer of the uipbuf pool */
+MEMB(packets_memb, struct uip_packetqueue_packet, UIP_CONF_IPV6_QUEUE_PKT_NUM);
 
 #define DEBUG 0
 #if DEBUG
@@ -17,70 +17,100 @@ MEMB(packets_memb, struct uip_packetqueue_packet, MAX_NUM_QUEUED_PACKETS);
 #define PRINTF(...)
 #endif
 
+/*---------------------------------------------------------------------------*/
+static void
+drop(struct uip_packetqueue_packet *packet)
+{
+  ctimer_stop(&packet->lifetimer);
+  list_remove(packet->handle->packets, packet);
+  uipbuf_release(packet->buf);
+  memb_free(&packets_memb, packet);
+  UIP_STAT(++uip_stat.nd6.qdrop);
+}
 /*---------------------------------------------------------------------------*/
 static void
 packet_timedout(void *ptr)
 {
-  struct uip_packetqueue_handle *h = ptr;
+  struct uip_packetqueue_packet *packet = ptr;
 
-  PRINTF("uip_packetqueue_free timed out %p\n", h);
-  memb_free(&packets_memb, h->packet);
-  h->packet = NULL;
+  PRINTF("uip_packetqueue_free timed out %p\n", packet->handle);
+  drop(packet);
 }
 /*---------------------------------------------------------------------------*/
 void
 uip_packetqueue_new(struct uip_packetqueue_handle *handle)
 {
   PRINTF("uip_packetqueue_new %p\n", handle);
-  handle->packet = NULL;
+  LIST_STRUCT_INIT(handle, packets);
 }
 /*---------------------------------------------------------------------------*/
-struct uip_packetqueue_packet *
-uip_packetqueue_alloc(struct uip_packetqueue_handle *handle, clock_time_t lifetime)
+int
+uip_packetqueue_enqueue(struct uip_packetqueue_handle *handle, clock_time_t lifetime)
 {
-  PRINTF("uip_packetqueue_alloc %p\n", handle);
-  if(handle->packet != NULL) {
-    PRINTF("alloced\n");
-    return NULL;
+  struct uip_packetqueue_packet *packet;
+
+  PRINTF("uip_packetqueue_enqueue %p\n", handle);
+  if(list_length(handle->packets) >= UIP_CONF_IPV6_QUEUE_PKT_DEPTH) {
+    PRINTF("queue full, dropping the oldest packet\n");
+    drop(list_head(handle->packets));
   }
-  handle->packet = memb_alloc(&packets_memb);
-  if(handle->packet != NULL) {
-    ctimer_set(&handle->packet->lifetimer, lifetime,
-               packet_timedout, handle);
-  } else {
-    PRINTF("uip_packetqueue_alloc failed\n");
+  packet = memb_alloc(&packets_memb);
+  if(packet == NULL) {
+    PRINTF("uip_packetqueue_enqueue failed\n");
+    UIP_STAT(++uip_stat.nd6.qdrop);
+    return 0;
   }
-  return handle->packet;
+  packet->buf = uipbuf_detach();
+  if(packet->buf == NULL) {
+    PRINTF("uip_packetqueue_enqueue: no free buffer\n");
+    memb_free(&packets_memb, packet);
+    UIP_STAT(++uip_stat.nd6.qdrop);
+    return 0;
+  }
+  packet->buf_len = uip_len;
+  packet->handle = handle;
+  list_add(handle->packets, packet);
+  ctimer_set(&packet->lifetimer, lifetime, packet_timedout, packet);
+  return 1;
 }
 /*---------------------------------------------------------------------------*/
-void
-uip_packetqueue_free(struct uip_packetqueue_handle *handle)
+int
+uip_packetqueue_dequeue(struct uip_packetqueue_handle *handle)
 {
-  PRINTF("uip_packetqueue_free %p\n", handle);
-  if(handle->packet != NULL) {
-    ctimer_stop(&handle->packet->lifetimer);
-    memb_free(&packets_memb, handle->packet);
-    handle->packet = NULL;
+  struct uip_packetqueue_packet *packet;
+
+  PRINTF("uip_packetqueue_dequeue %p\n", handle);
+  packet = list_pop(handle->packets);
+  if(packet == NULL) {
+    return 0;
   }
+  ctimer_stop(&packet->lifetimer);
+  uipbuf_attach(packet->buf);
+  uip_len = packet->buf_len;
+  memb_free(&packets_memb, packet);
+  return 1;
 }
 /*---------------------------------------------------------------------------*/
-uint8_t *
-uip_packetqueue_buf(struct uip_packetqueue_handle *h)
+void
+uip_packetqueue_free(struct uip_packetqueue_handle *handle)
 {
-  return h->packet != NULL? h->packet->queue_buf: NULL;
+  PRINTF("uip_packetqueue_free %p\n", handle);
+  while(list_head(handle->packets) != NULL) {
+    drop(list_head(handle->packets));
+  }
 }
 /*---------------------------------------------------------------------------*/
 uint16_t
 uip_packetqueue_buflen(struct uip_packetqueue_handle *h)
 {
-  return h->packet != NULL? h->packet->queue_buf_len: 0;
+  struct uip_packetqueue_packet *packet = list_head(h->packets);
+
+  return packet != NULL ? packet->buf_len : 0;
 }
 /*---------------------------------------------------------------------------*/
-void
-uip_packetqueue_set_buflen(struct uip_packetqueue_handle *h, uint16_t len)
+int
+uip_packetqueue_len(struct uip_packetqueue_handle *h)
 {
-  if(h->packet != NULL) {
-    h->packet->queue_buf_len = len;
-  }
+  return list_length(h->packets);
 }
 /*---------------------------------------------------------------------------*/
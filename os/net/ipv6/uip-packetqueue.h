@@ -2,34 +2,47 @@
 #define UIP_PACKETQUEUE_H
 
 #include "sys/ctimer.h"
+#include "lib/list.h"
 
 struct uip_packetqueue_handle;
 
+/* A queued packet stays in the buffer it was received or built in. The
+   buffer is detached from uip_buf rather than copied, see uipbuf.h. */
 struct uip_packetqueue_packet {
-  struct uip_ds6_queued_packet *next;
-  uint8_t queue_buf[UIP_BUFSIZE];
-  uint16_t queue_buf_len;
+  struct uip_packetqueue_packet *next;
+  union uip_packet_buf *buf;
+  uint16_t buf_len;
   struct ctimer lifetimer;
   struct uip_packetqueue_handle *handle;
 };
 
+/* The packets of a handle, oldest first. They come from a pool of
+   UIP_CONF_IPV6_QUEUE_PKT_NUM packets shared by all handles, and a
+   handle holds at most UIP_CONF_IPV6_QUEUE_PKT_DEPTH of them. */
 struct uip_packetqueue_handle {
-  struct uip_packetqueue_packet *packet;
+  LIST_STRUCT(packets);
 };
 
 void uip_packetqueue_new(struct uip_packetqueue_handle *handle);
 
+/* Move the packet in uip_buf to the end of the queue. If the queue is
+   full, its oldest packet is dropped to make room. Returns 1 if the
+   packet was queued, 0 if the pool is exhausted. */
+int uip_packetqueue_enqueue(struct uip_packetqueue_handle *handle,
+                            clock_time_t lifetime);
 
-struct uip_packetqueue_packet *
-uip_packetqueue_alloc(struct uip_packetqueue_handle *handle, clock_time_t lifetime);
-
+/* Move the oldest queued packet back to uip_buf and set uip_len.
+   Returns 1 if there was a packet, 0 otherwise. */
+int uip_packetqueue_dequeue(struct uip_packetqueue_handle *handle);
 
+/* Drop all the packets of the queue */
 void
 uip_packetqueue_free(struct uip_packetqueue_handle *handle);
 
-uint8_t *uip_packetqueue_buf(struct uip_packetqueue_handle *h);
+/* The length of the oldest queued packet, 0 if there is none */
 uint16_t uip_packetqueue_buflen(struct uip_packetqueue_handle *h);
-void uip_packetqueue_set_buflen(struct uip_packetqueue_handle *h, uint16_t len);
 
+/* The number of queued packets */
+int uip_packetqueue_len(struct uip_packetqueue_handle *h);
 
 #endif /* UIP_PACKETQUEUE_H */
@@ -58,6 +58,68 @@ static int num_nodes;
 LIST(nodelist);
 MEMB(nodememb, uip_sr_node_t, UIP_SR_LINK_NUM);
 
+#if UIP_SR_HASH
+/* The nodes, chained on the bucket of their link identifier */
+static uip_sr_node_t *nodehash[UIP_SR_HASH_SIZE];
+#endif /* UIP_SR_HASH */
+
+/* Changed whenever a node is added, removed or changes parent, which
+   invalidates the paths cached in the nodes. Never zero. */
+static uint16_t generation = 1;
+
+/* Value of path_hops for a node that the root cannot reach */
+#define PATH_UNREACHABLE 0xff
+
+/*---------------------------------------------------------------------------*/
+static void
+graph_changed(void)
+{
+  uip_sr_node_t *l;
+
+  if(++generation == 0) {
+    /* Make sure that no stale path becomes valid again */
+    for(l = list_head(nodelist); l != NULL; l = list_item_next(l)) {
+      l->path_generation = 0;
+    }
+    generation = 1;
+  }
+}
+/*---------------------------------------------------------------------------*/
+#if UIP_SR_HASH
+static uip_sr_node_t **
+hash_head(const unsigned char *link_identifier)
+{
+  uint32_t h;
+  int i;
+
+  h = 0;
+  for(i = 0; i < 8; i++) {
+    h = (h ^ link_identifier[i]) * 0x01000193;
+  }
+  return &nodehash[(h ^ (h >> 16)) % UIP_SR_HASH_SIZE];
+}
+#endif /* UIP_SR_HASH */
+/*---------------------------------------------------------------------------*/
+static void
+remove_node(uip_sr_node_t *node)
+{
+#if UIP_SR_HASH
+  uip_sr_node_t **p;
+
+  for(p = hash_head(node->link_identifier); *p != NULL;
+      p = &(*p)->hash_next) {
+    if(*p == node) {
+      *p = node->hash_next;
+      break;
+    }
+  }
+#endif /* UIP_SR_HASH */
+  list_remove(nodelist, node);
+  memb_free(&nodememb, node);
+  num_nodes--;
+  graph_changed();
+}
+
 /*---------------------------------------------------------------------------*/
 int
 uip_sr_num_nodes(void)
@@ -81,15 +143,80 @@ uip_sr_node_t *
 uip_sr_get_node(void *graph, const uip_ipaddr_t *addr)
 {
   uip_sr_node_t *l;
+#if UIP_SR_HASH
+  if(addr == NULL) {
+    return NULL;
+  }
+  for(l = *hash_head(addr->u8 + 8); l != NULL; l = l->hash_next) {
+    /* Compare node identifier, then prefix */
+    if(memcmp(l->link_identifier, addr->u8 + 8, 8) == 0 &&
+       node_matches_address(graph, l, addr)) {
+      return l;
+    }
+  }
+#else /* UIP_SR_HASH */
   for(l = list_head(nodelist); l != NULL; l = list_item_next(l)) {
     /* Compare prefix and node identifier */
     if(node_matches_address(graph, l, addr)) {
       return l;
     }
   }
+#endif /* UIP_SR_HASH */
   return NULL;
 }
 /*---------------------------------------------------------------------------*/
+/* Counts the leading bytes, up to max, that two addresses have in common */
+static uint8_t
+count_matching_bytes(const uip_ipaddr_t *a, const uip_ipaddr_t *b,
+                     uint8_t max)
+{
+  uint8_t i;
+
+  for(i = 0; i < max && a->u8[i] == b->u8[i]; i++);
+  return i;
+}
+/*---------------------------------------------------------------------------*/
+int
+uip_sr_get_path(uip_sr_node_t *node, const uip_sr_node_t *root,
+                uint8_t *hops, uint8_t *cmpr)
+{
+  int max_depth = UIP_SR_LINK_NUM;
+  const uip_sr_node_t *hop;
+  uip_ipaddr_t node_addr;
+  uip_ipaddr_t hop_addr;
+  unsigned n;
+  uint8_t c;
+
+  if(node == NULL || root == NULL) {
+    return 0;
+  }
+
+  if(node->path_generation != generation) {
+    NETSTACK_ROUTING.get_sr_node_ipaddr(&node_addr, node);
+    n = 0;
+    c = 15;
+    hop = node == root ? root : node->parent;
+    while(hop != NULL && hop != root && max_depth > 0) {
+      NETSTACK_ROUTING.get_sr_node_ipaddr(&hop_addr, hop);
+      c = count_matching_bytes(&hop_addr, &node_addr, c);
+      hop = hop->parent;
+      n++;
+      max_depth--;
+    }
+    node->path_hops = hop == root && n < PATH_UNREACHABLE ?
+      n : PATH_UNREACHABLE;
+    node->path_cmpr = c;
+    node->path_generation = generation;
+  }
+
+  if(node->path_hops == PATH_UNREACHABLE) {
+    return 0;
+  }
+  *hops = node->path_hops;
+  *cmpr = node->path_cmpr;
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
 int
 uip_sr_is_addr_reachable(void *graph, const uip_ipaddr_t *addr)
 {
@@ -148,8 +275,18 @@ uip_sr_update_node(void *graph, const uip_ipaddr_t *child, const uip_ipaddr_t *p
       return NULL;
     }
     child_node->parent = NULL;
+    child_node->path_generation = 0;
+    memcpy(child_node->link_identifier, ((const unsigned char *)child) + 8, 8);
+#if UIP_SR_HASH
+    {
+      uip_sr_node_t **head = hash_head(child_node->link_identifier);
+      child_node->hash_next = *head;
+      *head = child_node;
+    }
+#endif /* UIP_SR_HASH */
     list_add(nodelist, child_node);
     num_nodes++;
+    graph_changed();
   }
 
   /* Initialize node */
@@ -157,9 +294,9 @@ uip_sr_update_node(void *graph, const uip_ipaddr_t *child, const uip_ipaddr_t *p
   child_node->lifetime = lifetime;
   memcpy(child_node->link_identifier, ((const unsigned char *)child) + 8, 8);
 
+  old_parent_node = child_node->parent;
   /* Is the node reachable before the update? */
   if(uip_sr_is_addr_reachable(graph, child)) {
-    old_parent_node = child_node->parent;
     /* Update node */
     child_node->parent = parent_node;
     /* Has the node become unreachable? May happen if we create a loop. */
@@ -172,6 +309,9 @@ uip_sr_update_node(void *graph, const uip_ipaddr_t *child, const uip_ipaddr_t *p
   } else {
     child_node->parent = parent_node;
   }
+  if(child_node->parent != old_parent_node) {
+    graph_changed();
+  }
 
   LOG_INFO("NS: updating link, child ");
   LOG_INFO_6ADDR(child);
@@ -188,6 +328,10 @@ uip_sr_init(void)
   num_nodes = 0;
   memb_init(&nodememb);
   list_init(nodelist);
+#if UIP_SR_HASH
+  memset(nodehash, 0, sizeof(nodehash));
+#endif /* UIP_SR_HASH */
+  graph_changed();
 }
 /*---------------------------------------------------------------------------*/
 uip_sr_node_t *
@@ -218,6 +362,11 @@ uip_sr_periodic(unsigned seconds)
           break;
         }
       }
+      if(l2 != NULL) {
+        /* Keep the node until its children have moved or expired,
+           so that their parent pointers remain valid */
+        continue;
+      }
       if(LOG_INFO_ENABLED) {
         uip_ipaddr_t node_addr;
         NETSTACK_ROUTING.get_sr_node_ipaddr(&node_addr, l);
@@ -226,9 +375,7 @@ uip_sr_periodic(unsigned seconds)
         LOG_INFO_("\n");
       }
       /* No child found, deallocate node */
-      list_remove(nodelist, l);
-      memb_free(&nodememb, l);
-      num_nodes--;
+      remove_node(l);
     } else if(l->lifetime != UIP_SR_INFINITE_LIFETIME) {
       l->lifetime = l->lifetime > seconds ? l->lifetime - seconds : 0;
     }
@@ -242,10 +389,15 @@ uip_sr_free_all(void)
   uip_sr_node_t *next;
   for(l = list_head(nodelist); l != NULL; l = next) {
     next = list_item_next(l);
-    list_remove(nodelist, l);
-    memb_free(&nodememb, l);
-    num_nodes--;
+    remove_node(l);
   }
+  uip_sr_flush_paths();
+}
+/*---------------------------------------------------------------------------*/
+void
+uip_sr_flush_paths(void)
+{
+  graph_changed();
 }
 /*---------------------------------------------------------------------------*/
 int
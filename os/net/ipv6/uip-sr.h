@@ -85,6 +85,21 @@
 
 #define UIP_SR_INFINITE_LIFETIME           0xFFFFFFFF
 
+/* Index the nodes by link identifier, so that uip_sr_get_node() does
+   not walk the whole node list */
+#ifdef UIP_SR_CONF_HASH
+#define UIP_SR_HASH                   UIP_SR_CONF_HASH
+#else /* UIP_SR_CONF_HASH */
+#define UIP_SR_HASH                   1
+#endif /* UIP_SR_CONF_HASH */
+
+/* Number of buckets of the node hash table */
+#ifdef UIP_SR_CONF_HASH_SIZE
+#define UIP_SR_HASH_SIZE              UIP_SR_CONF_HASH_SIZE
+#else /* UIP_SR_CONF_HASH_SIZE */
+#define UIP_SR_HASH_SIZE              (UIP_SR_LINK_NUM > 0 ? UIP_SR_LINK_NUM : 1)
+#endif /* UIP_SR_CONF_HASH_SIZE */
+
 /********** Data Structures  **********/
 
 /** \brief A node in a source routing graph, stored at the root and representing
@@ -98,6 +113,15 @@ typedef struct uip_sr_node {
   us with the prefix */
   unsigned char link_identifier[8];
   struct uip_sr_node *parent;
+#if UIP_SR_HASH
+  /* Next node in the same hash bucket */
+  struct uip_sr_node *hash_next;
+#endif /* UIP_SR_HASH */
+  /* The path from the root, as computed by uip_sr_get_path(). Valid
+  as long as path_generation matches that of the graph. */
+  uint16_t path_generation;
+  uint8_t path_hops;
+  uint8_t path_cmpr;
 } uip_sr_node_t;
 
 /********** Public functions **********/
@@ -152,6 +176,22 @@ uip_sr_node_t *uip_sr_node_next(uip_sr_node_t *item);
 */
 uip_sr_node_t *uip_sr_get_node(void *graph, const uip_ipaddr_t *addr);
 
+/**
+ * Gets the path from the root to a node. The result is cached in the
+ * node until the graph changes, so that building a source routing
+ * header for a known destination does not walk the graph twice.
+ *
+ * \param node The destination node
+ * \param root The root node of the graph
+ * \param hops Set to the number of nodes between the root and the
+ * destination, excluding both
+ * \param cmpr Set to the number of leading bytes that the addresses of
+ * these nodes share with that of the destination, at most 15
+ * \return 1 if the node is reachable from the root, 0 otherwise
+*/
+int uip_sr_get_path(uip_sr_node_t *node, const uip_sr_node_t *root,
+                    uint8_t *hops, uint8_t *cmpr);
+
 /**
  * Telle whether an address is reachable, i.e. if there exists a path from
  * the root to the node in the current source routing graph
@@ -180,6 +220,13 @@ void uip_sr_init(void);
 */
 void uip_sr_free_all(void);
 
+/**
+ * Forgets the paths cached by uip_sr_get_path(). The addresses of the
+ * nodes are built from the DAG ID, so this must be called when the
+ * DAG changes.
+*/
+void uip_sr_flush_paths(void);
+
 /**
 * Print a textual description of a source routing link
 *
@@ -499,12 +499,21 @@ void uip_reass_over(void);
  * outgoing data from this buffer.
 */
 
-typedef union {
+typedef union uip_packet_buf {
   uint32_t u32[(UIP_BUFSIZE + 3) / 4];
   uint8_t u8[UIP_BUFSIZE];
 } uip_buf_t;
 
+#if UIPBUF_POOL_SIZE > 1
+#ifdef UIP_CONF_EXTERNAL_BUFFER
+#error "UIP_CONF_EXTERNAL_BUFFER requires UIPBUF_CONF_POOL_SIZE 1"
+#endif /* UIP_CONF_EXTERNAL_BUFFER */
+/* The buffer of the pool that uip_buf is a view onto, see uipbuf.h */
+extern uip_buf_t *uip_bufptr;
+#define uip_aligned_buf (*uip_bufptr)
+#else /* UIPBUF_POOL_SIZE > 1 */
 extern uip_buf_t uip_aligned_buf;
+#endif /* UIPBUF_POOL_SIZE > 1 */
 
 /** Macro to access uip_aligned_buf as an array of bytes */
 #define uip_buf (uip_aligned_buf.u8)
@@ -1262,6 +1271,9 @@ uint32_t uip_htonl(uint32_t val);
  */
 extern void *uip_appdata;
 
+/* Pointer to where the application data to be sent is placed. */
+extern void *uip_sappdata;
+
 #if UIP_URGDATA > 0
 /* uint8_t *uip_urgdata:
  *
@@ -1305,6 +1317,22 @@ extern uint16_t uip_ext_len;
 /** The final protocol after IPv6 extension headers:
   * UIP_PROTO_TCP, UIP_PROTO_UDP or UIP_PROTO_ICMP6 */
 extern uint8_t uip_last_proto;
+
+/**
+ * Set by a link layer that forwards the fragments of a datagram
+ * without reassembling it first. It then passes only the first
+ * fragment to the IP layer, with UIP_FRAGMENT_FWD_TRY. uip_len is the
+ * length of that fragment instead of the length of the datagram, and
+ * the fragment is forwarded as usual. If the datagram is for this
+ * node, or cannot be forwarded as fragments, the fragment is dropped
+ * and this is set to UIP_FRAGMENT_FWD_REASSEMBLE, to let the link
+ * layer reassemble the datagram.
+ */
+extern uint8_t uip_fragment_fwd;
+
+#define UIP_FRAGMENT_FWD_NONE       0
+#define UIP_FRAGMENT_FWD_TRY        1
+#define UIP_FRAGMENT_FWD_REASSEMBLE 2
 /** @} */
 
 #if UIP_URGDATA > 0
@@ -1476,6 +1504,8 @@ struct uip_stats {
     uip_stats_t drop;     /**< Number of dropped ND6 packets. */
     uip_stats_t recv;     /**< Number of recived ND6 packets */
     uip_stats_t sent;     /**< Number of sent ND6 packets */
+    uip_stats_t qdrop;    /**< Number of packets dropped while waiting
+                               for address resolution. */
   } nd6;
 };
 
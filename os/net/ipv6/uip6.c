@@ -81,6 +81,8 @@
 #include "net/ipv6/multicast/uip-mcast6.h"
 #include "net/routing/routing.h"
 
+#include <string.h>
+
 #if UIP_ND6_SEND_NS
 #include "net/ipv6/uip-ds6-nbr.h"
 #endif /* UIP_ND6_SEND_NS */
@@ -123,6 +125,8 @@ uint16_t uip_ext_len = 0;
 /** \brief The final protocol after IPv6 extension headers:
   * UIP_PROTO_TCP, UIP_PROTO_UDP or UIP_PROTO_ICMP6 */
 uint8_t uip_last_proto = 0;
+/** \brief Whether uip_buf only holds the first fragment of a datagram */
+uint8_t uip_fragment_fwd = UIP_FRAGMENT_FWD_NONE;
 /** @} */
 
 /*---------------------------------------------------------------------------*/
@@ -140,9 +144,9 @@ uint8_t uip_last_proto = 0;
  * @{
  */
 /** Packet buffer for incoming and outgoing packets */
-#ifndef UIP_CONF_EXTERNAL_BUFFER
+#if !defined(UIP_CONF_EXTERNAL_BUFFER) && UIPBUF_POOL_SIZE <= 1
 uip_buf_t uip_aligned_buf;
-#endif /* UIP_CONF_EXTERNAL_BUFFER */
+#endif /* !UIP_CONF_EXTERNAL_BUFFER && UIPBUF_POOL_SIZE <= 1 */
 
 /* The uip_appdata pointer points to application data. */
 void *uip_appdata;
@@ -278,6 +282,65 @@ uip_add32(uint8_t *op32, uint16_t op16)
 
 #if ! UIP_ARCH_CHKSUM
 /*---------------------------------------------------------------------------*/
+#if UIP_CHKSUM_WIDE
+static uint16_t
+chksum(uint16_t sum, const uint8_t *data, uint16_t len)
+{
+  uint64_t acc;
+  uint32_t w;
+  uint16_t h;
+
+  /* The one's complement sum does not depend on the byte order
+     (RFC 1071), so the data is summed in host byte order and the
+     result swapped once. A 32-bit word is congruent to the sum of
+     its halves modulo 0xffff, and the 64-bit accumulator cannot
+     overflow for any 16-bit length, so carries are folded only at
+     the end. */
+  acc = uip_htons(sum);
+
+  while(len >= 16) {
+    memcpy(&w, data, 4);
+    acc += w;
+    memcpy(&w, data + 4, 4);
+    acc += w;
+    memcpy(&w, data + 8, 4);
+    acc += w;
+    memcpy(&w, data + 12, 4);
+    acc += w;
+    data += 16;
+    len -= 16;
+  }
+  while(len >= 4) {
+    memcpy(&w, data, 4);
+    acc += w;
+    data += 4;
+    len -= 4;
+  }
+  if(len >= 2) {
+    memcpy(&h, data, 2);
+    acc += h;
+    data += 2;
+    len -= 2;
+  }
+  if(len > 0) {
+    /* The last byte is the first byte of a zero-padded word */
+#if UIP_BYTE_ORDER == UIP_BIG_ENDIAN
+    acc += (uint16_t)data[0] << 8;
+#else /* UIP_BYTE_ORDER == UIP_BIG_ENDIAN */
+    acc += data[0];
+#endif /* UIP_BYTE_ORDER == UIP_BIG_ENDIAN */
+  }
+
+  /* Fold the carries back in. The result is only 0 if all words
+     were 0, as with the 16-bit loop. */
+  while(acc >> 16) {
+    acc = (acc & 0xffff) + (acc >> 16);
+  }
+
+  /* Return sum in host byte order. */
+  return uip_ntohs((uint16_t)acc);
+}
+#else /* UIP_CHKSUM_WIDE */
 static uint16_t
 chksum(uint16_t sum, const uint8_t *data, uint16_t len)
 {
@@ -308,6 +371,7 @@ chksum(uint16_t sum, const uint8_t *data, uint16_t len)
   /* Return sum in host byte order. */
   return sum;
 }
+#endif /* UIP_CHKSUM_WIDE */
 /*---------------------------------------------------------------------------*/
 uint16_t
 uip_chksum(uint16_t *data, uint16_t len)
@@ -1139,8 +1203,17 @@ uip_process(uint8_t flag)
    * If the size of uip_len is larger than the size reported in the IP
    * packet header, the packet has been padded, and we set uip_len to
    * the correct value.
+   *
+   * A first fragment that is tried for forwarding is shorter, and keeps
+   * its length.
    */
-  if(uip_len < uipbuf_get_len_field(UIP_IP_BUF)) {
+  if(uip_fragment_fwd == UIP_FRAGMENT_FWD_TRY) {
+    if(uip_len > uipbuf_get_len_field(UIP_IP_BUF) + UIP_IPH_LEN) {
+      UIP_STAT(++uip_stat.ip.drop);
+      LOG_ERR("fragment longer than reported in IP header\n");
+      goto drop;
+    }
+  } else if(uip_len < uipbuf_get_len_field(UIP_IP_BUF)) {
     UIP_STAT(++uip_stat.ip.drop);
     LOG_ERR("packet shorter than reported in IP header\n");
     goto drop;
@@ -1154,7 +1227,9 @@ uip_process(uint8_t flag)
    * the IPv4 header contains the length of the entire packet. But for
    * IPv6 we need to add the size of the IPv6 header (40 bytes).
    */
-  uip_len = uipbuf_get_len_field(UIP_IP_BUF) + UIP_IPH_LEN;
+  if(uip_fragment_fwd != UIP_FRAGMENT_FWD_TRY) {
+    uip_len = uipbuf_get_len_field(UIP_IP_BUF) + UIP_IPH_LEN;
+  }
 
   /* Check that the packet length is acceptable given our IP buffer size. */
   if(uip_len > sizeof(uip_buf)) {
@@ -1381,6 +1456,10 @@ uip_process(uint8_t flag)
       }
       break;
     case UIP_PROTO_FRAG:
+      if(uip_fragment_fwd == UIP_FRAGMENT_FWD_TRY) {
+        uip_fragment_fwd = UIP_FRAGMENT_FWD_REASSEMBLE;
+        goto drop;
+      }
       /* Fragmentation header:call the reassembly function, then leave */
 #if UIP_CONF_IPV6_REASSEMBLY
       LOG_INFO("Processing fragmentation header\n");
@@ -1410,6 +1489,12 @@ uip_process(uint8_t flag)
     }
   }
 
+  if(uip_fragment_fwd == UIP_FRAGMENT_FWD_TRY) {
+    /* The datagram is for us, let the link layer reassemble it */
+    uip_fragment_fwd = UIP_FRAGMENT_FWD_REASSEMBLE;
+    goto drop;
+  }
+
   /* Process upper-layer input */
   if(next_header != NULL) {
     switch(protocol) {
@@ -33,12 +33,20 @@
 #include "net/ipv6/uip.h"
 #include "net/ipv6/uipbuf.h"
 #include <string.h>
+#include <assert.h>
 
 /*---------------------------------------------------------------------------*/
 
 static uint16_t uipbuf_attrs[UIPBUF_ATTR_MAX];
 static uint16_t uipbuf_default_attrs[UIPBUF_ATTR_MAX];
 
+#if UIPBUF_POOL_SIZE > 1
+static uip_buf_t uipbuf_pool[UIPBUF_POOL_SIZE];
+/* The first buffer is in use by uip_buf from the start */
+static bool uipbuf_used[UIPBUF_POOL_SIZE] = { true };
+uip_buf_t *uip_bufptr = &uipbuf_pool[0];
+#endif /* UIPBUF_POOL_SIZE > 1 */
+
 /*---------------------------------------------------------------------------*/
 void
 uipbuf_clear(void)
@@ -236,6 +244,91 @@ uipbuf_is_attr_flag(uint16_t flag)
 {
   return (uipbuf_attrs[UIPBUF_ATTR_FLAGS] & flag) == flag;
 }
+#if UIPBUF_POOL_SIZE > 1
+/*---------------------------------------------------------------------------*/
+/* Move a pointer into one buffer to the same offset in another */
+static void
+rebase(void **ptr, uip_buf_t *from, uip_buf_t *to)
+{
+  uint8_t *p = *ptr;
+
+  if(p >= from->u8 && p <= from->u8 + UIP_BUFSIZE) {
+    *ptr = to->u8 + (p - from->u8);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+set_current(uip_buf_t *buf)
+{
+  rebase(&uip_appdata, uip_bufptr, buf);
+  rebase(&uip_sappdata, uip_bufptr, buf);
+#if UIP_URGDATA > 0
+  rebase(&uip_urgdata, uip_bufptr, buf);
+#endif /* UIP_URGDATA > 0 */
+  uip_bufptr = buf;
+}
+#endif /* UIPBUF_POOL_SIZE > 1 */
+/*---------------------------------------------------------------------------*/
+uip_buf_t *
+uipbuf_detach(void)
+{
+#if UIPBUF_POOL_SIZE > 1
+  uip_buf_t *detached;
+  int i;
+
+  for(i = 0; i < UIPBUF_POOL_SIZE; i++) {
+    if(!uipbuf_used[i]) {
+      uipbuf_used[i] = true;
+      detached = uip_bufptr;
+      set_current(&uipbuf_pool[i]);
+      return detached;
+    }
+  }
+#endif /* UIPBUF_POOL_SIZE > 1 */
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+void
+uipbuf_attach(uip_buf_t *buf)
+{
+#if UIPBUF_POOL_SIZE > 1
+  uip_buf_t *previous = uip_bufptr;
+
+  if(buf != NULL && buf != previous) {
+    set_current(buf);
+    uipbuf_release(previous);
+  }
+#endif /* UIPBUF_POOL_SIZE > 1 */
+}
+/*---------------------------------------------------------------------------*/
+void
+uipbuf_release(uip_buf_t *buf)
+{
+#if UIPBUF_POOL_SIZE > 1
+  /* uip_buf would be handed out again while it is in use */
+  assert(buf != uip_bufptr);
+  if(buf == uip_bufptr) {
+    return;
+  }
+  if(buf >= &uipbuf_pool[0] && buf < &uipbuf_pool[UIPBUF_POOL_SIZE]) {
+    uipbuf_used[buf - uipbuf_pool] = false;
+  }
+#endif /* UIPBUF_POOL_SIZE > 1 */
+}
+/*---------------------------------------------------------------------------*/
+int
+uipbuf_numfree(void)
+{
+  int count = 0;
+#if UIPBUF_POOL_SIZE > 1
+  int i;
+
+  for(i = 0; i < UIPBUF_POOL_SIZE; i++) {
+    count += !uipbuf_used[i];
+  }
+#endif /* UIPBUF_POOL_SIZE > 1 */
+  return count;
+}
 /*---------------------------------------------------------------------------*/
 void
 uipbuf_init(void)
@@ -35,6 +35,21 @@
 
 #include "contiki.h"
 struct uip_ip_hdr;
+union uip_packet_buf;
+
+/**
+ * \brief The number of packet buffers. uip_buf is a view onto one of
+ * them; the others hold packets that were detached from uip_buf, for
+ * instance while waiting for address resolution. The default has room
+ * for the packets of uip-packetqueue when packet queuing is enabled.
+ */
+#ifdef UIPBUF_CONF_POOL_SIZE
+#define UIPBUF_POOL_SIZE UIPBUF_CONF_POOL_SIZE
+#elif UIP_CONF_IPV6_QUEUE_PKT
+#define UIPBUF_POOL_SIZE (1 + UIP_CONF_IPV6_QUEUE_PKT_NUM)
+#else
+#define UIPBUF_POOL_SIZE 1
+#endif
 
 /**
  * \brief          Resets uIP buffer
@@ -178,6 +193,44 @@ void uipbuf_clear_attr(void);
  */
 void uipbuf_init(void);
 
+/**
+ * \brief          Detach the packet buffer from uip_buf, so that the
+ *                 packet it holds is kept while uip_buf is reused
+ * \retval         The buffer holding the packet, or NULL if no buffer
+ *                 of the pool is free to replace it
+ *
+ *                 uip_buf becomes a view onto a free buffer of the pool.
+ *                 No data is copied, and uip_len and the other packet
+ *                 variables are left to the caller.
+ */
+union uip_packet_buf *uipbuf_detach(void);
+
+/**
+ * \brief          Make uip_buf a view onto a detached buffer again
+ * \param buf      A buffer returned by uipbuf_detach()
+ *
+ *                 The buffer that uip_buf viewed before is released.
+ *                 Pointers such as uip_appdata that pointed into it are
+ *                 moved to the same offset in the new buffer.
+ */
+void uipbuf_attach(union uip_packet_buf *buf);
+
+/**
+ * \brief          Return a detached buffer to the pool
+ * \param buf      A buffer returned by uipbuf_detach()
+ *
+ *                 The buffer that uip_buf views is not detached and
+ *                 must not be released. This is asserted, and ignored
+ *                 when assertions are disabled.
+ */
+void uipbuf_release(union uip_packet_buf *buf);
+
+/**
+ * \brief          Get the number of free buffers in the pool
+ * \retval         The number of buffers that uipbuf_detach() can use
+ */
+int uipbuf_numfree(void);
+
 /**
  * \brief The bits defined for uipbuf attributes flag.
  *
@@ -232,6 +232,18 @@ void uip_log(char *msg);
 #define UIP_CONF_IPV6_QUEUE_PKT       0
 #endif
 
+#ifndef UIP_CONF_IPV6_QUEUE_PKT_NUM
+/** How many packets can wait for address resolution, for all neighbors
+    together. Each one holds a buffer of the uipbuf pool (default: 2) */
+#define UIP_CONF_IPV6_QUEUE_PKT_NUM   2
+#endif
+
+#ifndef UIP_CONF_IPV6_QUEUE_PKT_DEPTH
+/** How many of those packets a single %neighbor can hold. When it is
+    full, its oldest packet is dropped (default: 2) */
+#define UIP_CONF_IPV6_QUEUE_PKT_DEPTH 2
+#endif
+
 #ifndef UIP_CONF_IPV6_CHECKS
 /** Do we do IPv6 consistency checks (highly recommended, default: yes) */
 #define UIP_CONF_IPV6_CHECKS          1
@@ -587,6 +599,22 @@ void uip_log(char *msg);
 #define UIP_BYTE_ORDER     (UIP_LITTLE_ENDIAN)
 #endif /* UIP_CONF_BYTE_ORDER */
 
+/**
+ * Whether the Internet checksum is summed 32 bits at a time into a
+ * 64-bit accumulator, rather than 16 bits at a time with a carry
+ * check after each word. This is faster on CPUs with 32-bit or wider
+ * registers, where it is the default.
+ *
+ * \hideinitializer
+ */
+#ifdef UIP_CONF_CHKSUM_WIDE
+#define UIP_CHKSUM_WIDE    (UIP_CONF_CHKSUM_WIDE)
+#elif defined(__SIZEOF_POINTER__) && __SIZEOF_POINTER__ >= 4
+#define UIP_CHKSUM_WIDE    1
+#else /* UIP_CONF_CHKSUM_WIDE */
+#define UIP_CHKSUM_WIDE    0
+#endif /* UIP_CONF_CHKSUM_WIDE */
+
 /** @} */
 /*------------------------------------------------------------------------------*/
 
@@ -57,6 +57,9 @@
 #define LOG_MODULE "CSMA"
 #define LOG_LEVEL LOG_LEVEL_MAC
 
+/* Backoffs do not depend on the random numbers of other modules */
+RANDOM_STREAM(csma_random, RANDOM_STREAM_MAC);
+
 /* Constants of the IEEE 802.15.4 standard */
 
 /* macMinBE: Initial backoff exponent. Range 0--CSMA_MAX_BE */
@@ -170,79 +173,71 @@ send_one_packet(struct neighbor_queue *n, struct packet_queue *q)
 {
   int ret;
   int last_sent_ok = 0;
+  int is_broadcast;
+  uint8_t dsn;
+  /* The frame was created when it was queued, send it from its queuebuf */
+  uint8_t *frame = queuebuf_dataptr(q->buf);
+  int frame_len = queuebuf_datalen(q->buf);
 
-  packetbuf_set_addr(PACKETBUF_ADDR_SENDER, &linkaddr_node_addr);
-  packetbuf_set_attr(PACKETBUF_ATTR_MAC_ACK, 1);
+  /* Only the attributes go to packetbuf, for the radio driver, for the
+     next attempt and for the sent callback */
+  queuebuf_attr_to_packetbuf(q->buf);
 
-#if LLSEC802154_ENABLED
-#if LLSEC802154_USES_EXPLICIT_KEYS
-  /* This should possibly be taken from upper layers in the future */
-  packetbuf_set_attr(PACKETBUF_ATTR_KEY_ID_MODE, CSMA_LLSEC_KEY_ID_MODE);
-#endif /* LLSEC802154_USES_EXPLICIT_KEYS */
-#endif /* LLSEC802154_ENABLED */
+  dsn = frame[2] & 0xff;
 
-  if(csma_security_create_frame() < 0) {
-    /* Failed to allocate space for headers */
-    LOG_ERR("failed to create packet, seqno: %d\n", packetbuf_attr(PACKETBUF_ATTR_MAC_SEQNO));
-    ret = MAC_TX_ERR_FATAL;
-  } else {
-    int is_broadcast;
-    uint8_t dsn;
-    dsn = ((uint8_t *)packetbuf_hdrptr())[2] & 0xff;
+  NETSTACK_RADIO.prepare(frame, frame_len);
 
-    NETSTACK_RADIO.prepare(packetbuf_hdrptr(), packetbuf_totlen());
+  is_broadcast = linkaddr_cmp(queuebuf_addr(q->buf, PACKETBUF_ADDR_RECEIVER),
+                              &linkaddr_null);
 
-    is_broadcast = packetbuf_holds_broadcast();
+  if(NETSTACK_RADIO.receiving_packet() ||
+     (!is_broadcast && NETSTACK_RADIO.pending_packet())) {
 
-    if(NETSTACK_RADIO.receiving_packet() ||
-       (!is_broadcast && NETSTACK_RADIO.pending_packet())) {
-
-      /* Currently receiving a packet over air or the radio has
-         already received a packet that needs to be read before
-         sending with auto ack. */
-      ret = MAC_TX_COLLISION;
-    } else {
+    /* Currently receiving a packet over air or the radio has
+       already received a packet that needs to be read before
+       sending with auto ack. */
+    ret = MAC_TX_COLLISION;
+  } else {
 
-      switch(NETSTACK_RADIO.transmit(packetbuf_totlen())) {
-      case RADIO_TX_OK:
-        if(is_broadcast) {
-          ret = MAC_TX_OK;
-        } else {
-          /* Check for ack */
-
-          /* Wait for max CSMA_ACK_WAIT_TIME */
-          RTIMER_BUSYWAIT_UNTIL(NETSTACK_RADIO.pending_packet(), CSMA_ACK_WAIT_TIME);
-
-          ret = MAC_TX_NOACK;
-          if(NETSTACK_RADIO.receiving_packet() ||
-             NETSTACK_RADIO.pending_packet() ||
-             NETSTACK_RADIO.channel_clear() == 0) {
-            int len;
-            uint8_t ackbuf[CSMA_ACK_LEN];
-
-            /* Wait an additional CSMA_AFTER_ACK_DETECTED_WAIT_TIME to complete reception */
-            RTIMER_BUSYWAIT_UNTIL(NETSTACK_RADIO.pending_packet(), CSMA_AFTER_ACK_DETECTED_WAIT_TIME);
-
-            if(NETSTACK_RADIO.pending_packet()) {
-              len = NETSTACK_RADIO.read(ackbuf, CSMA_ACK_LEN);
-              if(len == CSMA_ACK_LEN && ackbuf[2] == dsn) {
-                /* Ack received */
-                ret = MAC_TX_OK;
-              } else {
-                /* Not an ack or ack not for us: collision */
-                ret = MAC_TX_COLLISION;
-              }
+    switch(NETSTACK_RADIO.transmit(frame_len)) {
+    case RADIO_TX_OK:
+      if(is_broadcast) {
+        ret = MAC_TX_OK;
+      } else {
+        /* Check for ack */
+
+        /* Wait for max CSMA_ACK_WAIT_TIME */
+        RTIMER_BUSYWAIT_UNTIL(NETSTACK_RADIO.pending_packet(), CSMA_ACK_WAIT_TIME);
+
+        ret = MAC_TX_NOACK;
+        if(NETSTACK_RADIO.receiving_packet() ||
+           NETSTACK_RADIO.pending_packet() ||
+           NETSTACK_RADIO.channel_clear() == 0) {
+          int len;
+          uint8_t ackbuf[CSMA_ACK_LEN];
+
+          /* Wait an additional CSMA_AFTER_ACK_DETECTED_WAIT_TIME to complete reception */
+          RTIMER_BUSYWAIT_UNTIL(NETSTACK_RADIO.pending_packet(), CSMA_AFTER_ACK_DETECTED_WAIT_TIME);
+
+          if(NETSTACK_RADIO.pending_packet()) {
+            len = NETSTACK_RADIO.read(ackbuf, CSMA_ACK_LEN);
+            if(len == CSMA_ACK_LEN && ackbuf[2] == dsn) {
+              /* Ack received */
+              ret = MAC_TX_OK;
+            } else {
+              /* Not an ack or ack not for us: collision */
+              ret = MAC_TX_COLLISION;
             }
           }
         }
-        break;
-      case RADIO_TX_COLLISION:
-        ret = MAC_TX_COLLISION;
-        break;
-      default:
-        ret = MAC_TX_ERR;
-        break;
       }
+      break;
+    case RADIO_TX_COLLISION:
+      ret = MAC_TX_COLLISION;
+      break;
+    default:
+      ret = MAC_TX_ERR;
+      break;
     }
   }
   if(ret == MAC_TX_OK) {
@@ -266,7 +261,6 @@ transmit_from_queue(void *ptr)
         queuebuf_attr(q->buf, PACKETBUF_ATTR_MAC_SEQNO),
         n->transmissions, list_length(n->packet_queue));
       /* Send first packet in the neighbor queue */
-      queuebuf_to_packetbuf(q->buf);
       send_one_packet(n, q);
     }
   }
@@ -284,7 +278,7 @@ schedule_transmission(struct neighbor_queue *n)
   delay = ((1 << backoff_exponent) - 1) * backoff_period();
   if(delay > 0) {
     /* Pick a time for next transmission */
-    delay = random_rand() % delay;
+    delay = random_stream_rand(&csma_random) % delay;
   }
 
   LOG_DBG("scheduling transmission in %u ticks, NB=%u, BE=%u\n",
@@ -416,7 +410,7 @@ packet_sent(struct neighbor_queue *n,
   LOG_INFO("tx to ");
   LOG_INFO_LLADDR(&n->addr);
   LOG_INFO_(", seqno %u, status %u, tx %u, coll %u\n",
-            packetbuf_attr(PACKETBUF_ATTR_MAC_SEQNO),
+            queuebuf_attr(q->buf, PACKETBUF_ATTR_MAC_SEQNO),
             status, n->transmissions, n->collisions);
 
   switch(status) {
@@ -449,7 +443,7 @@ csma_output_packet(mac_callback_t sent, void *ptr)
   if(!initialized) {
     initialized = 1;
     /* Initialize the sequence number to a random value as per 802.15.4. */
-    seqno = random_rand();
+    seqno = random_stream_rand(&csma_random);
   }
 
   if(seqno == 0) {
@@ -459,6 +453,24 @@ csma_output_packet(mac_callback_t sent, void *ptr)
   }
   packetbuf_set_attr(PACKETBUF_ATTR_MAC_SEQNO, seqno++);
   packetbuf_set_attr(PACKETBUF_ATTR_FRAME_TYPE, FRAME802154_DATAFRAME);
+  packetbuf_set_addr(PACKETBUF_ADDR_SENDER, &linkaddr_node_addr);
+  packetbuf_set_attr(PACKETBUF_ATTR_MAC_ACK, 1);
+
+#if LLSEC802154_ENABLED
+#if LLSEC802154_USES_EXPLICIT_KEYS
+  /* This should possibly be taken from upper layers in the future */
+  packetbuf_set_attr(PACKETBUF_ATTR_KEY_ID_MODE, CSMA_LLSEC_KEY_ID_MODE);
+#endif /* LLSEC802154_USES_EXPLICIT_KEYS */
+#endif /* LLSEC802154_ENABLED */
+
+  /* Create the frame once. It is queued as is, and every transmission
+     of it is sent from its queuebuf without copying it back. */
+  if(csma_security_create_frame() < 0) {
+    /* Failed to allocate space for headers */
+    LOG_ERR("failed to create packet, seqno: %d\n", packetbuf_attr(PACKETBUF_ATTR_MAC_SEQNO));
+    mac_call_sent_callback(sent, ptr, MAC_TX_ERR_FATAL, 1);
+    return;
+  }
 
   /* Look for the neighbor entry */
   n = neighbor_queue_from_addr(addr);
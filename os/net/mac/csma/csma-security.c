@@ -80,25 +80,38 @@ static const char * HEX = "0123456789ABCDEF";
 #endif /* LLSEC802154_USES_EXPLICIT_KEYS */
 
 /**
- *  The keys for LLSEC for CSMA
+ *  The keys for LLSEC for CSMA, prepared for CCM* once when they are set
+ *  rather than before each frame. Keys that were never set are all zeros.
  */
-typedef struct {
-  uint8_t u8[16];
-} aes_key_t;
-static aes_key_t keys[CSMA_LLSEC_MAXKEYS];
+static struct aes_128_context keys[CSMA_LLSEC_MAXKEYS];
+static uint8_t keys_initialized;
 
+/*---------------------------------------------------------------------------*/
+static void
+init_keys(void)
+{
+  static const uint8_t zero_key[AES_128_KEY_LENGTH];
+  uint8_t i;
+
+  if(!keys_initialized) {
+    for(i = 0; i < CSMA_LLSEC_MAXKEYS; i++) {
+      CCM_STAR.init_context(&keys[i], zero_key);
+    }
+    keys_initialized = 1;
+  }
+}
+/*---------------------------------------------------------------------------*/
 /* assumed to be 16 bytes */
 int
 csma_security_set_key(uint8_t index, const uint8_t *key)
 {
   if(key != NULL && index < CSMA_LLSEC_MAXKEYS) {
-    memcpy(keys[index].u8, key, 16);
+    init_keys();
+    CCM_STAR.init_context(&keys[index], key);
     return 1;
   }
   return 0;
 }
-
-#define N_KEYS (sizeof(keys) / sizeof(aes_key))
 /*---------------------------------------------------------------------------*/
 static int
 aead(uint8_t hdrlen, int forward)
@@ -114,7 +127,6 @@ aead(uint8_t hdrlen, int forward)
   uint8_t generated_mic[MIC_LEN(7)];
   uint8_t *mic;
   uint8_t key_index;
-  aes_key_t *key;
   uint8_t with_encryption;
 
   key_index = LLSEC_KEY_INDEX;
@@ -123,7 +135,7 @@ aead(uint8_t hdrlen, int forward)
     return 0;
   }
 
-  key = &keys[key_index];
+  init_keys();
 
   ccm_star_packetbuf_set_nonce(nonce, forward);
   totlen = packetbuf_totlen();
@@ -145,7 +157,7 @@ aead(uint8_t hdrlen, int forward)
   mic = a + totlen;
   result = forward ? mic : generated_mic;
 
-  CCM_STAR.set_key(key->u8);
+  CCM_STAR.set_context(&keys[key_index]);
   CCM_STAR.aead(nonce,
       m, m_len,
       a, a_len,
@@ -306,6 +306,16 @@
 #endif
 #endif
 
+/* The number of unicast neighbors that may get packets to send over
+ * shared links between two shared links, beyond which the neighbors
+ * ready to send are looked up again in the whole neighbor table.
+ * Must be power of two */
+#ifdef TSCH_QUEUE_CONF_NUM_READY_UPDATES
+#define TSCH_QUEUE_NUM_READY_UPDATES TSCH_QUEUE_CONF_NUM_READY_UPDATES
+#else
+#define TSCH_QUEUE_NUM_READY_UPDATES 8
+#endif
+
 /* The number of neighbor queues. There are two queues allocated at all times:
  * one for EBs, one for broadcasts. Other queues are for unicast to neighbors */
 #ifdef TSCH_QUEUE_CONF_MAX_NEIGHBOR_QUEUES
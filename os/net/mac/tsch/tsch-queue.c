@@ -62,6 +62,9 @@
 #define LOG_MODULE "TSCH Queue"
 #define LOG_LEVEL LOG_LEVEL_MAC
 
+/* Backoffs do not depend on the random numbers of other modules */
+RANDOM_STREAM(tsch_random, RANDOM_STREAM_MAC);
+
 /* Check if TSCH_QUEUE_NUM_PER_NEIGHBOR is power of two */
 #if (TSCH_QUEUE_NUM_PER_NEIGHBOR & (TSCH_QUEUE_NUM_PER_NEIGHBOR - 1)) != 0
 #error TSCH_QUEUE_NUM_PER_NEIGHBOR must be power of two
@@ -75,6 +78,138 @@ NBR_TABLE(struct tsch_neighbor, tsch_neighbors);
 struct tsch_neighbor *n_broadcast;
 struct tsch_neighbor *n_eb;
 
+/* The unicast neighbors we have no Tx link to send over shared
+ * broadcast links. Those with packets and an expired backoff are in the
+ * ready list, in the order they became ready, and those with a backoff
+ * window are in the backoff list. The lists are only changed by the
+ * slot operation. A neighbor may stop being ready from process context
+ * (its queue is flushed or a Tx link to it is added), in which case it
+ * is dropped from the ready list when met. */
+#define SHARED_LIST_NONE    0
+#define SHARED_LIST_READY   1
+#define SHARED_LIST_BACKOFF 2
+static struct tsch_neighbor *ready_head;
+static struct tsch_neighbor *ready_tail;
+static struct tsch_neighbor *backoff_head;
+/* The neighbors that may have become ready from process context */
+static struct tsch_neighbor *ready_updates_array[TSCH_QUEUE_NUM_READY_UPDATES];
+static struct ringbufindex ready_updates_ringbuf;
+/* Set when there were too many updates, the lists are then rebuilt */
+static volatile uint8_t ready_rebuild;
+
+/*---------------------------------------------------------------------------*/
+/* May the neighbor send over a shared broadcast link now? */
+static int
+is_ready(const struct tsch_neighbor *n)
+{
+  return !n->is_broadcast && n->tx_links_count == 0
+    && n->backoff_window == 0 && !ringbufindex_empty(&n->tx_ringbuf);
+}
+/*---------------------------------------------------------------------------*/
+/* Removes a neighbor from its list of neighbors for shared links */
+static void
+shared_list_remove(struct tsch_neighbor *n)
+{
+  struct tsch_neighbor **head;
+  struct tsch_neighbor *prev = NULL;
+  struct tsch_neighbor *curr;
+
+  if(n->shared_list == SHARED_LIST_NONE) {
+    return;
+  }
+  head = n->shared_list == SHARED_LIST_READY ? &ready_head : &backoff_head;
+  for(curr = *head; curr != n; curr = curr->next_shared) {
+    prev = curr;
+  }
+  if(prev == NULL) {
+    *head = n->next_shared;
+  } else {
+    prev->next_shared = n->next_shared;
+  }
+  if(n == ready_tail) {
+    ready_tail = prev;
+  }
+  n->next_shared = NULL;
+  n->shared_list = SHARED_LIST_NONE;
+}
+/*---------------------------------------------------------------------------*/
+/* Moves a neighbor to the list of neighbors for shared links that
+ * matches its state. Called from the slot operation only. */
+static void
+shared_list_update(struct tsch_neighbor *n)
+{
+  uint8_t list = SHARED_LIST_NONE;
+
+  if(!n->is_broadcast && n->tx_links_count == 0) {
+    if(n->backoff_window != 0) {
+      list = SHARED_LIST_BACKOFF;
+    } else if(!ringbufindex_empty(&n->tx_ringbuf)) {
+      list = SHARED_LIST_READY;
+    }
+  }
+  if(list != n->shared_list) {
+    shared_list_remove(n);
+    if(list == SHARED_LIST_READY) {
+      if(ready_tail == NULL) {
+        ready_head = n;
+      } else {
+        ready_tail->next_shared = n;
+      }
+      ready_tail = n;
+    } else if(list == SHARED_LIST_BACKOFF) {
+      n->next_shared = backoff_head;
+      backoff_head = n;
+    }
+    n->shared_list = list;
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Tells the slot operation that a neighbor may have become ready.
+ * Called from process context only. */
+static void
+shared_list_notify(struct tsch_neighbor *n)
+{
+  if(n->shared_list == SHARED_LIST_NONE
+     && !n->is_broadcast && n->tx_links_count == 0) {
+    int16_t put_index = ringbufindex_peek_put(&ready_updates_ringbuf);
+    if(put_index != -1) {
+      ready_updates_array[put_index] = n;
+      ringbufindex_put(&ready_updates_ringbuf);
+    } else {
+      ready_rebuild = 1;
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Applies the updates from process context to the lists of neighbors
+ * for shared links */
+static void
+shared_list_sync(void)
+{
+  int16_t get_index;
+
+  if(ready_rebuild) {
+    struct tsch_neighbor *n;
+    ready_rebuild = 0;
+    while(ready_head != NULL) {
+      shared_list_remove(ready_head);
+    }
+    while(backoff_head != NULL) {
+      shared_list_remove(backoff_head);
+    }
+    while(ringbufindex_get(&ready_updates_ringbuf) != -1) {
+      /* All neighbors are updated below */
+    }
+    n = (struct tsch_neighbor *)nbr_table_head(tsch_neighbors);
+    while(n != NULL) {
+      shared_list_update(n);
+      n = (struct tsch_neighbor *)nbr_table_next(tsch_neighbors, n);
+    }
+  }
+  while((get_index = ringbufindex_get(&ready_updates_ringbuf)) != -1) {
+    shared_list_update(ready_updates_array[get_index]);
+  }
+}
 /*---------------------------------------------------------------------------*/
 /* Add a TSCH neighbor */
 struct tsch_neighbor *
@@ -211,15 +346,17 @@ static void
 tsch_queue_remove_nbr(struct tsch_neighbor *n)
 {
   if(n != NULL) {
-    if(tsch_get_lock()) {
-
-      tsch_release_lock();
-
-      /* Flush queue */
-      tsch_queue_flush_nbr_queue(n);
+    /* Flush queue. The sent callbacks are called without the lock. */
+    tsch_queue_flush_nbr_queue(n);
 
+    if(tsch_get_lock()) {
+      /* The neighbor leaves the lists for shared links and the table
+         at once, so that the slot operation never sees it in one only */
+      shared_list_sync();
+      shared_list_remove(n);
       /* Free neighbor */
       nbr_table_remove(tsch_neighbors, n);
+      tsch_release_lock();
     }
   }
 }
@@ -260,6 +397,7 @@ tsch_queue_add_packet(const linkaddr_t *addr, uint8_t max_transmissions,
             /* Add to ringbuf (actual add committed through atomic operation) */
             n->tx_array[put_index] = p;
             ringbufindex_put(&n->tx_ringbuf);
+            shared_list_notify(n);
             LOG_DBG("packet is added put_index %u, packet %p\n",
                    put_index, p);
             return p;
@@ -372,6 +510,8 @@ tsch_queue_packet_sent(struct tsch_neighbor *n, struct tsch_packet *p,
     }
   }
 
+  shared_list_update(n);
+
   return in_queue;
 }
 /*---------------------------------------------------------------------------*/
@@ -390,6 +530,7 @@ tsch_queue_reset(void)
       tsch_queue_backoff_reset(n);
       n = next_n;
     }
+    ready_rebuild = 1;
   }
 }
 /*---------------------------------------------------------------------------*/
@@ -464,11 +605,17 @@ struct tsch_packet *
 tsch_queue_get_unicast_packet_for_any(struct tsch_neighbor **n, struct tsch_link *link)
 {
   if(!tsch_is_locked()) {
-    struct tsch_neighbor *curr_nbr = (struct tsch_neighbor *)nbr_table_head(tsch_neighbors);
+    int is_shared_link = link != NULL && link->link_options & LINK_OPTION_SHARED;
+    struct tsch_neighbor *curr_nbr;
+    struct tsch_neighbor *next_nbr;
     struct tsch_packet *p = NULL;
-    while(curr_nbr != NULL) {
-      if(!curr_nbr->is_broadcast && curr_nbr->tx_links_count == 0) {
-        /* Only look up for non-broadcast neighbors we do not have a tx link to */
+    shared_list_sync();
+    /* Only look up for non-broadcast neighbors we do not have a tx link to */
+    for(curr_nbr = ready_head; curr_nbr != NULL; curr_nbr = next_nbr) {
+      next_nbr = curr_nbr->next_shared;
+      if(!is_ready(curr_nbr)) {
+        shared_list_update(curr_nbr);
+      } else {
         p = tsch_queue_get_packet_for_nbr(curr_nbr, link);
         if(p != NULL) {
           if(n != NULL) {
@@ -477,7 +624,20 @@ tsch_queue_get_unicast_packet_for_any(struct tsch_neighbor **n, struct tsch_link
           return p;
         }
       }
-      curr_nbr = (struct tsch_neighbor *)nbr_table_next(tsch_neighbors, curr_nbr);
+    }
+    if(!is_shared_link) {
+      /* Neighbors in backoff may also transmit over a dedicated link */
+      for(curr_nbr = backoff_head; curr_nbr != NULL; curr_nbr = curr_nbr->next_shared) {
+        if(!curr_nbr->is_broadcast && curr_nbr->tx_links_count == 0) {
+          p = tsch_queue_get_packet_for_nbr(curr_nbr, link);
+          if(p != NULL) {
+            if(n != NULL) {
+              *n = curr_nbr;
+            }
+            return p;
+          }
+        }
+      }
     }
   }
   return NULL;
@@ -504,10 +664,9 @@ tsch_queue_backoff_inc(struct tsch_neighbor *n)
 {
   /* Increment exponent */
   n->backoff_exponent = MIN(n->backoff_exponent + 1, TSCH_MAC_MAX_BE);
-  /* Pick a window (number of shared slots to skip). Ignore least significant
-   * few bits, which, on some embedded implementations of rand (e.g. msp430-libc),
-   * are known to have poor pseudo-random properties. */
-  n->backoff_window = (random_rand() >> 6) % (1 << n->backoff_exponent);
+  /* Pick a window (number of shared slots to skip) */
+  n->backoff_window = random_stream_rand(&tsch_random) %
+    (1 << n->backoff_exponent);
   /* Add one to the window as we will decrement it at the end of the current slot
    * through tsch_queue_update_all_backoff_windows */
   n->backoff_window++;
@@ -519,24 +678,53 @@ tsch_queue_update_all_backoff_windows(const linkaddr_t *dest_addr)
 {
   if(!tsch_is_locked()) {
     int is_broadcast = linkaddr_cmp(dest_addr, &tsch_broadcast_address);
-    struct tsch_neighbor *n = (struct tsch_neighbor *)nbr_table_head(tsch_neighbors);
-    while(n != NULL) {
-      if(n->backoff_window != 0 /* Is the queue in backoff state? */
-         && ((n->tx_links_count == 0 && is_broadcast)
-             || (n->tx_links_count > 0 && linkaddr_cmp(dest_addr, tsch_queue_get_nbr_address(n))))) {
+    struct tsch_neighbor *n;
+    if(is_broadcast) {
+      /* The queues we have no tx link to, which are in backoff state */
+      struct tsch_neighbor **prev = &backoff_head;
+      shared_list_sync();
+      while((n = *prev) != NULL) {
+        if(n->backoff_window != 0 && n->tx_links_count == 0) {
+          n->backoff_window--;
+        }
+        if(n->backoff_window == 0 || n->tx_links_count != 0) {
+          /* Leave the backoff list, for the ready list if there are packets */
+          *prev = n->next_shared;
+          n->next_shared = NULL;
+          n->shared_list = SHARED_LIST_NONE;
+          shared_list_update(n);
+        } else {
+          prev = &n->next_shared;
+        }
+      }
+    } else {
+      /* The queue we have a tx link to */
+      n = tsch_queue_get_nbr(dest_addr);
+      if(n != NULL && n->backoff_window != 0 && n->tx_links_count > 0) {
         n->backoff_window--;
       }
-      n = (struct tsch_neighbor *)nbr_table_next(tsch_neighbors, n);
     }
   }
 }
 /*---------------------------------------------------------------------------*/
+/* The Tx links to a neighbor changed */
+void
+tsch_queue_tx_links_updated(struct tsch_neighbor *n)
+{
+  if(n != NULL) {
+    shared_list_notify(n);
+  }
+}
+/*---------------------------------------------------------------------------*/
 /* Initialize TSCH queue module */
 void
 tsch_queue_init(void)
 {
   nbr_table_register(tsch_neighbors, NULL);
   memb_init(&packet_memb);
+  ringbufindex_init(&ready_updates_ringbuf, TSCH_QUEUE_NUM_READY_UPDATES);
+  ready_head = ready_tail = backoff_head = NULL;
+  ready_rebuild = 0;
   /* Add virtual EB and the broadcast neighbors */
   n_eb = tsch_queue_add_nbr(&tsch_eb_address);
   n_broadcast = tsch_queue_add_nbr(&tsch_broadcast_address);
@@ -184,6 +184,12 @@ void tsch_queue_backoff_inc(struct tsch_neighbor *n);
  * \param dest_addr The target address, &tsch_broadcast_address for broadcast
  */
 void tsch_queue_update_all_backoff_windows(const linkaddr_t *dest_addr);
+/**
+ * \brief Tell the queue module that the Tx links to a neighbor changed.
+ * Neighbors we have no Tx link to send over shared broadcast links.
+ * \param n The neighbor queue
+ */
+void tsch_queue_tx_links_updated(struct tsch_neighbor *n);
 /**
  * \brief Initialize TSCH queue module
  */
@@ -67,6 +67,83 @@ MEMB(link_memb, struct tsch_link, TSCH_SCHEDULE_MAX_LINKS);
 MEMB(slotframe_memb, struct tsch_slotframe, TSCH_SCHEDULE_MAX_SLOTFRAMES);
 /* List of slotframes (each slotframe holds its own list of links) */
 LIST(slotframe_list);
+/* The links of all slotframes, in the order of the slotframe list, and
+ * sorted by timeslot within a slotframe. Links of the same timeslot are
+ * in the order of the list of their slotframe. */
+static struct tsch_link *link_index[TSCH_SCHEDULE_MAX_LINKS];
+static uint16_t link_index_len;
+
+/*---------------------------------------------------------------------------*/
+/* Returns the position of the first link of a slotframe in the link index */
+static uint16_t
+link_index_start(struct tsch_slotframe *slotframe)
+{
+  struct tsch_slotframe *sf;
+  uint16_t start = 0;
+
+  for(sf = list_head(slotframe_list); sf != slotframe; sf = list_item_next(sf)) {
+    start += sf->links_count;
+  }
+  return start;
+}
+/*---------------------------------------------------------------------------*/
+/* Returns the position of the first of count links from start in the
+ * link index whose timeslot is after the given one, or start + count */
+static uint16_t
+link_index_after(uint16_t start, uint16_t count, uint16_t timeslot)
+{
+  uint16_t half;
+
+  while(count > 0) {
+    half = count / 2;
+    if(link_index[start + half]->timeslot <= timeslot) {
+      start += half + 1;
+      count -= half + 1;
+    } else {
+      count = half;
+    }
+  }
+  return start;
+}
+/*---------------------------------------------------------------------------*/
+/* Same as link_index_after, for the first link at the given timeslot or after */
+static uint16_t
+link_index_from(uint16_t start, uint16_t count, uint16_t timeslot)
+{
+  return timeslot == 0 ? start : link_index_after(start, count, timeslot - 1);
+}
+/*---------------------------------------------------------------------------*/
+static void
+link_index_add(struct tsch_slotframe *slotframe, struct tsch_link *l)
+{
+  uint16_t pos;
+
+  /* After the links of the same timeslot, as in the list of links */
+  pos = link_index_after(link_index_start(slotframe), slotframe->links_count,
+                         l->timeslot);
+  memmove(&link_index[pos + 1], &link_index[pos],
+          (link_index_len - pos) * sizeof(link_index[0]));
+  link_index[pos] = l;
+  link_index_len++;
+  slotframe->links_count++;
+}
+/*---------------------------------------------------------------------------*/
+static void
+link_index_remove(struct tsch_slotframe *slotframe, struct tsch_link *l)
+{
+  uint16_t pos;
+
+  pos = link_index_from(link_index_start(slotframe), slotframe->links_count,
+                        l->timeslot);
+  while(link_index[pos] != l) {
+    pos++;
+  }
+  link_index_len--;
+  slotframe->links_count--;
+  memmove(&link_index[pos], &link_index[pos + 1],
+          (link_index_len - pos) * sizeof(link_index[0]));
+}
+/*---------------------------------------------------------------------------*/
 
 /* Adds and returns a slotframe (NULL if failure) */
 struct tsch_slotframe *
@@ -88,6 +165,9 @@ tsch_schedule_add_slotframe(uint16_t handle, uint16_t size)
       sf->handle = handle;
       TSCH_ASN_DIVISOR_INIT(sf->size, size);
       LIST_STRUCT_INIT(sf, links_list);
+      sf->links_count = 0;
+      TSCH_ASN_INIT(sf->last_asn, 0, 0);
+      sf->last_timeslot = 0;
       /* Add the slotframe to the global list */
       list_add(slotframe_list, sf);
     }
@@ -256,6 +336,7 @@ tsch_schedule_add_link(struct tsch_slotframe *slotframe,
           address = &linkaddr_null;
         }
         linkaddr_copy(&l->addr, address);
+        link_index_add(slotframe, l);
 
         LOG_INFO("add_link sf=%u opt=%s type=%s ts=%u ch=%u addr=",
                  slotframe->handle,
@@ -309,6 +390,7 @@ tsch_schedule_remove_link(struct tsch_slotframe *slotframe, struct tsch_link *l)
       LOG_INFO_("\n");
 
       list_remove(slotframe->links_list, l);
+      link_index_remove(slotframe, l);
       memb_free(&link_memb, l);
 
       /* Release the lock before we update the neighbor (will take the lock) */
@@ -322,6 +404,7 @@ tsch_schedule_remove_link(struct tsch_slotframe *slotframe, struct tsch_link *l)
           if(!(link_options & LINK_OPTION_SHARED)) {
             n->dedicated_tx_links_count--;
           }
+          tsch_queue_tx_links_updated(n);
         }
       }
 
@@ -364,15 +447,15 @@ tsch_schedule_get_link_by_timeslot(struct tsch_slotframe *slotframe,
 {
   if(!tsch_is_locked()) {
     if(slotframe != NULL) {
-      struct tsch_link *l = list_head(slotframe->links_list);
-      /* Loop over all items. Assume there is max one link per timeslot and channel_offset */
-      while(l != NULL) {
-        if(l->timeslot == timeslot && l->channel_offset == channel_offset) {
-          return l;
+      uint16_t start = link_index_start(slotframe);
+      uint16_t end = start + slotframe->links_count;
+      uint16_t i = link_index_from(start, slotframe->links_count, timeslot);
+      /* Loop over the links of the timeslot. Assume there is max one link per timeslot and channel_offset */
+      for(; i < end && link_index[i]->timeslot == timeslot; i++) {
+        if(link_index[i]->channel_offset == channel_offset) {
+          return link_index[i];
         }
-        l = list_item_next(l);
       }
-      return l;
     }
   }
   return NULL;
@@ -400,6 +483,75 @@ default_tsch_link_comparator(struct tsch_link *a, struct tsch_link *b)
   return a;
 }
 
+/*---------------------------------------------------------------------------*/
+/* Selects one of the current best link and another link of the same
+ * timeslot, and maintains the backup link */
+static void
+select_overlapping_link(struct tsch_link **curr_best, struct tsch_link **curr_backup,
+                        struct tsch_link *l)
+{
+  struct tsch_link *new_best = NULL;
+  /* Two links are overlapping, we need to select one of them.
+   * By standard: prioritize Tx links first, second by lowest handle */
+  if(((*curr_best)->link_options & LINK_OPTION_TX) == (l->link_options & LINK_OPTION_TX)) {
+    /* Both or neither links have Tx, select the one with lowest handle */
+    if(l->slotframe_handle != (*curr_best)->slotframe_handle) {
+      if(l->slotframe_handle < (*curr_best)->slotframe_handle) {
+        new_best = l;
+      }
+    } else {
+      /* compare the link against the current best link and return the newly selected one */
+      new_best = TSCH_LINK_COMPARATOR(*curr_best, l);
+    }
+  } else {
+    /* Select the link that has the Tx option */
+    if(l->link_options & LINK_OPTION_TX) {
+      new_best = l;
+    }
+  }
+
+  /* Maintain backup_link */
+  /* Check if 'l' best can be used as backup */
+  if(new_best != l && (l->link_options & LINK_OPTION_RX)) { /* Does 'l' have Rx flag? */
+    if(*curr_backup == NULL || l->slotframe_handle < (*curr_backup)->slotframe_handle) {
+      *curr_backup = l;
+    }
+  }
+  /* Check if curr_best can be used as backup */
+  if(new_best != *curr_best && ((*curr_best)->link_options & LINK_OPTION_RX)) { /* Does curr_best have Rx flag? */
+    if(*curr_backup == NULL || (*curr_best)->slotframe_handle < (*curr_backup)->slotframe_handle) {
+      *curr_backup = *curr_best;
+    }
+  }
+
+  /* Maintain curr_best */
+  if(new_best != NULL) {
+    *curr_best = new_best;
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Returns the timeslot of an ASN in a slotframe. The next link is
+ * looked up a few timeslots after the previous one, which saves the
+ * divisions of TSCH_ASN_MOD */
+static uint16_t
+slotframe_timeslot(struct tsch_slotframe *sf, struct tsch_asn_t *asn)
+{
+  uint32_t diff = TSCH_ASN_DIFF(*asn, sf->last_asn);
+  uint16_t timeslot;
+
+  if(diff < sf->size.val
+     && asn->ms1b == sf->last_asn.ms1b + (asn->ls4b < sf->last_asn.ls4b)) {
+    timeslot = sf->last_timeslot + diff;
+    if(timeslot >= sf->size.val) {
+      timeslot -= sf->size.val;
+    }
+  } else {
+    timeslot = TSCH_ASN_MOD(*asn, sf->size);
+  }
+  sf->last_asn = *asn;
+  sf->last_timeslot = timeslot;
+  return timeslot;
+}
 /*---------------------------------------------------------------------------*/
 /* Returns the next active link after a given ASN, and a backup link (for the same ASN, with Rx flag) */
 struct tsch_link *
@@ -414,63 +566,38 @@ tsch_schedule_get_next_active_link(struct tsch_asn_t *asn, uint16_t *time_offset
   must have Rx flag set. */
   if(!tsch_is_locked()) {
     struct tsch_slotframe *sf = list_head(slotframe_list);
+    uint16_t start = 0;
     /* For each slotframe, look for the earliest occurring link */
     while(sf != NULL) {
-      /* Get timeslot from ASN, given the slotframe length */
-      uint16_t timeslot = TSCH_ASN_MOD(*asn, sf->size);
-      struct tsch_link *l = list_head(sf->links_list);
-      while(l != NULL) {
-        uint16_t time_to_timeslot =
-          l->timeslot > timeslot ?
-          l->timeslot - timeslot :
-          sf->size.val + l->timeslot - timeslot;
+      uint16_t end = start + sf->links_count;
+      if(sf->links_count > 0) {
+        /* Get timeslot from ASN, given the slotframe length */
+        uint16_t timeslot = slotframe_timeslot(sf, asn);
+        uint16_t i = link_index_after(start, sf->links_count, timeslot);
+        uint16_t time_to_timeslot;
+        uint16_t next_timeslot;
+        if(i == end) {
+          /* Wrap around to the first link of the next slotframe cycle */
+          i = start;
+          time_to_timeslot = sf->size.val + link_index[i]->timeslot - timeslot;
+        } else {
+          time_to_timeslot = link_index[i]->timeslot - timeslot;
+        }
+        next_timeslot = link_index[i]->timeslot;
         if(curr_best == NULL || time_to_timeslot < time_to_curr_best) {
           time_to_curr_best = time_to_timeslot;
-          curr_best = l;
+          curr_best = link_index[i];
           curr_backup = NULL;
-        } else if(time_to_timeslot == time_to_curr_best) {
-          struct tsch_link *new_best = NULL;
-          /* Two links are overlapping, we need to select one of them.
-           * By standard: prioritize Tx links first, second by lowest handle */
-          if((curr_best->link_options & LINK_OPTION_TX) == (l->link_options & LINK_OPTION_TX)) {
-            /* Both or neither links have Tx, select the one with lowest handle */
-            if(l->slotframe_handle != curr_best->slotframe_handle) {
-              if(l->slotframe_handle < curr_best->slotframe_handle) {
-                new_best = l;
-              }
-            } else {
-              /* compare the link against the current best link and return the newly selected one */
-              new_best = TSCH_LINK_COMPARATOR(curr_best, l);
-            }
-          } else {
-            /* Select the link that has the Tx option */
-            if(l->link_options & LINK_OPTION_TX) {
-              new_best = l;
-            }
-          }
-
-          /* Maintain backup_link */
-          /* Check if 'l' best can be used as backup */
-          if(new_best != l && (l->link_options & LINK_OPTION_RX)) { /* Does 'l' have Rx flag? */
-            if(curr_backup == NULL || l->slotframe_handle < curr_backup->slotframe_handle) {
-              curr_backup = l;
-            }
-          }
-          /* Check if curr_best can be used as backup */
-          if(new_best != curr_best && (curr_best->link_options & LINK_OPTION_RX)) { /* Does curr_best have Rx flag? */
-            if(curr_backup == NULL || curr_best->slotframe_handle < curr_backup->slotframe_handle) {
-              curr_backup = curr_best;
-            }
-          }
-
-          /* Maintain curr_best */
-          if(new_best != NULL) {
-            curr_best = new_best;
+          i++;
+        }
+        if(time_to_timeslot == time_to_curr_best) {
+          /* The other links of the timeslot overlap with the best one */
+          for(; i < end && link_index[i]->timeslot == next_timeslot; i++) {
+            select_overlapping_link(&curr_best, &curr_backup, link_index[i]);
           }
         }
-
-        l = list_item_next(l);
       }
+      start = end;
       sf = list_item_next(sf);
     }
     if(time_offset != NULL) {
@@ -491,6 +618,7 @@ tsch_schedule_init(void)
     memb_init(&link_memb);
     memb_init(&slotframe_memb);
     list_init(slotframe_list);
+    link_index_len = 0;
     tsch_release_lock();
     return 1;
   } else {
@@ -67,6 +67,24 @@ static aes_key keys[] = {
 };
 #define N_KEYS (sizeof(keys) / sizeof(aes_key))
 
+/* The keys, prepared for CCM* on first use rather than before each frame */
+static struct aes_128_context key_contexts[N_KEYS];
+static uint8_t key_contexts_initialized;
+
+/*---------------------------------------------------------------------------*/
+static void
+tsch_security_set_key(uint8_t key_index)
+{
+  uint8_t i;
+
+  if(!key_contexts_initialized) {
+    for(i = 0; i < N_KEYS; i++) {
+      CCM_STAR.init_context(&key_contexts[i], keys[i]);
+    }
+    key_contexts_initialized = 1;
+  }
+  CCM_STAR.set_context(&key_contexts[key_index - 1]);
+}
 /*---------------------------------------------------------------------------*/
 static void
 tsch_security_init_nonce(uint8_t *nonce,
@@ -193,7 +211,7 @@ tsch_security_secure_frame(uint8_t *hdr, uint8_t *outbuf,
     memcpy(outbuf, hdr, a_len + m_len);
   }
 
-  CCM_STAR.set_key(keys[key_index - 1]);
+  tsch_security_set_key(key_index);
 
   CCM_STAR.aead(nonce,
                 outbuf + a_len, m_len,
@@ -258,7 +276,7 @@ tsch_security_parse_frame(const uint8_t *hdr, int hdrlen, int datalen,
     m_len = 0;
   }
 
-  CCM_STAR.set_key(keys[key_index - 1]);
+  tsch_security_set_key(key_index);
 
   CCM_STAR.aead(nonce,
                 (uint8_t *)hdr + a_len, m_len,
@@ -91,6 +91,12 @@ struct tsch_slotframe {
   struct tsch_asn_divisor_t size;
   /* List of links belonging to this slotframe */
   LIST_STRUCT(links_list);
+  /* Number of links, which are also sorted by timeslot in the link
+   * index of the schedule */
+  uint16_t links_count;
+  /* The timeslot of the last ASN the next link was looked up for */
+  struct tsch_asn_t last_asn;
+  uint16_t last_timeslot;
 };
 
 /** \brief TSCH packet information */
@@ -114,6 +120,8 @@ struct tsch_neighbor {
   uint8_t last_backoff_window; /* Last CSMA backoff window */
   uint8_t tx_links_count; /* How many links do we have to this neighbor? */
   uint8_t dedicated_tx_links_count; /* How many dedicated links do we have to this neighbor? */
+  uint8_t shared_list; /* Which list of neighbors for shared links is this neighbor in? */
+  struct tsch_neighbor *next_shared; /* The next neighbor in that list */
   /* Array for the ringbuf. Contains pointers to packets.
    * Its size must be a power of two to allow for atomic put */
   struct tsch_packet *tx_array[TSCH_QUEUE_NUM_PER_NEIGHBOR];
@@ -70,6 +70,17 @@ static unsigned num_tables;
 MEMB(neighbor_addr_mem, nbr_table_key_t, NBR_TABLE_MAX_NEIGHBORS);
 LIST(nbr_table_keys);
 
+#if NBR_TABLE_HASH_SIZE
+/* Open-addressed index of the neighbor address table, with linear
+ * probing. A slot holds the neighbor index plus one, 0 is free. */
+#if NBR_TABLE_MAX_NEIGHBORS < 255
+typedef uint8_t nbr_hash_slot_t;
+#else
+typedef uint16_t nbr_hash_slot_t;
+#endif
+static nbr_hash_slot_t nbr_hash[NBR_TABLE_HASH_SIZE];
+#endif /* NBR_TABLE_HASH_SIZE */
+
 /*---------------------------------------------------------------------------*/
 static void remove_key(nbr_table_key_t *key, bool do_free);
 /*---------------------------------------------------------------------------*/
@@ -115,16 +126,87 @@ key_from_item(nbr_table_t *table, const nbr_table_item_t *item)
   return key_from_index(index_from_item(table, item));
 }
 /*---------------------------------------------------------------------------*/
+#if NBR_TABLE_HASH_SIZE
+/* Home slot of a link-layer address in the index */
+static unsigned
+hash_slot(const linkaddr_t *lladdr)
+{
+  uint32_t h = 0x811c9dc5;
+  int i;
+
+  for(i = 0; i < LINKADDR_SIZE; i++) {
+    h = (h ^ lladdr->u8[i]) * 0x01000193;
+  }
+  return (h ^ (h >> 16)) % NBR_TABLE_HASH_SIZE;
+}
+/*---------------------------------------------------------------------------*/
+/* Add a key to the index. There is always a free slot, as the index
+ * is larger than the neighbor table. */
+static void
+hash_add(nbr_table_key_t *key)
+{
+  unsigned i = hash_slot(&key->lladdr);
+
+  while(nbr_hash[i] != 0) {
+    i = (i + 1) % NBR_TABLE_HASH_SIZE;
+  }
+  nbr_hash[i] = index_from_key(key) + 1;
+}
+/*---------------------------------------------------------------------------*/
+/* Remove a key from the index, and move the entries that follow it in
+ * the same probe sequence back so that no lookup stops early. */
+static void
+hash_remove(nbr_table_key_t *key)
+{
+  unsigned i = hash_slot(&key->lladdr);
+  unsigned j;
+  unsigned home;
+  int index = index_from_key(key);
+
+  while(nbr_hash[i] != index + 1) {
+    if(nbr_hash[i] == 0) {
+      return;
+    }
+    i = (i + 1) % NBR_TABLE_HASH_SIZE;
+  }
+
+  for(j = (i + 1) % NBR_TABLE_HASH_SIZE; nbr_hash[j] != 0;
+      j = (j + 1) % NBR_TABLE_HASH_SIZE) {
+    home = hash_slot(&key_from_index(nbr_hash[j] - 1)->lladdr);
+    /* Leave the entry if its home slot lies cyclically in (i, j] */
+    if(i <= j ? (i < home && home <= j) : (i < home || home <= j)) {
+      continue;
+    }
+    nbr_hash[i] = nbr_hash[j];
+    i = j;
+  }
+  nbr_hash[i] = 0;
+}
+#endif /* NBR_TABLE_HASH_SIZE */
+/*---------------------------------------------------------------------------*/
 /* Get the index of a neighbor from its link-layer address */
 static int
 index_from_lladdr(const linkaddr_t *lladdr)
 {
+#if NBR_TABLE_HASH_SIZE
+  unsigned i;
+#else /* NBR_TABLE_HASH_SIZE */
   nbr_table_key_t *key;
+#endif /* NBR_TABLE_HASH_SIZE */
   /* Allow lladdr-free insertion, useful e.g. for IPv6 ND.
    * Only one such entry is possible at a time, indexed by linkaddr_null. */
   if(lladdr == NULL) {
     lladdr = &linkaddr_null;
   }
+#if NBR_TABLE_HASH_SIZE
+  for(i = hash_slot(lladdr); nbr_hash[i] != 0;
+      i = (i + 1) % NBR_TABLE_HASH_SIZE) {
+    if(linkaddr_cmp(lladdr, &key_from_index(nbr_hash[i] - 1)->lladdr)) {
+      return nbr_hash[i] - 1;
+    }
+  }
+  return -1;
+#else /* NBR_TABLE_HASH_SIZE */
   key = list_head(nbr_table_keys);
   while(key != NULL) {
     if(lladdr && linkaddr_cmp(lladdr, &key->lladdr)) {
@@ -133,6 +215,7 @@ index_from_lladdr(const linkaddr_t *lladdr)
     key = list_item_next(key);
   }
   return -1;
+#endif /* NBR_TABLE_HASH_SIZE */
 }
 /*---------------------------------------------------------------------------*/
 /* Get bit from "used" or "locked" bitmap */
@@ -185,6 +268,9 @@ remove_key(nbr_table_key_t *key, bool do_free)
   locked_map[index_from_key(key)] = 0;
   /* Remove neighbor from list */
   list_remove(nbr_table_keys, key);
+#if NBR_TABLE_HASH_SIZE
+  hash_remove(key);
+#endif /* NBR_TABLE_HASH_SIZE */
   if(do_free) {
     /* Release the memory */
     memb_free(&neighbor_addr_mem, key);
@@ -426,6 +512,9 @@ nbr_table_add_lladdr(nbr_table_t *table, const linkaddr_t *lladdr, nbr_table_rea
 
     /* Set link-layer address */
     linkaddr_copy(&key->lladdr, lladdr);
+#if NBR_TABLE_HASH_SIZE
+    hash_add(key);
+#endif /* NBR_TABLE_HASH_SIZE */
   }
 
   /* Get item in the current table */
@@ -54,6 +54,7 @@
 /* Structure pointing to a buffer either stored
    in RAM or swapped in CFS */
 struct queuebuf {
+  uint8_t refcount;
 #if QUEUEBUF_DEBUG
   struct queuebuf *next;
   const char *file;
@@ -125,16 +126,17 @@ LIST(queuebuf_list);
 #define PRINTF(...)
 #endif
 
-#ifdef QUEUEBUF_CONF_STATS
-#define QUEUEBUF_STATS QUEUEBUF_CONF_STATS
-#else
-#define QUEUEBUF_STATS 0
-#endif /* QUEUEBUF_CONF_STATS */
-
 #if QUEUEBUF_STATS
 uint8_t queuebuf_len, queuebuf_max_len;
+uint32_t queuebuf_bytes_copied;
+#define COPIED(n) (queuebuf_bytes_copied += (n))
+#else /* QUEUEBUF_STATS */
+#define COPIED(n)
 #endif /* QUEUEBUF_STATS */
 
+#define ATTRS_SIZE (sizeof(struct packetbuf_attr) * PACKETBUF_NUM_ATTRS + \
+                    sizeof(struct packetbuf_addr) * PACKETBUF_NUM_ADDRS)
+
 #if WITH_SWAP
 /*---------------------------------------------------------------------------*/
 static void
@@ -342,6 +344,8 @@ queuebuf_new_from_packetbuf(void)
 
     buframptr->len = packetbuf_copyto(buframptr->data);
     packetbuf_attr_copyto(buframptr->attrs, buframptr->addrs);
+    COPIED(buframptr->len + ATTRS_SIZE);
+    buf->refcount = 1;
 
 #if WITH_SWAP
     if(buf->location == IN_CFS) {
@@ -367,35 +371,65 @@ queuebuf_new_from_packetbuf(void)
   return buf;
 }
 /*---------------------------------------------------------------------------*/
-void
+int
 queuebuf_update_attr_from_packetbuf(struct queuebuf *buf)
 {
-  struct queuebuf_data *buframptr = queuebuf_load_to_ram(buf);
+  struct queuebuf_data *buframptr;
+
+  if(!memb_inmemb(&bufmem, buf) || buf->refcount > 1) {
+    PRINTF("queuebuf_update_attr_from_packetbuf: shared or invalid buffer\n");
+    return 0;
+  }
+  buframptr = queuebuf_load_to_ram(buf);
   packetbuf_attr_copyto(buframptr->attrs, buframptr->addrs);
+  COPIED(ATTRS_SIZE);
 #if WITH_SWAP
   if(buf->location == IN_CFS) {
     queuebuf_flush_tmpdata();
   }
 #endif
+  return 1;
 }
 /*---------------------------------------------------------------------------*/
-void
+int
 queuebuf_update_from_packetbuf(struct queuebuf *buf)
 {
-  struct queuebuf_data *buframptr = queuebuf_load_to_ram(buf);
+  struct queuebuf_data *buframptr;
+
+  if(!memb_inmemb(&bufmem, buf) || buf->refcount > 1) {
+    PRINTF("queuebuf_update_from_packetbuf: shared or invalid buffer\n");
+    return 0;
+  }
+  buframptr = queuebuf_load_to_ram(buf);
   packetbuf_attr_copyto(buframptr->attrs, buframptr->addrs);
   buframptr->len = packetbuf_copyto(buframptr->data);
+  COPIED(buframptr->len + ATTRS_SIZE);
 #if WITH_SWAP
   if(buf->location == IN_CFS) {
     queuebuf_flush_tmpdata();
   }
 #endif
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+struct queuebuf *
+queuebuf_ref(struct queuebuf *buf)
+{
+  if(!memb_inmemb(&bufmem, buf) || buf->refcount == UINT8_MAX) {
+    PRINTF("queuebuf_ref: too many holders or invalid buffer\n");
+    return NULL;
+  }
+  buf->refcount++;
+  return buf;
 }
 /*---------------------------------------------------------------------------*/
 void
 queuebuf_free(struct queuebuf *buf)
 {
   if(memb_inmemb(&bufmem, buf)) {
+    if(--buf->refcount > 0) {
+      return;
+    }
 #if WITH_SWAP
     if(buf->location == IN_RAM) {
       memb_free(&buframmem, buf->ram_ptr);
@@ -423,6 +457,18 @@ queuebuf_to_packetbuf(struct queuebuf *b)
     struct queuebuf_data *buframptr = queuebuf_load_to_ram(b);
     packetbuf_copyfrom(buframptr->data, buframptr->len);
     packetbuf_attr_copyfrom(buframptr->attrs, buframptr->addrs);
+    COPIED(buframptr->len + ATTRS_SIZE);
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
+queuebuf_attr_to_packetbuf(struct queuebuf *b)
+{
+  if(memb_inmemb(&bufmem, b)) {
+    struct queuebuf_data *buframptr = queuebuf_load_to_ram(b);
+    packetbuf_clear();
+    packetbuf_attr_copyfrom(buframptr->attrs, buframptr->addrs);
+    COPIED(ATTRS_SIZE);
   }
 }
 /*---------------------------------------------------------------------------*/
@@ -48,6 +48,12 @@
  *
  * The queuebuf module handles buffers that are queued.
  *
+ * A queuebuf is reference counted: queuebuf_ref() adds a holder and
+ * queuebuf_free() drops one, the buffer is released with the last
+ * holder. A queuebuf that has several holders cannot be updated, so
+ * that its frame can be transmitted directly from queuebuf_dataptr()
+ * as many times as needed.
+ *
  */
 
 #ifndef QUEUEBUF_H_
@@ -91,6 +97,18 @@
 #define QUEUEBUF_DEBUG 0
 #endif /* QUEUEBUF_CONF_DEBUG */
 
+#ifdef QUEUEBUF_CONF_STATS
+#define QUEUEBUF_STATS QUEUEBUF_CONF_STATS
+#else
+#define QUEUEBUF_STATS 0
+#endif /* QUEUEBUF_CONF_STATS */
+
+#if QUEUEBUF_STATS
+extern uint8_t queuebuf_len, queuebuf_max_len;
+/* The number of bytes copied between packetbuf and queuebufs */
+extern uint32_t queuebuf_bytes_copied;
+#endif /* QUEUEBUF_STATS */
+
 struct queuebuf;
 
 void queuebuf_init(void);
@@ -101,10 +119,16 @@ struct queuebuf *queuebuf_new_from_packetbuf_debug(const char *file, int line);
 #else /* QUEUEBUF_DEBUG */
 struct queuebuf *queuebuf_new_from_packetbuf(void);
 #endif /* QUEUEBUF_DEBUG */
-void queuebuf_update_attr_from_packetbuf(struct queuebuf *b);
-void queuebuf_update_from_packetbuf(struct queuebuf *b);
+/* Return 0, and leave the queuebuf unchanged, if it has several holders */
+int queuebuf_update_attr_from_packetbuf(struct queuebuf *b);
+int queuebuf_update_from_packetbuf(struct queuebuf *b);
 
 void queuebuf_to_packetbuf(struct queuebuf *b);
+/* Restore the attributes and addresses only, and clear the data */
+void queuebuf_attr_to_packetbuf(struct queuebuf *b);
+
+/* Return NULL if the queuebuf cannot take another holder */
+struct queuebuf *queuebuf_ref(struct queuebuf *b);
 void queuebuf_free(struct queuebuf *b);
 
 void *queuebuf_dataptr(struct queuebuf *b);
@@ -51,6 +51,7 @@
 #include "net/ipv6/uip.h"
 #include "net/ipv6/uip-nd6.h"
 #include "net/ipv6/uip-ds6-nbr.h"
+#include "net/ipv6/uip-sr.h"
 #include "net/nbr-table.h"
 #include "net/ipv6/multicast/uip-mcast6.h"
 #include "lib/list.h"
@@ -407,6 +408,8 @@ rpl_set_root(uint8_t instance_id, uip_ipaddr_t *dag_id)
   rpl_set_preferred_parent(dag, NULL);
 
   memcpy(&dag->dag_id, dag_id, sizeof(dag->dag_id));
+  /* The addresses of the source routing nodes change with the DAG ID */
+  uip_sr_flush_paths();
 
   instance->dio_intdoubl = RPL_DIO_INTERVAL_DOUBLINGS;
   instance->dio_intmin = RPL_DIO_INTERVAL_MIN;
@@ -686,6 +689,7 @@ rpl_free_dag(rpl_dag_t *dag)
     remove_parents(dag, 0);
   }
   dag->used = 0;
+  uip_sr_flush_paths();
 }
 /*---------------------------------------------------------------------------*/
 rpl_parent_t *
@@ -1174,6 +1178,7 @@ rpl_join_instance(uip_ipaddr_t *from, rpl_dio_t *dio)
   instance->lifetime_unit = dio->lifetime_unit;
 
   memcpy(&dag->dag_id, &dio->dag_id, sizeof(dio->dag_id));
+  uip_sr_flush_paths();
 
   /* Copy prefix information from the DIO into the DAG object. */
   memcpy(&dag->prefix_info, &dio->prefix_info, sizeof(rpl_prefix_t));
@@ -1270,6 +1275,7 @@ rpl_add_dag(uip_ipaddr_t *from, rpl_dio_t *dio)
   dag->version = dio->version;
 
   memcpy(&dag->dag_id, &dio->dag_id, sizeof(dio->dag_id));
+  uip_sr_flush_paths();
 
   /* copy prefix information into the dag */
   memcpy(&dag->prefix_info, &dio->prefix_info, sizeof(rpl_prefix_t));
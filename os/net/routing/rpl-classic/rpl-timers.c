@@ -53,6 +53,9 @@
 #define LOG_MODULE "RPL"
 #define LOG_LEVEL LOG_LEVEL_RPL
 
+/* Timer jitter does not depend on the random numbers of other modules */
+RANDOM_STREAM(rpl_random, RANDOM_STREAM_ROUTING);
+
 /* A configurable function called after update of the RPL DIO interval */
 #ifdef RPL_CALLBACK_NEW_DIO_INTERVAL
 void RPL_CALLBACK_NEW_DIO_INTERVAL(clock_time_t dio_interval);
@@ -120,7 +123,7 @@ new_dio_interval(rpl_instance_t *instance)
   instance->dio_next_delay = ticks;
 
   /* random number between I/2 and I */
-  ticks = ticks / 2 + (ticks / 2 * (uint32_t)random_rand()) / RANDOM_RAND_MAX;
+  ticks = ticks / 2 + (ticks / 2 * (uint32_t)random_stream_rand(&rpl_random)) / RANDOM_RAND_MAX;
 
   /*
    * The intervals must be equally long among the nodes for Trickle to
@@ -206,7 +209,7 @@ void
 rpl_reset_periodic_timer(void)
 {
   next_dis = RPL_DIS_INTERVAL / 2 +
-    ((uint32_t)RPL_DIS_INTERVAL * (uint32_t)random_rand()) / RANDOM_RAND_MAX -
+    ((uint32_t)RPL_DIS_INTERVAL * (uint32_t)random_stream_rand(&rpl_random)) / RANDOM_RAND_MAX -
     RPL_DIS_START_DELAY;
   ctimer_set(&periodic_timer, CLOCK_SECOND, handle_periodic_timer, NULL);
 }
@@ -255,7 +258,7 @@ set_dao_lifetime_timer(rpl_instance_t *instance)
     }
 
     /* make the time for the re registration be betwen 1/2 - 3/4 of lifetime */
-    expiration_time = expiration_time + (random_rand() % (expiration_time / 2));
+    expiration_time = expiration_time + (random_stream_rand(&rpl_random) % (expiration_time / 2));
     LOG_DBG("Scheduling DAO lifetime timer %u ticks in the future\n",
            (unsigned)expiration_time);
     ctimer_set(&instance->dao_lifetime_timer, expiration_time,
@@ -337,7 +340,7 @@ schedule_dao(rpl_instance_t *instance, clock_time_t latency)
   } else {
     if(latency != 0) {
       expiration_time = latency / 2 +
-        (random_rand() % (latency));
+        (random_stream_rand(&rpl_random) % (latency));
     } else {
       expiration_time = 0;
     }
@@ -391,7 +394,7 @@ rpl_schedule_unicast_dio_immediately(rpl_instance_t *instance)
 clock_time_t
 get_probing_delay(rpl_dag_t *dag)
 {
-  return ((RPL_PROBING_INTERVAL) / 2) + random_rand() % (RPL_PROBING_INTERVAL);
+  return ((RPL_PROBING_INTERVAL) / 2) + random_stream_rand(&rpl_random) % (RPL_PROBING_INTERVAL);
 }
 /*---------------------------------------------------------------------------*/
 rpl_parent_t *
@@ -426,7 +429,7 @@ get_probing_target(rpl_dag_t *dag)
   }
 
   /* With 50% probability: probe best non-fresh parent */
-  if(random_rand() % 2 == 0) {
+  if(random_stream_rand(&rpl_random) % 2 == 0) {
     p = nbr_table_head(rpl_parents);
     while(p != NULL) {
       if(p->dag == dag && !rpl_parent_is_fresh(p)) {
@@ -519,7 +522,7 @@ rpl_schedule_probing(rpl_instance_t *instance)
 void
 rpl_schedule_probing_now(rpl_instance_t *instance)
 {
-  ctimer_set(&instance->probing_timer, random_rand() % (CLOCK_SECOND * 4),
+  ctimer_set(&instance->probing_timer, random_stream_rand(&rpl_random) % (CLOCK_SECOND * 4),
                   handle_probing_timer, instance);
 }
 #endif /* RPL_WITH_PROBING */
@@ -514,6 +514,8 @@ init_dag(uint8_t instance_id, uip_ipaddr_t *dag_id, rpl_ocp_t ocp,
   curr_instance.dag.dao_last_acked_seqno = RPL_LOLLIPOP_INIT;
   curr_instance.dag.dao_last_seqno = RPL_LOLLIPOP_INIT;
   memcpy(&curr_instance.dag.dag_id, dag_id, sizeof(curr_instance.dag.dag_id));
+  /* The addresses of the source routing nodes change with the DAG ID */
+  uip_sr_flush_paths();
 
   return 1;
 }
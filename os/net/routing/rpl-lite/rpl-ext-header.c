@@ -161,20 +161,6 @@ rpl_ext_header_srh_update(void)
   return 1;
 }
 /*---------------------------------------------------------------------------*/
-/* Utility function for SRH. Counts the number of bytes in common between
- * two addresses at p1 and p2. */
-static int
-count_matching_bytes(const void *p1, const void *p2, size_t n)
-{
-  int i = 0;
-  for(i = 0; i < n; i++) {
-    if(((uint8_t *)p1)[i] != ((uint8_t *)p2)[i]) {
-      return i;
-    }
-  }
-  return n;
-}
-/*---------------------------------------------------------------------------*/
 /* Used by rpl_ext_header_update to insert a RPL SRH extension header. This
  * is used at the root, to initiate downward routing. Returns 1 on success,
  * 0 on failure.
@@ -224,37 +210,19 @@ insert_srh_header(void)
     return 0;
   }
 
-  if(!uip_sr_is_addr_reachable(NULL, &UIP_IP_BUF->destipaddr)) {
+  /* Compute path length and compression factors (we use cmpri == cmpre).
+     Both are cached in the destination node until the graph changes. */
+  if(!uip_sr_get_path(dest_node, root_node, &path_len, &cmpri)) {
     LOG_ERR("SRH no path found to destination\n");
     return 0;
   }
-
-  /* Compute path length and compression factors (we use cmpri == cmpre) */
-  path_len = 0;
-  node = dest_node->parent;
   /* For simplicity, we use cmpri = cmpre */
-  cmpri = 15;
-  cmpre = 15;
+  cmpre = cmpri;
 
   /* Note that in case of a direct child (node == root_node), we insert
   SRH anyway, as RFC 6553 mandates that routed datagrams must include
   SRH or the RPL option (or both) */
 
-  while(node != NULL && node != root_node) {
-
-    NETSTACK_ROUTING.get_sr_node_ipaddr(&node_addr, node);
-
-    /* How many bytes in common between all nodes in the path? */
-    cmpri = MIN(cmpri, count_matching_bytes(&node_addr, &UIP_IP_BUF->destipaddr, 16));
-    cmpre = cmpri;
-
-    LOG_INFO("SRH Hop ");
-    LOG_INFO_6ADDR(&node_addr);
-    LOG_INFO_("\n");
-    node = node->parent;
-    path_len++;
-  }
-
   /* Extension header length: fixed headers + (n-1) * (16-ComprI) + (16-ComprE)*/
   ext_len = RPL_RH_LEN + RPL_SRH_LEN
       + (path_len - 1) * (16 - cmpre)
@@ -63,6 +63,8 @@ PROCESS_THREAD(at_process, ev, data)
   struct at_cmd *a;
   PROCESS_BEGIN();
 
+  process_subscribe(PROCESS_CURRENT(), serial_line_event_message);
+
   while(1) {
     PROCESS_WAIT_EVENT_UNTIL(ev == serial_line_event_message && data != NULL);
     buf = (char *)data;
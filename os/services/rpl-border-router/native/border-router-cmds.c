@@ -230,6 +230,8 @@ PROCESS_THREAD(border_router_cmd_process, ev, data)
   static struct pt shell_input_pt;
   PROCESS_BEGIN();
 
+  process_subscribe(PROCESS_CURRENT(), serial_line_event_message);
+
   shell_init();
 
   while(1) {
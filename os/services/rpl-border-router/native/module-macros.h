@@ -41,3 +41,8 @@
 
 /* used by wpcap (see /cpu/native/net/wpcap-drv.c) */
 #define SELECT_CALLBACK 1
+
+/* serial_line_event_message is only delivered to the command process */
+#ifndef PROCESS_CONF_MAX_SUBSCRIPTIONS
+#define PROCESS_CONF_MAX_SUBSCRIPTIONS 8
+#endif /* PROCESS_CONF_MAX_SUBSCRIPTIONS */
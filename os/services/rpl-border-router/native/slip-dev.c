@@ -289,10 +289,18 @@ after_fread:
 unsigned char slip_buf[2048];
 int slip_end, slip_begin, slip_packet_end, slip_packet_count;
 static struct timer send_delay_timer;
+/* Wakes up the main loop when the send delay is over */
+static struct ctimer send_delay_wakeup;
 /* delay between slip packets */
 static clock_time_t send_delay = SEND_DELAY;
 /*---------------------------------------------------------------------------*/
 static void
+send_delay_expired(void *ptr)
+{
+  /* Nothing to do, the next set_fd() call will ask to flush */
+}
+/*---------------------------------------------------------------------------*/
+static void
 slip_send(int fd, unsigned char c)
 {
   if(slip_end >= sizeof(slip_buf)) {
@@ -352,6 +360,7 @@ slip_flushbuf(int fd)
         /* a delay between slip packets to avoid losing data */
         if(send_delay > 0) {
           timer_set(&send_delay_timer, send_delay);
+          ctimer_set(&send_delay_wakeup, send_delay, send_delay_expired, NULL);
         }
       }
     }
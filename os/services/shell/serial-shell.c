@@ -61,6 +61,8 @@ PROCESS_THREAD(serial_shell_process, ev, data)
 {
   PROCESS_BEGIN();
 
+  process_subscribe(PROCESS_CURRENT(), serial_line_event_message);
+
   shell_init();
 
   while(1) {
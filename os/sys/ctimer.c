@@ -46,10 +46,22 @@
 #include "contiki.h"
 #include "lib/list.h"
 
+#include <stddef.h>
+
 LIST(ctimer_list);
 
 static char initialized;
 
+#if ETIMER_WHEEL
+/* Once ctimer_process runs, pending timers are tracked by the etimer
+   wheel alone. */
+#define ADD_TIMER(c)    do { if(!initialized) { list_add(ctimer_list, c); } } while(0)
+#define REMOVE_TIMER(c) do { if(!initialized) { list_remove(ctimer_list, c); } } while(0)
+#else /* ETIMER_WHEEL */
+#define ADD_TIMER(c)    list_add(ctimer_list, c)
+#define REMOVE_TIMER(c) list_remove(ctimer_list, c)
+#endif /* ETIMER_WHEEL */
+
 #define DEBUG 0
 #if DEBUG
 #include <stdio.h>
@@ -70,8 +82,24 @@ PROCESS_THREAD(ctimer_process, ev, data)
   }
   initialized = 1;
 
+#if ETIMER_WHEEL
+  /* Timers are only kept on the list until the process has started. */
+  list_init(ctimer_list);
+#endif /* ETIMER_WHEEL */
+
   while(1) {
     PROCESS_YIELD_UNTIL(ev == PROCESS_EVENT_TIMER);
+#if ETIMER_WHEEL
+    /* The etimer wheel delivers expired callback timers synchronously,
+       so the event can not refer to a timer that was stopped or set
+       again since it expired. */
+    c = (struct ctimer *)((char *)data - offsetof(struct ctimer, etimer));
+    PROCESS_CONTEXT_BEGIN(c->p);
+    if(c->f != NULL) {
+      c->f(c->ptr);
+    }
+    PROCESS_CONTEXT_END(c->p);
+#else /* ETIMER_WHEEL */
     for(c = list_head(ctimer_list); c != NULL; c = c->next) {
       if(&c->etimer == data) {
         list_remove(ctimer_list, c);
@@ -83,6 +111,7 @@ PROCESS_THREAD(ctimer_process, ev, data)
         break;
       }
     }
+#endif /* ETIMER_WHEEL */
   }
   PROCESS_END();
 }
@@ -118,7 +147,7 @@ ctimer_set_with_process(struct ctimer *c, clock_time_t t,
     c->etimer.timer.interval = t;
   }
 
-  list_add(ctimer_list, c);
+  ADD_TIMER(c);
 }
 /*---------------------------------------------------------------------------*/
 void
@@ -130,7 +159,7 @@ ctimer_reset(struct ctimer *c)
     PROCESS_CONTEXT_END(&ctimer_process);
   }
 
-  list_add(ctimer_list, c);
+  ADD_TIMER(c);
 }
 /*---------------------------------------------------------------------------*/
 void
@@ -142,7 +171,7 @@ ctimer_restart(struct ctimer *c)
     PROCESS_CONTEXT_END(&ctimer_process);
   }
 
-  list_add(ctimer_list, c);
+  ADD_TIMER(c);
 }
 /*---------------------------------------------------------------------------*/
 void
@@ -154,7 +183,7 @@ ctimer_stop(struct ctimer *c)
     c->etimer.next = NULL;
     c->etimer.p = PROCESS_NONE;
   }
-  list_remove(ctimer_list, c);
+  REMOVE_TIMER(c);
 }
 /*---------------------------------------------------------------------------*/
 int
@@ -164,6 +164,8 @@ int ctimer_expired(struct ctimer *c);
  */
 void ctimer_init(void);
 
+PROCESS_NAME(ctimer_process);
+
 #endif /* CTIMER_H_ */
 /** @} */
 /** @} */
@@ -49,10 +49,15 @@
 #include "sys/etimer.h"
 #include "sys/process.h"
 
-static struct etimer *timerlist;
-static clock_time_t next_expiration;
+#if ETIMER_WHEEL
+#include "sys/ctimer.h"
+#endif /* ETIMER_WHEEL */
 
 PROCESS(etimer_process, "Event timer");
+
+#if !ETIMER_WHEEL
+static struct etimer *timerlist;
+static clock_time_t next_expiration;
 /*---------------------------------------------------------------------------*/
 static void
 update_time(void)
@@ -173,6 +178,507 @@ add_timer(struct etimer *timer)
   update_time();
 }
 /*---------------------------------------------------------------------------*/
+static void
+remove_timer(struct etimer *et)
+{
+  struct etimer *t;
+
+  /* First check if et is the first event timer on the list. */
+  if(et == timerlist) {
+    timerlist = timerlist->next;
+    update_time();
+  } else {
+    /* Else walk through the list and try to find the item before the
+       et timer. */
+    for(t = timerlist; t != NULL && t->next != et; t = t->next) {
+    }
+
+    if(t != NULL) {
+      /* We've found the item before the event timer that we are about
+         to remove. We point the items next pointer to the event after
+         the removed item. */
+      t->next = et->next;
+
+      update_time();
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
+etimer_adjust(struct etimer *et, int timediff)
+{
+  et->timer.start += timediff;
+  update_time();
+}
+/*---------------------------------------------------------------------------*/
+int
+etimer_pending(void)
+{
+  return timerlist != NULL;
+}
+/*---------------------------------------------------------------------------*/
+clock_time_t
+etimer_next_expiration_time(void)
+{
+  return etimer_pending() ? next_expiration : 0;
+}
+#else /* !ETIMER_WHEEL */
+/*
+ * Bucket index used for timers that had already expired when they
+ * were added. They are delivered at the next poll of etimer_process.
+ */
+#define DUE_BUCKET    (ETIMER_WHEEL_LEVELS * ETIMER_WHEEL_SLOTS)
+/* Bucket of the due timers that are being delivered */
+#define FIRING_BUCKET (DUE_BUCKET + 1)
+#define NO_BUCKET     0xff
+/*
+ * A linked timer holds its own address XORed with this value, which a
+ * timer that was never set is unlikely to hold by chance.
+ */
+#define LINK_MAGIC    ((uintptr_t)0x5ca1ab1eUL)
+#define SLOT_MASK     (ETIMER_WHEEL_SLOTS - 1)
+/* True if clock time a is strictly before clock time b */
+#define TIME_BEFORE(a, b) \
+  ((clock_time_t)((a) - (b)) > (clock_time_t)((clock_time_t)~0 >> 1))
+
+static struct etimer *buckets[FIRING_BUCKET + 1];
+static uint32_t occupied[ETIMER_WHEEL_LEVELS];
+/* All clock ticks before cursor have been processed. */
+static clock_time_t cursor;
+static clock_time_t next_expiration;
+static uint8_t next_expiration_valid;
+
+#if FIRING_BUCKET >= NO_BUCKET
+#error "ETIMER_WHEEL_LEVELS is too large"
+#endif
+/*---------------------------------------------------------------------------*/
+static unsigned
+level_shift(unsigned level)
+{
+  return level * ETIMER_WHEEL_BITS;
+}
+/*---------------------------------------------------------------------------*/
+/*
+ * Distance, counted in buckets of the given level, from the bucket
+ * holding the cursor to the bucket holding time t. Computed modulo the
+ * width of the bucket index so that clock wraps are handled.
+ */
+static clock_time_t
+bucket_distance(clock_time_t t, unsigned level)
+{
+  unsigned shift = level_shift(level);
+
+  return (clock_time_t)((clock_time_t)(t >> shift) -
+                        (clock_time_t)(cursor >> shift)) &
+    (clock_time_t)((clock_time_t)~0 >> shift);
+}
+/*---------------------------------------------------------------------------*/
+static void
+link_timer(struct etimer *t, unsigned bucket)
+{
+  t->bucket = bucket;
+  t->marker = (uintptr_t)t ^ LINK_MAGIC;
+  t->prev = NULL;
+  t->next = buckets[bucket];
+  if(t->next != NULL) {
+    t->next->prev = t;
+  }
+  buckets[bucket] = t;
+  if(bucket < DUE_BUCKET) {
+    occupied[bucket / ETIMER_WHEEL_SLOTS] |=
+      (uint32_t)1 << (bucket & SLOT_MASK);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+unlink_timer(struct etimer *t)
+{
+  if(t->prev != NULL) {
+    t->prev->next = t->next;
+  } else {
+    buckets[t->bucket] = t->next;
+  }
+  if(t->next != NULL) {
+    t->next->prev = t->prev;
+  }
+  if(buckets[t->bucket] == NULL && t->bucket < DUE_BUCKET) {
+    occupied[t->bucket / ETIMER_WHEEL_SLOTS] &=
+      ~((uint32_t)1 << (t->bucket & SLOT_MASK));
+  }
+  t->next = t->prev = NULL;
+  t->marker = 0;
+  t->bucket = NO_BUCKET;
+}
+/*---------------------------------------------------------------------------*/
+/*
+ * Whether a timer is in the wheel. As with the timer list, a timer that
+ * was never set may hold garbage, so its links are only followed once
+ * its bucket number and its link marker show that it was linked.
+ */
+static int
+is_linked(struct etimer *t)
+{
+  if(t->p == PROCESS_NONE || t->bucket > FIRING_BUCKET ||
+     t->marker != ((uintptr_t)t ^ LINK_MAGIC)) {
+    return 0;
+  }
+  return buckets[t->bucket] == t ||
+    (t->prev != NULL && t->prev->next == t);
+}
+/*---------------------------------------------------------------------------*/
+/*
+ * File a timer in the lowest wheel level whose bucket range covers its
+ * expiration time, counted from the cursor. Timers beyond the range of
+ * the top level are parked in its last bucket and filed again when that
+ * bucket is cascaded.
+ */
+static void
+file_timer(struct etimer *t)
+{
+  clock_time_t expiration;
+  clock_time_t distance;
+  unsigned level;
+
+  expiration = t->timer.start + t->timer.interval;
+  for(level = 0; level < ETIMER_WHEEL_LEVELS; level++) {
+    distance = bucket_distance(expiration, level);
+    if(distance < ETIMER_WHEEL_SLOTS) {
+      link_timer(t, level * ETIMER_WHEEL_SLOTS +
+                 ((expiration >> level_shift(level)) & SLOT_MASK));
+      return;
+    }
+  }
+
+  level--;
+  link_timer(t, level * ETIMER_WHEEL_SLOTS +
+             (((cursor >> level_shift(level)) + SLOT_MASK) & SLOT_MASK));
+}
+/*---------------------------------------------------------------------------*/
+/* File a timer, or queue it for the next poll if it has expired */
+static void
+insert_timer(struct etimer *t)
+{
+  clock_time_t expiration;
+
+  if(timer_expired(&t->timer)) {
+    link_timer(t, DUE_BUCKET);
+    etimer_request_poll();
+    return;
+  }
+
+  expiration = t->timer.start + t->timer.interval;
+  if(next_expiration_valid && TIME_BEFORE(expiration, next_expiration)) {
+    next_expiration = expiration;
+  }
+  file_timer(t);
+}
+/*---------------------------------------------------------------------------*/
+static void
+remove_timer(struct etimer *t)
+{
+  if(is_linked(t)) {
+    if(next_expiration_valid &&
+       t->timer.start + t->timer.interval == next_expiration) {
+      next_expiration_valid = 0;
+    }
+    unlink_timer(t);
+  }
+}
+/*---------------------------------------------------------------------------*/
+/*
+ * Find the first occupied bucket of a level, starting from the bucket
+ * that holds the cursor. Returns the slot, or -1 if the level is empty.
+ */
+static int
+first_slot(unsigned level)
+{
+  unsigned start;
+  uint32_t pending;
+  unsigned i;
+
+  pending = occupied[level];
+  if(pending == 0) {
+    return -1;
+  }
+  start = (cursor >> level_shift(level)) & SLOT_MASK;
+  for(i = 0; i < ETIMER_WHEEL_SLOTS; i++) {
+    if(pending & ((uint32_t)1 << ((start + i) & SLOT_MASK))) {
+      return (start + i) & SLOT_MASK;
+    }
+  }
+  return -1;
+}
+/*---------------------------------------------------------------------------*/
+/* The clock time at which the given bucket must be processed */
+static clock_time_t
+bucket_time(unsigned level, unsigned slot)
+{
+  unsigned shift = level_shift(level);
+  clock_time_t index;
+  clock_time_t time;
+
+  index = (cursor >> shift) +
+    (clock_time_t)((slot - ((cursor >> shift) & SLOT_MASK)) & SLOT_MASK);
+  time = (clock_time_t)(index << shift);
+  return TIME_BEFORE(time, cursor) ? cursor : time;
+}
+/*---------------------------------------------------------------------------*/
+static void
+update_next_expiration(void)
+{
+  struct etimer *t;
+  clock_time_t expiration;
+  unsigned level;
+  int slot;
+
+  next_expiration_valid = 1;
+  if(buckets[DUE_BUCKET] != NULL) {
+    next_expiration = clock_time();
+    return;
+  }
+  next_expiration = cursor + (clock_time_t)((clock_time_t)~0 >> 1);
+  for(level = 0; level < ETIMER_WHEEL_LEVELS; level++) {
+    slot = first_slot(level);
+    if(slot < 0) {
+      continue;
+    }
+    for(t = buckets[level * ETIMER_WHEEL_SLOTS + slot]; t != NULL;
+        t = t->next) {
+      expiration = t->timer.start + t->timer.interval;
+      if(TIME_BEFORE(expiration, next_expiration)) {
+        next_expiration = expiration;
+      }
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static int
+deliver_timer(struct etimer *t)
+{
+  struct process *p = t->p;
+
+  if(p == &ctimer_process) {
+    /* Callback timers are run right away, which spares an event and
+       lets ctimer_process find the ctimer without a list lookup. */
+    t->p = PROCESS_NONE;
+    process_post_synch(p, PROCESS_EVENT_TIMER, t);
+    return 1;
+  }
+
+  if(process_post(p, PROCESS_EVENT_TIMER, t) != PROCESS_ERR_OK) {
+    return 0;
+  }
+  /* Reset the process ID of the event timer, to signal that the
+     etimer has expired. This is later checked in the
+     etimer_expired() function. */
+  t->p = PROCESS_NONE;
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+/*
+ * Deliver the timers that were due when the function was called.
+ * Returns zero if the event queue filled up, in which case the
+ * remaining timers are left for the next poll.
+ */
+static int
+fire_due_timers(void)
+{
+  struct etimer *t;
+
+  /* Move the list aside first, so that callbacks that set a timer that
+     has already expired do not keep us here. The timers stay linked,
+     so that the callbacks may still stop or set them. */
+  buckets[FIRING_BUCKET] = buckets[DUE_BUCKET];
+  buckets[DUE_BUCKET] = NULL;
+  for(t = buckets[FIRING_BUCKET]; t != NULL; t = t->next) {
+    t->bucket = FIRING_BUCKET;
+  }
+  while((t = buckets[FIRING_BUCKET]) != NULL) {
+    unlink_timer(t);
+    if(!deliver_timer(t)) {
+      link_timer(t, DUE_BUCKET);
+      while((t = buckets[FIRING_BUCKET]) != NULL) {
+        unlink_timer(t);
+        link_timer(t, DUE_BUCKET);
+      }
+      etimer_request_poll();
+      return 0;
+    }
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+/*
+ * Process all buckets that are due up to and including the current
+ * clock time. Higher-level buckets are cascaded into the lower levels,
+ * and the timers of the level 0 bucket are delivered.
+ */
+static void
+run_wheel(void)
+{
+  clock_time_t now;
+  clock_time_t time;
+  clock_time_t next;
+  struct etimer *t;
+  unsigned level;
+  unsigned bucket;
+  int slot;
+  int found;
+
+  next_expiration_valid = 0;
+  if(!fire_due_timers()) {
+    return;
+  }
+
+  now = clock_time();
+  while(1) {
+    found = 0;
+    next = now;
+    for(level = 0; level < ETIMER_WHEEL_LEVELS; level++) {
+      slot = first_slot(level);
+      if(slot >= 0) {
+        time = bucket_time(level, slot);
+        if(!found || TIME_BEFORE(time, next)) {
+          next = time;
+          found = 1;
+        }
+      }
+    }
+    if(!found || TIME_BEFORE(now, next)) {
+      /* Nothing is due before now. */
+      cursor = now + 1;
+      return;
+    }
+
+    cursor = next;
+    for(level = ETIMER_WHEEL_LEVELS - 1; level > 0; level--) {
+      bucket = level * ETIMER_WHEEL_SLOTS +
+        ((cursor >> level_shift(level)) & SLOT_MASK);
+      /* The bucket at the cursor is due: cascade its timers. They
+         are filed relative to the cursor rather than to the clock,
+         so that when the wheel runs late they are still delivered
+         after the timers that expire before them. */
+      while((t = buckets[bucket]) != NULL) {
+        unlink_timer(t);
+        if(TIME_BEFORE(t->timer.start + t->timer.interval, cursor)) {
+          link_timer(t, cursor & SLOT_MASK);
+        } else {
+          file_timer(t);
+        }
+      }
+    }
+    bucket = cursor & SLOT_MASK;
+    while((t = buckets[bucket]) != NULL) {
+      unlink_timer(t);
+      if(!deliver_timer(t)) {
+        /* The event queue is full: resume from here at the next poll */
+        link_timer(t, bucket);
+        etimer_request_poll();
+        return;
+      }
+    }
+    if(!fire_due_timers()) {
+      return;
+    }
+    cursor++;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+exit_process_timers(struct process *p)
+{
+  struct etimer *t;
+  struct etimer *next;
+  unsigned bucket;
+
+  for(bucket = 0; bucket <= FIRING_BUCKET; bucket++) {
+    for(t = buckets[bucket]; t != NULL; t = next) {
+      next = t->next;
+      if(t->p == p) {
+        unlink_timer(t);
+      }
+    }
+  }
+  next_expiration_valid = 0;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(etimer_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  while(1) {
+    PROCESS_YIELD();
+
+    if(ev == PROCESS_EVENT_EXITED) {
+      exit_process_timers(data);
+    } else if(ev == PROCESS_EVENT_POLL) {
+      run_wheel();
+    }
+  }
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
+void
+etimer_request_poll(void)
+{
+  process_poll(&etimer_process);
+}
+/*---------------------------------------------------------------------------*/
+static void
+add_timer(struct etimer *timer)
+{
+  remove_timer(timer);
+  if(!etimer_pending()) {
+    /* Nothing to process in the wheel: catch the cursor up with the
+       clock so that it never falls too far behind. */
+    cursor = clock_time();
+  }
+  timer->p = PROCESS_CURRENT();
+  insert_timer(timer);
+}
+/*---------------------------------------------------------------------------*/
+void
+etimer_adjust(struct etimer *et, int timediff)
+{
+  if(is_linked(et)) {
+    remove_timer(et);
+    et->timer.start += timediff;
+    insert_timer(et);
+  } else {
+    et->timer.start += timediff;
+  }
+}
+/*---------------------------------------------------------------------------*/
+int
+etimer_pending(void)
+{
+  unsigned level;
+
+  if(buckets[DUE_BUCKET] != NULL) {
+    return 1;
+  }
+  for(level = 0; level < ETIMER_WHEEL_LEVELS; level++) {
+    if(occupied[level] != 0) {
+      return 1;
+    }
+  }
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+clock_time_t
+etimer_next_expiration_time(void)
+{
+  if(!etimer_pending()) {
+    return 0;
+  }
+  if(!next_expiration_valid) {
+    update_next_expiration();
+  }
+  return next_expiration;
+}
+#endif /* !ETIMER_WHEEL */
+/*---------------------------------------------------------------------------*/
 void
 etimer_set(struct etimer *et, clock_time_t interval)
 {
@@ -202,13 +708,6 @@ etimer_restart(struct etimer *et)
   add_timer(et);
 }
 /*---------------------------------------------------------------------------*/
-void
-etimer_adjust(struct etimer *et, int timediff)
-{
-  et->timer.start += timediff;
-  update_time();
-}
-/*---------------------------------------------------------------------------*/
 int
 etimer_expired(struct etimer *et)
 {
@@ -227,42 +726,10 @@ etimer_start_time(struct etimer *et)
   return et->timer.start;
 }
 /*---------------------------------------------------------------------------*/
-int
-etimer_pending(void)
-{
-  return timerlist != NULL;
-}
-/*---------------------------------------------------------------------------*/
-clock_time_t
-etimer_next_expiration_time(void)
-{
-  return etimer_pending() ? next_expiration : 0;
-}
-/*---------------------------------------------------------------------------*/
 void
 etimer_stop(struct etimer *et)
 {
-  struct etimer *t;
-
-  /* First check if et is the first event timer on the list. */
-  if(et == timerlist) {
-    timerlist = timerlist->next;
-    update_time();
-  } else {
-    /* Else walk through the list and try to find the item before the
-       et timer. */
-    for(t = timerlist; t != NULL && t->next != et; t = t->next) {
-    }
-
-    if(t != NULL) {
-      /* We've found the item before the event timer that we are about
-         to remove. We point the items next pointer to the event after
-         the removed item. */
-      t->next = et->next;
-
-      update_time();
-    }
-  }
+  remove_timer(et);
 
   /* Remove the next pointer from the item to be removed. */
   et->next = NULL;
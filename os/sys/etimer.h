@@ -65,6 +65,40 @@
 
 #include "contiki.h"
 
+/**
+ * \brief Keep pending event timers in a hierarchical timing wheel.
+ *
+ * By default, pending event timers are kept in an unsorted list, which
+ * makes setting a timer and computing the next expiration time linear
+ * in the number of pending timers. When ETIMER_CONF_WHEEL is set,
+ * timers are instead hashed into ETIMER_WHEEL_LEVELS levels of
+ * ETIMER_WHEEL_SLOTS buckets each, which makes etimer_set(),
+ * etimer_stop() and the expiry of a timer constant-time operations
+ * at the cost of a few hundred bytes of RAM. Callback timers are
+ * dispatched directly from the wheel in this mode.
+ */
+#ifdef ETIMER_CONF_WHEEL
+#define ETIMER_WHEEL ETIMER_CONF_WHEEL
+#else
+#define ETIMER_WHEEL 0
+#endif
+
+#if ETIMER_WHEEL
+/**
+ * Number of wheel levels. Each level covers 5 more bits of clock time,
+ * and timers further away than the top level are filed again when they
+ * get closer. ETIMER_WHEEL_LEVELS * 5 must be less than the width of
+ * clock_time_t in bits.
+ */
+#ifdef ETIMER_CONF_WHEEL_LEVELS
+#define ETIMER_WHEEL_LEVELS ETIMER_CONF_WHEEL_LEVELS
+#else
+#define ETIMER_WHEEL_LEVELS 4
+#endif
+#define ETIMER_WHEEL_BITS   5
+#define ETIMER_WHEEL_SLOTS  (1 << ETIMER_WHEEL_BITS)
+#endif /* ETIMER_WHEEL */
+
 /**
  * A timer.
  *
@@ -77,6 +111,11 @@ struct etimer {
   struct timer timer;
   struct etimer *next;
   struct process *p;
+#if ETIMER_WHEEL
+  struct etimer *prev;
+  uintptr_t marker;
+  uint8_t bucket;
+#endif /* ETIMER_WHEEL */
 };
 
 /**
@@ -43,10 +43,13 @@
  *
  */
 
+#include <stddef.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "contiki.h"
 #include "sys/process.h"
+#include "sys/critical.h"
 
 /*
  * Pointer to the currently running process structure.
@@ -65,15 +68,55 @@ struct event_data {
   struct process *p;
 };
 
-static process_num_events_t nevents, fevent;
-static struct event_data events[PROCESS_CONF_NUMEVENTS];
+/*
+ * One event queue per priority class.
+ */
+struct event_queue {
+  process_num_events_t nevents, fevent;
+  struct event_data events[PROCESS_CONF_NUMEVENTS];
+};
+
+static struct event_queue queues[PROCESS_PRIORITIES];
+/* Total number of queued events, over all classes */
+static uint16_t nevents;
+
+#if PROCESS_PRIORITIES * PROCESS_CONF_NUMEVENTS > 0xffff
+#error "PROCESS_PRIORITIES * PROCESS_CONF_NUMEVENTS must be at most 65535"
+#endif
+
+#if PROCESS_PRIORITIES > 1
+/* Event numbers that are queued in the highest class */
+static uint8_t urgent_events[256 / 8];
+#define EVENT_IS_URGENT(ev) (urgent_events[(ev) >> 3] & (1 << ((ev) & 7)))
+#endif /* PROCESS_PRIORITIES > 1 */
 
 #if PROCESS_CONF_STATS
-process_num_events_t process_maxevents;
+uint16_t process_maxevents;
+process_num_events_t process_class_maxevents[PROCESS_PRIORITIES];
+uint16_t process_class_overflows[PROCESS_PRIORITIES];
 #endif
 
 static volatile unsigned char poll_requested;
 
+#if PROCESS_POLL_QUEUE
+/* Processes that have been polled, in the order of the requests */
+static struct process *poll_head, *poll_tail;
+static unsigned poll_count;
+#endif /* PROCESS_POLL_QUEUE */
+
+#if PROCESS_MAX_SUBSCRIPTIONS
+struct subscription {
+  struct process *p;
+  process_event_t ev;
+};
+static struct subscription subscriptions[PROCESS_MAX_SUBSCRIPTIONS];
+static uint8_t num_subscriptions;
+/* Event numbers that have at least one subscriber */
+static uint8_t subscribed_events[256 / 8];
+#define EVENT_IS_SUBSCRIBED(ev) \
+  (subscribed_events[(ev) >> 3] & (1 << ((ev) & 7)))
+#endif /* PROCESS_MAX_SUBSCRIPTIONS */
+
 #define PROCESS_STATE_NONE        0
 #define PROCESS_STATE_RUNNING     1
 #define PROCESS_STATE_CALLED      2
@@ -96,6 +139,87 @@ process_alloc_event(void)
 }
 /*---------------------------------------------------------------------------*/
 void
+process_set_priority(struct process *p, unsigned char priority)
+{
+#if PROCESS_PRIORITIES > 1
+  p->priority = MIN(priority, PROCESS_PRIORITY_HIGH);
+#endif /* PROCESS_PRIORITIES > 1 */
+}
+/*---------------------------------------------------------------------------*/
+void
+process_set_event_urgent(process_event_t ev)
+{
+#if PROCESS_PRIORITIES > 1
+  urgent_events[ev >> 3] |= 1 << (ev & 7);
+#endif /* PROCESS_PRIORITIES > 1 */
+}
+/*---------------------------------------------------------------------------*/
+#if PROCESS_MAX_SUBSCRIPTIONS
+static void
+update_subscribed_event(process_event_t ev)
+{
+  uint8_t i;
+
+  for(i = 0; i < num_subscriptions; i++) {
+    if(subscriptions[i].ev == ev) {
+      subscribed_events[ev >> 3] |= 1 << (ev & 7);
+      return;
+    }
+  }
+  subscribed_events[ev >> 3] &= ~(1 << (ev & 7));
+}
+/*---------------------------------------------------------------------------*/
+static void
+remove_subscription(uint8_t i)
+{
+  process_event_t ev = subscriptions[i].ev;
+
+  /* Keep the subscriptions in the order they were made */
+  num_subscriptions--;
+  memmove(&subscriptions[i], &subscriptions[i + 1],
+          (num_subscriptions - i) * sizeof(subscriptions[0]));
+  update_subscribed_event(ev);
+}
+#endif /* PROCESS_MAX_SUBSCRIPTIONS */
+/*---------------------------------------------------------------------------*/
+int
+process_subscribe(struct process *p, process_event_t ev)
+{
+#if PROCESS_MAX_SUBSCRIPTIONS
+  uint8_t i;
+
+  for(i = 0; i < num_subscriptions; i++) {
+    if(subscriptions[i].p == p && subscriptions[i].ev == ev) {
+      return PROCESS_ERR_OK;
+    }
+  }
+  if(num_subscriptions == PROCESS_MAX_SUBSCRIPTIONS) {
+    return PROCESS_ERR_FULL;
+  }
+  subscriptions[num_subscriptions].p = p;
+  subscriptions[num_subscriptions].ev = ev;
+  num_subscriptions++;
+  subscribed_events[ev >> 3] |= 1 << (ev & 7);
+#endif /* PROCESS_MAX_SUBSCRIPTIONS */
+  return PROCESS_ERR_OK;
+}
+/*---------------------------------------------------------------------------*/
+void
+process_unsubscribe(struct process *p, process_event_t ev)
+{
+#if PROCESS_MAX_SUBSCRIPTIONS
+  uint8_t i;
+
+  for(i = 0; i < num_subscriptions; i++) {
+    if(subscriptions[i].p == p && subscriptions[i].ev == ev) {
+      remove_subscription(i);
+      return;
+    }
+  }
+#endif /* PROCESS_MAX_SUBSCRIPTIONS */
+}
+/*---------------------------------------------------------------------------*/
+void
 process_start(struct process *p, process_data_t data)
 {
   struct process *q;
@@ -157,6 +281,44 @@ exit_process(struct process *p, struct process *fromprocess)
     }
   }
 
+#if PROCESS_POLL_QUEUE
+  if(p->needspoll) {
+    int_master_status_t status = critical_enter();
+    struct process *prev = NULL;
+
+    for(q = poll_head; q != NULL; prev = q, q = q->next_poll) {
+      if(q == p) {
+        if(prev != NULL) {
+          prev->next_poll = p->next_poll;
+        } else {
+          poll_head = p->next_poll;
+        }
+        if(poll_tail == p) {
+          poll_tail = prev;
+        }
+        poll_count--;
+        break;
+      }
+    }
+    p->needspoll = 0;
+    critical_exit(status);
+  }
+#endif /* PROCESS_POLL_QUEUE */
+
+#if PROCESS_MAX_SUBSCRIPTIONS
+  {
+    uint8_t i = 0;
+
+    while(i < num_subscriptions) {
+      if(subscriptions[i].p == p) {
+        remove_subscription(i);
+      } else {
+        i++;
+      }
+    }
+  }
+#endif /* PROCESS_MAX_SUBSCRIPTIONS */
+
   if(p == process_list) {
     process_list = process_list->next;
   } else {
@@ -209,9 +371,16 @@ process_init(void)
 {
   lastevent = PROCESS_EVENT_MAX;
 
-  nevents = fevent = 0;
+  memset(queues, 0, sizeof(queues));
+  nevents = 0;
+#if PROCESS_PRIORITIES > 1
+  memset(urgent_events, 0, sizeof(urgent_events));
+  process_set_event_urgent(PROCESS_EVENT_TIMER);
+#endif /* PROCESS_PRIORITIES > 1 */
 #if PROCESS_CONF_STATS
   process_maxevents = 0;
+  memset(process_class_maxevents, 0, sizeof(process_class_maxevents));
+  memset(process_class_overflows, 0, sizeof(process_class_overflows));
 #endif /* PROCESS_CONF_STATS */
 
   process_current = process_list = NULL;
@@ -225,6 +394,28 @@ static void
 do_poll(void)
 {
   struct process *p;
+#if PROCESS_POLL_QUEUE
+  unsigned n;
+  int_master_status_t status;
+
+  poll_requested = 0;
+  /* Call the processes that were polled before we started. Processes
+     that are polled again meanwhile are called at the next round. */
+  for(n = poll_count; n > 0 && poll_head != NULL; n--) {
+    status = critical_enter();
+    p = poll_head;
+    poll_head = p->next_poll;
+    if(poll_head == NULL) {
+      poll_tail = NULL;
+    }
+    poll_count--;
+    p->needspoll = 0;
+    critical_exit(status);
+
+    p->state = PROCESS_STATE_RUNNING;
+    call_process(p, PROCESS_EVENT_POLL, NULL);
+  }
+#else /* PROCESS_POLL_QUEUE */
 
   poll_requested = 0;
   /* Call the processes that needs to be polled. */
@@ -235,7 +426,36 @@ do_poll(void)
       call_process(p, PROCESS_EVENT_POLL, NULL);
     }
   }
+#endif /* PROCESS_POLL_QUEUE */
+}
+/*---------------------------------------------------------------------------*/
+#if PROCESS_MAX_SUBSCRIPTIONS
+static void
+deliver_to_subscribers(process_event_t ev, process_data_t data)
+{
+  uint8_t i;
+
+  /* A subscriber can unsubscribe, or exit, when it is called, which
+     shifts the following subscriptions down. */
+  i = 0;
+  while(i < num_subscriptions) {
+    struct process *p = subscriptions[i].p;
+
+    if(subscriptions[i].ev == ev) {
+      if(poll_requested) {
+        do_poll();
+      }
+      call_process(p, ev, data);
+      if(i < num_subscriptions &&
+         (subscriptions[i].p != p || subscriptions[i].ev != ev)) {
+        /* The subscription was removed: look at the same index again */
+        continue;
+      }
+    }
+    i++;
+  }
 }
+#endif /* PROCESS_MAX_SUBSCRIPTIONS */
 /*---------------------------------------------------------------------------*/
 /*
  * Process the next event in the event queue and deliver it to
@@ -249,6 +469,7 @@ do_event(void)
   process_data_t data;
   struct process *receiver;
   struct process *p;
+  struct event_queue *q;
 
   /*
    * If there are any events in the queue, take the first one and walk
@@ -260,20 +481,32 @@ do_event(void)
 
   if(nevents > 0) {
 
-    /* There are events that we should deliver. */
-    ev = events[fevent].ev;
+    /* There are events that we should deliver. Take them from the
+       highest priority class that has any. */
+    q = &queues[PROCESS_PRIORITIES - 1];
+    while(q->nevents == 0) {
+      q--;
+    }
+    ev = q->events[q->fevent].ev;
 
-    data = events[fevent].data;
-    receiver = events[fevent].p;
+    data = q->events[q->fevent].data;
+    receiver = q->events[q->fevent].p;
 
     /* Since we have seen the new event, we move pointer upwards
        and decrease the number of events. */
-    fevent = (fevent + 1) % PROCESS_CONF_NUMEVENTS;
+    q->fevent = (q->fevent + 1) % PROCESS_CONF_NUMEVENTS;
+    --q->nevents;
     --nevents;
 
     /* If this is a broadcast event, we deliver it to all events, in
        order of their priority. */
     if(receiver == PROCESS_BROADCAST) {
+#if PROCESS_MAX_SUBSCRIPTIONS
+      if(EVENT_IS_SUBSCRIBED(ev)) {
+        deliver_to_subscribers(ev, data);
+        return;
+      }
+#endif /* PROCESS_MAX_SUBSCRIPTIONS */
       for(p = process_list; p != NULL; p = p->next) {
 
         /* If we have been requested to poll a process, we do this in
@@ -318,10 +551,29 @@ process_nevents(void)
   return nevents + poll_requested;
 }
 /*---------------------------------------------------------------------------*/
+/*
+ * The priority class in which an event is queued.
+ */
+static unsigned char
+event_class(struct process *p, process_event_t ev)
+{
+#if PROCESS_PRIORITIES > 1
+  if(EVENT_IS_URGENT(ev)) {
+    return PROCESS_PRIORITY_HIGH;
+  }
+  if(p != PROCESS_BROADCAST) {
+    return p->priority;
+  }
+#endif /* PROCESS_PRIORITIES > 1 */
+  return PROCESS_PRIORITY_NORMAL;
+}
+/*---------------------------------------------------------------------------*/
 int
 process_post(struct process *p, process_event_t ev, process_data_t data)
 {
   process_num_events_t snum;
+  unsigned char class;
+  struct event_queue *q;
 
   if(PROCESS_CURRENT() == NULL) {
     PRINTF("process_post: NULL process posts event %d to process '%s', nevents %d\n",
@@ -332,7 +584,13 @@ process_post(struct process *p, process_event_t ev, process_data_t data)
            p == PROCESS_BROADCAST ? "<broadcast>" : PROCESS_NAME_STRING(p), nevents);
   }
 
-  if(nevents == PROCESS_CONF_NUMEVENTS) {
+  class = event_class(p, ev);
+  q = &queues[class];
+
+  if(q->nevents == PROCESS_CONF_NUMEVENTS) {
+#if PROCESS_CONF_STATS
+    process_class_overflows[class]++;
+#endif /* PROCESS_CONF_STATS */
 #if DEBUG
     if(p == PROCESS_BROADCAST) {
       printf("soft panic: event queue is full when broadcast event %d was posted from %s\n", ev, PROCESS_NAME_STRING(process_current));
@@ -343,16 +601,20 @@ process_post(struct process *p, process_event_t ev, process_data_t data)
     return PROCESS_ERR_FULL;
   }
 
-  snum = (process_num_events_t)(fevent + nevents) % PROCESS_CONF_NUMEVENTS;
-  events[snum].ev = ev;
-  events[snum].data = data;
-  events[snum].p = p;
+  snum = (process_num_events_t)(q->fevent + q->nevents) % PROCESS_CONF_NUMEVENTS;
+  q->events[snum].ev = ev;
+  q->events[snum].data = data;
+  q->events[snum].p = p;
+  ++q->nevents;
   ++nevents;
 
 #if PROCESS_CONF_STATS
   if(nevents > process_maxevents) {
     process_maxevents = nevents;
   }
+  if(q->nevents > process_class_maxevents[class]) {
+    process_class_maxevents[class] = q->nevents;
+  }
 #endif /* PROCESS_CONF_STATS */
 
   return PROCESS_ERR_OK;
@@ -373,8 +635,26 @@ process_poll(struct process *p)
   if(p != NULL) {
     if(p->state == PROCESS_STATE_RUNNING ||
        p->state == PROCESS_STATE_CALLED) {
+#if PROCESS_POLL_QUEUE
+      int_master_status_t status = critical_enter();
+
+      if(!p->needspoll) {
+        p->next_poll = NULL;
+        if(poll_tail != NULL) {
+          poll_tail->next_poll = p;
+        } else {
+          poll_head = p;
+        }
+        poll_tail = p;
+        poll_count++;
+      }
+      p->needspoll = 1;
+      poll_requested = 1;
+      critical_exit(status);
+#else /* PROCESS_POLL_QUEUE */
       p->needspoll = 1;
       poll_requested = 1;
+#endif /* PROCESS_POLL_QUEUE */
     }
   }
 }
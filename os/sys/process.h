@@ -88,6 +88,58 @@ typedef unsigned char process_num_events_t;
 #define PROCESS_CONF_NUMEVENTS 32
 #endif /* PROCESS_CONF_NUMEVENTS */
 
+/**
+ * \brief Number of scheduling priority classes
+ *
+ * With more than one class, every class has its own event queue of
+ * PROCESS_CONF_NUMEVENTS entries, and the scheduler always delivers
+ * the oldest event of the highest non-empty class first. An event is
+ * queued in the class of its receiver, or in the highest class if the
+ * event number has been marked as urgent with
+ * process_set_event_urgent(). Broadcast events are queued in the
+ * lowest class unless they are urgent.
+ */
+#ifdef PROCESS_CONF_PRIORITIES
+#define PROCESS_PRIORITIES PROCESS_CONF_PRIORITIES
+#else
+#define PROCESS_PRIORITIES 1
+#endif /* PROCESS_CONF_PRIORITIES */
+
+/**
+ * \brief Keep a queue of the processes that have been polled
+ *
+ * By default, the scheduler walks the whole process list to find the
+ * processes that have been polled. With this option, process_poll()
+ * appends the process to a queue instead, so that polling is
+ * proportional to the number of polled processes.
+ */
+#ifdef PROCESS_CONF_POLL_QUEUE
+#define PROCESS_POLL_QUEUE PROCESS_CONF_POLL_QUEUE
+#else
+#define PROCESS_POLL_QUEUE 0
+#endif /* PROCESS_CONF_POLL_QUEUE */
+
+/**
+ * \brief Maximum number of event subscriptions
+ *
+ * When non-zero, processes can subscribe to event numbers with
+ * process_subscribe(). A broadcast event that has at least one
+ * subscriber is then only delivered to its subscribers, instead of to
+ * every process. Broadcast events without subscribers still reach all
+ * processes. Note that once an event has subscribers, a process that
+ * wants to receive its broadcasts must subscribe as well.
+ */
+#ifdef PROCESS_CONF_MAX_SUBSCRIPTIONS
+#define PROCESS_MAX_SUBSCRIPTIONS PROCESS_CONF_MAX_SUBSCRIPTIONS
+#else
+#define PROCESS_MAX_SUBSCRIPTIONS 0
+#endif /* PROCESS_CONF_MAX_SUBSCRIPTIONS */
+
+/** The default priority class of a process */
+#define PROCESS_PRIORITY_NORMAL 0
+/** The highest priority class, used for urgent events */
+#define PROCESS_PRIORITY_HIGH   (PROCESS_PRIORITIES - 1)
+
 #define PROCESS_EVENT_NONE            0x80
 #define PROCESS_EVENT_INIT            0x81
 #define PROCESS_EVENT_POLL            0x82
@@ -310,6 +362,38 @@ static PT_THREAD(process_thread_##name(struct pt *process_pt,	\
                           process_thread_##name }
 #endif
 
+/**
+ * Declare a process in a given priority class.
+ *
+ * This macro works like PROCESS(), but places the events posted to the
+ * process in the given priority class. Without PROCESS_CONF_PRIORITIES,
+ * the priority is ignored.
+ *
+ * \param name The variable name of the process structure.
+ * \param strname The string representation of the process' name.
+ * \param priority The priority class, e.g., PROCESS_PRIORITY_HIGH.
+ *
+ * \hideinitializer
+ */
+#if PROCESS_PRIORITIES > 1
+#if PROCESS_CONF_NO_PROCESS_NAMES
+#define PROCESS_WITH_PRIORITY(name, strname, priority)	\
+  PROCESS_THREAD(name, ev, data);			\
+  struct process name = { NULL,		        \
+                          process_thread_##name,	\
+                          { 0 }, 0, 0, priority }
+#else
+#define PROCESS_WITH_PRIORITY(name, strname, priority)	\
+  PROCESS_THREAD(name, ev, data);			\
+  struct process name = { NULL, strname,		\
+                          process_thread_##name,	\
+                          { 0 }, 0, 0, priority }
+#endif
+#else /* PROCESS_PRIORITIES > 1 */
+#define PROCESS_WITH_PRIORITY(name, strname, priority)	\
+  PROCESS(name, strname)
+#endif /* PROCESS_PRIORITIES > 1 */
+
 /** @} */
 
 struct process {
@@ -323,6 +407,12 @@ struct process {
   PT_THREAD((* thread)(struct pt *, process_event_t, process_data_t));
   struct pt pt;
   unsigned char state, needspoll;
+#if PROCESS_PRIORITIES > 1
+  unsigned char priority;
+#endif
+#if PROCESS_POLL_QUEUE
+  struct process *next_poll;
+#endif
 };
 
 /**
@@ -452,6 +542,53 @@ process_current = p
  */
 process_event_t process_alloc_event(void);
 
+/**
+ * \brief      Set the priority class of a process.
+ * \param p    The process
+ * \param priority The priority class, between PROCESS_PRIORITY_NORMAL
+ *             and PROCESS_PRIORITY_HIGH
+ *
+ *             Events that are already queued for the process keep
+ *             their class. Without PROCESS_CONF_PRIORITIES, this
+ *             function has no effect.
+ */
+void process_set_priority(struct process *p, unsigned char priority);
+
+/**
+ * \brief      Mark an event number as urgent.
+ * \param ev   The event number
+ *
+ *             Urgent events are queued in the highest priority class,
+ *             whatever the class of their receiver, so that they
+ *             are delivered ahead of bulk events. PROCESS_EVENT_TIMER
+ *             is urgent by default. Without PROCESS_CONF_PRIORITIES,
+ *             this function has no effect.
+ */
+void process_set_event_urgent(process_event_t ev);
+
+/**
+ * \brief      Subscribe a process to broadcasts of an event.
+ * \param p    The process
+ * \param ev   The event number
+ * \retval PROCESS_ERR_OK The process is subscribed to the event
+ * \retval PROCESS_ERR_FULL There are already PROCESS_CONF_MAX_SUBSCRIPTIONS
+ *             subscriptions
+ *
+ *             Once an event has subscribers, broadcasts of the event
+ *             are only delivered to them. Subscriptions are removed
+ *             when the process exits. Without
+ *             PROCESS_CONF_MAX_SUBSCRIPTIONS, every process receives
+ *             every broadcast and this function does nothing.
+ */
+int process_subscribe(struct process *p, process_event_t ev);
+
+/**
+ * \brief      Remove the subscription of a process to an event.
+ * \param p    The process
+ * \param ev   The event number
+ */
+void process_unsubscribe(struct process *p, process_event_t ev);
+
 /** @} */
 
 /**
@@ -521,6 +658,24 @@ int process_nevents(void);
 
 /** @} */
 
+#if PROCESS_CONF_STATS
+/**
+ * \name Scheduler statistics
+ *
+ * Kept when PROCESS_CONF_STATS is set.
+ * @{
+ */
+
+/** The highest number of events that have been queued at once */
+extern uint16_t process_maxevents;
+/** The high-water mark of the event queue of each priority class */
+extern process_num_events_t process_class_maxevents[PROCESS_PRIORITIES];
+/** The number of events that did not fit in each priority class */
+extern uint16_t process_class_overflows[PROCESS_PRIORITIES];
+
+/** @} */
+#endif /* PROCESS_CONF_STATS */
+
 extern struct process *process_list;
 
 #define PROCESS_LIST() process_list
@@ -24,6 +24,8 @@ AUTOSTART_PROCESSES(&udp_client_process);
 
 #if RADIO_OFF_SLP
 
+#define STR(x) #x
+#define XSTR(x) STR(x)
 #pragma message "Radio disable SLP is ENABLED as " XSTR(RADIO_OFF_SLP)
 #if RADIO_OFF_SLP == RADOFF_SLP_COUNTER
 static int count = 0;
@@ -36,6 +38,10 @@ static double prob = OFF_TIMER_BASE_PROB;
 static struct ctimer off_timer;
 static struct ctimer to_off_timer;
 
+// The policy draws from its own stream, so that it does not change the
+// backoffs and timers of the network stack
+RANDOM_STREAM(policy_random, RANDOM_STREAM_APP);
+
 // Switch on and off functions, just used for the ctimers now, as using ip processors to "disable"
 static void switch_on() {
   LOG_INFO("Radio back on\n");
@@ -64,11 +70,11 @@ static enum netstack_ip_action ip_input(void) {
   if (proto == UIP_PROTO_UDP) {
 
 #if RADIO_OFF_SLP == RADOFF_SLP_RAND
-    double r = (double) random_rand() / (double) RAND_MAX;  // Random float in [0, 1]
+    double r = random_stream_float(&policy_random);  // Random float in [0, 1)
     LOG_INFO("Random %lf threshold %lf\n", r, OFF_TIMER_PROB);
     if (r < OFF_TIMER_PROB) {
 #elif RADIO_OFF_SLP == RADOFF_SLP_CUMUL_RAND
-    double r = (double) random_rand() / (double) RAND_MAX;  // Random float in [0, 1]
+    double r = random_stream_float(&policy_random);  // Random float in [0, 1)
     prob *= OFF_TIMER_MULTIPLIER;
     LOG_INFO("Random %lf threshold %lf\n", r, prob);
     if (r < prob) {
@@ -79,7 +85,7 @@ static enum netstack_ip_action ip_input(void) {
     if (count >= OFF_TIMER_THRESHOLD) {
       count = 0;
 #elif RADIO_OFF_SLP == RADOFF_SLP_RANDINIT_COUNTER
-    if (count == -1) count = random_rand() % OFF_TIMER_THRESHOLD;  // Initialize to random
+    if (count == -1) count = random_stream_rand(&policy_random) % OFF_TIMER_THRESHOLD;  // Initialize to random
     count++;
     LOG_INFO("Count %d threshold %d\n", count, OFF_TIMER_THRESHOLD);
     if (count >= OFF_TIMER_THRESHOLD) {
@@ -31,6 +31,7 @@
 /*---------------------------------------------------------------------------*/
 #include "contiki.h"
 #include "lib/list.h"
+#include "lib/memb.h"
 #include "lib/stack.h"
 #include "lib/queue.h"
 #include "lib/circular-list.h"
@@ -1024,6 +1025,54 @@ UNIT_TEST(test_cdll)
   UNIT_TEST_END();
 }
 /*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(test_memb, "Memory block allocation");
+UNIT_TEST(test_memb)
+{
+  /* Enough blocks to span more than one bitmap word */
+  MEMB(pool, demo_struct_t, MEMB_WORD_BITS + 5);
+  demo_struct_t *blocks[MEMB_WORD_BITS + 5];
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  memb_init(&pool);
+  UNIT_TEST_ASSERT(memb_numfree(&pool) == MEMB_WORD_BITS + 5);
+
+  /* Blocks are allocated in order until the pool is full */
+  for(i = 0; i < MEMB_WORD_BITS + 5; i++) {
+    blocks[i] = memb_alloc(&pool);
+    UNIT_TEST_ASSERT(blocks[i] == (demo_struct_t *)pool.mem + i);
+    UNIT_TEST_ASSERT(memb_inmemb(&pool, blocks[i]));
+  }
+  UNIT_TEST_ASSERT(memb_alloc(&pool) == NULL);
+  UNIT_TEST_ASSERT(memb_numfree(&pool) == 0);
+
+  /* The lowest free block is allocated first */
+  UNIT_TEST_ASSERT(memb_free(&pool, blocks[MEMB_WORD_BITS + 2]) == 0);
+  UNIT_TEST_ASSERT(memb_free(&pool, blocks[3]) == 0);
+  UNIT_TEST_ASSERT(memb_numfree(&pool) == 2);
+  UNIT_TEST_ASSERT(memb_alloc(&pool) == blocks[3]);
+  UNIT_TEST_ASSERT(memb_alloc(&pool) == blocks[MEMB_WORD_BITS + 2]);
+  UNIT_TEST_ASSERT(memb_alloc(&pool) == NULL);
+
+  /* Invalid and double frees are detected */
+  UNIT_TEST_ASSERT(memb_free(&pool, &elements[0]) == -1);
+  UNIT_TEST_ASSERT(memb_inmemb(&pool, &elements[0]) == 0);
+  UNIT_TEST_ASSERT(memb_free(&pool, (char *)blocks[1] + 1) == -1);
+  UNIT_TEST_ASSERT(memb_free(&pool, blocks[1]) == 0);
+  UNIT_TEST_ASSERT(memb_free(&pool, blocks[1]) == -1);
+
+  for(i = 0; i < MEMB_WORD_BITS + 5; i++) {
+    memb_free(&pool, blocks[i]);
+  }
+  UNIT_TEST_ASSERT(memb_numfree(&pool) == MEMB_WORD_BITS + 5);
+#if MEMB_STATS
+  UNIT_TEST_ASSERT(memb_peak(&pool) == MEMB_WORD_BITS + 5);
+#endif
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
 PROCESS_THREAD(data_structure_test_process, ev, data)
 {
   PROCESS_BEGIN();
@@ -1039,6 +1088,7 @@ PROCESS_THREAD(data_structure_test_process, ev, data)
   UNIT_TEST_RUN(test_csll);
   UNIT_TEST_RUN(test_dll);
   UNIT_TEST_RUN(test_cdll);
+  UNIT_TEST_RUN(test_memb);
 
   printf("=check-me= DONE\n");
 
@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *         Known-answer tests of the AES-128 drivers of native builds,
+ *         and their throughput.
+ */
+
+#include "contiki.h"
+#include "lib/aes-128.h"
+#include "lib/hexconv.h"
+#include "lib/random.h"
+#include "dev/native-aes-128.h"
+#include "unit-test.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+PROCESS(test_process, "AES-128 test");
+AUTOSTART_PROCESSES(&test_process);
+
+RANDOM_STREAM(test_random, RANDOM_STREAM_APP);
+
+/* The example of FIPS-197, Appendix B, its vector of Appendix C.1, and
+ * the ECB-AES128 vectors of NIST SP 800-38A, F.1.1: key, plaintext,
+ * ciphertext */
+static const char *vectors[][3] = {
+  { "2b7e151628aed2a6abf7158809cf4f3c", "3243f6a8885a308d313198a2e0370734",
+    "3925841d02dc09fbdc118597196a0b32" },
+  { "000102030405060708090a0b0c0d0e0f", "00112233445566778899aabbccddeeff",
+    "69c4e0d86a7b0430d8cdb78070b4c55a" },
+  { "2b7e151628aed2a6abf7158809cf4f3c", "6bc1bee22e409f96e93d7e117393172a",
+    "3ad77bb40d7a3660a89ecaf32466ef97" },
+  { "2b7e151628aed2a6abf7158809cf4f3c", "ae2d8a571e03ac9c9eb76fac45af8e51",
+    "f5d3d58503b9699de785895a96fdbaaf" },
+  { "2b7e151628aed2a6abf7158809cf4f3c", "30c81c46a35ce411e5fbc1191a0a52ef",
+    "43b1cd7f598ece23881b00e3ed030688" },
+  { "2b7e151628aed2a6abf7158809cf4f3c", "f69f2445df4f9b17ad2b417be66c3710",
+    "7b0c785e27e8ad3f8223207104725dd4" },
+};
+#define NUM_VECTORS (sizeof(vectors) / sizeof(vectors[0]))
+
+/* Random keys and blocks checked against the byte-wise driver */
+#define RANDOM_KEYS 64
+#define RANDOM_BLOCKS 16
+
+/* Blocks encrypted per throughput measurement */
+#define BENCH_BLOCKS 1000000
+/*---------------------------------------------------------------------------*/
+static bool
+check_vectors(const struct aes_128_driver *driver)
+{
+  static struct aes_128_context context;
+  uint8_t key[AES_128_KEY_LENGTH];
+  uint8_t block[AES_128_BLOCK_SIZE];
+  uint8_t expected[AES_128_BLOCK_SIZE];
+  bool success = true;
+  int i;
+
+  for(i = 0; i < NUM_VECTORS; i++) {
+    hexconv_unhexlify(vectors[i][0], 32, key, sizeof(key));
+    hexconv_unhexlify(vectors[i][2], 32, expected, sizeof(expected));
+
+    hexconv_unhexlify(vectors[i][1], 32, block, sizeof(block));
+    driver->set_key(key);
+    driver->encrypt(block);
+    success = success && !memcmp(block, expected, sizeof(block));
+
+    hexconv_unhexlify(vectors[i][1], 32, block, sizeof(block));
+    driver->init_context(&context, key);
+    driver->set_context(&context);
+    driver->encrypt(block);
+    success = success && !memcmp(block, expected, sizeof(block));
+  }
+  return success;
+}
+/*---------------------------------------------------------------------------*/
+static bool
+check_random(const struct aes_128_driver *driver)
+{
+  static struct aes_128_context contexts[2];
+  uint8_t keys[2][AES_128_KEY_LENGTH];
+  uint8_t block[AES_128_BLOCK_SIZE];
+  uint8_t expected[AES_128_BLOCK_SIZE];
+  bool success = true;
+  int i;
+  int j;
+  int k;
+  int b;
+
+  for(i = 0; i < RANDOM_KEYS; i++) {
+    for(k = 0; k < 2; k++) {
+      for(j = 0; j < AES_128_KEY_LENGTH; j++) {
+        keys[k][j] = random_stream_rand(&test_random);
+      }
+      driver->init_context(&contexts[k], keys[k]);
+    }
+    for(j = 0; j < RANDOM_BLOCKS; j++) {
+      /* Switch between contexts and set_key(), as a MAC layer may */
+      k = random_stream_rand(&test_random) % 2;
+      for(b = 0; b < AES_128_BLOCK_SIZE; b++) {
+        block[b] = random_stream_rand(&test_random);
+      }
+      memcpy(expected, block, sizeof(block));
+      aes_128_driver.set_key(keys[k]);
+      aes_128_driver.encrypt(expected);
+
+      if(j % 4 == 3) {
+        driver->set_key(keys[k]);
+      } else {
+        driver->set_context(&contexts[k]);
+      }
+      driver->encrypt(block);
+      success = success && !memcmp(block, expected, sizeof(block));
+    }
+  }
+  return success;
+}
+/*---------------------------------------------------------------------------*/
+static bool
+check_driver(const char *name, const struct aes_128_driver *driver)
+{
+  bool vectors_ok;
+  bool random_ok;
+
+  vectors_ok = check_vectors(driver);
+  printf("TEST: %s: known answers --- %s\n", name, vectors_ok ? "OK" : "FAIL");
+
+  random_ok = check_random(driver);
+  printf("TEST: %s: random keys --- %s\n", name, random_ok ? "OK" : "FAIL");
+
+  return vectors_ok && random_ok;
+}
+/*---------------------------------------------------------------------------*/
+static double
+cpu_usec(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+/*---------------------------------------------------------------------------*/
+static void
+bench_driver(const char *name, const struct aes_128_driver *driver)
+{
+  static struct aes_128_context context;
+  static const uint8_t key[AES_128_KEY_LENGTH];
+  uint8_t block[AES_128_BLOCK_SIZE] = { 0 };
+  double start;
+  double elapsed;
+  int i;
+
+  driver->init_context(&context, key);
+  driver->set_context(&context);
+  start = cpu_usec();
+  for(i = 0; i < BENCH_BLOCKS; i++) {
+    driver->encrypt(block);
+  }
+  elapsed = cpu_usec() - start;
+  printf("TEST: %-9s %7.1f ns/block %7.1f MB/s\n", name,
+         elapsed * 1e3 / BENCH_BLOCKS,
+         (double)AES_128_BLOCK_SIZE * BENCH_BLOCKS / elapsed);
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(aes128_bytewise, "AES-128 byte-wise driver");
+UNIT_TEST(aes128_bytewise)
+{
+  UNIT_TEST_BEGIN();
+  UNIT_TEST_ASSERT(check_driver("byte-wise", &aes_128_driver));
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(aes128_ttable, "AES-128 T-table driver");
+UNIT_TEST(aes128_ttable)
+{
+  UNIT_TEST_BEGIN();
+  UNIT_TEST_ASSERT(check_driver("T-table", &aes_128_ttable_driver));
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(aes128_aesni, "AES-128 AES-NI driver");
+UNIT_TEST(aes128_aesni)
+{
+  UNIT_TEST_BEGIN();
+#if NATIVE_AES_128_AESNI
+  if(native_aes_128_has_aesni()) {
+    UNIT_TEST_ASSERT(check_driver("AES-NI", &native_aes_128_aesni_driver));
+  } else {
+    printf("TEST: AES-NI: not supported by the CPU --- SKIPPED\n");
+  }
+#else /* NATIVE_AES_128_AESNI */
+  printf("TEST: AES-NI: not built --- SKIPPED\n");
+#endif /* NATIVE_AES_128_AESNI */
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(aes128_default, "AES-128 default driver");
+UNIT_TEST(aes128_default)
+{
+  UNIT_TEST_BEGIN();
+  /* The driver that the native platforms select at runtime */
+  UNIT_TEST_ASSERT(&AES_128 == &native_aes_128_driver);
+  UNIT_TEST_ASSERT(check_driver("AES_128", &AES_128));
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  UNIT_TEST_RUN(aes128_bytewise);
+  UNIT_TEST_RUN(aes128_ttable);
+  UNIT_TEST_RUN(aes128_aesni);
+  UNIT_TEST_RUN(aes128_default);
+
+  bench_driver("byte-wise", &aes_128_driver);
+  bench_driver("T-table", &aes_128_ttable_driver);
+#if NATIVE_AES_128_AESNI
+  if(native_aes_128_has_aesni()) {
+    bench_driver("AES-NI", &native_aes_128_aesni_driver);
+  }
+#endif /* NATIVE_AES_128_AESNI */
+  bench_driver("AES_128", &AES_128);
+
+  printf("=check-me= DONE\n");
+  printf("---\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -166,6 +166,261 @@ UNIT_TEST(aesccm_decrypt)
   UNIT_TEST_END();
 }
 /*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(aesccm_contexts, "AES-CCM key contexts");
+UNIT_TEST(aesccm_contexts)
+{
+  int i;
+  int j;
+  int other; /* Whether the current frame is secured with the other key */
+  UNIT_TEST_BEGIN();
+
+  printf("TEST: *** key contexts\n");
+
+  static uint8_t key_bytes[16];
+  static uint8_t other_key_bytes[16];
+  static uint8_t nonce_bytes[13];
+  static struct aes_128_context contexts[2];
+  hexconv_unhexlify(key, strlen(key), key_bytes, sizeof(key_bytes));
+  hexconv_unhexlify(nonce, strlen(nonce), nonce_bytes, sizeof(nonce_bytes));
+  for(j = 0; j < sizeof(other_key_bytes); j++) {
+    other_key_bytes[j] = key_bytes[j] ^ 0x5a;
+  }
+
+  /* Prepare the other key last, to check that preparing a context does
+   * not change the key in use */
+  CCM_STAR.init_context(&contexts[0], key_bytes);
+  CCM_STAR.set_context(&contexts[0]);
+  CCM_STAR.init_context(&contexts[1], other_key_bytes);
+  other = 0;
+
+  for(i = 0; i < NUM_TESTSCASES; i++) {
+    bool success;
+    const char *hdr_string = testcases[i][0];
+    const char *cleartext_string = testcases[i][1];
+    const char *ciphertext_string = testcases[i][2];
+
+    if(hdr_string != NULL && cleartext_string != NULL) {
+      static uint8_t cleartext_bytes[MAXLEN * 2 + MICLEN];
+      static uint8_t ciphertext_bytes[MAXLEN * 2 + MICLEN];
+      static uint8_t buffer[MAXLEN * 2 + MICLEN];
+      static uint8_t first_buffer[MAXLEN * 2 + MICLEN];
+      uint8_t generated_mic[MICLEN];
+      size_t a_len = strlen(hdr_string) / 2;
+      size_t m_len = strlen(cleartext_string) / 2;
+      hexconv_unhexlify(hdr_string, strlen(hdr_string), cleartext_bytes, sizeof(cleartext_bytes));
+      hexconv_unhexlify(cleartext_string, strlen(cleartext_string), cleartext_bytes + a_len, sizeof(cleartext_bytes) - a_len);
+      hexconv_unhexlify(ciphertext_string, strlen(ciphertext_string), ciphertext_bytes, sizeof(ciphertext_bytes));
+
+      /* Alternate between the contexts, as a MAC layer with several keys */
+      if(other) {
+        CCM_STAR.set_context(&contexts[1]);
+      }
+      memcpy(first_buffer, cleartext_bytes, a_len + m_len);
+      CCM_STAR.aead(nonce_bytes, first_buffer + a_len, m_len,
+                    first_buffer, a_len, first_buffer + a_len + m_len,
+                    MICLEN, 1);
+
+      CCM_STAR.set_context(&contexts[other ? 0 : 1]);
+      memcpy(buffer, cleartext_bytes, a_len + m_len);
+      CCM_STAR.aead(nonce_bytes, buffer + a_len, m_len,
+                    buffer, a_len, buffer + a_len + m_len, MICLEN, 1);
+
+      /* Whichever of the two frames was secured with the key of the vectors */
+      success = !memcmp(other ? buffer : first_buffer, ciphertext_bytes,
+                        a_len + m_len + MICLEN);
+
+      /* A context gives the same result as setting its key */
+      CCM_STAR.set_key(other ? other_key_bytes : key_bytes);
+      memcpy(buffer, cleartext_bytes, a_len + m_len);
+      CCM_STAR.aead(nonce_bytes, buffer + a_len, m_len,
+                    buffer, a_len, buffer + a_len + m_len, MICLEN, 1);
+      success = success && !memcmp(buffer, other ? first_buffer : ciphertext_bytes,
+                                   a_len + m_len + MICLEN);
+
+      /* And a context can be set again after set_key() */
+      CCM_STAR.set_context(&contexts[0]);
+      memcpy(buffer, ciphertext_bytes, a_len + m_len + MICLEN);
+      CCM_STAR.aead(nonce_bytes, buffer + a_len, m_len,
+                    buffer, a_len, generated_mic, MICLEN, 0);
+      success = success
+                && !memcmp(buffer, cleartext_bytes, a_len + m_len)
+                && !memcmp(generated_mic, buffer + a_len + m_len, MICLEN);
+
+      printf("TEST: contexts: %u + %u bytes --- %s\n",
+             (unsigned)a_len, (unsigned)m_len, success ? "OK" : "FAIL");
+      UNIT_TEST_ASSERT(success);
+      other = !other;
+    }
+  }
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+/* The two-pass CCM* of earlier versions, one AES block at a time, to
+ * check that the interleaved engine gives the same output */
+static void
+ref_set_iv(uint8_t *iv, uint8_t flags, const uint8_t *nonce, uint16_t counter)
+{
+  iv[0] = flags;
+  memcpy(iv + 1, nonce, 13);
+  iv[14] = counter >> 8;
+  iv[15] = counter;
+}
+/*---------------------------------------------------------------------------*/
+static void
+ref_ctr_step(const uint8_t *nonce, uint16_t pos, uint8_t *m_and_result,
+             uint16_t m_len, uint16_t counter)
+{
+  uint8_t a[16];
+  uint8_t i;
+
+  ref_set_iv(a, 1, nonce, counter);
+  AES_128.encrypt(a);
+  for(i = 0; (pos + i < m_len) && (i < 16); i++) {
+    m_and_result[pos + i] ^= a[i];
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+ref_mic(const uint8_t *nonce, const uint8_t *m, uint16_t m_len,
+        const uint8_t *a, uint16_t a_len, uint8_t *result, uint8_t mic_len)
+{
+  uint8_t x[16];
+  uint32_t pos;
+  uint8_t i;
+
+  ref_set_iv(x, ((a_len > 0) ? (1u << 6) : 0)
+             | (((mic_len - 2u) >> 1) << 3) | 1u, nonce, m_len);
+  AES_128.encrypt(x);
+  if(a_len) {
+    x[0] ^= a_len >> 8;
+    x[1] ^= a_len;
+    for(i = 2; (i - 2 < a_len) && (i < 16); i++) {
+      x[i] ^= a[i - 2];
+    }
+    AES_128.encrypt(x);
+    for(pos = 14; pos < a_len; pos += 16) {
+      for(i = 0; (pos + i < a_len) && (i < 16); i++) {
+        x[i] ^= a[pos + i];
+      }
+      AES_128.encrypt(x);
+    }
+  }
+  for(pos = 0; pos < m_len; pos += 16) {
+    for(i = 0; (pos + i < m_len) && (i < 16); i++) {
+      x[i] ^= m[pos + i];
+    }
+    AES_128.encrypt(x);
+  }
+  ref_ctr_step(nonce, 0, x, 16, 0);
+  memcpy(result, x, mic_len);
+}
+/*---------------------------------------------------------------------------*/
+static void
+ref_aead(const uint8_t *nonce, uint8_t *m, uint16_t m_len,
+         const uint8_t *a, uint16_t a_len, uint8_t *result, uint8_t mic_len,
+         int forward)
+{
+  uint32_t pos;
+  uint16_t counter;
+
+  if(a_len > 0xfeff || mic_len < 4 || mic_len > 16 || mic_len % 2) {
+    return;
+  }
+  if(!forward) {
+    for(pos = 0, counter = 1; pos < m_len; pos += 16) {
+      ref_ctr_step(nonce, pos, m, m_len, counter++);
+    }
+  }
+  ref_mic(nonce, m, m_len, a, a_len, result, mic_len);
+  if(forward) {
+    for(pos = 0, counter = 1; pos < m_len; pos += 16) {
+      ref_ctr_step(nonce, pos, m, m_len, counter++);
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+#define BATCH_ROUNDS 400
+#define BATCH_MAX_FRAMES 9
+#define BATCH_MAX_LEN 300
+
+UNIT_TEST_REGISTER(aesccm_batch, "AES-CCM interleaved and batched");
+UNIT_TEST(aesccm_batch)
+{
+  static const uint8_t mic_lens[] = { 4, 6, 8, 10, 12, 14, 16, 0, 3 };
+  static uint8_t buffers[BATCH_MAX_FRAMES][2][BATCH_MAX_LEN * 2 + 16];
+  static uint8_t nonces[BATCH_MAX_FRAMES][13];
+  static uint8_t key_bytes[16];
+  struct ccm_star_frame frames[BATCH_MAX_FRAMES];
+  bool success = true;
+  int round;
+  int count;
+  int forward;
+  int f;
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  printf("TEST: *** interleaved and batched, %u frames at once\n",
+         CCM_STAR_BATCH_FRAMES);
+
+  for(round = 0; round < BATCH_ROUNDS; round++) {
+    for(i = 0; i < sizeof(key_bytes); i++) {
+      key_bytes[i] = random_rand();
+    }
+    CCM_STAR.set_key(key_bytes);
+    count = 1 + random_rand() % BATCH_MAX_FRAMES;
+    forward = random_rand() % 2;
+
+    for(f = 0; f < count; f++) {
+      /* Mostly frame sizes, with a and m empty or a block long at times */
+      frames[f].a_len = random_rand() % 4 == 0
+        ? 14 * (random_rand() % 3) : random_rand() % BATCH_MAX_LEN;
+      frames[f].m_len = random_rand() % 4 == 0
+        ? 16 * (random_rand() % 3) : random_rand() % BATCH_MAX_LEN;
+      frames[f].mic_len = mic_lens[random_rand() % sizeof(mic_lens)];
+      for(i = 0; i < sizeof(nonces[f]); i++) {
+        nonces[f][i] = random_rand();
+      }
+      for(i = 0; i < sizeof(buffers[f][0]); i++) {
+        buffers[f][0][i] = buffers[f][1][i] = random_rand();
+      }
+      frames[f].nonce = nonces[f];
+      frames[f].a = buffers[f][0];
+      frames[f].m = buffers[f][0] + frames[f].a_len;
+      frames[f].result = frames[f].m + frames[f].m_len;
+
+      ref_aead(nonces[f], buffers[f][1] + frames[f].a_len, frames[f].m_len,
+               buffers[f][1], frames[f].a_len,
+               buffers[f][1] + frames[f].a_len + frames[f].m_len,
+               frames[f].mic_len, forward);
+    }
+
+    /* A single frame goes through aead(), as the MAC layers do */
+    if(count == 1) {
+      CCM_STAR.aead(frames[0].nonce, frames[0].m, frames[0].m_len,
+                    frames[0].a, frames[0].a_len, frames[0].result,
+                    frames[0].mic_len, forward);
+    } else {
+      CCM_STAR.aead_frames(frames, count, forward);
+    }
+
+    for(f = 0; f < count; f++) {
+      if(memcmp(buffers[f][0], buffers[f][1], sizeof(buffers[f][0]))) {
+        printf("TEST: frame %d of %d: a %u, m %u, MIC %u, forward %d --- FAIL\n",
+               f, count, frames[f].a_len, frames[f].m_len, frames[f].mic_len,
+               forward);
+        success = false;
+      }
+    }
+  }
+
+  printf("TEST: %d rounds --- %s\n", BATCH_ROUNDS, success ? "OK" : "FAIL");
+  UNIT_TEST_ASSERT(success);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
 PROCESS_THREAD(test_process, ev, data)
 {
   PROCESS_BEGIN();
@@ -175,6 +430,8 @@ PROCESS_THREAD(test_process, ev, data)
 
   UNIT_TEST_RUN(aesccm_encrypt);
   UNIT_TEST_RUN(aesccm_decrypt);
+  UNIT_TEST_RUN(aesccm_contexts);
+  UNIT_TEST_RUN(aesccm_batch);
 
   printf("=check-me= DONE\n");
   printf("---\n");
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "contiki.h"
+#include "sys/ctimer.h"
+#include "unit-test.h"
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+
+/*
+ * Sets a few hundred event and callback timers with intervals that
+ * span several levels of the etimer wheel, stops or re-arms some of
+ * them, and checks that every remaining timer fires exactly once, in
+ * order and not before its expiration time. The event timers start
+ * out filled with garbage, as on the stack, to check that they need
+ * no initialization. Then has two callback timers that are due at once
+ * stop each other, and checks that only one of them fires.
+ */
+
+#define NUM_ETIMERS  256
+#define NUM_CTIMERS  64
+/* Long enough to reach the third level of the wheel */
+#define MAX_INTERVAL (3 * CLOCK_SECOND)
+
+PROCESS(test_process, "test");
+AUTOSTART_PROCESSES(&test_process);
+
+static struct etimer etimers[NUM_ETIMERS];
+static struct ctimer ctimers[NUM_CTIMERS];
+static uint8_t fired[NUM_ETIMERS + NUM_CTIMERS];
+static bool stopped[NUM_ETIMERS + NUM_CTIMERS];
+static unsigned expected;
+static unsigned received;
+static unsigned early;
+static unsigned out_of_order;
+/* Events and callbacks are delivered in separate orders */
+static clock_time_t last_expiration[2];
+static bool next_expiration_ok;
+static struct etimer guard;
+static struct ctimer pair[2];
+static unsigned pair_fired;
+static unsigned stray_events;
+
+/*---------------------------------------------------------------------------*/
+static clock_time_t
+interval(unsigned i)
+{
+  /* A deterministic spread of short and long intervals */
+  return 1 + (i * 7919) % MAX_INTERVAL;
+}
+/*---------------------------------------------------------------------------*/
+static void
+record(unsigned i, clock_time_t expiration)
+{
+  clock_time_t *last = &last_expiration[i >= NUM_ETIMERS];
+
+  fired[i]++;
+  received++;
+  if(clock_time() < expiration) {
+    early++;
+  }
+  /* The timers of a poll are delivered in wheel order, but timers
+     that expired within the same tick can be delivered in any order. */
+  if(expiration + 1 < *last) {
+    out_of_order++;
+  }
+  if(expiration > *last) {
+    *last = expiration;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+ctimer_callback(void *ptr)
+{
+  struct ctimer *c = ptr;
+
+  record(NUM_ETIMERS + (c - ctimers),
+         c->etimer.timer.start + c->etimer.timer.interval);
+}
+/*---------------------------------------------------------------------------*/
+static void
+stop_other(void *ptr)
+{
+  pair_fired++;
+  ctimer_stop(ptr);
+}
+/*---------------------------------------------------------------------------*/
+static void
+set_timers(void)
+{
+  clock_time_t earliest;
+  unsigned i;
+
+  /* Links and a bucket number in range, pointing nowhere */
+  memset(etimers, 0x11, sizeof(etimers));
+
+  earliest = clock_time() + MAX_INTERVAL + 1;
+  for(i = 0; i < NUM_ETIMERS; i++) {
+    etimer_set(&etimers[i], interval(i));
+    if(etimer_expiration_time(&etimers[i]) < earliest) {
+      earliest = etimer_expiration_time(&etimers[i]);
+    }
+  }
+  for(i = 0; i < NUM_CTIMERS; i++) {
+    ctimer_set(&ctimers[i], interval(NUM_ETIMERS + i),
+               ctimer_callback, &ctimers[i]);
+    if(etimer_expiration_time(&ctimers[i].etimer) < earliest) {
+      earliest = etimer_expiration_time(&ctimers[i].etimer);
+    }
+  }
+  next_expiration_ok = etimer_next_expiration_time() == earliest;
+
+  /* Stop every fifth timer, re-arm every seventh one */
+  for(i = 0; i < NUM_ETIMERS + NUM_CTIMERS; i++) {
+    if(i % 5 == 0) {
+      if(i < NUM_ETIMERS) {
+        etimer_stop(&etimers[i]);
+      } else {
+        ctimer_stop(&ctimers[i - NUM_ETIMERS]);
+      }
+      stopped[i] = true;
+    } else {
+      if(i % 7 == 0) {
+        if(i < NUM_ETIMERS) {
+          etimer_restart(&etimers[i]);
+        } else {
+          ctimer_restart(&ctimers[i - NUM_ETIMERS]);
+        }
+      }
+      expected++;
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(timers_fire, "Event and callback timers fire once");
+UNIT_TEST(timers_fire)
+{
+  unsigned i;
+
+  UNIT_TEST_BEGIN();
+
+  printf("TEST: %u of %u timers fired, %u early, %u out of order\n",
+         received, expected, early, out_of_order);
+  UNIT_TEST_ASSERT(next_expiration_ok);
+  UNIT_TEST_ASSERT(received == expected);
+  UNIT_TEST_ASSERT(early == 0);
+  UNIT_TEST_ASSERT(out_of_order == 0);
+  for(i = 0; i < NUM_ETIMERS + NUM_CTIMERS; i++) {
+    UNIT_TEST_ASSERT(fired[i] == (stopped[i] ? 0 : 1));
+  }
+  for(i = 0; i < NUM_ETIMERS; i++) {
+    UNIT_TEST_ASSERT(etimer_expired(&etimers[i]));
+  }
+  for(i = 0; i < NUM_CTIMERS; i++) {
+    UNIT_TEST_ASSERT(ctimer_expired(&ctimers[i]));
+  }
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(due_stop, "Due callback timers stop each other");
+UNIT_TEST(due_stop)
+{
+  UNIT_TEST_BEGIN();
+
+  UNIT_TEST_ASSERT(pair_fired == 1);
+  UNIT_TEST_ASSERT(stray_events == 0);
+  UNIT_TEST_ASSERT(ctimer_expired(&pair[0]));
+  UNIT_TEST_ASSERT(ctimer_expired(&pair[1]));
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  set_timers();
+  etimer_set(&guard, 2 * MAX_INTERVAL);
+
+  while(1) {
+    PROCESS_WAIT_EVENT_UNTIL(ev == PROCESS_EVENT_TIMER);
+    if(data == &guard) {
+      break;
+    }
+    record((struct etimer *)data - etimers,
+           etimer_expiration_time((struct etimer *)data));
+  }
+
+  UNIT_TEST_RUN(timers_fire);
+
+  /* Both have expired when they are set */
+  ctimer_set(&pair[0], 0, stop_other, &pair[1]);
+  ctimer_set(&pair[1], 0, stop_other, &pair[0]);
+  etimer_set(&guard, CLOCK_SECOND / 10);
+  while(1) {
+    PROCESS_WAIT_EVENT_UNTIL(ev == PROCESS_EVENT_TIMER);
+    if(data == &guard) {
+      break;
+    }
+    stray_events++;
+  }
+
+  UNIT_TEST_RUN(due_stop);
+
+  printf("=check-me= DONE\n");
+  printf("---\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
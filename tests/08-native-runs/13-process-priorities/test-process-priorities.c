@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "contiki.h"
+#include "unit-test.h"
+#include <stdio.h>
+#include <stdbool.h>
+
+/*
+ * Floods a normal-priority process with events and checks that events
+ * to a high-priority process, and urgent events, are delivered ahead
+ * of the flood and are not lost when the normal class overflows. Then
+ * fills both classes and checks that every event is delivered.
+ */
+
+#define FLOOD (PROCESS_CONF_NUMEVENTS + 8)
+
+PROCESS(test_process, "test");
+PROCESS(bulk_process, "bulk");
+PROCESS_WITH_PRIORITY(urgent_process, "urgent", PROCESS_PRIORITY_HIGH);
+AUTOSTART_PROCESSES(&test_process);
+
+static process_event_t bulk_event;
+static process_event_t alarm_event;
+static struct etimer et;
+static unsigned bulk_posted;
+static unsigned bulk_received;
+/* Number of bulk events delivered before each of the priority events */
+static int urgent_process_at = -1;
+static int alarm_at = -1;
+static unsigned urgent_received;
+static unsigned full_posted;
+static unsigned full_queued;
+
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(bulk_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  while(1) {
+    PROCESS_WAIT_EVENT();
+    if(ev == bulk_event) {
+      bulk_received++;
+    } else if(ev == alarm_event) {
+      alarm_at = bulk_received;
+    }
+  }
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(urgent_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  while(1) {
+    PROCESS_WAIT_EVENT_UNTIL(ev == PROCESS_EVENT_CONTINUE);
+    if(urgent_process_at < 0) {
+      urgent_process_at = bulk_received;
+    }
+    urgent_received++;
+  }
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(priorities, "Priority classes");
+UNIT_TEST(priorities)
+{
+  UNIT_TEST_BEGIN();
+
+  printf("TEST: %u of %u bulk events posted, %u received\n",
+         bulk_posted, FLOOD, bulk_received);
+  printf("TEST: urgent process ran after %d, urgent event after %d\n",
+         urgent_process_at, alarm_at);
+  printf("TEST: class high-water marks %u/%u, overflows %u/%u\n",
+         process_class_maxevents[PROCESS_PRIORITY_NORMAL],
+         process_class_maxevents[PROCESS_PRIORITY_HIGH],
+         process_class_overflows[PROCESS_PRIORITY_NORMAL],
+         process_class_overflows[PROCESS_PRIORITY_HIGH]);
+
+  /* The normal class overflowed, the high class did not */
+  UNIT_TEST_ASSERT(bulk_posted < FLOOD);
+  UNIT_TEST_ASSERT(bulk_received == bulk_posted);
+  UNIT_TEST_ASSERT(process_class_overflows[PROCESS_PRIORITY_NORMAL] >=
+                   FLOOD - bulk_posted);
+  UNIT_TEST_ASSERT(process_class_overflows[PROCESS_PRIORITY_HIGH] == 0);
+  UNIT_TEST_ASSERT(process_class_maxevents[PROCESS_PRIORITY_NORMAL] ==
+                   PROCESS_CONF_NUMEVENTS);
+
+  /* Both priority events overtook the whole flood */
+  UNIT_TEST_ASSERT(urgent_process_at == 0);
+  UNIT_TEST_ASSERT(alarm_at == 0);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(full_classes, "Full priority classes");
+UNIT_TEST(full_classes)
+{
+  UNIT_TEST_BEGIN();
+
+  printf("TEST: %u events posted to full classes, %u queued, "
+         "%u bulk and %u urgent received\n",
+         full_posted, full_queued, bulk_received, urgent_received);
+
+  UNIT_TEST_ASSERT(full_posted == 2 * PROCESS_CONF_NUMEVENTS);
+  UNIT_TEST_ASSERT(full_queued >= full_posted);
+  UNIT_TEST_ASSERT(process_maxevents >= full_posted);
+  UNIT_TEST_ASSERT(bulk_received == bulk_posted + PROCESS_CONF_NUMEVENTS);
+  UNIT_TEST_ASSERT(urgent_received == 1 + PROCESS_CONF_NUMEVENTS);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_process, ev, data)
+{
+  unsigned i;
+
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  bulk_event = process_alloc_event();
+  alarm_event = process_alloc_event();
+  process_set_event_urgent(alarm_event);
+  process_start(&bulk_process, NULL);
+  process_start(&urgent_process, NULL);
+
+  for(i = 0; i < FLOOD; i++) {
+    if(process_post(&bulk_process, bulk_event, NULL) == PROCESS_ERR_OK) {
+      bulk_posted++;
+    }
+  }
+  process_post(&urgent_process, PROCESS_EVENT_CONTINUE, NULL);
+  process_post(&bulk_process, alarm_event, NULL);
+
+  /* Wait until the flood has drained. The queue of this process is
+     full, so wait for a timer rather than posting to ourselves. */
+  while(bulk_received < bulk_posted) {
+    etimer_set(&et, CLOCK_SECOND / 10);
+    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+  }
+
+  UNIT_TEST_RUN(priorities);
+
+  for(i = 0; i < PROCESS_CONF_NUMEVENTS; i++) {
+    if(process_post(&bulk_process, bulk_event, NULL) == PROCESS_ERR_OK) {
+      full_posted++;
+    }
+    if(process_post(&urgent_process, PROCESS_EVENT_CONTINUE, NULL) ==
+       PROCESS_ERR_OK) {
+      full_posted++;
+    }
+  }
+  full_queued = process_nevents();
+  while(bulk_received < bulk_posted + PROCESS_CONF_NUMEVENTS ||
+        urgent_received < 1 + PROCESS_CONF_NUMEVENTS) {
+    etimer_set(&et, CLOCK_SECOND / 10);
+    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+  }
+
+  UNIT_TEST_RUN(full_classes);
+
+  printf("=check-me= DONE\n");
+  printf("---\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "contiki.h"
+#include "unit-test.h"
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+
+
+/*
+ * Checks that broadcasts of subscribed events only reach their
+ * subscribers, that subscriptions go away on unsubscribe and exit, and
+ * that polled processes are called in order and not after they exit.
+ */
+
+PROCESS(test_process, "test");
+PROCESS(a_process, "a");
+PROCESS(b_process, "b");
+PROCESS(c_process, "c");
+PROCESS(d_process, "d");
+AUTOSTART_PROCESSES(&test_process);
+
+#define NUM_PROCESSES 4
+
+static process_event_t sub_event;
+static process_event_t all_event;
+static unsigned received[NUM_PROCESSES];
+static unsigned all_received;
+static char poll_order[NUM_PROCESSES + 1];
+static unsigned num_polls;
+
+/* Results of the steps */
+static bool subscribe_full;
+static bool subscribers_only;
+static bool all_reached;
+static bool unsubscribed;
+static bool exited;
+static bool exit_cancels_poll;
+
+/*---------------------------------------------------------------------------*/
+static void
+record(int i, process_event_t ev)
+{
+  if(ev == sub_event) {
+    received[i]++;
+  } else if(ev == all_event) {
+    all_received++;
+  } else if(ev == PROCESS_EVENT_POLL) {
+    poll_order[num_polls++] = 'a' + i;
+  }
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(a_process, ev, data)
+{
+  PROCESS_BEGIN();
+  while(1) {
+    PROCESS_WAIT_EVENT();
+    record(0, ev);
+  }
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(b_process, ev, data)
+{
+  PROCESS_BEGIN();
+  while(1) {
+    PROCESS_WAIT_EVENT();
+    record(1, ev);
+  }
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(c_process, ev, data)
+{
+  PROCESS_BEGIN();
+  while(1) {
+    PROCESS_WAIT_EVENT();
+    record(2, ev);
+  }
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(d_process, ev, data)
+{
+  PROCESS_BEGIN();
+  while(1) {
+    PROCESS_WAIT_EVENT();
+    record(3, ev);
+  }
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
+static bool
+received_is(unsigned a, unsigned b, unsigned c, unsigned d)
+{
+  bool ok;
+
+  ok = received[0] == a && received[1] == b &&
+    received[2] == c && received[3] == d;
+  memset(received, 0, sizeof(received));
+  return ok;
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(subscriptions, "Broadcast subscriptions");
+UNIT_TEST(subscriptions)
+{
+  UNIT_TEST_BEGIN();
+
+  UNIT_TEST_ASSERT(subscribe_full);
+  UNIT_TEST_ASSERT(subscribers_only);
+  UNIT_TEST_ASSERT(all_reached);
+  UNIT_TEST_ASSERT(unsubscribed);
+  UNIT_TEST_ASSERT(exited);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(poll_queue, "Poll queue");
+UNIT_TEST(poll_queue)
+{
+  UNIT_TEST_BEGIN();
+
+  printf("TEST: poll order %s\n", poll_order);
+  UNIT_TEST_ASSERT(strcmp(poll_order, "cabc") == 0);
+  UNIT_TEST_ASSERT(exit_cancels_poll);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  sub_event = process_alloc_event();
+  all_event = process_alloc_event();
+  process_start(&a_process, NULL);
+  process_start(&b_process, NULL);
+  process_start(&c_process, NULL);
+  process_start(&d_process, NULL);
+
+  process_subscribe(&a_process, sub_event);
+  process_subscribe(&b_process, sub_event);
+  /* Subscribing twice does not take another slot */
+  process_subscribe(&b_process, sub_event);
+  process_subscribe(&d_process, all_event);
+  process_subscribe(&d_process, PROCESS_EVENT_CONTINUE);
+  subscribe_full =
+    process_subscribe(&c_process, PROCESS_EVENT_CONTINUE) == PROCESS_ERR_FULL;
+  process_unsubscribe(&d_process, all_event);
+  process_unsubscribe(&d_process, PROCESS_EVENT_CONTINUE);
+
+  /* Only the subscribers receive the broadcast */
+  process_post(PROCESS_BROADCAST, sub_event, NULL);
+  process_post(PROCESS_BROADCAST, all_event, NULL);
+  PROCESS_PAUSE();
+  subscribers_only = received_is(1, 1, 0, 0);
+  /* Events without subscribers reach every process */
+  all_reached = all_received == NUM_PROCESSES;
+
+  process_unsubscribe(&b_process, sub_event);
+  process_post(PROCESS_BROADCAST, sub_event, NULL);
+  PROCESS_PAUSE();
+  unsubscribed = received_is(1, 0, 0, 0);
+
+  /* Subscriptions are removed when the process exits. Without
+     subscribers, the event is broadcast to all processes again. */
+  process_exit(&a_process);
+  process_post(PROCESS_BROADCAST, sub_event, NULL);
+  PROCESS_PAUSE();
+  exited = received_is(0, 1, 1, 1);
+
+  /* Polls are delivered in the order of the requests, and a process
+     polled twice is only called once per round */
+  process_start(&a_process, NULL);
+  process_poll(&c_process);
+  process_poll(&a_process);
+  process_poll(&c_process);
+  process_poll(&b_process);
+  process_poll(&d_process);
+  process_exit(&d_process);
+  PROCESS_PAUSE();
+  process_poll(&c_process);
+  PROCESS_PAUSE();
+  exit_cancels_poll = strchr(poll_order, 'd') == NULL;
+
+  UNIT_TEST_RUN(subscriptions);
+  UNIT_TEST_RUN(poll_queue);
+
+  printf("=check-me= DONE\n");
+  printf("---\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
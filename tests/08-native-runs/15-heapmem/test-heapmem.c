@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "contiki.h"
+#include "lib/heapmem.h"
+#include "lib/random.h"
+#include "unit-test.h"
+#include <stdio.h>
+#include <stdbool.h>
+
+/*
+ * Runs a random sequence of allocations, reallocations and
+ * deallocations, and checks that the contents of the chunks stay
+ * intact, that the statistics add up, that an allocation of the
+ * reported largest free size succeeds, and that the heap footprint
+ * returns to zero when everything has been freed.
+ */
+
+#define NUM_SLOTS  64
+#define NUM_ROUNDS 20000
+#define MAX_SIZE   300
+
+PROCESS(test_process, "test");
+AUTOSTART_PROCESSES(&test_process);
+
+static uint8_t *slots[NUM_SLOTS];
+static size_t sizes[NUM_SLOTS];
+static unsigned corrupted;
+static unsigned failures;
+
+/*---------------------------------------------------------------------------*/
+static void
+fill(unsigned i)
+{
+  size_t j;
+
+  for(j = 0; j < sizes[i]; j++) {
+    slots[i][j] = (uint8_t)(i + j);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static bool
+intact(unsigned i, size_t size)
+{
+  size_t j;
+
+  for(j = 0; j < size; j++) {
+    if(slots[i][j] != (uint8_t)(i + j)) {
+      return false;
+    }
+  }
+  return true;
+}
+/*---------------------------------------------------------------------------*/
+static void
+run_workload(void)
+{
+  unsigned round, i;
+  size_t size;
+  void *ptr;
+
+  for(round = 0; round < NUM_ROUNDS; round++) {
+    i = random_rand() % NUM_SLOTS;
+    size = 1 + random_rand() % MAX_SIZE;
+    if(slots[i] == NULL) {
+      slots[i] = heapmem_alloc(size);
+      if(slots[i] == NULL) {
+        failures++;
+        continue;
+      }
+      sizes[i] = size;
+      fill(i);
+    } else if(random_rand() % 4 == 0) {
+      ptr = heapmem_realloc(slots[i], size);
+      if(ptr == NULL) {
+        failures++;
+        continue;
+      }
+      slots[i] = ptr;
+      if(!intact(i, size < sizes[i] ? size : sizes[i])) {
+        corrupted++;
+      }
+      sizes[i] = size;
+      fill(i);
+    } else {
+      if(!intact(i, sizes[i])) {
+        corrupted++;
+      }
+      heapmem_free(slots[i]);
+      slots[i] = NULL;
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(heapmem_workload, "Random heapmem workload");
+UNIT_TEST(heapmem_workload)
+{
+  heapmem_stats_t stats;
+  size_t allocated, class_chunks;
+  unsigned i;
+  void *ptr;
+
+  UNIT_TEST_BEGIN();
+
+  run_workload();
+
+  heapmem_stats(&stats);
+  printf("TEST: %u failures, %u corrupted, %lu chunks, %lu free, "
+         "largest free %lu\n", failures, corrupted,
+         (unsigned long)stats.chunks, (unsigned long)stats.free_chunks,
+         (unsigned long)stats.max_available);
+
+  UNIT_TEST_ASSERT(corrupted == 0);
+  UNIT_TEST_ASSERT(stats.failures == failures);
+
+  allocated = 0;
+  for(i = 0; i < NUM_SLOTS; i++) {
+    if(slots[i] != NULL) {
+      allocated += sizes[i];
+    }
+  }
+  UNIT_TEST_ASSERT(stats.allocated >= allocated);
+  UNIT_TEST_ASSERT(stats.allocated + stats.overhead + stats.available ==
+                   HEAPMEM_CONF_ARENA_SIZE);
+
+  class_chunks = 0;
+  for(i = 0; i < HEAPMEM_STATS_CLASSES; i++) {
+    class_chunks += stats.class_allocated[i] + stats.class_free[i];
+  }
+  UNIT_TEST_ASSERT(class_chunks == stats.chunks);
+
+  /* The largest free chunk can be allocated despite fragmentation */
+  ptr = heapmem_alloc(stats.max_available);
+  UNIT_TEST_ASSERT(ptr != NULL);
+  heapmem_free(ptr);
+
+  for(i = 0; i < NUM_SLOTS; i++) {
+    if(slots[i] != NULL && !intact(i, sizes[i])) {
+      corrupted++;
+    }
+    heapmem_free(slots[i]);
+    slots[i] = NULL;
+  }
+  UNIT_TEST_ASSERT(corrupted == 0);
+
+  /* Free chunks are merged and released, so the heap is empty */
+  heapmem_stats(&stats);
+  UNIT_TEST_ASSERT(stats.footprint == 0);
+  UNIT_TEST_ASSERT(stats.available == HEAPMEM_CONF_ARENA_SIZE);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  random_init(1);
+  UNIT_TEST_RUN(heapmem_workload);
+
+  printf("=check-me= DONE\n");
+  printf("---\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
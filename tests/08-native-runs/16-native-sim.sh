@@ -0,0 +1,71 @@
+#!/bin/bash
+source ../utils.sh
+
+# Contiki directory
+CONTIKI=$1
+# Test basename
+BASENAME=$(basename $0 .sh)
+
+EXAMPLE=$CONTIKI/examples/rpl-udp
+CLIENTS="2 3 4 5"
+
+declare -i OKCOUNT=0
+declare -i TESTCOUNT=0
+
+echo "Building the simulator and the rpl-udp motes"
+(make -C $CONTIKI/tools/native-sim &&
+ make -C $EXAMPLE TARGET=native-sim -j4) > make.log 2> make.err
+
+# A multi-hop line: only the first client is in range of the server
+cat > $BASENAME.sim <<SIM
+seed 1
+duration 180
+udgm 50 100 1 1
+mote $EXAMPLE/udp-server.native-sim 0 0
+mote $EXAMPLE/udp-client.native-sim 40 0
+mote $EXAMPLE/udp-client.native-sim 80 0
+mote $EXAMPLE/udp-client.native-sim 120 0
+mote $EXAMPLE/udp-client.native-sim 160 0
+SIM
+
+echo "Running the simulation twice"
+$CONTIKI/tools/native-sim/native-sim $BASENAME.sim > sim1.log 2> sim.err
+$CONTIKI/tools/native-sim/native-sim $BASENAME.sim > sim2.log 2>> sim.err
+cp sim1.log $BASENAME.log
+
+# Every client reaches the server over the multi-hop network
+for ID in $CLIENTS; do
+  if grep -q "ID:$ID.*Received response" sim1.log; then
+    printf "> client $ID OK\n"
+    OKCOUNT+=1
+  else
+    printf "> client $ID FAIL\n"
+  fi
+  TESTCOUNT+=1
+done
+
+# The same seed gives the same run
+if [ -s sim1.log ] && cmp -s sim1.log sim2.log; then
+  printf "> deterministic OK\n"
+  OKCOUNT+=1
+else
+  printf "> deterministic FAIL\n"
+fi
+TESTCOUNT+=1
+
+if [ $TESTCOUNT -eq $OKCOUNT ] ; then
+  printf "%-32s TEST OK    %3d/%d\n" "$BASENAME" "$OKCOUNT" "$TESTCOUNT" | tee $BASENAME.testlog;
+else
+  echo "==== make.log ====" ; cat make.log;
+  echo "==== make.err ====" ; cat make.err;
+  echo "==== sim.err ====" ; cat sim.err;
+  echo "==== $BASENAME.log ====" ; cat $BASENAME.log;
+
+  printf "%-32s TEST FAIL  %3d/%d\n" "$BASENAME" "$OKCOUNT" "$TESTCOUNT" | tee $BASENAME.testlog;
+fi
+
+rm -f make.log make.err sim.err sim1.log sim2.log $BASENAME.sim
+
+# We do not want Make to stop -> Return 0
+# The Makefile will check if a log contains FAIL at the end
+exit 0
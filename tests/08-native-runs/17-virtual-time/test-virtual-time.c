@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "contiki.h"
+#include "sys/rtimer.h"
+#include "unit-test.h"
+#include <stdio.h>
+#include <time.h>
+
+/*
+ * Runs an hour of timers in virtual time, and checks that the clock
+ * jumps to every deadline: etimers and rtimers run exactly on time, and
+ * the hour takes a fraction of a second of real time.
+ */
+
+#define HOUR         (60 * 60)
+#define NUM_RTIMERS  1000
+#define RTIMER_STEP  (RTIMER_SECOND / 1000)
+/* Generous, for a loaded host */
+#define MAX_WALL_SECONDS 5
+
+PROCESS(test_process, "test");
+AUTOSTART_PROCESSES(&test_process);
+
+static struct etimer et;
+static struct rtimer rt;
+static rtimer_clock_t rtimer_expected;
+static unsigned rtimer_count;
+static unsigned rtimer_late;
+static clock_time_t start_ticks;
+static unsigned long start_seconds;
+static clock_time_t hour_ticks;
+static unsigned long hour_seconds;
+static unsigned periodic_late;
+static rtimer_clock_t busywait_start;
+static rtimer_clock_t busywait_end;
+static double wall_seconds;
+
+/*---------------------------------------------------------------------------*/
+static double
+wall_now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+/*---------------------------------------------------------------------------*/
+static void
+rtimer_callback(struct rtimer *t, void *ptr)
+{
+  if(RTIMER_NOW() != rtimer_expected) {
+    rtimer_late++;
+  }
+  if(++rtimer_count < NUM_RTIMERS) {
+    rtimer_expected += RTIMER_STEP;
+    rtimer_set(&rt, rtimer_expected, 0, rtimer_callback, NULL);
+  }
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(virtual_time, "Timers in virtual time");
+UNIT_TEST(virtual_time)
+{
+  UNIT_TEST_BEGIN();
+
+  printf("TEST: %u rtimers, %u late\n", rtimer_count, rtimer_late);
+  printf("TEST: %u late periodic etimers\n", periodic_late);
+  printf("TEST: busy-wait %ld ticks\n",
+         (long)(busywait_end - busywait_start));
+  printf("TEST: %lu s (%lu ticks) in %.3f s\n", hour_seconds - start_seconds,
+         (unsigned long)(hour_ticks - start_ticks), wall_seconds);
+
+  UNIT_TEST_ASSERT(rtimer_count == NUM_RTIMERS);
+  UNIT_TEST_ASSERT(rtimer_late == 0);
+  UNIT_TEST_ASSERT(periodic_late == 0);
+  UNIT_TEST_ASSERT(busywait_end - busywait_start == RTIMER_SECOND / 100);
+  UNIT_TEST_ASSERT(hour_ticks - start_ticks == HOUR * CLOCK_SECOND);
+  UNIT_TEST_ASSERT(hour_seconds - start_seconds == HOUR);
+  UNIT_TEST_ASSERT(wall_seconds < MAX_WALL_SECONDS);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_process, ev, data)
+{
+  static unsigned i;
+  static double wall_start;
+
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  wall_start = wall_now();
+
+  /* A chain of rtimers, each one set by the previous one */
+  rtimer_expected = RTIMER_NOW() + RTIMER_STEP;
+  rtimer_set(&rt, rtimer_expected, 0, rtimer_callback, NULL);
+  while(rtimer_count < NUM_RTIMERS) {
+    etimer_set(&et, CLOCK_SECOND / 10);
+    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+  }
+
+  /* Time only moves while busy-waiting */
+  busywait_start = RTIMER_NOW();
+  RTIMER_BUSYWAIT(RTIMER_SECOND / 100);
+  busywait_end = RTIMER_NOW();
+
+  /* Periodic etimers, an hour of them, then one that lasts an hour */
+  etimer_set(&et, CLOCK_SECOND);
+  for(i = 0; i < HOUR; i++) {
+    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+    if(clock_time() != etimer_expiration_time(&et)) {
+      periodic_late++;
+    }
+    etimer_reset(&et);
+  }
+  etimer_stop(&et);
+
+  start_ticks = clock_time();
+  start_seconds = clock_seconds();
+  etimer_set(&et, HOUR * CLOCK_SECOND);
+  PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+  hour_ticks = clock_time();
+  hour_seconds = clock_seconds();
+
+  wall_seconds = wall_now() - wall_start;
+
+  UNIT_TEST_RUN(virtual_time);
+
+  printf("=check-me= DONE\n");
+  printf("---\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "contiki.h"
+#include "lib/random.h"
+#include "unit-test.h"
+#include <stdio.h>
+#include <stdbool.h>
+
+/*
+ * Checks the random streams: their sequences follow from the seed and
+ * their ID alone, bit for bit, and do not depend on each other.
+ */
+
+#define SEED      12345
+#define NUM_DRAWS 10000
+
+PROCESS(test_process, "test");
+AUTOSTART_PROCESSES(&test_process);
+
+RANDOM_STREAM(app_random, RANDOM_STREAM_APP);
+RANDOM_STREAM(other_random, RANDOM_STREAM_APP + 1);
+
+/* The reference xoshiro128** generator, seeded through splitmix64 */
+static const uint32_t app_expected[] = {
+  0xacd865ab, 0xb22d7ed3, 0xbc934d15, 0x42ca9e71
+};
+static const uint32_t default_expected[] = {
+  0x89f4befd, 0x94e95a78, 0x7a8293bc, 0xf0f3ccf8
+};
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(known_answers, "Known answers");
+UNIT_TEST(known_answers)
+{
+  unsigned i;
+
+  UNIT_TEST_BEGIN();
+
+  random_seed(SEED);
+  for(i = 0; i < 4; i++) {
+    UNIT_TEST_ASSERT(random_stream_u32(&app_random) == app_expected[i]);
+  }
+  for(i = 0; i < 4; i++) {
+    UNIT_TEST_ASSERT(random_u32() == default_expected[i]);
+  }
+
+  /* The streams start over with a new seed */
+  random_seed(SEED);
+  UNIT_TEST_ASSERT(random_stream_u32(&app_random) == app_expected[0]);
+  UNIT_TEST_ASSERT(random_stream_u64(&app_random) ==
+                   ((uint64_t)app_expected[1] << 32 | app_expected[2]));
+  UNIT_TEST_ASSERT(random_stream_rand(&app_random) == app_expected[3] >> 16);
+
+  /* random_init() seeds the streams too */
+  random_init(SEED);
+  UNIT_TEST_ASSERT(random_stream_u32(&app_random) == app_expected[0]);
+  UNIT_TEST_ASSERT(random_rand() == default_expected[0] >> 16);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(independence, "Streams are independent");
+UNIT_TEST(independence)
+{
+  uint32_t alone[4];
+  unsigned i;
+
+  UNIT_TEST_BEGIN();
+
+  random_seed(SEED);
+  for(i = 0; i < 4; i++) {
+    alone[i] = random_stream_u32(&other_random);
+  }
+
+  /* Draws from other streams do not change the sequence */
+  random_seed(SEED);
+  for(i = 0; i < 4; i++) {
+    random_u32();
+    random_stream_u32(&app_random);
+    random_rand();
+    UNIT_TEST_ASSERT(random_stream_u32(&other_random) == alone[i]);
+  }
+  /* Streams with different IDs draw different sequences */
+  UNIT_TEST_ASSERT(alone[0] != app_expected[0]);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(ranges, "Ranges");
+UNIT_TEST(ranges)
+{
+  unsigned i;
+  unsigned below_half = 0;
+  float f;
+  float sum = 0;
+  uint16_t r;
+  uint16_t r_max = 0;
+  bool f_in_range = true;
+
+  UNIT_TEST_BEGIN();
+
+  random_seed(SEED);
+  for(i = 0; i < NUM_DRAWS; i++) {
+    f = random_float();
+    if(f < 0.0f || f >= 1.0f) {
+      f_in_range = false;
+    }
+    if(f < 0.5f) {
+      below_half++;
+    }
+    sum += f;
+    r = random_rand();
+    if(r > r_max) {
+      r_max = r;
+    }
+  }
+  printf("TEST: mean of %u floats %.4f, %u below 0.5, largest rand %u\n",
+         NUM_DRAWS, sum / NUM_DRAWS, below_half, r_max);
+
+  UNIT_TEST_ASSERT(f_in_range);
+  UNIT_TEST_ASSERT(sum / NUM_DRAWS > 0.48f && sum / NUM_DRAWS < 0.52f);
+  UNIT_TEST_ASSERT(below_half > NUM_DRAWS * 48 / 100 &&
+                   below_half < NUM_DRAWS * 52 / 100);
+  /* The whole range of random_rand() is used */
+  UNIT_TEST_ASSERT(r_max > RANDOM_RAND_MAX - RANDOM_RAND_MAX / 100);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  UNIT_TEST_RUN(known_answers);
+  UNIT_TEST_RUN(independence);
+  UNIT_TEST_RUN(ranges);
+
+  printf("=check-me= DONE\n");
+  printf("---\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
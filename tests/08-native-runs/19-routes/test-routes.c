@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "contiki.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/ipv6/uip-ds6-route.h"
+#include "lib/random.h"
+#include "unit-test.h"
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * Fills the routing table with host routes and nested prefixes,
+ * removes some of them, and checks that every lookup returns the
+ * longest match, as found by walking the whole table.
+ */
+
+#define NUM_NEXTHOPS 3
+#define NUM_HOSTS    200
+#define NUM_PROBES   2000
+
+PROCESS(test_process, "test");
+AUTOSTART_PROCESSES(&test_process);
+
+RANDOM_STREAM(test_random, RANDOM_STREAM_APP);
+
+static uip_ipaddr_t nexthops[NUM_NEXTHOPS];
+static unsigned mismatches;
+static unsigned probes;
+
+/*---------------------------------------------------------------------------*/
+static void
+make_addr(uip_ipaddr_t *addr, uint16_t a0, uint16_t a1, uint16_t a2,
+          uint16_t a3, uint16_t a7)
+{
+  uip_ip6addr(addr, a0, a1, a2, a3, 0, 0, 0, a7);
+}
+/*---------------------------------------------------------------------------*/
+static uip_ds6_route_t *
+add_route(uint16_t a0, uint16_t a1, uint16_t a2, uint16_t a3, uint16_t a7,
+          uint8_t length, int nexthop)
+{
+  uip_ipaddr_t addr;
+
+  make_addr(&addr, a0, a1, a2, a3, a7);
+  return uip_ds6_route_add(&addr, length, &nexthops[nexthop]);
+}
+/*---------------------------------------------------------------------------*/
+static uip_ds6_route_t *
+scan_lookup(const uip_ipaddr_t *addr)
+{
+  uip_ds6_route_t *r;
+  uip_ds6_route_t *found = NULL;
+
+  for(r = uip_ds6_route_head(); r != NULL; r = uip_ds6_route_next(r)) {
+    if((found == NULL || r->length > found->length) &&
+       uip_ipaddr_prefixcmp(addr, &r->ipaddr, r->length)) {
+      found = r;
+    }
+  }
+  return found;
+}
+/*---------------------------------------------------------------------------*/
+static void
+check(const uip_ipaddr_t *addr)
+{
+  probes++;
+  if(uip_ds6_route_lookup(addr) != scan_lookup(addr)) {
+    mismatches++;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+check_all(void)
+{
+  uip_ipaddr_t addr;
+  unsigned i;
+
+  for(i = 0; i < NUM_PROBES; i++) {
+    /* Mostly addresses close to the routes, some further away */
+    make_addr(&addr, 0x2001, 0x0db8 + (random_stream_rand(&test_random) % 4 == 0),
+              random_stream_rand(&test_random) % 3,
+              random_stream_rand(&test_random) % 4,
+              0x100 + random_stream_rand(&test_random) % (NUM_HOSTS + 10));
+    check(&addr);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static unsigned
+count_routes(void)
+{
+  uip_ds6_route_t *r;
+  unsigned n = 0;
+
+  for(r = uip_ds6_route_head(); r != NULL; r = uip_ds6_route_next(r)) {
+    n++;
+  }
+  return n;
+}
+/*---------------------------------------------------------------------------*/
+static uint8_t
+match_length(uint16_t a0, uint16_t a1, uint16_t a2, uint16_t a3, uint16_t a7)
+{
+  uip_ipaddr_t addr;
+  uip_ds6_route_t *r;
+
+  make_addr(&addr, a0, a1, a2, a3, a7);
+  r = uip_ds6_route_lookup(&addr);
+  return r == NULL ? 0 : r->length;
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(lookup, "Longest prefix match");
+UNIT_TEST(lookup)
+{
+  uip_ipaddr_t addr;
+  uip_ds6_route_t *r;
+  unsigned i;
+
+  UNIT_TEST_BEGIN();
+
+  UNIT_TEST_ASSERT(add_route(0x2001, 0x0db8, 0, 0, 0, 32, 0) != NULL);
+  UNIT_TEST_ASSERT(add_route(0x2001, 0x0db8, 1, 0, 0, 48, 1) != NULL);
+  UNIT_TEST_ASSERT(add_route(0x2001, 0x0db8, 1, 2, 0, 64, 2) != NULL);
+  UNIT_TEST_ASSERT(add_route(0xfd00, 0, 0, 0, 0, 8, 0) != NULL);
+  for(i = 0; i < NUM_HOSTS; i++) {
+    r = add_route(0x2001, 0x0db8, i % 3, i % 4, 0x100 + i, 128,
+                  i % NUM_NEXTHOPS);
+    UNIT_TEST_ASSERT(r != NULL && r->length == 128);
+  }
+  UNIT_TEST_ASSERT(uip_ds6_route_num_routes() == NUM_HOSTS + 4);
+  UNIT_TEST_ASSERT(count_routes() == NUM_HOSTS + 4);
+
+  /* Adding a route again returns the existing one */
+  make_addr(&addr, 0x2001, 0x0db8, 1, 1, 0x101);
+  r = uip_ds6_route_lookup(&addr);
+  UNIT_TEST_ASSERT(add_route(0x2001, 0x0db8, 1, 1, 0x101, 128, 1) == r);
+  UNIT_TEST_ASSERT(uip_ds6_route_num_routes() == NUM_HOSTS + 4);
+
+  UNIT_TEST_ASSERT(match_length(0x2001, 0x0db8, 1, 1, 0x101) == 128);
+  UNIT_TEST_ASSERT(match_length(0x2001, 0x0db8, 1, 2, 0xffff) == 64);
+  UNIT_TEST_ASSERT(match_length(0x2001, 0x0db8, 1, 3, 0xffff) == 48);
+  UNIT_TEST_ASSERT(match_length(0x2001, 0x0db8, 2, 3, 0xffff) == 32);
+  UNIT_TEST_ASSERT(match_length(0xfd12, 0, 0, 0, 1) == 8);
+  UNIT_TEST_ASSERT(match_length(0x2001, 0x0db9, 0, 0, 1) == 0);
+  check_all();
+
+  /* Remove every other host route and one of the prefixes */
+  for(i = 0; i < NUM_HOSTS; i += 2) {
+    make_addr(&addr, 0x2001, 0x0db8, i % 3, i % 4, 0x100 + i);
+    uip_ds6_route_rm(uip_ds6_route_lookup(&addr));
+  }
+  make_addr(&addr, 0x2001, 0x0db8, 1, 0, 0);
+  uip_ds6_route_rm(uip_ds6_route_lookup(&addr));
+  UNIT_TEST_ASSERT(uip_ds6_route_num_routes() == NUM_HOSTS / 2 + 3);
+  UNIT_TEST_ASSERT(match_length(0x2001, 0x0db8, 1, 3, 0xffff) == 32);
+  check_all();
+
+  /* Drop everything through one next hop */
+  uip_ds6_route_rm_by_nexthop(&nexthops[1]);
+  UNIT_TEST_ASSERT(uip_ds6_route_num_routes() == count_routes());
+  for(r = uip_ds6_route_head(); r != NULL; r = uip_ds6_route_next(r)) {
+    UNIT_TEST_ASSERT(!uip_ipaddr_cmp(uip_ds6_route_nexthop(r),
+                                     &nexthops[1]));
+  }
+  check_all();
+
+  /* Refill the freed entries */
+  for(i = 0; i < NUM_HOSTS; i++) {
+    add_route(0x2001, 0x0db8, i % 3, i % 4, 0x100 + i, 128, i % 2 ? 0 : 2);
+  }
+  UNIT_TEST_ASSERT(uip_ds6_route_num_routes() == NUM_HOSTS + 3);
+  check_all();
+
+  printf("TEST: %u lookups, %u mismatches\n", probes, mismatches);
+  UNIT_TEST_ASSERT(mismatches == 0);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_process, ev, data)
+{
+  uip_lladdr_t lladdr;
+  int i;
+
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  for(i = 0; i < NUM_NEXTHOPS; i++) {
+    memset(&lladdr, 0, sizeof(lladdr));
+    lladdr.addr[sizeof(lladdr.addr) - 1] = i + 1;
+    uip_ip6addr(&nexthops[i], 0xfe80, 0, 0, 0, 0, 0, 0, i + 1);
+    uip_ds6_nbr_add(&nexthops[i], &lladdr, 1, NBR_REACHABLE,
+                    NBR_TABLE_REASON_UNDEFINED, NULL);
+  }
+
+  UNIT_TEST_RUN(lookup);
+
+  printf("=check-me= DONE\n");
+  printf("---\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "contiki.h"
+#include "net/ipv6/uip-sr.h"
+#include "net/routing/routing.h"
+#include "lib/random.h"
+#include "unit-test.h"
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * Builds a source routing graph, moves nodes to random parents and
+ * expires some of them, and checks that the nodes are found by
+ * address and that the cached paths match a walk of the graph.
+ */
+
+#define NUM_NODES 200
+#define NUM_MOVES 2000
+
+PROCESS(test_process, "test");
+AUTOSTART_PROCESSES(&test_process);
+
+RANDOM_STREAM(test_random, RANDOM_STREAM_APP);
+
+static uip_ipaddr_t addrs[NUM_NODES];
+static unsigned mismatches;
+static unsigned checks;
+
+/*---------------------------------------------------------------------------*/
+static void
+make_addr(uip_ipaddr_t *addr, unsigned i)
+{
+  uip_sr_node_t tmp;
+
+  /* Take the prefix that the routing protocol gives to the nodes */
+  memset(&tmp, 0, sizeof(tmp));
+  tmp.link_identifier[0] = 0x02;
+  tmp.link_identifier[1] = 0x12;
+  tmp.link_identifier[6] = i >> 8;
+  tmp.link_identifier[7] = i;
+  NETSTACK_ROUTING.get_sr_node_ipaddr(addr, &tmp);
+}
+/*---------------------------------------------------------------------------*/
+static int
+walk_path(uip_sr_node_t *node, uip_sr_node_t *root,
+          uint8_t *hops, uint8_t *cmpr)
+{
+  uip_ipaddr_t node_addr;
+  uip_ipaddr_t hop_addr;
+  uip_sr_node_t *hop;
+  unsigned n = 0;
+  uint8_t c = 15;
+  uint8_t i;
+
+  NETSTACK_ROUTING.get_sr_node_ipaddr(&node_addr, node);
+  for(hop = node->parent; hop != NULL && hop != root; hop = hop->parent) {
+    if(++n > NUM_NODES) {
+      return 0;
+    }
+    NETSTACK_ROUTING.get_sr_node_ipaddr(&hop_addr, hop);
+    for(i = 0; i < c && hop_addr.u8[i] == node_addr.u8[i]; i++);
+    c = i;
+  }
+  *hops = n;
+  *cmpr = c;
+  return hop == root;
+}
+/*---------------------------------------------------------------------------*/
+static void
+check_node(unsigned i)
+{
+  uip_sr_node_t *node;
+  uip_sr_node_t *root;
+  uint8_t hops, cmpr, ref_hops, ref_cmpr;
+  int reachable;
+
+  node = uip_sr_get_node(NULL, &addrs[i]);
+  root = uip_sr_get_node(NULL, &addrs[0]);
+  if(node == NULL || node == root) {
+    return;
+  }
+  checks++;
+  if(memcmp(node->link_identifier, &addrs[i].u8[8], 8) != 0) {
+    mismatches++;
+    return;
+  }
+  reachable = uip_sr_get_path(node, root, &hops, &cmpr);
+  if(reachable != walk_path(node, root, &ref_hops, &ref_cmpr) ||
+     (reachable && (hops != ref_hops || cmpr != ref_cmpr))) {
+    mismatches++;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+check_all(void)
+{
+  unsigned i;
+
+  for(i = 0; i < NUM_NODES; i++) {
+    check_node(i);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static unsigned
+count_nodes(void)
+{
+  uip_sr_node_t *l;
+  unsigned n = 0;
+
+  for(l = uip_sr_node_head(); l != NULL; l = uip_sr_node_next(l)) {
+    n++;
+  }
+  return n;
+}
+/*---------------------------------------------------------------------------*/
+static int
+is_listed(const uip_sr_node_t *node)
+{
+  uip_sr_node_t *l;
+
+  for(l = uip_sr_node_head(); l != NULL; l = uip_sr_node_next(l)) {
+    if(l == node) {
+      return 1;
+    }
+  }
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(graph, "Source routing graph");
+UNIT_TEST(graph)
+{
+  uip_sr_node_t *node;
+  uint8_t hops, cmpr;
+  unsigned child, parent;
+  unsigned expired;
+  unsigned i;
+
+  UNIT_TEST_BEGIN();
+
+  for(i = 0; i < NUM_NODES; i++) {
+    make_addr(&addrs[i], i);
+  }
+
+  /* A tree, each node attached to an earlier one */
+  UNIT_TEST_ASSERT(uip_sr_update_node(NULL, &addrs[0], NULL,
+                                      UIP_SR_INFINITE_LIFETIME) != NULL);
+  for(i = 1; i < NUM_NODES; i++) {
+    parent = random_stream_rand(&test_random) % i;
+    UNIT_TEST_ASSERT(uip_sr_update_node(NULL, &addrs[i], &addrs[parent],
+                                        600) != NULL);
+  }
+  UNIT_TEST_ASSERT(uip_sr_num_nodes() == NUM_NODES);
+  UNIT_TEST_ASSERT(count_nodes() == NUM_NODES);
+  check_all();
+
+  /* A direct child has no hops in between */
+  uip_sr_update_node(NULL, &addrs[1], &addrs[0], 600);
+  UNIT_TEST_ASSERT(uip_sr_get_path(uip_sr_get_node(NULL, &addrs[1]),
+                                   uip_sr_get_node(NULL, &addrs[0]),
+                                   &hops, &cmpr));
+  UNIT_TEST_ASSERT(hops == 0);
+
+  /* Random moves, some of which would create loops and are refused */
+  for(i = 0; i < NUM_MOVES; i++) {
+    child = 1 + random_stream_rand(&test_random) % (NUM_NODES - 1);
+    parent = random_stream_rand(&test_random) % NUM_NODES;
+    if(parent != child) {
+      uip_sr_update_node(NULL, &addrs[child], &addrs[parent], 600);
+    }
+    check_node(child);
+    check_node(random_stream_rand(&test_random) % NUM_NODES);
+  }
+  check_all();
+
+  /* Expire a quarter of the nodes. Only those without children may
+     be removed, the others stay until their children have moved. */
+  for(i = 1; i < NUM_NODES; i += 4) {
+    uip_sr_get_node(NULL, &addrs[i])->lifetime = 0;
+  }
+  uip_sr_periodic(1);
+  expired = 0;
+  for(i = 1; i < NUM_NODES; i++) {
+    node = uip_sr_get_node(NULL, &addrs[i]);
+    if(node == NULL) {
+      UNIT_TEST_ASSERT(i % 4 == 1);
+      expired++;
+    } else {
+      UNIT_TEST_ASSERT(node->parent == NULL || is_listed(node->parent));
+    }
+  }
+  UNIT_TEST_ASSERT(expired > 0);
+  UNIT_TEST_ASSERT(uip_sr_num_nodes() == NUM_NODES - expired);
+  UNIT_TEST_ASSERT(count_nodes() == NUM_NODES - expired);
+  check_all();
+
+  /* Nodes come back */
+  for(i = 1; i < NUM_NODES; i++) {
+    uip_sr_update_node(NULL, &addrs[i], &addrs[i / 2], 600);
+  }
+  UNIT_TEST_ASSERT(uip_sr_num_nodes() == NUM_NODES);
+  check_all();
+
+  uip_sr_free_all();
+  UNIT_TEST_ASSERT(uip_sr_num_nodes() == 0);
+  UNIT_TEST_ASSERT(uip_sr_get_node(NULL, &addrs[1]) == NULL);
+
+  printf("TEST: %u paths checked, %u mismatches\n", checks, mismatches);
+  UNIT_TEST_ASSERT(mismatches == 0);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  UNIT_TEST_RUN(graph);
+
+  printf("=check-me= DONE\n");
+  printf("---\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
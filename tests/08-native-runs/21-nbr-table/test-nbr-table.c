@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "contiki.h"
+#include "net/nbr-table.h"
+#include "lib/random.h"
+#include "unit-test.h"
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * Adds, locks, removes and garbage-collects neighbors drawn from an
+ * address space larger than the table, and checks after every step
+ * that the lookup by link-layer address finds what a walk over the
+ * table finds.
+ */
+
+#define NUM_ADDRS  (3 * NBR_TABLE_MAX_NEIGHBORS)
+#define NUM_ROUNDS 4000
+
+PROCESS(test_process, "test");
+AUTOSTART_PROCESSES(&test_process);
+
+RANDOM_STREAM(test_random, RANDOM_STREAM_APP);
+
+struct test_nbr {
+  uint16_t id;
+};
+NBR_TABLE(struct test_nbr, test_table);
+
+static unsigned mismatches;
+static unsigned probes;
+static unsigned removed;
+
+/*---------------------------------------------------------------------------*/
+static void
+make_addr(linkaddr_t *addr, unsigned id)
+{
+  /* Addresses that only differ in a few bytes, as in a deployment */
+  memset(addr, 0, sizeof(*addr));
+  addr->u8[0] = 0x02;
+  addr->u8[LINKADDR_SIZE - 2] = id >> 8;
+  addr->u8[LINKADDR_SIZE - 1] = id;
+}
+/*---------------------------------------------------------------------------*/
+static void
+removed_callback(nbr_table_item_t *item)
+{
+  removed++;
+}
+/*---------------------------------------------------------------------------*/
+static struct test_nbr *
+walk_lookup(const linkaddr_t *addr)
+{
+  struct test_nbr *n;
+
+  for(n = nbr_table_head(test_table); n != NULL;
+      n = nbr_table_next(test_table, n)) {
+    if(linkaddr_cmp(addr, nbr_table_get_lladdr(test_table, n))) {
+      return n;
+    }
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+static void
+check_all(void)
+{
+  linkaddr_t addr;
+  struct test_nbr *n;
+  unsigned id;
+
+  for(id = 0; id < NUM_ADDRS; id++) {
+    make_addr(&addr, id);
+    n = nbr_table_get_from_lladdr(test_table, &addr);
+    probes++;
+    if(n != walk_lookup(&addr) || (n != NULL && n->id != id)) {
+      mismatches++;
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static unsigned
+count_entries(void)
+{
+  struct test_nbr *n;
+  unsigned count = 0;
+
+  for(n = nbr_table_head(test_table); n != NULL;
+      n = nbr_table_next(test_table, n)) {
+    count++;
+  }
+  return count;
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(lookup, "Lookup by link-layer address");
+UNIT_TEST(lookup)
+{
+  linkaddr_t addr;
+  struct test_nbr *n;
+  unsigned round;
+  unsigned id;
+
+  UNIT_TEST_BEGIN();
+
+  nbr_table_register(test_table, removed_callback);
+
+  /* Fill the table, then keep adding to force garbage collection */
+  for(id = 0; id < NUM_ADDRS; id++) {
+    make_addr(&addr, id);
+    n = nbr_table_add_lladdr(test_table, &addr,
+                             NBR_TABLE_REASON_UNDEFINED, NULL);
+    UNIT_TEST_ASSERT(n != NULL);
+    n->id = id;
+  }
+  UNIT_TEST_ASSERT(count_entries() == NBR_TABLE_MAX_NEIGHBORS);
+  UNIT_TEST_ASSERT(removed == NUM_ADDRS - NBR_TABLE_MAX_NEIGHBORS);
+  check_all();
+
+  /* The lladdr-free entry */
+  n = nbr_table_add_lladdr(test_table, NULL, NBR_TABLE_REASON_UNDEFINED, NULL);
+  UNIT_TEST_ASSERT(n != NULL);
+  n->id = 0xffff;
+  UNIT_TEST_ASSERT(nbr_table_get_from_lladdr(test_table, NULL) == n);
+  UNIT_TEST_ASSERT(nbr_table_get_from_lladdr(test_table, &linkaddr_null) == n);
+  nbr_table_remove(test_table, n);
+  UNIT_TEST_ASSERT(nbr_table_get_from_lladdr(test_table, NULL) == NULL);
+
+  for(round = 0; round < NUM_ROUNDS; round++) {
+    id = random_stream_rand(&test_random) % NUM_ADDRS;
+    make_addr(&addr, id);
+    n = nbr_table_get_from_lladdr(test_table, &addr);
+    switch(random_stream_rand(&test_random) % 4) {
+    case 0:
+      if(n != NULL) {
+        nbr_table_remove(test_table, n);
+      }
+      break;
+    case 1:
+      if(n != NULL) {
+        if(random_stream_rand(&test_random) % 2) {
+          nbr_table_lock(test_table, n);
+        } else {
+          nbr_table_unlock(test_table, n);
+        }
+      }
+      break;
+    default:
+      n = nbr_table_add_lladdr(test_table, &addr,
+                               NBR_TABLE_REASON_UNDEFINED, NULL);
+      if(n != NULL) {
+        n->id = id;
+      }
+      break;
+    }
+    if(round % 16 == 0) {
+      check_all();
+    }
+  }
+  check_all();
+
+  nbr_table_clear();
+  UNIT_TEST_ASSERT(count_entries() == 0);
+  check_all();
+
+  /* Refill after clearing */
+  for(id = 0; id < NBR_TABLE_MAX_NEIGHBORS; id++) {
+    make_addr(&addr, id * 7);
+    n = nbr_table_add_lladdr(test_table, &addr,
+                             NBR_TABLE_REASON_UNDEFINED, NULL);
+    UNIT_TEST_ASSERT(n != NULL);
+    n->id = id * 7;
+  }
+  check_all();
+
+  printf("TEST: %u lookups, %u mismatches, %u removed by the table\n",
+         probes, mismatches, removed);
+  UNIT_TEST_ASSERT(mismatches == 0);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  UNIT_TEST_RUN(lookup);
+
+  printf("=check-me= DONE\n");
+  printf("---\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
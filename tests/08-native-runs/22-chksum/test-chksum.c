@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "contiki.h"
+#include "net/ipv6/uip.h"
+#include "net/ipv6/uipbuf.h"
+#include "lib/random.h"
+#include "unit-test.h"
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * Checks the Internet checksum against a straightforward 16-bit
+ * implementation, over random data at every alignment and length,
+ * and over the pseudo-header of ICMPv6 and UDP packets in uip_buf.
+ */
+
+#define MAX_LEN    1300
+#define NUM_ROUNDS 20000
+
+PROCESS(test_process, "test");
+AUTOSTART_PROCESSES(&test_process);
+
+RANDOM_STREAM(test_random, RANDOM_STREAM_APP);
+
+static uint8_t buf[MAX_LEN + 8];
+static unsigned mismatches;
+static unsigned checks;
+
+/*---------------------------------------------------------------------------*/
+/* The reference: one big-endian word at a time, with end-around carry */
+static uint16_t
+ref_chksum(uint16_t sum, const uint8_t *data, uint16_t len)
+{
+  uint16_t t;
+  uint16_t i;
+
+  for(i = 0; i < len; i += 2) {
+    t = data[i] << 8;
+    if(i + 1 < len) {
+      t += data[i + 1];
+    }
+    sum += t;
+    if(sum < t) {
+      sum++;
+    }
+  }
+  return sum;
+}
+/*---------------------------------------------------------------------------*/
+static void
+fill(uint8_t *data, unsigned len, unsigned pattern)
+{
+  unsigned i;
+
+  for(i = 0; i < len; i++) {
+    switch(pattern) {
+    case 0:
+      data[i] = 0;
+      break;
+    case 1:
+      data[i] = 0xff;
+      break;
+    default:
+      data[i] = random_stream_rand(&test_random);
+      break;
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+check(uint16_t result, uint16_t expected)
+{
+  checks++;
+  if(result != expected) {
+    mismatches++;
+    if(mismatches < 10) {
+      printf("TEST: 0x%04x, expected 0x%04x\n", result, expected);
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static uint16_t
+ref_upper_layer_chksum(uint8_t proto, uint16_t len)
+{
+  uint16_t sum;
+
+  sum = len + proto;
+  sum = ref_chksum(sum, (uint8_t *)&UIP_IP_BUF->srcipaddr,
+                   2 * sizeof(uip_ipaddr_t));
+  sum = ref_chksum(sum, UIP_IP_PAYLOAD(0), len);
+  return (sum == 0) ? 0xffff : uip_htons(sum);
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(chksum, "Internet checksum");
+UNIT_TEST(chksum)
+{
+  unsigned round;
+  unsigned offset;
+  unsigned len;
+
+  UNIT_TEST_BEGIN();
+
+  /* Every length and alignment of short buffers, and the edge cases
+     of all-zero and all-ones data */
+  for(len = 0; len <= 64; len++) {
+    for(offset = 0; offset < 8; offset++) {
+      fill(buf + offset, len, (len + offset) % 3);
+      check(uip_chksum((uint16_t *)(buf + offset), len),
+            uip_htons(ref_chksum(0, buf + offset, len)));
+    }
+  }
+  for(round = 0; round < NUM_ROUNDS; round++) {
+    offset = random_stream_rand(&test_random) % 8;
+    len = random_stream_rand(&test_random) % (MAX_LEN + 1);
+    fill(buf + offset, len, round % 16 == 0 ? round % 32 == 0 : 2);
+    check(uip_chksum((uint16_t *)(buf + offset), len),
+          uip_htons(ref_chksum(0, buf + offset, len)));
+  }
+
+  /* ICMPv6 and UDP checksums, including the pseudo-header */
+  for(round = 0; round < NUM_ROUNDS / 10; round++) {
+    len = UIP_UDPH_LEN + random_stream_rand(&test_random) %
+      (UIP_BUFSIZE - UIP_IPH_LEN - UIP_UDPH_LEN);
+    fill(uip_buf, UIP_IPH_LEN + len, round % 8 == 0 ? round % 16 == 0 : 2);
+    uip_ext_len = 0;
+    uipbuf_set_len_field(UIP_IP_BUF, len);
+    check(uip_icmp6chksum(), ref_upper_layer_chksum(UIP_PROTO_ICMP6, len));
+    check(uip_udpchksum(), ref_upper_layer_chksum(UIP_PROTO_UDP, len));
+  }
+
+  printf("TEST: %u checksums, %u mismatches\n", checks, mismatches);
+  UNIT_TEST_ASSERT(mismatches == 0);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  UNIT_TEST_RUN(chksum);
+
+  printf("=check-me= DONE\n");
+  printf("---\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
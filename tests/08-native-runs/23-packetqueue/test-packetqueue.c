@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "contiki.h"
+#include "net/ipv6/uip.h"
+#include "net/ipv6/uip-packetqueue.h"
+#include "unit-test.h"
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * Queues packets from uip_buf until the buffer pool is exhausted, and
+ * checks that queued packets survive uip_buf being reused, come back
+ * intact, and that their buffers return to the pool when they are
+ * sent, freed or time out. Then fills the queue of a single handle and
+ * checks that it stays in order, is bounded, and that drops are counted.
+ */
+
+#define NUM_HANDLES UIPBUF_POOL_SIZE
+
+PROCESS(test_process, "test");
+AUTOSTART_PROCESSES(&test_process);
+
+static struct uip_packetqueue_handle handles[NUM_HANDLES];
+static struct etimer et;
+static int free_before_timeout;
+static int free_after_timeout;
+static uint16_t len_after_timeout;
+
+/*---------------------------------------------------------------------------*/
+static void
+fill(uint16_t len, uint8_t seed)
+{
+  uint16_t i;
+
+  for(i = 0; i < len; i++) {
+    uip_buf[i] = seed + i * 7;
+  }
+  uip_len = len;
+}
+/*---------------------------------------------------------------------------*/
+static bool
+holds(uint16_t len, uint8_t seed)
+{
+  uint16_t i;
+
+  if(uip_len != len) {
+    return false;
+  }
+  for(i = 0; i < len; i++) {
+    if(uip_buf[i] != (uint8_t)(seed + i * 7)) {
+      return false;
+    }
+  }
+  return true;
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(queue, "Queue packets without copying");
+UNIT_TEST(queue)
+{
+  uint8_t *buf;
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  for(i = 0; i < NUM_HANDLES; i++) {
+    uip_packetqueue_new(&handles[i]);
+  }
+  UNIT_TEST_ASSERT(uipbuf_numfree() == UIPBUF_POOL_SIZE - 1);
+
+  /* Queue packets until the pool is exhausted */
+  for(i = 0; i < NUM_HANDLES - 1; i++) {
+    fill(100 + i, i);
+    buf = uip_buf;
+    uip_appdata = &uip_buf[40];
+    UNIT_TEST_ASSERT(uip_packetqueue_enqueue(&handles[i], CLOCK_SECOND * 10));
+    /* uip_buf is now another buffer, and uip_appdata follows it */
+    UNIT_TEST_ASSERT(uip_buf != buf);
+    UNIT_TEST_ASSERT(uip_appdata == &uip_buf[40]);
+    UNIT_TEST_ASSERT(uip_packetqueue_buflen(&handles[i]) == 100 + i);
+  }
+  UNIT_TEST_ASSERT(uipbuf_numfree() == 0);
+
+  /* No buffer left: the packet stays in uip_buf */
+  fill(300, 99);
+  buf = uip_buf;
+  UNIT_TEST_ASSERT(!uip_packetqueue_enqueue(&handles[NUM_HANDLES - 1],
+                                            CLOCK_SECOND * 10));
+  UNIT_TEST_ASSERT(uip_buf == buf);
+  UNIT_TEST_ASSERT(holds(300, 99));
+
+  /* Queued packets come back intact, in any order */
+  for(i = NUM_HANDLES - 2; i >= 0; i--) {
+    uipbuf_clear();
+    UNIT_TEST_ASSERT(uip_packetqueue_dequeue(&handles[i]));
+    UNIT_TEST_ASSERT(holds(100 + i, i));
+    UNIT_TEST_ASSERT(uip_packetqueue_buflen(&handles[i]) == 0);
+    UNIT_TEST_ASSERT(!uip_packetqueue_dequeue(&handles[i]));
+  }
+  UNIT_TEST_ASSERT(uipbuf_numfree() == UIPBUF_POOL_SIZE - 1);
+
+  /* Freeing a queued packet returns its buffer */
+  fill(50, 1);
+  UNIT_TEST_ASSERT(uip_packetqueue_enqueue(&handles[0], CLOCK_SECOND * 10));
+  UNIT_TEST_ASSERT(uipbuf_numfree() == UIPBUF_POOL_SIZE - 2);
+  uip_packetqueue_free(&handles[0]);
+  UNIT_TEST_ASSERT(uipbuf_numfree() == UIPBUF_POOL_SIZE - 1);
+  UNIT_TEST_ASSERT(!uip_packetqueue_dequeue(&handles[0]));
+
+  /* So does the lifetime expiring */
+  UNIT_TEST_ASSERT(free_before_timeout == UIPBUF_POOL_SIZE - 2);
+  UNIT_TEST_ASSERT(free_after_timeout == UIPBUF_POOL_SIZE - 1);
+  UNIT_TEST_ASSERT(len_after_timeout == 0);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(depth, "Bounded in-order queue per handle");
+UNIT_TEST(depth)
+{
+  uip_stats_t qdrop = uip_stat.nd6.qdrop;
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  for(i = 0; i < NUM_HANDLES; i++) {
+    uip_packetqueue_new(&handles[i]);
+  }
+
+  /* A full queue drops its oldest packet */
+  for(i = 0; i < UIP_CONF_IPV6_QUEUE_PKT_DEPTH + 1; i++) {
+    fill(60 + i, 10 + i);
+    UNIT_TEST_ASSERT(uip_packetqueue_enqueue(&handles[0], CLOCK_SECOND * 10));
+  }
+  UNIT_TEST_ASSERT(uip_packetqueue_len(&handles[0]) ==
+                   UIP_CONF_IPV6_QUEUE_PKT_DEPTH);
+  UNIT_TEST_ASSERT(uip_stat.nd6.qdrop == qdrop + 1);
+
+  /* Other handles share the rest of the pool, until it runs out */
+  for(i = UIP_CONF_IPV6_QUEUE_PKT_DEPTH; i < UIP_CONF_IPV6_QUEUE_PKT_NUM; i++) {
+    fill(40, i);
+    UNIT_TEST_ASSERT(uip_packetqueue_enqueue(&handles[1], CLOCK_SECOND * 10));
+  }
+  fill(40, 0);
+  UNIT_TEST_ASSERT(!uip_packetqueue_enqueue(&handles[2], CLOCK_SECOND * 10));
+  UNIT_TEST_ASSERT(uip_packetqueue_len(&handles[2]) == 0);
+  UNIT_TEST_ASSERT(uip_stat.nd6.qdrop == qdrop + 2);
+
+  /* The remaining packets come back oldest first */
+  for(i = 1; i < UIP_CONF_IPV6_QUEUE_PKT_DEPTH + 1; i++) {
+    UNIT_TEST_ASSERT(uip_packetqueue_buflen(&handles[0]) == 60 + i);
+    UNIT_TEST_ASSERT(uip_packetqueue_dequeue(&handles[0]));
+    UNIT_TEST_ASSERT(holds(60 + i, 10 + i));
+  }
+  UNIT_TEST_ASSERT(!uip_packetqueue_dequeue(&handles[0]));
+
+  /* Freeing a handle drops all its packets */
+  uip_packetqueue_free(&handles[1]);
+  UNIT_TEST_ASSERT(uip_packetqueue_len(&handles[1]) == 0);
+  UNIT_TEST_ASSERT(uip_stat.nd6.qdrop ==
+                   qdrop + 2 + UIP_CONF_IPV6_QUEUE_PKT_NUM -
+                   UIP_CONF_IPV6_QUEUE_PKT_DEPTH);
+  UNIT_TEST_ASSERT(uipbuf_numfree() == UIPBUF_POOL_SIZE - 1);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_process, ev, data)
+{
+  static struct uip_packetqueue_handle timed;
+
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  uip_packetqueue_new(&timed);
+  fill(80, 3);
+  uip_packetqueue_enqueue(&timed, CLOCK_SECOND / 10);
+  free_before_timeout = uipbuf_numfree();
+  etimer_set(&et, CLOCK_SECOND / 4);
+  PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+  free_after_timeout = uipbuf_numfree();
+  len_after_timeout = uip_packetqueue_buflen(&timed);
+
+  UNIT_TEST_RUN(queue);
+  UNIT_TEST_RUN(depth);
+
+  printf("=check-me= DONE\n");
+  printf("---\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
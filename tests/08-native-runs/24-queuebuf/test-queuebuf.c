@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "contiki.h"
+#include "net/packetbuf.h"
+#include "net/queuebuf.h"
+#include "unit-test.h"
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * Checks that a queuebuf stays allocated as long as it has a holder,
+ * that its frame can be read in place and is not updated while it is
+ * shared, that the count of holders does not wrap, and that restoring
+ * only its attributes leaves them in packetbuf without the data.
+ */
+
+PROCESS(test_process, "test");
+AUTOSTART_PROCESSES(&test_process);
+
+static const linkaddr_t receiver = { { 1, 2, 3, 4, 5, 6, 7, 8 } };
+
+/*---------------------------------------------------------------------------*/
+static void
+fill(uint16_t len, uint8_t seed)
+{
+  uint8_t *p;
+  uint16_t i;
+
+  packetbuf_clear();
+  p = packetbuf_dataptr();
+  for(i = 0; i < len; i++) {
+    p[i] = seed + i * 7;
+  }
+  packetbuf_set_datalen(len);
+  packetbuf_set_addr(PACKETBUF_ADDR_RECEIVER, &receiver);
+  packetbuf_set_attr(PACKETBUF_ATTR_MAC_SEQNO, seed);
+}
+/*---------------------------------------------------------------------------*/
+static bool
+holds(const uint8_t *p, uint16_t len, uint8_t seed)
+{
+  uint16_t i;
+
+  for(i = 0; i < len; i++) {
+    if(p[i] != (uint8_t)(seed + i * 7)) {
+      return false;
+    }
+  }
+  return true;
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(refcount, "Reference counted queuebufs");
+UNIT_TEST(refcount)
+{
+  struct queuebuf *qb;
+  int numfree;
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  numfree = queuebuf_numfree();
+  fill(100, 3);
+  qb = queuebuf_new_from_packetbuf();
+  UNIT_TEST_ASSERT(qb != NULL);
+  UNIT_TEST_ASSERT(queuebuf_numfree() == numfree - 1);
+
+  /* Two more holders share the same buffer */
+  UNIT_TEST_ASSERT(queuebuf_ref(qb) == qb);
+  UNIT_TEST_ASSERT(queuebuf_ref(qb) == qb);
+  UNIT_TEST_ASSERT(queuebuf_numfree() == numfree - 1);
+
+  /* The frame is read in place, as often as needed */
+  fill(20, 9);
+  UNIT_TEST_ASSERT(queuebuf_datalen(qb) == 100);
+  UNIT_TEST_ASSERT(holds(queuebuf_dataptr(qb), 100, 3));
+
+  /* and cannot be changed while it is shared */
+  UNIT_TEST_ASSERT(!queuebuf_update_from_packetbuf(qb));
+  UNIT_TEST_ASSERT(!queuebuf_update_attr_from_packetbuf(qb));
+  UNIT_TEST_ASSERT(queuebuf_datalen(qb) == 100);
+  UNIT_TEST_ASSERT(holds(queuebuf_dataptr(qb), 100, 3));
+  UNIT_TEST_ASSERT(queuebuf_attr(qb, PACKETBUF_ATTR_MAC_SEQNO) == 3);
+
+  /* Released with the last holder only */
+  queuebuf_free(qb);
+  queuebuf_free(qb);
+  UNIT_TEST_ASSERT(queuebuf_numfree() == numfree - 1);
+  UNIT_TEST_ASSERT(holds(queuebuf_dataptr(qb), 100, 3));
+
+  /* The last holder may update it */
+  UNIT_TEST_ASSERT(queuebuf_update_from_packetbuf(qb));
+  UNIT_TEST_ASSERT(queuebuf_datalen(qb) == 20);
+  UNIT_TEST_ASSERT(holds(queuebuf_dataptr(qb), 20, 9));
+
+  /* The count of holders does not wrap */
+  for(i = 1; i < 255; i++) {
+    UNIT_TEST_ASSERT(queuebuf_ref(qb) == qb);
+  }
+  UNIT_TEST_ASSERT(queuebuf_ref(qb) == NULL);
+  for(i = 1; i < 255; i++) {
+    queuebuf_free(qb);
+  }
+  UNIT_TEST_ASSERT(queuebuf_numfree() == numfree - 1);
+  queuebuf_free(qb);
+  UNIT_TEST_ASSERT(queuebuf_numfree() == numfree);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(attrs, "Restore attributes only");
+UNIT_TEST(attrs)
+{
+  struct queuebuf *qb;
+
+  UNIT_TEST_BEGIN();
+
+  fill(60, 5);
+  qb = queuebuf_new_from_packetbuf();
+  UNIT_TEST_ASSERT(qb != NULL);
+
+  fill(30, 11);
+  packetbuf_set_addr(PACKETBUF_ADDR_RECEIVER, &linkaddr_null);
+  queuebuf_attr_to_packetbuf(qb);
+  UNIT_TEST_ASSERT(packetbuf_datalen() == 0);
+  UNIT_TEST_ASSERT(packetbuf_attr(PACKETBUF_ATTR_MAC_SEQNO) == 5);
+  UNIT_TEST_ASSERT(linkaddr_cmp(packetbuf_addr(PACKETBUF_ADDR_RECEIVER),
+                                &receiver));
+
+  /* A full restore brings the data back too */
+  queuebuf_to_packetbuf(qb);
+  UNIT_TEST_ASSERT(packetbuf_datalen() == 60);
+  UNIT_TEST_ASSERT(holds(packetbuf_dataptr(), 60, 5));
+  queuebuf_free(qb);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  UNIT_TEST_RUN(refcount);
+  UNIT_TEST_RUN(attrs);
+
+  printf("=check-me= DONE\n");
+  printf("---\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
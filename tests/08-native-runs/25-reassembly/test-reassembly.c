@@ -0,0 +1,603 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "contiki.h"
+#include "unit-test.h"
+#include "net/ipv6/simple-udp.h"
+#include "net/ipv6/sicslowpan.h"
+#include "net/ipv6/uip.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/ipv6/uip-packetqueue.h"
+#include "net/ipv6/uipbuf.h"
+#include "net/mac/mac.h"
+#include "net/netstack.h"
+#include "net/packetbuf.h"
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * Feeds fragmented UDP datagrams to the 6LoWPAN layer, in order, out
+ * of order, interleaved, duplicated, overlapping, timing out and
+ * exceeding the fragment buffers, and checks what is delivered. Then
+ * feeds datagrams routed through this node, and checks the fragments
+ * it forwards.
+ */
+
+#define PORT      5683
+/* A datagram of three fragments of 48 bytes: the IPv6 and UDP headers
+   in the first one, and 96 bytes of data in the others */
+#define CHUNK     48
+#define DGRAM_LEN (3 * CHUNK)
+#define DATA_LEN  (DGRAM_LEN - UIP_IPUDPH_LEN)
+/* Datagrams to fd00::99 are routed through fe80::<NEXT_HOP> */
+#define NEXT_HOP  9
+#define MAX_FRAMES 4
+
+PROCESS(test_process, "test");
+AUTOSTART_PROCESSES(&test_process);
+
+static struct simple_udp_connection conn;
+static struct etimer et;
+static uint8_t dgram[2][DGRAM_LEN];
+static uint8_t rx_data[DATA_LEN];
+static uint16_t rx_len;
+static unsigned rx_count;
+static struct sicslowpan_reass_stats before;
+/* The frames sent */
+static uint8_t frames[MAX_FRAMES][PACKETBUF_SIZE];
+static uint16_t frame_lens[MAX_FRAMES];
+static linkaddr_t frame_dests[MAX_FRAMES];
+static unsigned frame_count;
+/*---------------------------------------------------------------------------*/
+static void
+send(mac_callback_t sent, void *ptr)
+{
+  if(frame_count < MAX_FRAMES) {
+    frame_lens[frame_count] = packetbuf_datalen();
+    memcpy(frames[frame_count], packetbuf_dataptr(), packetbuf_datalen());
+    linkaddr_copy(&frame_dests[frame_count],
+                  packetbuf_addr(PACKETBUF_ADDR_RECEIVER));
+  }
+  frame_count++;
+}
+/*---------------------------------------------------------------------------*/
+static void
+input(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+static int
+on(void)
+{
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+off(void)
+{
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+max_payload(void)
+{
+  return 100;
+}
+/*---------------------------------------------------------------------------*/
+static void
+init(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+const struct mac_driver test_mac_driver = {
+  "test",
+  init,
+  send,
+  input,
+  on,
+  off,
+  max_payload,
+};
+/*---------------------------------------------------------------------------*/
+static void
+receiver(struct simple_udp_connection *c,
+         const uip_ipaddr_t *sender_addr, uint16_t sender_port,
+         const uip_ipaddr_t *receiver_addr, uint16_t receiver_port,
+         const uint8_t *data, uint16_t datalen)
+{
+  rx_count++;
+  rx_len = datalen;
+  memcpy(rx_data, data, MIN(datalen, sizeof(rx_data)));
+}
+/*---------------------------------------------------------------------------*/
+/* Build a UDP datagram from src to dest, with data starting at fill */
+static void
+make_dgram_to(uint8_t *d, const uip_ipaddr_t *src, const uip_ipaddr_t *dest,
+              uint8_t fill)
+{
+  struct uip_udp_hdr *udp = (struct uip_udp_hdr *)(uip_buf + UIP_IPH_LEN);
+  int i;
+
+  uipbuf_clear();
+  memset(uip_buf, 0, DGRAM_LEN);
+  UIP_IP_BUF->vtc = 0x60;
+  uipbuf_set_len_field(UIP_IP_BUF, DGRAM_LEN - UIP_IPH_LEN);
+  UIP_IP_BUF->proto = UIP_PROTO_UDP;
+  UIP_IP_BUF->ttl = 64;
+  uip_ipaddr_copy(&UIP_IP_BUF->srcipaddr, src);
+  uip_ipaddr_copy(&UIP_IP_BUF->destipaddr, dest);
+  udp->srcport = UIP_HTONS(PORT);
+  udp->destport = UIP_HTONS(PORT);
+  udp->udplen = UIP_HTONS(DGRAM_LEN - UIP_IPH_LEN);
+  for(i = 0; i < DATA_LEN; i++) {
+    uip_buf[UIP_IPUDPH_LEN + i] = fill + i;
+  }
+  uip_len = DGRAM_LEN;
+  udp->udpchksum = ~uip_udpchksum();
+  if(udp->udpchksum == 0) {
+    udp->udpchksum = 0xffff;
+  }
+  memcpy(d, uip_buf, DGRAM_LEN);
+  uipbuf_clear();
+}
+/*---------------------------------------------------------------------------*/
+/* Build a UDP datagram from fe80::<id> to ff02::1 */
+static void
+make_dgram(uint8_t *d, uint8_t id, uint8_t fill)
+{
+  uip_ipaddr_t src;
+  uip_ipaddr_t dest;
+
+  uip_ip6addr(&src, 0xfe80, 0, 0, 0, 0, 0, 0, id);
+  uip_create_linklocal_allnodes_mcast(&dest);
+  make_dgram_to(d, &src, &dest, fill);
+}
+/*---------------------------------------------------------------------------*/
+/* Build a UDP datagram from fd00::<id> to fd00::99, which this node
+   routes */
+static void
+make_routed_dgram(uint8_t *d, uint8_t id, uint8_t fill)
+{
+  uip_ipaddr_t src;
+  uip_ipaddr_t dest;
+
+  uip_ip6addr(&src, 0xfd00, 0, 0, 0, 0, 0, 0, id);
+  uip_ip6addr(&dest, 0xfd00, 0, 0, 0, 0, 0, 0, 0x99);
+  make_dgram_to(d, &src, &dest, fill);
+}
+/*---------------------------------------------------------------------------*/
+/* Send fragment n of a datagram, of the given length, as if received
+   from the link-layer address <id> */
+static void
+send_frag_len(const uint8_t *d, uint8_t id, uint16_t tag, int n, int len)
+{
+  linkaddr_t sender;
+  uint8_t *p;
+
+  packetbuf_clear();
+  p = packetbuf_dataptr();
+  p[2] = tag >> 8;
+  p[3] = tag & 0xff;
+  if(n == 0) {
+    p[0] = SICSLOWPAN_DISPATCH_FRAG1 | (DGRAM_LEN >> 8);
+    p[1] = DGRAM_LEN & 0xff;
+    p[4] = SICSLOWPAN_DISPATCH_IPV6;
+    memcpy(p + 5, d, len);
+    packetbuf_set_datalen(5 + len);
+  } else {
+    p[0] = SICSLOWPAN_DISPATCH_FRAGN | (DGRAM_LEN >> 8);
+    p[1] = DGRAM_LEN & 0xff;
+    p[4] = (n * CHUNK) >> 3;
+    memcpy(p + 5, d + n * CHUNK, len);
+    packetbuf_set_datalen(5 + len);
+  }
+  memset(&sender, 0, sizeof(sender));
+  sender.u8[LINKADDR_SIZE - 1] = id;
+  packetbuf_set_addr(PACKETBUF_ADDR_SENDER, &sender);
+  NETSTACK_NETWORK.input();
+}
+/*---------------------------------------------------------------------------*/
+static void
+send_frag(const uint8_t *d, uint8_t id, uint16_t tag, int n)
+{
+  send_frag_len(d, id, tag, n, CHUNK);
+}
+/*---------------------------------------------------------------------------*/
+static int
+received(uint8_t fill)
+{
+  int i;
+
+  if(rx_len != DATA_LEN) {
+    return 0;
+  }
+  for(i = 0; i < DATA_LEN; i++) {
+    if(rx_data[i] != (uint8_t)(fill + i)) {
+      return 0;
+    }
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static void
+start(void)
+{
+  rx_count = 0;
+  rx_len = 0;
+  frame_count = 0;
+  before = sicslowpan_reass_stats;
+}
+/*---------------------------------------------------------------------------*/
+#define STAT(x) (sicslowpan_reass_stats.x - before.x)
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(in_order, "Fragments in order");
+UNIT_TEST(in_order)
+{
+  UNIT_TEST_BEGIN();
+
+  start();
+  make_dgram(dgram[0], 1, 0);
+  send_frag(dgram[0], 1, 100, 0);
+  send_frag(dgram[0], 1, 100, 1);
+  UNIT_TEST_ASSERT(rx_count == 0);
+  send_frag(dgram[0], 1, 100, 2);
+  UNIT_TEST_ASSERT(rx_count == 1);
+  UNIT_TEST_ASSERT(received(0));
+  UNIT_TEST_ASSERT(STAT(reassembled) == 1);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(out_of_order, "Fragments out of order");
+UNIT_TEST(out_of_order)
+{
+  UNIT_TEST_BEGIN();
+
+  start();
+  make_dgram(dgram[0], 1, 10);
+  send_frag(dgram[0], 1, 101, 2);
+  send_frag(dgram[0], 1, 101, 1);
+  UNIT_TEST_ASSERT(rx_count == 0);
+  send_frag(dgram[0], 1, 101, 0);
+  UNIT_TEST_ASSERT(rx_count == 1);
+  UNIT_TEST_ASSERT(received(10));
+  UNIT_TEST_ASSERT(STAT(reassembled) == 1);
+
+  start();
+  make_dgram(dgram[0], 1, 20);
+  send_frag(dgram[0], 1, 102, 1);
+  send_frag(dgram[0], 1, 102, 0);
+  send_frag(dgram[0], 1, 102, 2);
+  UNIT_TEST_ASSERT(rx_count == 1);
+  UNIT_TEST_ASSERT(received(20));
+  UNIT_TEST_ASSERT(STAT(reassembled) == 1);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(interleaved, "Interleaved senders");
+UNIT_TEST(interleaved)
+{
+  UNIT_TEST_BEGIN();
+
+  /* Two senders happen to use the same tag */
+  start();
+  make_dgram(dgram[0], 1, 30);
+  make_dgram(dgram[1], 2, 40);
+  send_frag(dgram[0], 1, 103, 0);
+  send_frag(dgram[1], 2, 103, 0);
+  send_frag(dgram[1], 2, 103, 2);
+  send_frag(dgram[0], 1, 103, 1);
+  send_frag(dgram[1], 2, 103, 1);
+  UNIT_TEST_ASSERT(rx_count == 1);
+  UNIT_TEST_ASSERT(received(40));
+  send_frag(dgram[0], 1, 103, 2);
+  UNIT_TEST_ASSERT(rx_count == 2);
+  UNIT_TEST_ASSERT(received(30));
+  UNIT_TEST_ASSERT(STAT(reassembled) == 2);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(duplicates, "Duplicate fragments");
+UNIT_TEST(duplicates)
+{
+  UNIT_TEST_BEGIN();
+
+  start();
+  make_dgram(dgram[0], 1, 50);
+  send_frag(dgram[0], 1, 104, 0);
+  send_frag(dgram[0], 1, 104, 1);
+  send_frag(dgram[0], 1, 104, 1);
+  send_frag(dgram[0], 1, 104, 0);
+  UNIT_TEST_ASSERT(rx_count == 0);
+  send_frag(dgram[0], 1, 104, 2);
+  UNIT_TEST_ASSERT(rx_count == 1);
+  UNIT_TEST_ASSERT(received(50));
+  UNIT_TEST_ASSERT(STAT(duplicates) == 2);
+  UNIT_TEST_ASSERT(STAT(overlaps) == 0);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(overlap, "Overlapping fragments");
+UNIT_TEST(overlap)
+{
+  UNIT_TEST_BEGIN();
+
+  /* The second fragment is longer than announced by the third one */
+  start();
+  make_dgram(dgram[0], 1, 60);
+  send_frag(dgram[0], 1, 105, 0);
+  send_frag_len(dgram[0], 1, 105, 1, CHUNK + 8);
+  send_frag(dgram[0], 1, 105, 2);
+  UNIT_TEST_ASSERT(STAT(overlaps) == 1);
+  /* The packet is dropped, and so are its other fragments */
+  send_frag(dgram[0], 1, 105, 1);
+  UNIT_TEST_ASSERT(rx_count == 0);
+  UNIT_TEST_ASSERT(STAT(reassembled) == 0);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(timeout_start, "Timeout (before)");
+UNIT_TEST(timeout_start)
+{
+  UNIT_TEST_BEGIN();
+
+  start();
+  make_dgram(dgram[0], 1, 70);
+  send_frag(dgram[0], 1, 106, 0);
+  send_frag(dgram[0], 1, 106, 1);
+  UNIT_TEST_ASSERT(rx_count == 0);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(timeout_end, "Timeout (after)");
+UNIT_TEST(timeout_end)
+{
+  UNIT_TEST_BEGIN();
+
+  /* The last fragment starts a new reassembly */
+  send_frag(dgram[0], 1, 106, 2);
+  UNIT_TEST_ASSERT(rx_count == 0);
+  UNIT_TEST_ASSERT(STAT(timeouts) == 1);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(eviction, "Eviction of the oldest packet");
+UNIT_TEST(eviction)
+{
+  static uint8_t third[DGRAM_LEN];
+
+  UNIT_TEST_BEGIN();
+
+  /* All timed out by now. Three packets fill the buffers... */
+  start();
+  make_dgram(dgram[0], 1, 80);
+  make_dgram(dgram[1], 2, 90);
+  make_dgram(third, 3, 100);
+  send_frag(dgram[0], 1, 107, 0);
+  send_frag(dgram[0], 1, 107, 1);
+  send_frag(dgram[1], 2, 107, 0);
+  send_frag(dgram[1], 2, 107, 1);
+  send_frag(third, 3, 107, 0);
+  send_frag(third, 3, 107, 1);
+  UNIT_TEST_ASSERT(STAT(timeouts) == 1);
+  UNIT_TEST_ASSERT(STAT(evictions) == 0);
+
+  /* ...so completing the last one drops the oldest */
+  send_frag(third, 3, 107, 2);
+  UNIT_TEST_ASSERT(STAT(evictions) == 1);
+  UNIT_TEST_ASSERT(rx_count == 1);
+  UNIT_TEST_ASSERT(received(100));
+
+  send_frag(dgram[0], 1, 107, 2);
+  UNIT_TEST_ASSERT(rx_count == 1);
+  send_frag(dgram[1], 2, 107, 2);
+  UNIT_TEST_ASSERT(rx_count == 2);
+  UNIT_TEST_ASSERT(received(90));
+  UNIT_TEST_ASSERT(STAT(reassembled) == 2);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(no_context, "Out of reassembly contexts");
+UNIT_TEST(no_context)
+{
+  uint8_t id;
+
+  UNIT_TEST_BEGIN();
+
+  /* One context is held by the evicted packet until it times out, and
+     may be reused by a new packet */
+  start();
+  for(id = 1; id <= 4; id++) {
+    make_dgram(dgram[0], id, id);
+    send_frag(dgram[0], id, 108, 0);
+  }
+  UNIT_TEST_ASSERT(STAT(no_context) == 0);
+  make_dgram(dgram[0], 5, 5);
+  send_frag(dgram[0], 5, 108, 0);
+  UNIT_TEST_ASSERT(STAT(no_context) == 1);
+  UNIT_TEST_ASSERT(rx_count == 0);
+
+  UNIT_TEST_END();
+}
+/* Returns true if frame i is fragment n of the datagram d, with the
+   given tag, sent to the next hop */
+static int
+forwarded_frag(int i, const uint8_t *d, uint16_t tag, int n)
+{
+  const uint8_t *p = frames[i];
+
+  if(frame_dests[i].u8[LINKADDR_SIZE - 1] != NEXT_HOP ||
+     ((p[0] & 0xf8) << 8 | p[1]) != ((n == 0 ? SICSLOWPAN_DISPATCH_FRAG1
+                                             : SICSLOWPAN_DISPATCH_FRAGN)
+                                     << 8 | DGRAM_LEN) ||
+     (p[2] << 8 | p[3]) != tag) {
+    return 0;
+  }
+  /* The IPv6 header of the first fragment is compressed anew */
+  return n == 0 ||
+    (p[4] == (n * CHUNK) >> 3 && frame_lens[i] == 5 + CHUNK &&
+     memcmp(p + 5, d + n * CHUNK, CHUNK) == 0);
+}
+/*---------------------------------------------------------------------------*/
+/* Route fd00::99 through a reachable neighbor, the only default
+   router */
+static void
+add_next_hop(void)
+{
+  uip_ds6_defrt_t *defrt;
+  uip_ipaddr_t ipaddr;
+  uip_lladdr_t lladdr;
+
+  while((defrt = uip_ds6_defrt_head()) != NULL) {
+    uip_ds6_defrt_rm(defrt);
+  }
+  uip_ip6addr(&ipaddr, 0xfe80, 0, 0, 0, 0, 0, 0, NEXT_HOP);
+  memset(&lladdr, 0, sizeof(lladdr));
+  lladdr.addr[sizeof(lladdr.addr) - 1] = NEXT_HOP;
+  uip_ds6_nbr_add(&ipaddr, &lladdr, 0, NBR_REACHABLE,
+                  NBR_TABLE_REASON_UNDEFINED, NULL);
+  uip_ds6_defrt_add(&ipaddr, 0);
+}
+/*---------------------------------------------------------------------------*/
+static uip_ds6_nbr_t *
+next_hop(void)
+{
+  uip_ipaddr_t ipaddr;
+
+  uip_ip6addr(&ipaddr, 0xfe80, 0, 0, 0, 0, 0, 0, NEXT_HOP);
+  return uip_ds6_nbr_lookup(&ipaddr);
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(forward, "Forwarding");
+UNIT_TEST(forward)
+{
+  uint16_t tag;
+
+  UNIT_TEST_BEGIN();
+
+  /* The last fragment arrives first, and is sent after the first one
+     with the tag of the next hop */
+  start();
+  make_routed_dgram(dgram[0], 1, 110);
+  send_frag(dgram[0], 1, 200, 2);
+  UNIT_TEST_ASSERT(frame_count == 0);
+  send_frag(dgram[0], 1, 200, 0);
+  UNIT_TEST_ASSERT(frame_count == 2);
+  tag = (frames[0][2] << 8) | frames[0][3];
+  UNIT_TEST_ASSERT(tag != 200);
+  UNIT_TEST_ASSERT(forwarded_frag(0, dgram[0], tag, 0));
+  UNIT_TEST_ASSERT(forwarded_frag(1, dgram[0], tag, 2));
+  send_frag(dgram[0], 1, 200, 1);
+  UNIT_TEST_ASSERT(frame_count == 3);
+  UNIT_TEST_ASSERT(forwarded_frag(2, dgram[0], tag, 1));
+  UNIT_TEST_ASSERT(STAT(forwarded) == 1);
+  UNIT_TEST_ASSERT(STAT(reassembled) == 0);
+  UNIT_TEST_ASSERT(rx_count == 0);
+
+  /* Duplicates are not forwarded again */
+  send_frag(dgram[0], 1, 200, 1);
+  UNIT_TEST_ASSERT(frame_count == 3);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(forward_unresolved, "Forwarding to an unresolved hop");
+UNIT_TEST(forward_unresolved)
+{
+  uip_ds6_nbr_t *nbr;
+
+  UNIT_TEST_BEGIN();
+
+  /* The first fragment cannot wait for address resolution without its
+     context, so the datagram is reassembled and queued whole */
+  nbr = next_hop();
+  UNIT_TEST_ASSERT(nbr != NULL);
+  nbr->state = NBR_INCOMPLETE;
+
+  start();
+  make_routed_dgram(dgram[0], 1, 120);
+  send_frag(dgram[0], 1, 201, 0);
+  send_frag(dgram[0], 1, 201, 1);
+  send_frag(dgram[0], 1, 201, 2);
+  UNIT_TEST_ASSERT(frame_count == 0);
+  UNIT_TEST_ASSERT(STAT(forwarded) == 0);
+  UNIT_TEST_ASSERT(STAT(reassembled) == 1);
+  UNIT_TEST_ASSERT(uip_packetqueue_buflen(&nbr->packethandle) == DGRAM_LEN);
+
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  simple_udp_register(&conn, PORT, NULL, PORT, receiver);
+
+  UNIT_TEST_RUN(in_order);
+  UNIT_TEST_RUN(out_of_order);
+  UNIT_TEST_RUN(interleaved);
+  UNIT_TEST_RUN(duplicates);
+  UNIT_TEST_RUN(overlap);
+  UNIT_TEST_RUN(timeout_start);
+
+  etimer_set(&et, CLOCK_SECOND);
+  PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+
+  UNIT_TEST_RUN(timeout_end);
+
+  etimer_set(&et, CLOCK_SECOND);
+  PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+
+  UNIT_TEST_RUN(eviction);
+  UNIT_TEST_RUN(no_context);
+
+  add_next_hop();
+  etimer_set(&et, CLOCK_SECOND);
+  PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+
+  UNIT_TEST_RUN(forward);
+  UNIT_TEST_RUN(forward_unresolved);
+
+  printf("=check-me= DONE\n");
+  printf("---\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "contiki.h"
+#include "unit-test.h"
+#include "net/ipv6/sicslowpan.h"
+#include "net/ipv6/uip.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/ipv6/uipbuf.h"
+#include "net/mac/mac.h"
+#include "net/netstack.h"
+#include "net/packetbuf.h"
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * Sends UDP packets through 6LoWPAN, and checks that the headers
+ * compressed from the cache are the same as the ones compressed from
+ * scratch, whatever changes between the packets.
+ */
+
+#define PORT      5683
+#define DATA_LEN  20
+
+PROCESS(test_process, "test");
+AUTOSTART_PROCESSES(&test_process);
+
+/* The last frame sent */
+static uint8_t frame[PACKETBUF_SIZE];
+static uint16_t frame_len;
+static uint8_t first[PACKETBUF_SIZE];
+static uint16_t first_len;
+/* The link-layer address our IID is derived from */
+static uip_lladdr_t src_lladdr;
+/*---------------------------------------------------------------------------*/
+static void
+send(mac_callback_t sent, void *ptr)
+{
+  frame_len = packetbuf_datalen();
+  memcpy(frame, packetbuf_dataptr(), frame_len);
+}
+/*---------------------------------------------------------------------------*/
+static void
+input(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+static int
+on(void)
+{
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+off(void)
+{
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+max_payload(void)
+{
+  return 100;
+}
+/*---------------------------------------------------------------------------*/
+static void
+init(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+const struct mac_driver test_mac_driver = {
+  "test",
+  init,
+  send,
+  input,
+  on,
+  off,
+  max_payload,
+};
+/*---------------------------------------------------------------------------*/
+/* Compress a UDP packet from fd00::<our IID> to fd00::<IID of dest>,
+   sent to the link-layer address of lldest */
+static void
+send_packet(uint8_t dest, uint8_t lldest, uint8_t ttl, uint16_t data_len)
+{
+  struct uip_udp_hdr *udp = (struct uip_udp_hdr *)(uip_buf + UIP_IPH_LEN);
+  uip_lladdr_t dest_lladdr;
+  linkaddr_t link_dest;
+  int i;
+
+  memset(&dest_lladdr, 0, sizeof(dest_lladdr));
+  dest_lladdr.addr[sizeof(dest_lladdr.addr) - 1] = dest;
+  memset(&link_dest, 0, sizeof(link_dest));
+  link_dest.u8[LINKADDR_SIZE - 1] = lldest;
+
+  uipbuf_clear();
+  memset(uip_buf, 0, UIP_IPUDPH_LEN);
+  UIP_IP_BUF->vtc = 0x60;
+  uipbuf_set_len_field(UIP_IP_BUF, UIP_UDPH_LEN + data_len);
+  UIP_IP_BUF->proto = UIP_PROTO_UDP;
+  UIP_IP_BUF->ttl = ttl;
+  uip_ip6addr(&UIP_IP_BUF->srcipaddr, UIP_DS6_DEFAULT_PREFIX, 0, 0, 0, 0, 0, 0, 0);
+  uip_ds6_set_addr_iid(&UIP_IP_BUF->srcipaddr, &src_lladdr);
+  uip_ip6addr(&UIP_IP_BUF->destipaddr, UIP_DS6_DEFAULT_PREFIX, 0, 0, 0, 0, 0, 0, 0);
+  uip_ds6_set_addr_iid(&UIP_IP_BUF->destipaddr, &dest_lladdr);
+  udp->srcport = UIP_HTONS(PORT);
+  udp->destport = UIP_HTONS(PORT);
+  udp->udplen = UIP_HTONS(UIP_UDPH_LEN + data_len);
+  for(i = 0; i < data_len; i++) {
+    uip_buf[UIP_IPUDPH_LEN + i] = i;
+  }
+  uip_len = UIP_IPUDPH_LEN + data_len;
+  udp->udpchksum = ~uip_udpchksum();
+
+  frame_len = 0;
+  NETSTACK_NETWORK.output(&link_dest);
+}
+/*---------------------------------------------------------------------------*/
+static void
+keep_frame(void)
+{
+  memcpy(first, frame, frame_len);
+  first_len = frame_len;
+}
+/*---------------------------------------------------------------------------*/
+static int
+same_frame(void)
+{
+  return frame_len == first_len && memcmp(frame, first, frame_len) == 0;
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(repeat, "Repeated packet");
+UNIT_TEST(repeat)
+{
+  UNIT_TEST_BEGIN();
+  send_packet(1, 1, 64, DATA_LEN);
+  UNIT_TEST_ASSERT(frame_len > 0);
+  keep_frame();
+  send_packet(1, 1, 64, DATA_LEN);
+  UNIT_TEST_ASSERT(same_frame());
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(payload, "Payload length");
+UNIT_TEST(payload)
+{
+  uint16_t len;
+
+  UNIT_TEST_BEGIN();
+  /* The payload length is elided, so the header stays the same */
+  send_packet(1, 1, 64, DATA_LEN);
+  keep_frame();
+  send_packet(1, 1, 64, DATA_LEN + 10);
+  len = frame_len;
+  send_packet(1, 1, 64, DATA_LEN);
+  UNIT_TEST_ASSERT(len == first_len + 10);
+  UNIT_TEST_ASSERT(same_frame());
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(hop_limit, "Hop limit");
+UNIT_TEST(hop_limit)
+{
+  UNIT_TEST_BEGIN();
+  /* A hop limit of 63 is carried inline */
+  send_packet(1, 1, 64, DATA_LEN);
+  keep_frame();
+  send_packet(1, 1, 63, DATA_LEN);
+  UNIT_TEST_ASSERT(frame_len == first_len + 1);
+  send_packet(1, 1, 64, DATA_LEN);
+  UNIT_TEST_ASSERT(same_frame());
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(link_dest, "Link-layer destination");
+UNIT_TEST(link_dest)
+{
+  UNIT_TEST_BEGIN();
+  /* The IID of the destination is only elided when it is derived
+     from the link-layer destination */
+  send_packet(1, 1, 64, DATA_LEN);
+  keep_frame();
+  send_packet(1, 2, 64, DATA_LEN);
+  UNIT_TEST_ASSERT(frame_len == first_len + 8);
+  send_packet(1, 1, 64, DATA_LEN);
+  UNIT_TEST_ASSERT(same_frame());
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(lladdr, "Own link-layer address");
+UNIT_TEST(lladdr)
+{
+  uip_lladdr_t lladdr;
+
+  UNIT_TEST_BEGIN();
+  /* Our IID is no longer derived from our link-layer address */
+  send_packet(1, 1, 64, DATA_LEN);
+  keep_frame();
+  memcpy(&lladdr, &uip_lladdr, sizeof(lladdr));
+  uip_lladdr.addr[0] ^= 0x01;
+  send_packet(1, 1, 64, DATA_LEN);
+  memcpy(&uip_lladdr, &lladdr, sizeof(lladdr));
+  UNIT_TEST_ASSERT(frame_len == first_len + 8);
+  send_packet(1, 1, 64, DATA_LEN);
+  UNIT_TEST_ASSERT(same_frame());
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(flows, "More flows than cache entries");
+UNIT_TEST(flows)
+{
+  static uint8_t frames[4][PACKETBUF_SIZE];
+  static uint16_t lens[4];
+  uint8_t i;
+
+  UNIT_TEST_BEGIN();
+  for(i = 0; i < 4; i++) {
+    send_packet(10 + i, 10 + i, 64, DATA_LEN);
+    memcpy(frames[i], frame, frame_len);
+    lens[i] = frame_len;
+  }
+  for(i = 0; i < 4; i++) {
+    send_packet(10 + i, 10 + i, 64, DATA_LEN);
+    UNIT_TEST_ASSERT(frame_len == lens[i]);
+    UNIT_TEST_ASSERT(memcmp(frame, frames[i], frame_len) == 0);
+  }
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  memcpy(&src_lladdr, &uip_lladdr, sizeof(src_lladdr));
+
+  UNIT_TEST_RUN(repeat);
+  UNIT_TEST_RUN(payload);
+  UNIT_TEST_RUN(hop_limit);
+  UNIT_TEST_RUN(link_dest);
+  UNIT_TEST_RUN(lladdr);
+  UNIT_TEST_RUN(flows);
+
+  printf("=check-me= DONE\n");
+  printf("---\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
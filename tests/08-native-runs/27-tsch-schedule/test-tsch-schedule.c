@@ -0,0 +1,422 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "contiki.h"
+#include "unit-test.h"
+#include "lib/random.h"
+#include "net/mac/tsch/tsch.h"
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * Builds random schedules, and checks that the next active link and
+ * its backup are the ones found by walking all links of all
+ * slotframes, as the schedule did before it kept its links sorted.
+ */
+
+#define NUM_NEIGHBORS  4
+#define NUM_ROUNDS     50
+
+PROCESS(test_process, "test");
+AUTOSTART_PROCESSES(&test_process);
+
+/* What the schedule needs from the rest of TSCH */
+struct tsch_link *current_link;
+const linkaddr_t tsch_broadcast_address = { { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } };
+static struct tsch_neighbor neighbors[NUM_NEIGHBORS];
+static linkaddr_t neighbor_addrs[NUM_NEIGHBORS];
+static int locked;
+/*---------------------------------------------------------------------------*/
+int
+tsch_is_locked(void)
+{
+  return locked;
+}
+/*---------------------------------------------------------------------------*/
+int
+tsch_get_lock(void)
+{
+  if(locked) {
+    return 0;
+  }
+  locked = 1;
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+void
+tsch_release_lock(void)
+{
+  locked = 0;
+}
+/*---------------------------------------------------------------------------*/
+struct tsch_neighbor *
+tsch_queue_get_nbr(const linkaddr_t *addr)
+{
+  int i;
+
+  for(i = 0; i < NUM_NEIGHBORS; i++) {
+    if(linkaddr_cmp(addr, &neighbor_addrs[i])) {
+      return &neighbors[i];
+    }
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+struct tsch_neighbor *
+tsch_queue_add_nbr(const linkaddr_t *addr)
+{
+  return tsch_queue_get_nbr(addr);
+}
+/*---------------------------------------------------------------------------*/
+void
+tsch_queue_tx_links_updated(struct tsch_neighbor *n)
+{
+}
+/*---------------------------------------------------------------------------*/
+/* Neighbor i has i packets queued, for the default link comparator */
+static void
+init_neighbors(void)
+{
+  int i, j;
+
+  for(i = 0; i < NUM_NEIGHBORS; i++) {
+    memset(&neighbor_addrs[i], 0, sizeof(linkaddr_t));
+    neighbor_addrs[i].u8[LINKADDR_SIZE - 1] = i + 1;
+    ringbufindex_init(&neighbors[i].tx_ringbuf, TSCH_QUEUE_NUM_PER_NEIGHBOR);
+    for(j = 0; j < i; j++) {
+      ringbufindex_put(&neighbors[i].tx_ringbuf);
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* The next active link, by walking all links of all slotframes */
+static struct tsch_link *
+reference_next_active_link(struct tsch_asn_t *asn, uint16_t *time_offset,
+                           struct tsch_link **backup_link)
+{
+  uint16_t time_to_curr_best = 0;
+  struct tsch_link *curr_best = NULL;
+  struct tsch_link *curr_backup = NULL;
+  struct tsch_slotframe *sf;
+
+  for(sf = tsch_schedule_slotframe_head(); sf != NULL;
+      sf = tsch_schedule_slotframe_next(sf)) {
+    uint16_t timeslot = TSCH_ASN_MOD(*asn, sf->size);
+    struct tsch_link *l;
+    for(l = list_head(sf->links_list); l != NULL; l = list_item_next(l)) {
+      uint16_t time_to_timeslot =
+        l->timeslot > timeslot ?
+        l->timeslot - timeslot :
+        sf->size.val + l->timeslot - timeslot;
+      if(curr_best == NULL || time_to_timeslot < time_to_curr_best) {
+        time_to_curr_best = time_to_timeslot;
+        curr_best = l;
+        curr_backup = NULL;
+      } else if(time_to_timeslot == time_to_curr_best) {
+        struct tsch_link *new_best = NULL;
+        if((curr_best->link_options & LINK_OPTION_TX) == (l->link_options & LINK_OPTION_TX)) {
+          if(l->slotframe_handle != curr_best->slotframe_handle) {
+            if(l->slotframe_handle < curr_best->slotframe_handle) {
+              new_best = l;
+            }
+          } else {
+            /* The default link comparator */
+            new_best = curr_best;
+            if((curr_best->link_options & LINK_OPTION_TX)
+               && !linkaddr_cmp(&curr_best->addr, &l->addr)) {
+              struct tsch_neighbor *an = tsch_queue_get_nbr(&curr_best->addr);
+              struct tsch_neighbor *bn = tsch_queue_get_nbr(&l->addr);
+              int a_packet_count = an ? ringbufindex_elements(&an->tx_ringbuf) : 0;
+              int b_packet_count = bn ? ringbufindex_elements(&bn->tx_ringbuf) : 0;
+              new_best = a_packet_count >= b_packet_count ? curr_best : l;
+            }
+          }
+        } else if(l->link_options & LINK_OPTION_TX) {
+          new_best = l;
+        }
+        if(new_best != l && (l->link_options & LINK_OPTION_RX)) {
+          if(curr_backup == NULL || l->slotframe_handle < curr_backup->slotframe_handle) {
+            curr_backup = l;
+          }
+        }
+        if(new_best != curr_best && (curr_best->link_options & LINK_OPTION_RX)) {
+          if(curr_backup == NULL || curr_best->slotframe_handle < curr_backup->slotframe_handle) {
+            curr_backup = curr_best;
+          }
+        }
+        if(new_best != NULL) {
+          curr_best = new_best;
+        }
+      }
+    }
+  }
+  *time_offset = time_to_curr_best;
+  *backup_link = curr_backup;
+  return curr_best;
+}
+/*---------------------------------------------------------------------------*/
+/* Whether the schedule agrees with the reference over a whole cycle of
+ * every slotframe, starting from an arbitrary ASN */
+static int
+same_next_active_links(void)
+{
+  struct tsch_asn_t asn;
+  struct tsch_link *link, *backup, *ref_link, *ref_backup;
+  uint16_t offset, ref_offset;
+  int i;
+
+  TSCH_ASN_INIT(asn, 0, random_rand());
+  for(i = 0; i < 500; i++) {
+    link = tsch_schedule_get_next_active_link(&asn, &offset, &backup);
+    ref_link = reference_next_active_link(&asn, &ref_offset, &ref_backup);
+    if(link != ref_link || backup != ref_backup
+       || (link != NULL && offset != ref_offset)) {
+      printf("ASN %lu: link %p/%p backup %p/%p offset %u/%u\n",
+             (unsigned long)asn.ls4b, (void *)link, (void *)ref_link,
+             (void *)backup, (void *)ref_backup, offset, ref_offset);
+      return 0;
+    }
+    TSCH_ASN_INC(asn, 1);
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+/* Adds a link with random options at a random timeslot */
+static struct tsch_link *
+add_random_link(struct tsch_slotframe *sf)
+{
+  static const uint8_t options[] = {
+    LINK_OPTION_RX, LINK_OPTION_TX, LINK_OPTION_TX | LINK_OPTION_SHARED,
+    LINK_OPTION_TX | LINK_OPTION_RX | LINK_OPTION_SHARED,
+  };
+  uint16_t r = random_rand();
+  const linkaddr_t *addr = (r & 4) ? &tsch_broadcast_address
+    : &neighbor_addrs[(r >> 3) % NUM_NEIGHBORS];
+
+  return tsch_schedule_add_link(sf, options[r % 4], LINK_TYPE_NORMAL, addr,
+                                (r >> 5) % sf->size.val, (r >> 8) % 4, 0);
+}
+/*---------------------------------------------------------------------------*/
+/* Adds slotframes of random sizes, with random handles */
+static void
+add_random_slotframes(int count)
+{
+  static const uint16_t sizes[] = { 1, 3, 7, 10, 17, 31, 101 };
+  int i;
+
+  tsch_schedule_remove_all_slotframes();
+  for(i = 0; i < count; i++) {
+    uint16_t r = random_rand();
+    while(tsch_schedule_add_slotframe(r % 8, sizes[(r >> 3) % 7]) == NULL) {
+      r = random_rand();
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Returns a random slotframe of the schedule */
+static struct tsch_slotframe *
+random_slotframe(void)
+{
+  struct tsch_slotframe *sf;
+  int count = 0;
+  int n;
+
+  for(sf = tsch_schedule_slotframe_head(); sf != NULL;
+      sf = tsch_schedule_slotframe_next(sf)) {
+    count++;
+  }
+  n = random_rand() % count;
+  for(sf = tsch_schedule_slotframe_head(); n > 0;
+      sf = tsch_schedule_slotframe_next(sf)) {
+    n--;
+  }
+  return sf;
+}
+/*---------------------------------------------------------------------------*/
+/* Returns a random link of the schedule, if any */
+static struct tsch_link *
+random_link(void)
+{
+  struct tsch_slotframe *sf = random_slotframe();
+  struct tsch_link *l = list_head(sf->links_list);
+  int n = l != NULL ? random_rand() % list_length(sf->links_list) : 0;
+
+  while(n-- > 0) {
+    l = list_item_next(l);
+  }
+  return l;
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(empty, "Empty schedule");
+UNIT_TEST(empty)
+{
+  struct tsch_asn_t asn;
+  struct tsch_link *backup;
+  uint16_t offset;
+
+  UNIT_TEST_BEGIN();
+  tsch_schedule_remove_all_slotframes();
+  TSCH_ASN_INIT(asn, 0, 1234);
+  UNIT_TEST_ASSERT(tsch_schedule_get_next_active_link(&asn, &offset, &backup) == NULL);
+  UNIT_TEST_ASSERT(backup == NULL);
+  tsch_schedule_add_slotframe(0, 7);
+  UNIT_TEST_ASSERT(tsch_schedule_get_next_active_link(&asn, &offset, &backup) == NULL);
+  UNIT_TEST_ASSERT(same_next_active_links());
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(single, "Single link");
+UNIT_TEST(single)
+{
+  struct tsch_asn_t asn;
+  struct tsch_slotframe *sf;
+  struct tsch_link *l, *backup;
+  uint16_t offset;
+
+  UNIT_TEST_BEGIN();
+  tsch_schedule_remove_all_slotframes();
+  sf = tsch_schedule_add_slotframe(0, 7);
+  l = tsch_schedule_add_link(sf, LINK_OPTION_RX, LINK_TYPE_NORMAL,
+                             &tsch_broadcast_address, 3, 0, 0);
+  /* The link is after the current timeslot */
+  TSCH_ASN_INIT(asn, 0, 7 * 10 + 1);
+  UNIT_TEST_ASSERT(tsch_schedule_get_next_active_link(&asn, &offset, &backup) == l);
+  UNIT_TEST_ASSERT(offset == 2);
+  /* The link is at the current timeslot, it is next in the next cycle */
+  TSCH_ASN_INIT(asn, 0, 7 * 10 + 3);
+  UNIT_TEST_ASSERT(tsch_schedule_get_next_active_link(&asn, &offset, &backup) == l);
+  UNIT_TEST_ASSERT(offset == 7);
+  /* The link is before the current timeslot */
+  TSCH_ASN_INIT(asn, 0, 7 * 10 + 5);
+  UNIT_TEST_ASSERT(tsch_schedule_get_next_active_link(&asn, &offset, &backup) == l);
+  UNIT_TEST_ASSERT(offset == 5);
+  UNIT_TEST_ASSERT(backup == NULL);
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(random_add, "Random schedules");
+UNIT_TEST(random_add)
+{
+  int round, i;
+  int ok = 1;
+
+  UNIT_TEST_BEGIN();
+  for(round = 0; round < NUM_ROUNDS && ok; round++) {
+    add_random_slotframes(1 + round % TSCH_SCHEDULE_MAX_SLOTFRAMES);
+    for(i = 0; i < TSCH_SCHEDULE_MAX_LINKS; i++) {
+      add_random_link(random_slotframe());
+    }
+    ok = same_next_active_links();
+  }
+  UNIT_TEST_ASSERT(ok);
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(random_remove, "Random additions and removals");
+UNIT_TEST(random_remove)
+{
+  struct tsch_link *l;
+  int round, i;
+  int ok = 1;
+
+  UNIT_TEST_BEGIN();
+  for(round = 0; round < NUM_ROUNDS && ok; round++) {
+    add_random_slotframes(1 + round % TSCH_SCHEDULE_MAX_SLOTFRAMES);
+    for(i = 0; i < 4 * TSCH_SCHEDULE_MAX_LINKS && ok; i++) {
+      if(random_rand() % 3 == 0 && (l = random_link()) != NULL) {
+        tsch_schedule_remove_link(tsch_schedule_get_slotframe_by_handle(l->slotframe_handle), l);
+      } else {
+        add_random_link(random_slotframe());
+      }
+      if(i % 16 == 0) {
+        ok = same_next_active_links();
+      }
+    }
+  }
+  UNIT_TEST_ASSERT(ok);
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(by_timeslot, "Link by timeslot");
+UNIT_TEST(by_timeslot)
+{
+  struct tsch_slotframe *sf;
+  struct tsch_link *l, *found;
+  uint16_t timeslot, channel_offset;
+  int i;
+  int ok = 1;
+
+  UNIT_TEST_BEGIN();
+  add_random_slotframes(TSCH_SCHEDULE_MAX_SLOTFRAMES);
+  for(i = 0; i < TSCH_SCHEDULE_MAX_LINKS; i++) {
+    add_random_link(random_slotframe());
+  }
+  for(sf = tsch_schedule_slotframe_head(); sf != NULL;
+      sf = tsch_schedule_slotframe_next(sf)) {
+    for(timeslot = 0; timeslot < sf->size.val; timeslot++) {
+      for(channel_offset = 0; channel_offset < 4; channel_offset++) {
+        /* The first link of the list at this timeslot and channel offset */
+        for(l = list_head(sf->links_list); l != NULL; l = list_item_next(l)) {
+          if(l->timeslot == timeslot && l->channel_offset == channel_offset) {
+            break;
+          }
+        }
+        found = tsch_schedule_get_link_by_timeslot(sf, timeslot, channel_offset);
+        ok = ok && found == l;
+      }
+    }
+  }
+  UNIT_TEST_ASSERT(ok);
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  init_neighbors();
+  tsch_schedule_init();
+
+  UNIT_TEST_RUN(empty);
+  UNIT_TEST_RUN(single);
+  UNIT_TEST_RUN(random_add);
+  UNIT_TEST_RUN(random_remove);
+  UNIT_TEST_RUN(by_timeslot);
+
+  printf("=check-me= DONE\n");
+  printf("---\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "contiki.h"
+#include "unit-test.h"
+#include "lib/random.h"
+#include "net/packetbuf.h"
+#include "net/mac/tsch/tsch.h"
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * Runs random traffic through the TSCH queues, and checks that the
+ * neighbor picked for a shared broadcast link and the backoff windows
+ * are the ones found by walking all neighbors, as the queues did
+ * before they kept the ready neighbors apart.
+ */
+
+#define NUM_NEIGHBORS  (NBR_TABLE_CONF_MAX_NEIGHBORS - 2)
+#define NUM_EVENTS     20000
+
+PROCESS(test_process, "test");
+AUTOSTART_PROCESSES(&test_process);
+
+/* What the queues need from the rest of TSCH */
+const linkaddr_t tsch_broadcast_address = { { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } };
+const linkaddr_t tsch_eb_address = { { 0, 0, 0, 0, 0, 0, 0, 0 } };
+int tsch_is_coordinator;
+static int locked;
+/*---------------------------------------------------------------------------*/
+int
+tsch_is_locked(void)
+{
+  return locked;
+}
+/*---------------------------------------------------------------------------*/
+int
+tsch_get_lock(void)
+{
+  if(locked) {
+    return 0;
+  }
+  locked = 1;
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+void
+tsch_release_lock(void)
+{
+  locked = 0;
+}
+/*---------------------------------------------------------------------------*/
+void
+tsch_set_ka_timeout(uint32_t timeout)
+{
+}
+/*---------------------------------------------------------------------------*/
+static linkaddr_t addrs[NUM_NEIGHBORS];
+static struct tsch_link shared_link;
+static struct tsch_link dedicated_link;
+static struct tsch_link unicast_link;
+/*---------------------------------------------------------------------------*/
+/* Whether a neighbor may send over a broadcast link, as the queues
+ * looked up neighbors before */
+static int
+may_send(struct tsch_neighbor *n, struct tsch_link *link)
+{
+  return !n->is_broadcast && n->tx_links_count == 0
+    && tsch_queue_get_packet_for_nbr(n, link) != NULL;
+}
+/*---------------------------------------------------------------------------*/
+static int
+any_may_send(struct tsch_link *link)
+{
+  int i;
+
+  for(i = 0; i < NUM_NEIGHBORS; i++) {
+    struct tsch_neighbor *n = tsch_queue_get_nbr(&addrs[i]);
+    if(n != NULL && may_send(n, link)) {
+      return 1;
+    }
+  }
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+/* Whether the backoff windows are updated after a shared link to an
+ * address as the queues updated them before */
+static int
+same_backoff_update(const linkaddr_t *dest_addr)
+{
+  int is_broadcast = linkaddr_cmp(dest_addr, &tsch_broadcast_address);
+  uint8_t expected[NUM_NEIGHBORS];
+  int i;
+
+  for(i = 0; i < NUM_NEIGHBORS; i++) {
+    struct tsch_neighbor *n = tsch_queue_get_nbr(&addrs[i]);
+    expected[i] = 0;
+    if(n != NULL) {
+      expected[i] = n->backoff_window;
+      if(n->backoff_window != 0
+         && ((n->tx_links_count == 0 && is_broadcast)
+             || (n->tx_links_count > 0 && linkaddr_cmp(dest_addr, &addrs[i])))) {
+        expected[i]--;
+      }
+    }
+  }
+  tsch_queue_update_all_backoff_windows(dest_addr);
+  for(i = 0; i < NUM_NEIGHBORS; i++) {
+    struct tsch_neighbor *n = tsch_queue_get_nbr(&addrs[i]);
+    if(n != NULL && n->backoff_window != expected[i]) {
+      printf("neighbor %d: backoff window %u instead of %u\n",
+             i, n->backoff_window, expected[i]);
+      return 0;
+    }
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+/* Sends a packet, with a random outcome */
+static void
+send(struct tsch_neighbor *n, struct tsch_packet *p, struct tsch_link *link)
+{
+  p->transmissions++;
+  if(!tsch_queue_packet_sent(n, p, link,
+                             random_rand() % 2 ? MAC_TX_OK : MAC_TX_NOACK)) {
+    tsch_queue_free_packet(p);
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* A broadcast link with no broadcast packet to send */
+static int
+broadcast_slot(struct tsch_link *link)
+{
+  struct tsch_neighbor *n = NULL;
+  struct tsch_packet *p;
+
+  p = tsch_queue_get_unicast_packet_for_any(&n, link);
+  if(p == NULL) {
+    if(any_may_send(link)) {
+      printf("no neighbor picked\n");
+      return 0;
+    }
+  } else {
+    if(n == NULL || !may_send(n, link) || p != tsch_queue_get_packet_for_nbr(n, link)) {
+      printf("neighbor %p picked\n", (void *)n);
+      return 0;
+    }
+    send(n, p, link);
+  }
+  return !(link->link_options & LINK_OPTION_SHARED) || same_backoff_update(&link->addr);
+}
+/*---------------------------------------------------------------------------*/
+/* A shared unicast link to a neighbor */
+static int
+unicast_slot(int i)
+{
+  struct tsch_neighbor *n = tsch_queue_get_nbr(&addrs[i]);
+  struct tsch_packet *p;
+
+  linkaddr_copy(&unicast_link.addr, &addrs[i]);
+  if(n != NULL && n->tx_links_count > 0) {
+    p = tsch_queue_get_packet_for_nbr(n, &unicast_link);
+    if(p != NULL) {
+      send(n, p, &unicast_link);
+    }
+  }
+  return same_backoff_update(&addrs[i]);
+}
+/*---------------------------------------------------------------------------*/
+/* Gives or takes a Tx link to a neighbor, as the schedule does */
+static void
+toggle_tx_link(int i)
+{
+  struct tsch_neighbor *n = tsch_queue_add_nbr(&addrs[i]);
+
+  if(n != NULL) {
+    if(n->tx_links_count == 0) {
+      n->tx_links_count++;
+    } else {
+      n->tx_links_count--;
+      tsch_queue_tx_links_updated(n);
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+add_packet(int i)
+{
+  packetbuf_clear();
+  packetbuf_set_datalen(10);
+  tsch_queue_add_packet(&addrs[i], 1 + random_rand() % 4, NULL, NULL);
+}
+/*---------------------------------------------------------------------------*/
+/* Runs random events, returns 0 at the first difference */
+static int
+run(unsigned add_weight)
+{
+  int i;
+  int ok = 1;
+
+  for(i = 0; i < NUM_EVENTS && ok; i++) {
+    unsigned r = random_rand() % (add_weight + 20);
+    int nbr = random_rand() % NUM_NEIGHBORS;
+    if(r < add_weight) {
+      add_packet(nbr);
+    } else if(r < add_weight + 8) {
+      ok = broadcast_slot(&shared_link);
+    } else if(r < add_weight + 10) {
+      ok = broadcast_slot(&dedicated_link);
+    } else if(r < add_weight + 15) {
+      ok = unicast_slot(nbr);
+    } else if(r < add_weight + 17) {
+      toggle_tx_link(nbr);
+    } else if(r < add_weight + 18) {
+      tsch_queue_free_packets_to(&addrs[nbr]);
+    } else if(r < add_weight + 19) {
+      tsch_queue_free_unused_neighbors();
+    } else if(random_rand() % 20 == 0) {
+      tsch_queue_reset();
+    }
+  }
+  return ok;
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(light, "Light traffic");
+UNIT_TEST(light)
+{
+  UNIT_TEST_BEGIN();
+  UNIT_TEST_ASSERT(run(4));
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+UNIT_TEST_REGISTER(heavy, "Heavy traffic");
+UNIT_TEST(heavy)
+{
+  UNIT_TEST_BEGIN();
+  UNIT_TEST_ASSERT(run(40));
+  UNIT_TEST_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(test_process, ev, data)
+{
+  int i;
+
+  PROCESS_BEGIN();
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  for(i = 0; i < NUM_NEIGHBORS; i++) {
+    memset(&addrs[i], 0, sizeof(linkaddr_t));
+    addrs[i].u8[LINKADDR_SIZE - 1] = i + 1;
+  }
+  shared_link.link_options = LINK_OPTION_TX | LINK_OPTION_SHARED;
+  linkaddr_copy(&shared_link.addr, &tsch_broadcast_address);
+  dedicated_link.link_options = LINK_OPTION_TX;
+  linkaddr_copy(&dedicated_link.addr, &tsch_broadcast_address);
+  unicast_link.link_options = LINK_OPTION_TX | LINK_OPTION_SHARED;
+  tsch_queue_init();
+
+  UNIT_TEST_RUN(light);
+  UNIT_TEST_RUN(heavy);
+
+  printf("=check-me= DONE\n");
+  printf("---\n");
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
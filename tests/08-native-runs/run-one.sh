@@ -25,7 +25,7 @@ for TEST in ./test*.native; do
 
   wait_log_assert "start $TEST" "Run unit-test" $RUNLOG 30
   wait_log_assert "run $TEST" "=check-me= DONE" $RUNLOG 120
-  assert "check $TEST" "! grep -q '=check-me= FAILED' $RUNLOG"
+  assert "check $TEST" "! grep -q -e '=check-me= FAILED' -e '^Result: failure' $RUNLOG"
 done
 
 do_wrap_up
@@ -0,0 +1,945 @@
+/*
+ * Copyright (c) 2026, Contiki-NG contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * \file
+ *         A network simulator that runs many native-sim motes in one
+ *         process, in simulated time.
+ *
+ *         Every mote loads its own copy of its firmware, a shared
+ *         object, so that it has globals of its own. Each mote runs in a
+ *         coroutine with a stack of its own, and returns to the
+ *         simulator when it waits for time to pass.
+ *
+ *         Time advances from one event to the next: a mote timer, or the
+ *         end of a radio transmission. A transmission reaches the motes
+ *         linked to the sender, according to a unit-disk graph or to
+ *         explicit links, with a probability of success per link.
+ *         Overlapping transmissions heard by a mote collide.
+ */
+
+#define _GNU_SOURCE
+#include <dlfcn.h>
+#include <errno.h>
+#include <libgen.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+
+#include "native-sim.h"
+
+#define STACK_SIZE     (128 * 1024)
+#define FRAME_MAX      127
+/* Preamble, start of frame delimiter and length field */
+#define PHY_OVERHEAD   6
+/* Microseconds per byte at 250 kbit/s */
+#define BYTE_AIR_TIME  32
+#define RSSI_NOISE     -100
+/* The unit-disk graph model, after the one of Cooja */
+#define RSSI_STRONG    -10
+#define RSSI_WEAK      -95
+#define LINE_MAX_LEN   1024
+
+struct mote;
+
+struct mote_type {
+  struct mote_type *next;
+  char *path;
+  /* The contents of the firmware file */
+  void *image;
+  size_t size;
+};
+
+struct link {
+  struct mote *to;
+  /* Probability that a frame that does not collide is received */
+  double prr;
+  int rssi;
+};
+
+struct transmission {
+  struct transmission *next;
+  struct mote *sender;
+  uint64_t end;
+  int channel;
+  bool lost;
+  unsigned short len;
+  uint8_t frame[FRAME_MAX];
+  /* The motes that hear the transmission */
+  unsigned nheard;
+  struct link *heard[];
+};
+
+struct mote {
+  uint16_t id;
+  struct mote_type *type;
+  void (*main)(const struct native_sim_host *host);
+  double x;
+  double y;
+  ucontext_t context;
+  void *stack;
+  /* Wake-up events of an earlier generation are stale */
+  uint64_t generation;
+
+  struct link *links;
+  unsigned nlinks;
+  unsigned maxlinks;
+
+  bool radio_on;
+  int channel;
+  bool transmitting;
+  /* Transmissions that the mote hears */
+  unsigned heard;
+  /* The frame being received, and whether it is corrupt */
+  struct transmission *rx;
+  struct link *rx_link;
+  bool rx_corrupt;
+  /* The frame received and not read yet */
+  uint8_t rx_frame[FRAME_MAX];
+  unsigned short rx_len;
+  int rx_rssi;
+
+  char line[LINE_MAX_LEN];
+  size_t line_len;
+};
+
+enum event_kind {
+  EVENT_WAKE,
+  EVENT_TX_END,
+};
+
+struct event {
+  uint64_t time;
+  uint64_t seq;
+  enum event_kind kind;
+  struct mote *mote;
+  uint64_t generation;
+  struct transmission *tx;
+};
+
+static struct mote_type *types;
+static struct mote **motes;
+static unsigned nmotes;
+static unsigned maxmotes;
+
+static struct event *heap;
+static size_t heap_len;
+static size_t heap_max;
+static uint64_t event_seq;
+
+static struct transmission *active;
+
+static ucontext_t host_context;
+static struct mote *current;
+static uint64_t now;
+
+/* Scenario */
+static uint64_t seed = 1;
+static uint64_t duration = 60 * 1000000ULL;
+static bool udgm = true;
+static double tx_range = 50;
+static double interference_range = 100;
+static double success_tx = 1;
+static double success_rx = 1;
+static bool quiet;
+
+/* Statistics */
+static unsigned long long resumes;
+static unsigned long long frames_sent;
+static unsigned long long frames_received;
+static unsigned long long frames_collided;
+static unsigned long long frames_lost;
+static unsigned long long frames_dropped;
+
+static uint64_t rng_state;
+/*---------------------------------------------------------------------------*/
+static void
+die(const char *fmt, ...)
+{
+  va_list ap;
+
+  va_start(ap, fmt);
+  fprintf(stderr, "native-sim: ");
+  vfprintf(stderr, fmt, ap);
+  fprintf(stderr, "\n");
+  va_end(ap);
+  exit(EXIT_FAILURE);
+}
+/*---------------------------------------------------------------------------*/
+static void *
+xcalloc(size_t n, size_t size)
+{
+  void *p = calloc(n, size);
+
+  if(p == NULL) {
+    die("out of memory");
+  }
+  return p;
+}
+/*---------------------------------------------------------------------------*/
+/* splitmix64, so that a run only depends on the seed */
+static uint64_t
+rng_next(void)
+{
+  uint64_t z = (rng_state += 0x9e3779b97f4a7c15ULL);
+
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+/*---------------------------------------------------------------------------*/
+static double
+rng_uniform(void)
+{
+  return (rng_next() >> 11) * (1.0 / (1ULL << 53));
+}
+/*---------------------------------------------------------------------------*/
+/* Events, in a binary heap ordered by time, then by order of insertion */
+static bool
+event_before(const struct event *a, const struct event *b)
+{
+  return a->time < b->time || (a->time == b->time && a->seq < b->seq);
+}
+/*---------------------------------------------------------------------------*/
+static void
+event_push(uint64_t time, enum event_kind kind, struct mote *m,
+           struct transmission *tx)
+{
+  struct event ev;
+  size_t i;
+
+  if(heap_len == heap_max) {
+    heap_max = heap_max ? heap_max * 2 : 1024;
+    heap = realloc(heap, heap_max * sizeof(*heap));
+    if(heap == NULL) {
+      die("out of memory");
+    }
+  }
+
+  ev.time = time;
+  ev.seq = event_seq++;
+  ev.kind = kind;
+  ev.mote = m;
+  ev.generation = m != NULL ? m->generation : 0;
+  ev.tx = tx;
+
+  for(i = heap_len++; i > 0 && event_before(&ev, &heap[(i - 1) / 2]);
+      i = (i - 1) / 2) {
+    heap[i] = heap[(i - 1) / 2];
+  }
+  heap[i] = ev;
+}
+/*---------------------------------------------------------------------------*/
+static struct event
+event_pop(void)
+{
+  struct event top = heap[0];
+  struct event last = heap[--heap_len];
+  size_t i = 0;
+  size_t child;
+
+  while((child = 2 * i + 1) < heap_len) {
+    if(child + 1 < heap_len && event_before(&heap[child + 1], &heap[child])) {
+      child++;
+    }
+    if(!event_before(&heap[child], &last)) {
+      break;
+    }
+    heap[i] = heap[child];
+    i = child;
+  }
+  heap[i] = last;
+  return top;
+}
+/*---------------------------------------------------------------------------*/
+/* Resume the mote at the given time, unless it is resumed earlier */
+static void
+schedule_wake(struct mote *m, uint64_t time)
+{
+  m->generation++;
+  if(time != NATIVE_SIM_NEVER) {
+    event_push(time, EVENT_WAKE, m, NULL);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+resume(struct mote *m)
+{
+  current = m;
+  resumes++;
+  if(swapcontext(&host_context, &m->context) < 0) {
+    die("swapcontext: %s", strerror(errno));
+  }
+  current = NULL;
+}
+/*---------------------------------------------------------------------------*/
+/* Host functions, called by the running mote */
+static uint16_t
+host_mote_id(void)
+{
+  return current->id;
+}
+/*---------------------------------------------------------------------------*/
+static uint32_t
+host_seed(void)
+{
+  uint64_t z = seed * 0x9e3779b97f4a7c15ULL + current->id;
+
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  return (uint32_t)(z ^ (z >> 31));
+}
+/*---------------------------------------------------------------------------*/
+static uint64_t
+host_now(void)
+{
+  return now;
+}
+/*---------------------------------------------------------------------------*/
+static void
+host_wait(uint64_t until)
+{
+  struct mote *m = current;
+
+  schedule_wake(m, until);
+  if(swapcontext(&m->context, &host_context) < 0) {
+    die("swapcontext: %s", strerror(errno));
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+print_line(struct mote *m)
+{
+  if(!quiet) {
+    printf("%llu.%06llu\tID:%u\t%.*s\n",
+           (unsigned long long)(now / 1000000),
+           (unsigned long long)(now % 1000000),
+           m->id, (int)m->line_len, m->line);
+  }
+  m->line_len = 0;
+}
+/*---------------------------------------------------------------------------*/
+static void
+host_output(const char *data, size_t len)
+{
+  struct mote *m = current;
+  size_t i;
+
+  for(i = 0; i < len; i++) {
+    if(data[i] == '\n') {
+      print_line(m);
+    } else if(m->line_len < sizeof(m->line)) {
+      m->line[m->line_len++] = data[i];
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+host_radio_transmit(const void *frame, unsigned short len)
+{
+  struct mote *m = current;
+  struct transmission *tx;
+  struct link *l;
+  struct mote *r;
+  unsigned i;
+
+  if(len > FRAME_MAX) {
+    len = FRAME_MAX;
+  }
+
+  tx = xcalloc(1, sizeof(*tx) + m->nlinks * sizeof(tx->heard[0]));
+  tx->sender = m;
+  tx->end = now + (uint64_t)(len + PHY_OVERHEAD) * BYTE_AIR_TIME;
+  tx->channel = m->channel;
+  tx->lost = rng_uniform() >= success_tx;
+  tx->len = len;
+  memcpy(tx->frame, frame, len);
+  frames_sent++;
+
+  /* A frame being received by the sender is lost */
+  if(m->rx != NULL) {
+    m->rx_corrupt = true;
+  }
+  m->transmitting = true;
+
+  for(i = 0; i < m->nlinks; i++) {
+    l = &m->links[i];
+    r = l->to;
+    if(!r->radio_on || r->channel != tx->channel) {
+      continue;
+    }
+    tx->heard[tx->nheard++] = l;
+    if(r->rx != NULL) {
+      /* Collides with the frame being received */
+      r->rx_corrupt = true;
+    } else if(!r->transmitting && l->prr > 0) {
+      r->rx = tx;
+      r->rx_link = l;
+      /* Collides with a frame that started earlier */
+      r->rx_corrupt = r->heard > 0;
+    }
+    r->heard++;
+  }
+
+  tx->next = active;
+  active = tx;
+  event_push(tx->end, EVENT_TX_END, NULL, tx);
+
+  /* The radio is busy for the air time of the frame */
+  while(now < tx->end) {
+    host_wait(tx->end);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+end_transmission(struct transmission *tx)
+{
+  struct transmission **p;
+  struct mote *r;
+  struct link *l;
+  unsigned i;
+
+  for(p = &active; *p != tx; p = &(*p)->next);
+  *p = tx->next;
+  tx->sender->transmitting = false;
+
+  for(i = 0; i < tx->nheard; i++) {
+    l = tx->heard[i];
+    r = l->to;
+    r->heard--;
+    if(r->rx != tx) {
+      continue;
+    }
+    r->rx = NULL;
+    if(r->rx_corrupt) {
+      frames_collided++;
+    } else if(tx->lost || rng_uniform() >= l->prr) {
+      frames_lost++;
+    } else if(r->rx_len > 0) {
+      /* The previous frame has not been read */
+      frames_dropped++;
+    } else {
+      memcpy(r->rx_frame, tx->frame, tx->len);
+      r->rx_len = tx->len;
+      r->rx_rssi = l->rssi;
+      frames_received++;
+      /* Like an interrupt, which resumes the mote right away */
+      schedule_wake(r, now);
+    }
+  }
+  free(tx);
+}
+/*---------------------------------------------------------------------------*/
+static int
+host_radio_read(void *buf, unsigned short size, int *rssi)
+{
+  struct mote *m = current;
+  int len = m->rx_len;
+
+  if(len == 0) {
+    return 0;
+  }
+  m->rx_len = 0;
+  if(size < len) {
+    return 0;
+  }
+  memcpy(buf, m->rx_frame, len);
+  *rssi = m->rx_rssi;
+  return len;
+}
+/*---------------------------------------------------------------------------*/
+static int
+host_radio_pending(void)
+{
+  return current->rx_len > 0;
+}
+/*---------------------------------------------------------------------------*/
+static int
+host_radio_receiving(void)
+{
+  return current->rx != NULL;
+}
+/*---------------------------------------------------------------------------*/
+static int
+host_radio_rssi(void)
+{
+  struct transmission *tx;
+  int rssi = RSSI_NOISE;
+  unsigned i;
+
+  for(tx = active; tx != NULL; tx = tx->next) {
+    if(tx->channel != current->channel) {
+      continue;
+    }
+    for(i = 0; i < tx->nheard; i++) {
+      if(tx->heard[i]->to == current && tx->heard[i]->rssi > rssi) {
+        rssi = tx->heard[i]->rssi;
+      }
+    }
+  }
+  return rssi;
+}
+/*---------------------------------------------------------------------------*/
+static void
+host_radio_set(int on, int channel)
+{
+  struct mote *m = current;
+
+  if(m->rx != NULL && (!on || channel != m->channel)) {
+    m->rx_corrupt = true;
+  }
+  if(!on) {
+    m->rx_len = 0;
+  }
+  m->radio_on = on;
+  m->channel = channel;
+}
+/*---------------------------------------------------------------------------*/
+static const struct native_sim_host host = {
+  NATIVE_SIM_API_VERSION,
+  host_mote_id,
+  host_seed,
+  host_now,
+  host_wait,
+  host_output,
+  host_radio_transmit,
+  host_radio_read,
+  host_radio_pending,
+  host_radio_receiving,
+  host_radio_rssi,
+  host_radio_set,
+};
+/*---------------------------------------------------------------------------*/
+static void
+mote_start(void)
+{
+  current->main(&host);
+  die("mote %u returned", current->id);
+}
+/*---------------------------------------------------------------------------*/
+/* Mote firmware */
+static struct mote_type *
+load_type(const char *path)
+{
+  struct mote_type *t;
+  struct stat st;
+  FILE *f;
+
+  for(t = types; t != NULL; t = t->next) {
+    if(strcmp(t->path, path) == 0) {
+      return t;
+    }
+  }
+
+  f = fopen(path, "rb");
+  if(f == NULL) {
+    die("%s: %s", path, strerror(errno));
+  }
+  if(fstat(fileno(f), &st) < 0) {
+    die("%s: %s", path, strerror(errno));
+  }
+  t = xcalloc(1, sizeof(*t));
+  t->path = strdup(path);
+  t->size = st.st_size;
+  t->image = xcalloc(1, t->size);
+  if(fread(t->image, 1, t->size, f) != t->size) {
+    die("%s: short read", path);
+  }
+  fclose(f);
+
+  t->next = types;
+  types = t;
+  return t;
+}
+/*---------------------------------------------------------------------------*/
+/*
+ * Load a new instance of the firmware. The dynamic linker loads a file
+ * once however many times it is opened, so every instance is opened
+ * from a copy of its own, in memory. The copy stays open: the linker
+ * also recognizes files by name, and the name of a closed copy would be
+ * reused by the next one.
+ */
+static void
+load_instance(struct mote *m)
+{
+  char name[64];
+  void *handle;
+  int fd;
+
+  fd = memfd_create(basename(m->type->path), MFD_CLOEXEC);
+  if(fd < 0) {
+    die("memfd_create: %s", strerror(errno));
+  }
+  if(write(fd, m->type->image, m->type->size) != (ssize_t)m->type->size) {
+    die("write: %s", strerror(errno));
+  }
+  snprintf(name, sizeof(name), "/proc/self/fd/%d", fd);
+  handle = dlopen(name, RTLD_NOW | RTLD_LOCAL);
+  if(handle == NULL) {
+    die("%s: %s", m->type->path, dlerror());
+  }
+  m->main = (void (*)(const struct native_sim_host *))
+    dlsym(handle, NATIVE_SIM_MAIN);
+  if(m->main == NULL) {
+    die("%s: not a native-sim firmware", m->type->path);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+add_mote(const char *path, double x, double y)
+{
+  struct mote *m;
+
+  if(nmotes == UINT16_MAX) {
+    die("too many motes");
+  }
+  if(nmotes == maxmotes) {
+    maxmotes = maxmotes ? maxmotes * 2 : 64;
+    motes = realloc(motes, maxmotes * sizeof(*motes));
+    if(motes == NULL) {
+      die("out of memory");
+    }
+  }
+
+  m = xcalloc(1, sizeof(*m));
+  m->id = nmotes + 1;
+  m->type = load_type(path);
+  m->x = x;
+  m->y = y;
+  m->radio_on = true;
+  m->channel = -1;
+  load_instance(m);
+
+  m->stack = mmap(NULL, STACK_SIZE, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if(m->stack == MAP_FAILED) {
+    die("mmap: %s", strerror(errno));
+  }
+  getcontext(&m->context);
+  m->context.uc_stack.ss_sp = m->stack;
+  m->context.uc_stack.ss_size = STACK_SIZE;
+  m->context.uc_link = NULL;
+  makecontext(&m->context, mote_start, 0);
+
+  motes[nmotes++] = m;
+}
+/*---------------------------------------------------------------------------*/
+static struct mote *
+mote_by_id(unsigned long id)
+{
+  if(id < 1 || id > nmotes) {
+    die("no mote %lu", id);
+  }
+  return motes[id - 1];
+}
+/*---------------------------------------------------------------------------*/
+static void
+add_link(struct mote *from, struct mote *to, double prr, int rssi)
+{
+  struct link *l;
+
+  if(from->nlinks == from->maxlinks) {
+    from->maxlinks = from->maxlinks ? from->maxlinks * 2 : 8;
+    from->links = realloc(from->links, from->maxlinks * sizeof(*l));
+    if(from->links == NULL) {
+      die("out of memory");
+    }
+  }
+  l = &from->links[from->nlinks++];
+  l->to = to;
+  l->prr = prr;
+  l->rssi = rssi;
+}
+/*---------------------------------------------------------------------------*/
+/* Links of the unit-disk graph model. Motes in range receive frames
+   with a probability that decreases with the distance; motes in
+   interference range only hear them. */
+static void
+make_udgm_links(void)
+{
+  struct mote *a, *b;
+  double d2, ratio;
+  unsigned i, j;
+
+  for(i = 0; i < nmotes; i++) {
+    a = motes[i];
+    for(j = 0; j < nmotes; j++) {
+      b = motes[j];
+      if(i == j) {
+        continue;
+      }
+      d2 = (a->x - b->x) * (a->x - b->x) + (a->y - b->y) * (a->y - b->y);
+      if(d2 > interference_range * interference_range) {
+        continue;
+      }
+      if(d2 <= tx_range * tx_range) {
+        ratio = d2 / (tx_range * tx_range);
+        add_link(a, b, 1.0 - ratio * (1.0 - success_rx),
+                 RSSI_STRONG + ratio * (RSSI_WEAK - RSSI_STRONG));
+      } else {
+        add_link(a, b, 0, RSSI_NOISE);
+      }
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Scenario files */
+static char *
+resolve(const char *dir, const char *path)
+{
+  char *full;
+
+  if(path[0] == '/') {
+    return strdup(path);
+  }
+  /* A path without a slash would be looked up in the library path */
+  if(asprintf(&full, "%s/%s", dir != NULL ? dir : ".", path) < 0) {
+    die("out of memory");
+  }
+  return full;
+}
+/*---------------------------------------------------------------------------*/
+static double
+number(const char *s, const char *file, unsigned line)
+{
+  char *end;
+  double v;
+
+  if(s == NULL) {
+    die("%s:%u: missing argument", file, line);
+  }
+  v = strtod(s, &end);
+  if(*end != '\0') {
+    die("%s:%u: not a number: %s", file, line, s);
+  }
+  return v;
+}
+/*---------------------------------------------------------------------------*/
+static void
+load_scenario(const char *file)
+{
+  char buf[1024];
+  char *argv[8];
+  char *dir, *slash, *path, *save;
+  unsigned line = 0;
+  unsigned argc;
+  unsigned cols, rows, c, r;
+  double spacing;
+  FILE *f;
+
+  f = fopen(file, "r");
+  if(f == NULL) {
+    die("%s: %s", file, strerror(errno));
+  }
+  dir = strdup(file);
+  slash = strrchr(dir, '/');
+  if(slash != NULL) {
+    *slash = '\0';
+  } else {
+    free(dir);
+    dir = NULL;
+  }
+
+  while(fgets(buf, sizeof(buf), f) != NULL) {
+    line++;
+    if(strchr(buf, '#') != NULL) {
+      *strchr(buf, '#') = '\0';
+    }
+    argc = 0;
+    for(argv[0] = strtok_r(buf, " \t\r\n", &save);
+        argv[argc] != NULL && argc < 7;
+        argv[++argc] = strtok_r(NULL, " \t\r\n", &save));
+    if(argc == 0) {
+      continue;
+    }
+    argv[argc] = NULL;
+
+    if(strcmp(argv[0], "seed") == 0) {
+      seed = number(argv[1], file, line);
+    } else if(strcmp(argv[0], "duration") == 0) {
+      duration = number(argv[1], file, line) * 1000000;
+    } else if(strcmp(argv[0], "udgm") == 0) {
+      udgm = true;
+      tx_range = number(argv[1], file, line);
+      interference_range = number(argv[2], file, line);
+      success_tx = argc > 3 ? number(argv[3], file, line) : 1;
+      success_rx = argc > 4 ? number(argv[4], file, line) : 1;
+    } else if(strcmp(argv[0], "links") == 0) {
+      udgm = false;
+    } else if(strcmp(argv[0], "mote") == 0) {
+      if(argv[1] == NULL) {
+        die("%s:%u: missing firmware", file, line);
+      }
+      path = resolve(dir, argv[1]);
+      add_mote(path, argc > 2 ? number(argv[2], file, line) : 0,
+               argc > 3 ? number(argv[3], file, line) : 0);
+      free(path);
+    } else if(strcmp(argv[0], "grid") == 0) {
+      if(argv[1] == NULL) {
+        die("%s:%u: missing firmware", file, line);
+      }
+      path = resolve(dir, argv[1]);
+      cols = number(argv[2], file, line);
+      rows = number(argv[3], file, line);
+      spacing = number(argv[4], file, line);
+      for(r = 0; r < rows; r++) {
+        for(c = 0; c < cols; c++) {
+          add_mote(path, c * spacing, r * spacing);
+        }
+      }
+      free(path);
+    } else if(strcmp(argv[0], "link") == 0) {
+      add_link(mote_by_id(number(argv[1], file, line)),
+               mote_by_id(number(argv[2], file, line)),
+               number(argv[3], file, line),
+               argc > 4 ? number(argv[4], file, line) : RSSI_WEAK / 2);
+    } else {
+      die("%s:%u: unknown command %s", file, line, argv[0]);
+    }
+  }
+
+  fclose(f);
+  free(dir);
+}
+/*---------------------------------------------------------------------------*/
+static double
+wall_seconds(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+/*---------------------------------------------------------------------------*/
+static void
+usage(void)
+{
+  fprintf(stderr,
+          "usage: native-sim [-q] [-d seconds] [-s seed] scenario\n"
+          "  -q  do not print the output of the motes\n"
+          "  -d  simulated time, overrides the scenario\n"
+          "  -s  random seed, overrides the scenario\n");
+  exit(EXIT_FAILURE);
+}
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char **argv)
+{
+  double opt_duration = -1;
+  long long opt_seed = -1;
+  double start, elapsed;
+  struct rlimit limit;
+  struct event ev;
+  unsigned i;
+  int opt;
+
+  while((opt = getopt(argc, argv, "qd:s:")) != -1) {
+    switch(opt) {
+    case 'q':
+      quiet = true;
+      break;
+    case 'd':
+      opt_duration = atof(optarg);
+      break;
+    case 's':
+      opt_seed = atoll(optarg);
+      break;
+    default:
+      usage();
+    }
+  }
+  if(optind + 1 != argc) {
+    usage();
+  }
+
+  /* Every mote keeps a file descriptor open */
+  if(getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+  }
+
+  load_scenario(argv[optind]);
+  if(opt_duration >= 0) {
+    duration = opt_duration * 1000000;
+  }
+  if(opt_seed >= 0) {
+    seed = opt_seed;
+  }
+  if(nmotes == 0) {
+    die("%s: no motes", argv[optind]);
+  }
+  rng_state = seed;
+  if(udgm) {
+    make_udgm_links();
+  }
+
+  /* All motes boot at time zero, in the order of their IDs */
+  for(i = 0; i < nmotes; i++) {
+    event_push(0, EVENT_WAKE, motes[i], NULL);
+  }
+
+  start = wall_seconds();
+  while(heap_len > 0 && heap[0].time <= duration) {
+    ev = event_pop();
+    now = ev.time;
+    if(ev.kind == EVENT_TX_END) {
+      end_transmission(ev.tx);
+    } else if(ev.generation == ev.mote->generation) {
+      resume(ev.mote);
+    }
+  }
+  elapsed = wall_seconds() - start;
+
+  /* Flush what the motes wrote on their last line */
+  for(i = 0; i < nmotes; i++) {
+    if(motes[i]->line_len > 0) {
+      print_line(motes[i]);
+    }
+  }
+  fflush(stdout);
+
+  fprintf(stderr, "native-sim: %u motes, %.1f s simulated in %.2f s (%.0fx), "
+          "%llu resumes\n",
+          nmotes, duration / 1e6, elapsed,
+          elapsed > 0 ? duration / 1e6 / elapsed : 0, resumes);
+  fprintf(stderr, "native-sim: frames sent %llu, received %llu, "
+          "collided %llu, lost %llu, dropped %llu\n",
+          frames_sent, frames_received, frames_collided, frames_lost,
+          frames_dropped);
+  return 0;
+}